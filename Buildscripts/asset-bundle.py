@@ -0,0 +1,185 @@
+import argparse
+import shutil
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+# Copies the system data folder and adds assets.bundle: small PNG images that are pre-decoded into the display's
+# native color format. Tactility's image cache (see Tactility/Source/lvgl/ImageCache.cpp) loads these without decoding.
+#
+# Bundle format (little endian):
+#   magic "TTAB", u32 version, u32 color depth, u32 entry count
+#   entries: u16 path length, path (relative to the system folder), u32 offset, u32 size
+#   images: LVGL v9 image header (12 bytes) followed by the pixel data, aligned to 4 bytes
+
+BUNDLE_FILE_NAME = "assets.bundle"
+BUNDLE_MAGIC = b"TTAB"
+BUNDLE_VERSION = 1
+# Larger images (e.g. boot logos) are shown once, so they're not worth the flash space
+MAX_PIXEL_COUNT = 40 * 40
+
+LV_IMAGE_HEADER_MAGIC = 0x19
+LV_COLOR_FORMAT_RGB565 = 0x12
+LV_COLOR_FORMAT_RGB565A8 = 0x14
+LV_COLOR_FORMAT_ARGB8888 = 0x10
+
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+
+def paeth(a: int, b: int, c: int) -> int:
+    p = a + b - c
+    pa = abs(p - a)
+    pb = abs(p - b)
+    pc = abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    elif pb <= pc:
+        return b
+    else:
+        return c
+
+def unfilter(data: bytes, width: int, height: int, bytes_per_pixel: int) -> bytearray:
+    stride = width * bytes_per_pixel
+    output = bytearray(stride * height)
+    previous = bytearray(stride)
+    offset = 0
+    for y in range(height):
+        filter_type = data[offset]
+        line = bytearray(data[offset + 1:offset + 1 + stride])
+        offset += 1 + stride
+        for x in range(stride):
+            left = line[x - bytes_per_pixel] if x >= bytes_per_pixel else 0
+            up = previous[x]
+            up_left = previous[x - bytes_per_pixel] if x >= bytes_per_pixel else 0
+            if filter_type == 1:
+                line[x] = (line[x] + left) & 0xFF
+            elif filter_type == 2:
+                line[x] = (line[x] + up) & 0xFF
+            elif filter_type == 3:
+                line[x] = (line[x] + ((left + up) >> 1)) & 0xFF
+            elif filter_type == 4:
+                line[x] = (line[x] + paeth(left, up, up_left)) & 0xFF
+            elif filter_type != 0:
+                raise ValueError(f"Unsupported filter type {filter_type}")
+        output[y * stride:(y + 1) * stride] = line
+        previous = line
+    return output
+
+def decode_png(path: Path):
+    """Returns (width, height, pixels) where pixels is a list of (r, g, b, a) tuples, or None when unsupported"""
+    data = path.read_bytes()
+    if not data.startswith(PNG_SIGNATURE):
+        return None
+    offset = len(PNG_SIGNATURE)
+    compressed = bytearray()
+    palette = []
+    transparency = b""
+    width = height = bit_depth = color_type = interlace = 0
+    while offset < len(data):
+        length, chunk_type = struct.unpack(">I4s", data[offset:offset + 8])
+        chunk = data[offset + 8:offset + 8 + length]
+        offset += 12 + length
+        if chunk_type == b"IHDR":
+            width, height, bit_depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif chunk_type == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif chunk_type == b"tRNS":
+            transparency = chunk
+        elif chunk_type == b"IDAT":
+            compressed += chunk
+        elif chunk_type == b"IEND":
+            break
+    if bit_depth != 8 or interlace != 0:
+        return None
+    channels = { 0: 1, 2: 3, 3: 1, 4: 2, 6: 4 }.get(color_type)
+    if channels is None:
+        return None
+    raw = unfilter(zlib.decompress(bytes(compressed)), width, height, channels)
+    pixels = []
+    for i in range(0, len(raw), channels):
+        if color_type == 0:
+            pixels.append((raw[i], raw[i], raw[i], 255))
+        elif color_type == 2:
+            pixels.append((raw[i], raw[i + 1], raw[i + 2], 255))
+        elif color_type == 3:
+            index = raw[i]
+            alpha = transparency[index] if index < len(transparency) else 255
+            pixels.append(palette[index] + (alpha,))
+        elif color_type == 4:
+            pixels.append((raw[i], raw[i], raw[i], raw[i + 1]))
+        else:
+            pixels.append(tuple(raw[i:i + 4]))
+    return width, height, pixels
+
+def to_rgb565(r: int, g: int, b: int) -> int:
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+def encode_image(width: int, height: int, pixels, color_depth: int) -> bytes:
+    if color_depth == 32:
+        color_format = LV_COLOR_FORMAT_ARGB8888
+        stride = width * 4
+        data = b"".join(struct.pack("<BBBB", b, g, r, a) for r, g, b, a in pixels)
+    elif all(a == 255 for _, _, _, a in pixels):
+        color_format = LV_COLOR_FORMAT_RGB565
+        stride = width * 2
+        data = b"".join(struct.pack("<H", to_rgb565(r, g, b)) for r, g, b, _ in pixels)
+    else:
+        # The RGB565 plane is followed by an alpha plane with half the stride
+        color_format = LV_COLOR_FORMAT_RGB565A8
+        stride = width * 2
+        data = b"".join(struct.pack("<H", to_rgb565(r, g, b)) for r, g, b, _ in pixels)
+        data += bytes(a for _, _, _, a in pixels)
+    header = struct.pack("<BBHHHHH", LV_IMAGE_HEADER_MAGIC, color_format, 0, width, height, stride, 0)
+    return header + data
+
+def create_bundle(system_path: Path, color_depth: int) -> int:
+    images = []
+    for path in sorted(system_path.rglob("*.png")):
+        decoded = decode_png(path)
+        if decoded is None:
+            print(f"Skipping {path}: unsupported PNG format")
+            continue
+        width, height, pixels = decoded
+        if width * height > MAX_PIXEL_COUNT:
+            continue
+        images.append((path.relative_to(system_path).as_posix(), encode_image(width, height, pixels, color_depth)))
+
+    index_size = 16 + sum(2 + len(name.encode("utf-8")) + 8 for name, _ in images)
+    offset = (index_size + 3) & ~3
+    index = bytearray(BUNDLE_MAGIC + struct.pack("<III", BUNDLE_VERSION, color_depth, len(images)))
+    content = bytearray()
+    for name, image in images:
+        encoded_name = name.encode("utf-8")
+        index += struct.pack("<H", len(encoded_name)) + encoded_name + struct.pack("<II", offset + len(content), len(image))
+        content += image
+        content += bytes(-len(content) % 4)
+    index += bytes(offset - len(index))
+    bundle_path = system_path / BUNDLE_FILE_NAME
+    bundle_path.write_bytes(index + content)
+    size = bundle_path.stat().st_size
+    print(f"Bundled {len(images)} images in {bundle_path} ({size} bytes, {color_depth} bit color)")
+    return size
+
+def main():
+    parser = argparse.ArgumentParser(description="Copy the system data and pre-decode its small PNG images")
+    parser.add_argument("--color-depth", type=int, required=True, help="LVGL color depth of the target (LV_COLOR_DEPTH)")
+    parser.add_argument("source", help="The system data folder (e.g. Data/system)")
+    parser.add_argument("target", help="The output folder")
+    args = parser.parse_args()
+
+    source_path = Path(args.source)
+    target_path = Path(args.target)
+    if target_path.exists():
+        shutil.rmtree(target_path)
+    # copy2() keeps the modification times, which are used for the partition image
+    shutil.copytree(source_path, target_path, copy_function=shutil.copy2)
+
+    if args.color_depth not in (16, 32):
+        print(f"Not creating {BUNDLE_FILE_NAME}: {args.color_depth} bit color is not supported")
+        return 0
+
+    create_bundle(target_path, args.color_depth)
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
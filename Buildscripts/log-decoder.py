@@ -0,0 +1,125 @@
+import re
+import struct
+import sys
+from pathlib import Path
+
+# Decodes binary log records (see TactilityCore/Include/Tactility/LoggerBinary.h) back into text.
+# Tags and format strings are recovered by hashing all string literals that are used with a Logger in the source tree.
+
+SYNC = b"\xa5\x5a"
+LEVEL_PREFIXES = ["E", "W", "I", "D", "V"]
+SOURCE_DIRECTORIES = ["Tactility", "TactilityC", "TactilityCore", "TactilityFreeRtos", "Devices", "Drivers", "Firmware"]
+TAG_PATTERN = re.compile(r'Logger\s*\(\s*"((?:[^"\\]|\\.)*)"\s*\)')
+FORMAT_PATTERN = re.compile(r'\.(?:verbose|debug|info|warn|error)\s*\(\s*"((?:[^"\\]|\\.)*)"|\.log\s*\([^,]+,\s*"((?:[^"\\]|\\.)*)"|tt_log\s*\([^,]+,[^,]+,\s*"((?:[^"\\]|\\.)*)"')
+
+def get_project_root():
+    return Path(__file__).parent.parent.resolve()
+
+def fnv1a(text: str) -> int:
+    hash = 2166136261
+    for byte in text.encode("utf-8"):
+        hash ^= byte
+        hash = (hash * 16777619) & 0xFFFFFFFF
+    return hash
+
+def unescape(literal: str) -> str:
+    return literal.encode("utf-8").decode("unicode_escape")
+
+def build_string_tables(root: Path):
+    tags = {}
+    formats = {}
+    for directory in SOURCE_DIRECTORIES:
+        for path in (root / directory).rglob("*"):
+            if path.suffix not in (".cpp", ".h", ".c"):
+                continue
+            source = path.read_text(encoding="utf-8", errors="ignore")
+            for match in TAG_PATTERN.finditer(source):
+                tag = unescape(match.group(1))
+                tags[fnv1a(tag)] = tag
+            for match in FORMAT_PATTERN.finditer(source):
+                literal = next(group for group in match.groups() if group is not None)
+                format_string = unescape(literal)
+                formats[fnv1a(format_string)] = format_string
+    return tags, formats
+
+def read_arguments(payload: bytes, offset: int, count: int):
+    arguments = []
+    for _ in range(count):
+        type = chr(payload[offset])
+        offset += 1
+        if type == "i":
+            arguments.append(struct.unpack_from("<q", payload, offset)[0])
+            offset += 8
+        elif type == "u":
+            arguments.append(struct.unpack_from("<Q", payload, offset)[0])
+            offset += 8
+        elif type == "f":
+            arguments.append(struct.unpack_from("<d", payload, offset)[0])
+            offset += 8
+        elif type == "b":
+            arguments.append("true" if payload[offset] else "false")
+            offset += 1
+        elif type == "s":
+            length = struct.unpack_from("<H", payload, offset)[0]
+            offset += 2
+            arguments.append(payload[offset:offset + length].decode("utf-8", errors="replace"))
+            offset += length
+        else:
+            break
+    return arguments
+
+def format_record(payload: bytes, tags, formats) -> str:
+    level, timestamp, tag_hash, format_hash, argument_count = struct.unpack_from("<BIIIB", payload, 0)
+    arguments = read_arguments(payload, 14, argument_count)
+    tag = tags.get(tag_hash, f"tag:{tag_hash:08x}")
+    format_string = formats.get(format_hash)
+    if format_string is None:
+        message = f"format:{format_hash:08x} {arguments}"
+    else:
+        try:
+            message = format_string.format(*arguments)
+        except (IndexError, ValueError, KeyError):
+            message = f"{format_string} {arguments}"
+    prefix = LEVEL_PREFIXES[level] if level < len(LEVEL_PREFIXES) else "?"
+    return f"{timestamp} {prefix} [{tag}] {message}\n"
+
+def decode(stream, output, tags, formats):
+    buffer = b""
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            break
+        buffer += chunk
+        while True:
+            index = buffer.find(SYNC)
+            if index < 0:
+                # Keep the last byte in case it's the start of a sync marker
+                output.write(buffer[:-1].decode("utf-8", errors="replace"))
+                buffer = buffer[-1:]
+                break
+            output.write(buffer[:index].decode("utf-8", errors="replace"))
+            buffer = buffer[index:]
+            if len(buffer) < 4:
+                break
+            length = struct.unpack_from("<H", buffer, 2)[0]
+            if len(buffer) < 4 + length:
+                break
+            output.write(format_record(buffer[4:4 + length], tags, formats))
+            buffer = buffer[4 + length:]
+        output.flush()
+    output.write(buffer.decode("utf-8", errors="replace"))
+
+def print_help():
+    print("Usage: python log-decoder.py [input_file]\n")
+    print("\t[input_file]    the captured log output (reads from stdin when omitted)")
+
+if __name__ == "__main__":
+    if "--help" in sys.argv:
+        print_help()
+        sys.exit(0)
+    tags, formats = build_string_tables(get_project_root())
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], "rb") as file:
+            decode(file, sys.stdout, tags, formats)
+    else:
+        decode(sys.stdin.buffer, sys.stdout, tags, formats)
@@ -14,4 +14,4 @@ mkdir -p $target_path
 cp version.txt $target_path
 cp $build_path/Firmware/FirmwareSim $target_path/
 cp -r Data/data $target_path/
-cp -r Data/system $target_path/
+python3 Buildscripts/asset-bundle.py --color-depth 32 Data/system $target_path/system
@@ -34,7 +34,8 @@ std::shared_ptr<tt::hal::display::DisplayDevice> createDisplay() {
         .touch = createTouch(),
         .backlightDutyFunction = driver::pwmbacklight::setBacklightDuty,
         .resetPin = GPIO_NUM_NC,
-        .rgbElementOrder = LCD_RGB_ELEMENT_ORDER_BGR
+        .rgbElementOrder = LCD_RGB_ELEMENT_ORDER_BGR,
+        .doubleBuffer = true
     };
 
     auto spi_configuration = std::make_shared<Ili934xDisplay::SpiConfiguration>(Ili934xDisplay::SpiConfiguration {
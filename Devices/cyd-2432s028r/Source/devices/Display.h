@@ -11,7 +11,8 @@ constexpr auto LCD_PIN_CS = GPIO_NUM_15;
 constexpr auto LCD_PIN_DC = GPIO_NUM_2;
 constexpr auto LCD_HORIZONTAL_RESOLUTION = 240;
 constexpr auto LCD_VERTICAL_RESOLUTION = 320;
-constexpr auto LCD_BUFFER_HEIGHT = LCD_VERTICAL_RESOLUTION / 10;
+// Double-buffered, so the total buffer memory is the same as a single buffer of 1/10 of the screen
+constexpr auto LCD_BUFFER_HEIGHT = LCD_VERTICAL_RESOLUTION / 20;
 constexpr auto LCD_BUFFER_SIZE = LCD_HORIZONTAL_RESOLUTION * LCD_BUFFER_HEIGHT;
 constexpr auto LCD_SPI_TRANSFER_SIZE_LIMIT = LCD_BUFFER_SIZE * LV_COLOR_DEPTH / 8;
 
@@ -9,7 +9,8 @@ constexpr auto LCD_PIN_CS = GPIO_NUM_12;
 constexpr auto LCD_PIN_DC = GPIO_NUM_11; // RS
 constexpr auto LCD_HORIZONTAL_RESOLUTION = 320;
 constexpr auto LCD_VERTICAL_RESOLUTION = 240;
-constexpr auto LCD_BUFFER_HEIGHT = (LCD_VERTICAL_RESOLUTION / 3);
+// Double-buffered, so the total buffer memory is the same as a single buffer of 1/3 of the screen
+constexpr auto LCD_BUFFER_HEIGHT = (LCD_VERTICAL_RESOLUTION / 6);
 constexpr auto LCD_BUFFER_SIZE = (LCD_HORIZONTAL_RESOLUTION * LCD_BUFFER_HEIGHT);
 constexpr auto LCD_SPI_TRANSFER_SIZE_LIMIT = LCD_BUFFER_SIZE * LV_COLOR_DEPTH / 8;
 
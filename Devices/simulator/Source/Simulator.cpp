@@ -1,6 +1,7 @@
 #include "LvglTask.h"
 #include "hal/SdlDisplay.h"
 #include "hal/SdlKeyboard.h"
+#include "hal/SimulatedI2cDevices.h"
 #include "hal/SimulatorPower.h"
 #include "hal/SimulatorSdCard.h"
 
@@ -14,6 +15,7 @@ using namespace tt::hal;
 static bool initBoot() {
     lv_init();
     lvgl_task_start();
+    attachSimulatedI2cDevices();
     return true;
 }
 
@@ -0,0 +1,21 @@
+#include "SimulatedI2cDevices.h"
+
+#include <Tactility/hal/i2c/I2cSimulator.h>
+
+using namespace tt::hal::i2c;
+
+// A BQ27220 fuel gauge with a battery that is 80% charged
+static std::shared_ptr<simulator::RegisterMapDevice> createFuelGauge() {
+    auto device = std::make_shared<simulator::RegisterMapDevice>();
+    device->setRegister16(0x06, 2981); // Temperature (0.1 K)
+    device->setRegister16(0x08, 3900); // Voltage (mV)
+    device->setRegister16(0x0C, static_cast<uint16_t>(-120)); // Current (mA)
+    device->setRegister16(0x10, 1600); // Remaining capacity (mAh)
+    device->setRegister16(0x12, 2000); // Full charge capacity (mAh)
+    device->setRegister16(0x2C, 80); // State of charge (%)
+    return device;
+}
+
+void attachSimulatedI2cDevices() {
+    simulator::attachDevice(I2C_NUM_0, 0x55, createFuelGauge());
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+/** Attach device models to the simulated I2C buses, so drivers and the I2C scanner have something to talk to */
+void attachSimulatedI2cDevices();
@@ -120,6 +120,7 @@ std::shared_ptr<tt::hal::display::DisplayDriver> EspLcdDisplay::getDisplayDriver
 
         displayDriver = std::make_shared<EspLcdDisplayDriver>(
             panelHandle,
+            isRgbPanel() ? nullptr : ioHandle,
             lock,
             lvgl_port_config.hres,
             lvgl_port_config.vres,
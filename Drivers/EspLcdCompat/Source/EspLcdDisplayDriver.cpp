@@ -0,0 +1,101 @@
+#include "EspLcdDisplayDriver.h"
+
+#include <Tactility/Logger.h>
+
+static const auto LOGGER = tt::Logger("EspLcdDispDrv");
+
+EspLcdDisplayDriver::EspLcdDisplayDriver(
+    esp_lcd_panel_handle_t panelHandle,
+    esp_lcd_panel_io_handle_t ioHandle,
+    std::shared_ptr<tt::Lock> lock,
+    uint16_t hRes,
+    uint16_t vRes,
+    tt::hal::display::ColorFormat colorFormat,
+    gpio_num_t tearingEffectPin
+) : panelHandle(panelHandle), ioHandle(ioHandle), lock(lock), hRes(hRes), vRes(vRes), colorFormat(colorFormat), tearingEffectPin(tearingEffectPin) {
+    if (tearingEffectPin == GPIO_NUM_NC) {
+        return;
+    }
+
+    const gpio_config_t io_config = {
+        .pin_bit_mask = 1ULL << tearingEffectPin,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_POSEDGE
+    };
+
+    auto semaphore = std::make_unique<tt::Semaphore>(1, 0);
+    // The ISR service might already be installed by another driver
+    const auto isr_service_result = gpio_install_isr_service(0);
+    if (gpio_config(&io_config) != ESP_OK ||
+        (isr_service_result != ESP_OK && isr_service_result != ESP_ERR_INVALID_STATE) ||
+        gpio_isr_handler_add(tearingEffectPin, onTearingEffect, semaphore.get()) != ESP_OK
+    ) {
+        LOGGER.error("Failed to set up tearing effect interrupt on GPIO {}", static_cast<int>(tearingEffectPin));
+        return;
+    }
+
+    tearingEffectSemaphore = std::move(semaphore);
+}
+
+EspLcdDisplayDriver::~EspLcdDisplayDriver() {
+    if (tearingEffectSemaphore != nullptr) {
+        gpio_isr_handler_remove(tearingEffectPin);
+    }
+}
+
+void IRAM_ATTR EspLcdDisplayDriver::onTearingEffect(void* argument) {
+    static_cast<tt::Semaphore*>(argument)->release();
+}
+
+bool IRAM_ATTR EspLcdDisplayDriver::onColorTransferDone(esp_lcd_panel_io_handle_t ioHandle, esp_lcd_panel_io_event_data_t* eventData, void* context) {
+    auto* driver = static_cast<EspLcdDisplayDriver*>(context);
+    driver->finishedTransferCount++;
+    driver->transferFinishedSemaphore.release();
+    return false;
+}
+
+bool EspLcdDisplayDriver::drawBitmap(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData) {
+    if (ioHandle != nullptr && queuedTransferCount == finishedTransferCount) {
+        // esp_lvgl_port registers its own callback when LVGL is started, so register again before each series of transfers
+        const esp_lcd_panel_io_callbacks_t callbacks = { .on_color_trans_done = onColorTransferDone };
+        if (esp_lcd_panel_io_register_event_callbacks(ioHandle, &callbacks, this) != ESP_OK) {
+            LOGGER.error("Failed to register transfer callback");
+            return false;
+        }
+    }
+
+    // Count the transfer first: it can finish before esp_lcd_panel_draw_bitmap() returns
+    if (ioHandle != nullptr) {
+        queuedTransferCount++;
+    }
+
+    if (esp_lcd_panel_draw_bitmap(panelHandle, xStart, yStart, xEnd, yEnd, pixelData) != ESP_OK) {
+        if (ioHandle != nullptr) {
+            queuedTransferCount--;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool EspLcdDisplayDriver::waitForPendingTransfers(size_t maxPendingTransfers, TickType_t timeout) {
+    while (queuedTransferCount - finishedTransferCount > maxPendingTransfers) {
+        if (!transferFinishedSemaphore.acquire(timeout)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EspLcdDisplayDriver::waitForTearingEffect(TickType_t timeout) {
+    if (tearingEffectSemaphore == nullptr) {
+        return false;
+    }
+
+    // Ignore a signal from an earlier refresh cycle
+    tearingEffectSemaphore->acquire(0);
+    return tearingEffectSemaphore->acquire(timeout);
+}
@@ -1,40 +1,67 @@
 #pragma once
 
 #include <Tactility/Mutex.h>
+#include <Tactility/Semaphore.h>
 #include <Tactility/hal/display/DisplayDriver.h>
 
+#include <driver/gpio.h>
+#include <esp_lcd_panel_io.h>
 #include <esp_lcd_panel_ops.h>
 
+#include <atomic>
+
 class EspLcdDisplayDriver : public tt::hal::display::DisplayDriver {
 
     esp_lcd_panel_handle_t panelHandle;
+    esp_lcd_panel_io_handle_t _Nullable ioHandle;
     std::shared_ptr<tt::Lock> lock;
     uint16_t hRes;
     uint16_t vRes;
     tt::hal::display::ColorFormat colorFormat;
+    gpio_num_t tearingEffectPin;
+    std::unique_ptr<tt::Semaphore> tearingEffectSemaphore;
+    // esp_lcd_panel_draw_bitmap() queues the color data and returns before it is sent
+    std::atomic<uint32_t> queuedTransferCount = 0;
+    std::atomic<uint32_t> finishedTransferCount = 0;
+    tt::Semaphore transferFinishedSemaphore { 1, 0 };
+
+    static void IRAM_ATTR onTearingEffect(void* argument);
+
+    static bool IRAM_ATTR onColorTransferDone(esp_lcd_panel_io_handle_t ioHandle, esp_lcd_panel_io_event_data_t* eventData, void* context);
 
 public:
 
+    /**
+     * @param[in] ioHandle the IO of the panel, to track when transfers are finished, or nullptr when draw_bitmap() is synchronous (e.g. RGB panels)
+     * @param[in] tearingEffectPin the GPIO that is connected to the TE output of the panel, or GPIO_NUM_NC
+     */
     EspLcdDisplayDriver(
         esp_lcd_panel_handle_t panelHandle,
+        esp_lcd_panel_io_handle_t _Nullable ioHandle,
         std::shared_ptr<tt::Lock> lock,
         uint16_t hRes,
         uint16_t vRes,
-        tt::hal::display::ColorFormat colorFormat
-    ) : panelHandle(panelHandle), lock(lock), hRes(hRes), vRes(vRes), colorFormat(colorFormat) {}
+        tt::hal::display::ColorFormat colorFormat,
+        gpio_num_t tearingEffectPin = GPIO_NUM_NC
+    );
+
+    ~EspLcdDisplayDriver() override;
 
     tt::hal::display::ColorFormat getColorFormat() const override {
         return colorFormat;
     }
 
-    bool drawBitmap(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData) override {
-        bool result = esp_lcd_panel_draw_bitmap(panelHandle, xStart, yStart, xEnd, yEnd, pixelData) == ESP_OK;
-        return result;
-    }
+    bool drawBitmap(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData) override;
 
     uint16_t getPixelWidth() const override { return hRes; }
 
     uint16_t getPixelHeight() const override { return vRes; }
 
     std::shared_ptr<tt::Lock> getLock() const override { return lock; }
+
+    bool supportsTearingEffectSync() const override { return tearingEffectSemaphore != nullptr; }
+
+    bool waitForTearingEffect(TickType_t timeout) override;
+
+    bool waitForPendingTransfers(size_t maxPendingTransfers, TickType_t timeout) override;
 };
@@ -3,14 +3,19 @@
 
 #include <cassert>
 #include <esp_lvgl_port_disp.h>
+#include <esp_timer.h>
 #include <Tactility/Check.h>
 #include <Tactility/Logger.h>
 #include <Tactility/hal/touch/TouchDevice.h>
 
 static const auto LOGGER = tt::Logger("EspLcdDispV2");
 
+constexpr int64_t RENDER_MEASUREMENT_PERIOD_US = 1'000'000;
+
 inline unsigned int getBufferSize(const std::shared_ptr<EspLcdConfiguration>& configuration) {
-    if (configuration->bufferSize != DEFAULT_BUFFER_SIZE) {
+    if (configuration->renderMode != EspLcdRenderMode::Partial) {
+        return configuration->horizontalResolution * configuration->verticalResolution;
+    } else if (configuration->bufferSize != DEFAULT_BUFFER_SIZE) {
         return configuration->bufferSize;
     } else {
         return configuration->horizontalResolution * (configuration->verticalResolution / 10);
@@ -126,6 +131,11 @@ bool EspLcdDisplayV2::startLvgl() {
         LOGGER.warn("DisplayDriver is still in use.");
     }
 
+    if (configuration->renderMode == EspLcdRenderMode::Direct && !useDsiPanel() && !isRgbPanel()) {
+        LOGGER.warn("Direct mode is only supported by RGB and MIPI-DSI panels: falling back to partial mode");
+        configuration->renderMode = EspLcdRenderMode::Partial;
+    }
+
     auto lvgl_port_config  = getLvglPortDisplayConfig(configuration, ioHandle, panelHandle);
 
     if (useDsiPanel()) {
@@ -138,6 +148,13 @@ bool EspLcdDisplayV2::startLvgl() {
         lvglDisplay = lvgl_port_add_disp(&lvgl_port_config);
     }
 
+    if (lvglDisplay != nullptr) {
+        renderMeasurement = {};
+        for (auto code : { LV_EVENT_REFR_START, LV_EVENT_RENDER_START, LV_EVENT_FLUSH_WAIT_START, LV_EVENT_FLUSH_WAIT_FINISH, LV_EVENT_REFR_READY }) {
+            lv_display_add_event_cb(lvglDisplay, onRenderEvent, code, this);
+        }
+    }
+
     auto touch_device = getTouchDevice();
     if (touch_device != nullptr && touch_device->supportsLvgl()) {
         touch_device->startLvgl(lvglDisplay);
@@ -167,7 +184,7 @@ lvgl_port_display_cfg_t EspLcdDisplayV2::getLvglPortDisplayConfig(std::shared_pt
         .panel_handle = panelHandle,
         .control_handle = nullptr,
         .buffer_size = getBufferSize(configuration),
-        .double_buffer = false,
+        .double_buffer = configuration->doubleBuffer,
         .trans_size = 0,
         .hres = configuration->horizontalResolution,
         .vres = configuration->verticalResolution,
@@ -179,16 +196,80 @@ lvgl_port_display_cfg_t EspLcdDisplayV2::getLvglPortDisplayConfig(std::shared_pt
         },
         .color_format = configuration->lvglColorFormat,
         .flags = {
-            .buff_dma = 1,
-            .buff_spiram = 0,
+            .buff_dma = configuration->bufferInPsram ? 0U : 1U,
+            .buff_spiram = configuration->bufferInPsram ? 1U : 0U,
             .sw_rotate = 0,
             .swap_bytes = configuration->lvglSwapBytes,
-            .full_refresh = 0,
-            .direct_mode = 0
+            .full_refresh = configuration->renderMode == EspLcdRenderMode::Full ? 1U : 0U,
+            .direct_mode = configuration->renderMode == EspLcdRenderMode::Direct ? 1U : 0U
         }
     };
 }
 
+// region Render statistics
+
+void EspLcdDisplayV2::onRenderEvent(lv_event_t* event) {
+    auto* display = static_cast<EspLcdDisplayV2*>(lv_event_get_user_data(event));
+    display->updateRenderMeasurement(lv_event_get_code(event));
+}
+
+void EspLcdDisplayV2::updateRenderMeasurement(lv_event_code_t code) {
+    auto& measurement = renderMeasurement;
+    const auto now = esp_timer_get_time();
+    switch (code) {
+        case LV_EVENT_REFR_START:
+            measurement.refreshStartTime = now;
+            measurement.refreshFlushWaitTime = 0;
+            measurement.refreshRendered = false;
+            if (measurement.periodStartTime == 0) {
+                measurement.periodStartTime = now;
+            }
+            break;
+        case LV_EVENT_RENDER_START:
+            measurement.refreshRendered = true;
+            break;
+        case LV_EVENT_FLUSH_WAIT_START:
+            measurement.flushWaitStartTime = now;
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            measurement.refreshFlushWaitTime += now - measurement.flushWaitStartTime;
+            break;
+        case LV_EVENT_REFR_READY: {
+            if (measurement.refreshRendered) {
+                measurement.periodFrameCount++;
+                measurement.periodRenderTime += (now - measurement.refreshStartTime) - measurement.refreshFlushWaitTime;
+                measurement.periodFlushWaitTime += measurement.refreshFlushWaitTime;
+            }
+
+            const auto period_duration = now - measurement.periodStartTime;
+            if (period_duration >= RENDER_MEASUREMENT_PERIOD_US) {
+                const auto frame_count = measurement.periodFrameCount;
+                auto lock = renderStatisticsMutex.asScopedLock();
+                lock.lock();
+                renderStatistics.frameCount += frame_count;
+                renderStatistics.framesPerSecond = static_cast<float>(frame_count) * 1'000'000.f / static_cast<float>(period_duration);
+                renderStatistics.averageRenderTimeUs = frame_count > 0 ? measurement.periodRenderTime / frame_count : 0;
+                renderStatistics.averageFlushWaitTimeUs = frame_count > 0 ? measurement.periodFlushWaitTime / frame_count : 0;
+                measurement.periodStartTime = now;
+                measurement.periodFrameCount = 0;
+                measurement.periodRenderTime = 0;
+                measurement.periodFlushWaitTime = 0;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+EspLcdRenderStatistics EspLcdDisplayV2::getRenderStatistics() const {
+    auto lock = renderStatisticsMutex.asScopedLock();
+    lock.lock();
+    return renderStatistics;
+}
+
+// endregion
+
 std::shared_ptr<tt::hal::display::DisplayDriver> EspLcdDisplayV2::getDisplayDriver() {
     assert(lvglDisplay == nullptr); // Still attached to LVGL context. Call stopLvgl() first.
     if (displayDriver == nullptr) {
@@ -220,10 +301,12 @@ std::shared_ptr<tt::hal::display::DisplayDriver> EspLcdDisplayV2::getDisplayDriv
 
         displayDriver = std::make_shared<EspLcdDisplayDriver>(
             panelHandle,
+            isRgbPanel() || useDsiPanel() ? nullptr : ioHandle,
             lock,
             lvgl_port_config.hres,
             lvgl_port_config.vres,
-            color_format
+            color_format,
+            configuration->tearingEffectPin
         );
     }
     return displayDriver;
@@ -3,6 +3,7 @@
 #include <esp_lcd_panel_dev.h>
 #include <Tactility/Check.h>
 #include <Tactility/Lock.h>
+#include <Tactility/Mutex.h>
 #include <Tactility/hal/display/DisplayDevice.h>
 
 #include <esp_lcd_types.h>
@@ -10,6 +11,15 @@
 
 constexpr auto DEFAULT_BUFFER_SIZE = 0;
 
+enum class EspLcdRenderMode {
+    /** Render the changed areas into buffers that are smaller than the screen */
+    Partial,
+    /** Render the whole screen on every refresh (requires screen-sized buffers) */
+    Full,
+    /** Render the changed areas into screen-sized buffers at their screen position (for RGB and MIPI-DSI panels) */
+    Direct
+};
+
 struct EspLcdConfiguration {
     unsigned int horizontalResolution;
     unsigned int verticalResolution;
@@ -28,6 +38,25 @@ struct EspLcdConfiguration {
     bool lvglSwapBytes;
     lcd_rgb_element_order_t rgbElementOrder;
     uint32_t bitsPerPixel;
+    /** Full and Direct mode use screen-sized buffers and ignore bufferSize */
+    EspLcdRenderMode renderMode = EspLcdRenderMode::Partial;
+    /** Use 2 buffers, so LVGL can render into one while the other one is transferred to the display */
+    bool doubleBuffer = false;
+    /** Allocate the buffers in PSRAM. These buffers aren't DMA-capable, so this is meant for RGB and MIPI-DSI panels. */
+    bool bufferInPsram = false;
+    /** The GPIO that is connected to the tearing effect (TE) output of the panel, used by the DisplayDriver */
+    gpio_num_t tearingEffectPin = GPIO_NUM_NC;
+};
+
+struct EspLcdRenderStatistics {
+    /** The amount of refreshes that rendered something */
+    uint32_t frameCount;
+    /** Frames per second during the last measurement period */
+    float framesPerSecond;
+    /** Average time to render a frame during the last measurement period, excluding the time spent waiting for transfers */
+    uint32_t averageRenderTimeUs;
+    /** Average time per frame that rendering was blocked by a transfer that was still in progress, during the last measurement period */
+    uint32_t averageFlushWaitTimeUs;
 };
 
 class EspLcdDisplayV2 : public tt::hal::display::DisplayDevice {
@@ -38,6 +67,26 @@ class EspLcdDisplayV2 : public tt::hal::display::DisplayDevice {
     std::shared_ptr<tt::Lock> lock;
     std::shared_ptr<EspLcdConfiguration> configuration;
 
+    struct RenderMeasurement {
+        int64_t periodStartTime = 0;
+        int64_t refreshStartTime = 0;
+        int64_t flushWaitStartTime = 0;
+        int64_t refreshFlushWaitTime = 0;
+        bool refreshRendered = false;
+        uint32_t periodFrameCount = 0;
+        int64_t periodRenderTime = 0;
+        int64_t periodFlushWaitTime = 0;
+    };
+
+    // Only accessed from the LVGL task
+    RenderMeasurement renderMeasurement;
+    tt::Mutex renderStatisticsMutex;
+    EspLcdRenderStatistics renderStatistics = {};
+
+    static void onRenderEvent(lv_event_t* event);
+
+    void updateRenderMeasurement(lv_event_code_t code);
+
     bool applyConfiguration() const;
 
     lvgl_port_display_cfg_t getLvglPortDisplayConfig(std::shared_ptr<EspLcdConfiguration> configuration, esp_lcd_panel_io_handle_t ioHandle, esp_lcd_panel_handle_t panelHandle);
@@ -93,6 +142,9 @@ public:
 
     lv_display_t* _Nullable getLvglDisplay() const final { return lvglDisplay; }
 
+    /** @return the rendering performance, which is measured while LVGL is started */
+    EspLcdRenderStatistics getRenderStatistics() const;
+
     // endregion
 
     std::shared_ptr<tt::hal::touch::TouchDevice> _Nullable getTouchDevice() override { return configuration->touch; }
@@ -28,6 +28,7 @@ public:
         std::function<void(uint8_t)> _Nullable backlightDutyFunction;
         gpio_num_t resetPin;
         lcd_rgb_element_order_t rgbElementOrder;
+        bool doubleBuffer = false; // Render into one buffer while the other one is transferred (uses twice the buffer memory)
     };
 
 private:
@@ -28,6 +28,7 @@ public:
         gpio_num_t resetPin;
         bool lvglSwapBytes;
         lcd_rgb_element_order_t rgbElementOrder = LCD_RGB_ELEMENT_ORDER_RGB;
+        bool doubleBuffer = false; // Render into one buffer while the other one is transferred (uses twice the buffer memory)
     };
 
 private:
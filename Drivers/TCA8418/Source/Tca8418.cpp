@@ -25,28 +25,31 @@ bool Tca8418::initMatrix(uint8_t rows, uint8_t columns) {
         return false;
 
     if ((rows != 0) && (columns != 0)) {
-        // Configure the keypad matrix.
+        // Configure the keypad matrix in a single bus transaction.
+        tt::hal::i2c::Transaction transaction(3);
         uint8_t mask = 0x00;
         for (int r = 0; r < rows; r++) {
             mask <<= 1;
             mask |= 1;
         }
-        writeRegister(registers::KP_GPIO1, &mask, 1);
+        transaction.writeRegister8(address, registers::KP_GPIO1, mask);
 
         mask = 0x00;
         for (int c = 0; c < columns && c < 8; c++) {
             mask <<= 1;
             mask |= 1;
         }
-        writeRegister(registers::KP_GPIO2, &mask, 1);
+        transaction.writeRegister8(address, registers::KP_GPIO2, mask);
 
         if (columns > 8) {
             if (columns == 9)
                 mask = 0x01;
             else
                 mask = 0x03;
-            writeRegister(registers::KP_GPIO3, &mask, 1);
+            transaction.writeRegister8(address, registers::KP_GPIO3, mask);
         }
+
+        return execute(transaction);
     }
 
     return true;
@@ -12,6 +12,25 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Read ELF data from a source such as a file.
+ *
+ * @param context - Reader context
+ * @param offset  - Offset in the ELF data
+ * @param buffer  - Destination buffer
+ * @param size    - Amount of bytes to read
+ *
+ * @return ESP_OK if all bytes were read or other if failed.
+ */
+typedef int (*esp_elf_read_t)(void *context, size_t offset, void *buffer, size_t size);
+
+/** @brief ELF data reader */
+
+typedef struct esp_elf_reader {
+    esp_elf_read_t  read;               /*!< read callback */
+    void            *context;           /*!< context that is passed to the read callback */
+} esp_elf_reader_t;
+
 /**
  * @brief Map symbol's address of ELF to physic space.
  *
@@ -41,6 +60,20 @@ int esp_elf_init(esp_elf_t *elf);
  */
 int esp_elf_relocate(esp_elf_t *elf, const uint8_t *pbuf);
 
+/**
+ * @brief Decode and relocate ELF data from a reader.
+ *
+ * Sections or segments are read straight into their final memory. Only the headers,
+ * the symbol tables and a small chunk of relocation entries are buffered,
+ * and they are released before this function returns.
+ *
+ * @param elf    - ELF object pointer
+ * @param reader - ELF data reader
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+int esp_elf_relocate_stream(esp_elf_t *elf, const esp_elf_reader_t *reader);
+
 /**
  * @brief Request running relocated ELF function.
  *
@@ -62,6 +95,30 @@ int esp_elf_request(esp_elf_t *elf, int opt, int argc, char *argv[]);
  */
 void esp_elf_deinit(esp_elf_t *elf);
 
+/**
+ * @brief Get the writable memory of a relocated ELF.
+ *
+ * This memory holds the global variables of the ELF. Restoring a copy that was made
+ * right after esp_elf_relocate() resets the ELF to its initial state, so it can be
+ * requested again without relocating it.
+ *
+ * @param elf   - ELF object pointer
+ * @param pdata - Receives the start of the writable memory
+ * @param size  - Receives the size of the writable memory
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+int esp_elf_get_data(esp_elf_t *elf, uint8_t **pdata, size_t *size);
+
+/**
+ * @brief Get the amount of memory that a relocated ELF uses.
+ *
+ * @param elf - ELF object pointer
+ *
+ * @return Memory size in bytes.
+ */
+size_t esp_elf_get_memory_size(esp_elf_t *elf);
+
 /**
  * @brief Print header description information of ELF.
  *
@@ -41,6 +41,12 @@ extern "C" {
 #define PT_LOPROC       0x70000000      /*!< Start of processor-specific */
 #define PT_HIPROC       0x7fffffff      /*!< End of processor-specific */
 
+/** @brief Segment flags */
+
+#define PF_X            0x1             /*!< Segment is executable */
+#define PF_W            0x2             /*!< Segment is writable */
+#define PF_R            0x4             /*!< Segment is readable */
+
 /** @brief Section Type */
 
 #define SHT_NULL        0               /*!< invalid section header */
@@ -226,6 +232,12 @@ typedef struct esp_elf {
 
     uint32_t         svaddr;            /*!< start virtual address of segment */
 
+    uint32_t         ssize;             /*!< size of segment buffer */
+
+    uint32_t         wsoff;             /*!< offset of writable segments in segment buffer */
+
+    uint32_t         wssize;            /*!< size of writable segments in segment buffer */
+
     unsigned char   *ptext;             /*!< instruction buffer pointer */
 
     unsigned char   *pdata;             /*!< data buffer pointer */
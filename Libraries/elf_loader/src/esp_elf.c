@@ -24,6 +24,8 @@
 #define stype(_s, _t)               ((_s)->type == (_t))
 #define sflags(_s, _f)              (((_s)->flags & (_f)) == (_f))
 #define ADDR_OFFSET                 (0x400)
+#define READ_CHUNK_SIZE             (512)
+#define RELA_CHUNK_COUNT            (32)
 
 uintptr_t elf_find_sym_default(const char *sym_name);
 
@@ -41,25 +43,138 @@ uintptr_t elf_find_sym(const char *sym_name) {
     return current_resolver(sym_name);
 }
 
+/**
+ * @brief Read data from an ELF source.
+ *
+ * @param reader - ELF data reader
+ * @param offset - Offset in the ELF data
+ * @param buffer - Destination buffer
+ * @param size   - Amount of bytes to read
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+static int elf_read(const esp_elf_reader_t *reader, size_t offset, void *buffer, size_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+
+    return reader->read(reader->context, offset, buffer, size);
+}
+
+/**
+ * @brief Read data from an ELF source into a new heap buffer.
+ *
+ * @param reader - ELF data reader
+ * @param offset - Offset in the ELF data
+ * @param size   - Amount of bytes to read
+ * @param out    - Receives the buffer, which must be released with free()
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+static int elf_read_alloc(const esp_elf_reader_t *reader, size_t offset, size_t size, void **out)
+{
+    void *buffer = malloc(size ? size : 1);
+    if (!buffer) {
+        return -ENOMEM;
+    }
+
+    int ret = elf_read(reader, offset, buffer, size);
+    if (ret) {
+        free(buffer);
+        return ret;
+    }
+
+    *out = buffer;
+    return 0;
+}
+
+/**
+ * @brief Copy data from an ELF source into loaded memory.
+ *
+ * The data goes through a small bounce buffer, so the destination is only written
+ * with memcpy(). This keeps executable and PSRAM memory writes word-aligned,
+ * regardless of how the reader accesses its buffer.
+ *
+ * @param reader - ELF data reader
+ * @param offset - Offset in the ELF data
+ * @param pdst   - Destination memory
+ * @param size   - Amount of bytes to copy
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+static int elf_read_to(const esp_elf_reader_t *reader, size_t offset, uint8_t *pdst, size_t size)
+{
+    uint32_t chunk[READ_CHUNK_SIZE / sizeof(uint32_t)];
+
+    while (size > 0) {
+        size_t chunk_size = MIN(size, sizeof(chunk));
+        int ret = elf_read(reader, offset, chunk, chunk_size);
+        if (ret) {
+            return ret;
+        }
+
+        memcpy(pdst, chunk, chunk_size);
+        offset += chunk_size;
+        pdst += chunk_size;
+        size -= chunk_size;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Read callback for ELF data that is fully in memory.
+ */
+static int elf_read_memory(void *context, size_t offset, void *buffer, size_t size)
+{
+    memcpy(buffer, (const uint8_t *)context + offset, size);
+    return 0;
+}
+
+/**
+ * @brief Free all memory that was allocated by loading an ELF.
+ *
+ * @param elf - ELF object pointer
+ */
+static void esp_elf_free_loaded(esp_elf_t *elf)
+{
+#if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
+    esp_elf_free(elf->pdata);
+    elf->pdata = NULL;
+    esp_elf_free(elf->ptext);
+    elf->ptext = NULL;
+#else
+    esp_elf_free(elf->psegment);
+    elf->psegment = NULL;
+#endif
+}
+
 #if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
 
 /**
  * @brief Load ELF section.
  *
- * @param elf - ELF object pointer
- * @param pbuf - ELF data buffer
+ * @param elf    - ELF object pointer
+ * @param reader - ELF data reader
+ * @param ehdr   - ELF header
+ * @param shdr   - ELF section headers
  *
  * @return ESP_OK if success or other if failed.
  */
 
-static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
+static int esp_elf_load_section(esp_elf_t *elf, const esp_elf_reader_t *reader,
+                                const elf32_hdr_t *ehdr, const elf32_shdr_t *shdr)
 {
+    int ret;
     uint32_t entry;
     uint32_t size;
+    char *shstrab;
 
-    const elf32_hdr_t *ehdr = (const elf32_hdr_t *)pbuf;
-    const elf32_shdr_t *shdr = (const elf32_shdr_t *)(pbuf + ehdr->shoff);
-    const char *shstrab = (const char *)pbuf + shdr[ehdr->shstrndx].offset;
+    ret = elf_read_alloc(reader, shdr[ehdr->shstrndx].offset, shdr[ehdr->shstrndx].size, (void **)&shstrab);
+    if (ret) {
+        return ret;
+    }
 
     /* Calculate ELF image size */
 
@@ -128,6 +243,8 @@ static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
         }
     }
 
+    free(shstrab);
+
     /* No .text on image */
 
     if (!elf->sec[ELF_SEC_TEXT].size) {
@@ -154,8 +271,12 @@ static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
     /* Dump ".text" from ELF to executable space memory */
 
     elf->sec[ELF_SEC_TEXT].addr = (Elf32_Addr)elf->ptext;
-    memcpy(elf->ptext, pbuf + elf->sec[ELF_SEC_TEXT].offset,
-           elf->sec[ELF_SEC_TEXT].size);
+    ret = elf_read_to(reader, elf->sec[ELF_SEC_TEXT].offset, elf->ptext,
+                      elf->sec[ELF_SEC_TEXT].size);
+    if (ret) {
+        esp_elf_free_loaded(elf);
+        return ret;
+    }
 
 #ifdef CONFIG_ELF_LOADER_SET_MMU
     if (esp_elf_arch_init_mmu(elf)) {
@@ -177,8 +298,12 @@ static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
         if (elf->sec[ELF_SEC_DATA].size) {
             elf->sec[ELF_SEC_DATA].addr = (uint32_t)pdata;
 
-            memcpy(pdata, pbuf + elf->sec[ELF_SEC_DATA].offset,
-                   elf->sec[ELF_SEC_DATA].size);
+            ret = elf_read_to(reader, elf->sec[ELF_SEC_DATA].offset, pdata,
+                              elf->sec[ELF_SEC_DATA].size);
+            if (ret) {
+                esp_elf_free_loaded(elf);
+                return ret;
+            }
 
             pdata += elf->sec[ELF_SEC_DATA].size;
         }
@@ -186,8 +311,12 @@ static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
         if (elf->sec[ELF_SEC_RODATA].size) {
             elf->sec[ELF_SEC_RODATA].addr = (uint32_t)pdata;
 
-            memcpy(pdata, pbuf + elf->sec[ELF_SEC_RODATA].offset,
-                   elf->sec[ELF_SEC_RODATA].size);
+            ret = elf_read_to(reader, elf->sec[ELF_SEC_RODATA].offset, pdata,
+                              elf->sec[ELF_SEC_RODATA].size);
+            if (ret) {
+                esp_elf_free_loaded(elf);
+                return ret;
+            }
 
             pdata += elf->sec[ELF_SEC_RODATA].size;
         }
@@ -195,8 +324,12 @@ static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
         if (elf->sec[ELF_SEC_DRLRO].size) {
             elf->sec[ELF_SEC_DRLRO].addr = (uint32_t)pdata;
 
-            memcpy(pdata, pbuf + elf->sec[ELF_SEC_DRLRO].offset,
-                   elf->sec[ELF_SEC_DRLRO].size);
+            ret = elf_read_to(reader, elf->sec[ELF_SEC_DRLRO].offset, pdata,
+                              elf->sec[ELF_SEC_DRLRO].size);
+            if (ret) {
+                esp_elf_free_loaded(elf);
+                return ret;
+            }
 
             pdata += elf->sec[ELF_SEC_DRLRO].size;
         }
@@ -226,21 +359,27 @@ static int esp_elf_load_section(esp_elf_t *elf, const uint8_t *pbuf)
 /**
  * @brief Load ELF segment.
  *
- * @param elf - ELF object pointer
- * @param pbuf - ELF data buffer
+ * @param elf    - ELF object pointer
+ * @param reader - ELF data reader
+ * @param ehdr   - ELF header
  *
  * @return ESP_OK if success or other if failed.
  */
 
-static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
+static int esp_elf_load_segment(esp_elf_t *elf, const esp_elf_reader_t *reader,
+                                const elf32_hdr_t *ehdr)
 {
+    int ret;
     uint32_t size;
     bool first_segment = false;
     Elf32_Addr vaddr_s = 0;
     Elf32_Addr vaddr_e = 0;
+    elf32_phdr_t *phdr;
 
-    const elf32_hdr_t *ehdr = (const elf32_hdr_t *)pbuf;
-    const elf32_phdr_t *phdr = (const elf32_phdr_t *)(pbuf + ehdr->phoff);
+    ret = elf_read_alloc(reader, ehdr->phoff, ehdr->phnum * sizeof(elf32_phdr_t), (void **)&phdr);
+    if (ret) {
+        return ret;
+    }
 
     for (int i = 0; i < ehdr->phnum; i++) {
         if (phdr[i].type != PT_LOAD) {
@@ -250,6 +389,7 @@ static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
         if (phdr[i].memsz < phdr[i].filesz) {
             ESP_LOGE(TAG, "Invalid segment[%d], memsz: %d, filesz: %d",
                      i, phdr[i].memsz, phdr[i].filesz);
+            free(phdr);
             return -EINVAL;
         }
 
@@ -260,12 +400,14 @@ static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
             if (vaddr_e < vaddr_s) {
                 ESP_LOGE(TAG, "Invalid segment[%d], vaddr: 0x%x, memsz: %d",
                          i, phdr[i].vaddr, phdr[i].memsz);
+                free(phdr);
                 return -EINVAL;
             }
         } else {
             if (phdr[i].vaddr < vaddr_e) {
                 ESP_LOGE(TAG, "Invalid segment[%d], should not overlap, vaddr: 0x%x, vaddr_e: 0x%x\n",
                          i, phdr[i].vaddr, vaddr_e);
+                free(phdr);
                 return -EINVAL;
             }
 
@@ -278,6 +420,7 @@ static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
             if (vaddr_e < phdr[i].vaddr) {
                 ESP_LOGE(TAG, "Invalid segment[%d], address overflow, vaddr: 0x%x, vaddr_e: 0x%x\n",
                          i, phdr[i].vaddr, vaddr_e);
+                free(phdr);
                 return -EINVAL;
             }
         }
@@ -288,12 +431,15 @@ static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
 
     size = vaddr_e - vaddr_s;
     if (size == 0) {
+        free(phdr);
         return -EINVAL;
     }
 
     elf->svaddr = vaddr_s;
+    elf->ssize = size;
     elf->psegment = esp_elf_malloc(size, true);
     if (!elf->psegment) {
+        free(phdr);
         return -ENOMEM;
     }
 
@@ -303,14 +449,34 @@ static int esp_elf_load_segment(esp_elf_t *elf, const uint8_t *pbuf)
 
     for (int i = 0; i < ehdr->phnum; i++) {
         if (phdr[i].type == PT_LOAD) {
-            memcpy(elf->psegment + phdr[i].vaddr - vaddr_s,
-                   (uint8_t *)pbuf + phdr[i].offset, phdr[i].filesz);
+            ret = elf_read_to(reader, phdr[i].offset,
+                              elf->psegment + phdr[i].vaddr - vaddr_s, phdr[i].filesz);
+            if (ret) {
+                free(phdr);
+                esp_elf_free_loaded(elf);
+                return ret;
+            }
             ESP_LOGD(TAG, "Copy segment[%d], mem_addr: 0x%x, vaddr: 0x%x, size: 0x%08x",
                      i, (int)((uint8_t *)elf->psegment + phdr[i].vaddr - vaddr_s),
                      phdr[i].vaddr, phdr[i].filesz);
+
+            if (phdr[i].flags & PF_W) {
+                uint32_t start = phdr[i].vaddr - vaddr_s;
+                uint32_t end = start + phdr[i].memsz;
+                if (elf->wssize == 0) {
+                    elf->wsoff = start;
+                    elf->wssize = end - start;
+                } else {
+                    uint32_t wsend = MAX(elf->wsoff + elf->wssize, end);
+                    elf->wsoff = MIN(elf->wsoff, start);
+                    elf->wssize = wsend - elf->wsoff;
+                }
+            }
         }
     }
 
+    free(phdr);
+
 #if SOC_CACHE_INTERNAL_MEM_VIA_L1CACHE
     cache_ll_writeback_all(CACHE_LL_LEVEL_INT_MEM, CACHE_TYPE_DATA, CACHE_LL_ID_ALL);
 #endif
@@ -374,115 +540,212 @@ int esp_elf_init(esp_elf_t *elf)
 }
 
 /**
- * @brief Decode and relocate ELF data.
+ * @brief Relocate a single relocation entry.
  *
- * @param elf - ELF object pointer
- * @param pbuf - ELF data buffer
+ * @param elf    - ELF object pointer
+ * @param rela   - Relocation entry
+ * @param symtab - Symbol table of the relocation section
+ * @param nr_sym - Amount of entries in the symbol table
+ * @param strtab - String table of the symbol table
  *
  * @return ESP_OK if success or other if failed.
  */
-int esp_elf_relocate(esp_elf_t *elf, const uint8_t *pbuf)
+static int esp_elf_relocate_entry(esp_elf_t *elf, const elf32_rela_t *rela,
+                                  const elf32_sym_t *symtab, uint32_t nr_sym,
+                                  const char *strtab)
 {
-    int ret;
+    int type;
+    uintptr_t addr = 0;
 
-    const elf32_hdr_t *ehdr;
-    const elf32_shdr_t *shdr;
-    const char *shstrab;
-
-    if (!elf || !pbuf) {
+    if (ELF_R_SYM(rela->info) >= nr_sym) {
+        ESP_LOGE(TAG, "Invalid symbol index %d", (int)ELF_R_SYM(rela->info));
         return -EINVAL;
     }
 
-    ehdr    = (const elf32_hdr_t *)pbuf;
-    shdr    = (const elf32_shdr_t *)(pbuf + ehdr->shoff);
-    shstrab = (const char *)pbuf + shdr[ehdr->shstrndx].offset;
+    const elf32_sym_t *sym = &symtab[ELF_R_SYM(rela->info)];
 
-    /* Load section or segment to memory space */
+    type = ELF_R_TYPE(rela->info);
+    if (type == STT_COMMON || type == STT_OBJECT || type == STT_SECTION) {
+        const char *comm_name = strtab + sym->name;
 
-#if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
-    ret = esp_elf_load_section(elf, pbuf);
-#else
-    ret = esp_elf_load_segment(elf, pbuf);
-#endif
+        if (comm_name[0]) {
+            addr = elf_find_sym(comm_name);
 
-    if (ret) {
-        ESP_LOGE(TAG, "Error to load elf file, ret=%d", ret);
-        return ret;
+            if (!addr) {
+                ESP_LOGE(TAG, "Can't find common %s", strtab + sym->name);
+                return -ENOSYS;
+            }
+
+            ESP_LOGD(TAG, "Find common %s addr=%x", comm_name, addr);
+        }
+    } else if (type == STT_FILE) {
+        const char *func_name = strtab + sym->name;
+
+        if (sym->value) {
+            addr = esp_elf_map_sym(elf, sym->value);
+        } else {
+            addr = elf_find_sym(func_name);
+        }
+
+        if (!addr) {
+            ESP_LOGE(TAG, "Can't find symbol %s", func_name);
+            return -ENOSYS;
+        }
+
+        ESP_LOGD(TAG, "Find function %s addr=%x", func_name, addr);
     }
 
-    ESP_LOGI(TAG, "elf->entry=%p\n", elf->entry);
+    esp_elf_arch_relocate(elf, rela, sym, addr);
 
-    /* Relocation section data */
+    return 0;
+}
 
-    for (uint32_t i = 0; i < ehdr->shnum; i++) {
-        if (stype(&shdr[i], SHT_RELA)) {
-            uint32_t nr_reloc;
-            const elf32_rela_t *rela;
-            const elf32_sym_t *symtab;
-            const char *strtab;
+/**
+ * @brief Relocate all relocation sections.
+ *
+ * Relocation entries are read in small chunks. The symbol and string tables
+ * are read once for each symbol table that is referenced.
+ *
+ * @param elf    - ELF object pointer
+ * @param reader - ELF data reader
+ * @param ehdr   - ELF header
+ * @param shdr   - ELF section headers
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+static int esp_elf_relocate_sections(esp_elf_t *elf, const esp_elf_reader_t *reader,
+                                     const elf32_hdr_t *ehdr, const elf32_shdr_t *shdr)
+{
+    int ret = 0;
+    uint32_t symtab_index = 0;
+    uint32_t nr_sym = 0;
+    elf32_sym_t *symtab = NULL;
+    char *strtab = NULL;
+    elf32_rela_t *rela;
+
+    rela = malloc(RELA_CHUNK_COUNT * sizeof(elf32_rela_t));
+    if (!rela) {
+        return -ENOMEM;
+    }
 
-            nr_reloc = shdr[i].size / sizeof(elf32_rela_t);
-            rela     = (const elf32_rela_t *)(pbuf + shdr[i].offset);
-            symtab   = (const elf32_sym_t *)(pbuf + shdr[shdr[i].link].offset);
-            strtab   = (const char *)(pbuf + shdr[shdr[shdr[i].link].link].offset);
+    for (uint32_t i = 0; i < ehdr->shnum && !ret; i++) {
+        if (!stype(&shdr[i], SHT_RELA)) {
+            continue;
+        }
 
-            ESP_LOGD(TAG, "Section %s has %d symbol tables", shstrab + shdr[i].name, (int)nr_reloc);
+        /* Section 0 is never a symbol table, so it marks that none is loaded yet */
 
-            for (int i = 0; i < nr_reloc; i++) {
-                int type;
-                uintptr_t addr = 0;
-                elf32_rela_t rela_buf;
+        if (shdr[i].link != symtab_index) {
+            const elf32_shdr_t *symtab_shdr;
 
-                memcpy(&rela_buf, &rela[i], sizeof(elf32_rela_t));
+            free(symtab);
+            free(strtab);
+            symtab = NULL;
+            strtab = NULL;
+            symtab_index = 0;
 
-                const elf32_sym_t *sym = &symtab[ELF_R_SYM(rela_buf.info)];
+            if (shdr[i].link == 0 || shdr[i].link >= ehdr->shnum ||
+                    shdr[shdr[i].link].link >= ehdr->shnum) {
+                ret = -EINVAL;
+                break;
+            }
 
-                type = ELF_R_TYPE(rela_buf.info);
-                if (type == STT_COMMON || type == STT_OBJECT || type == STT_SECTION) {
-                    const char *comm_name = strtab + sym->name;
+            symtab_shdr = &shdr[shdr[i].link];
+            ret = elf_read_alloc(reader, symtab_shdr->offset, symtab_shdr->size, (void **)&symtab);
+            if (!ret) {
+                ret = elf_read_alloc(reader, shdr[symtab_shdr->link].offset,
+                                     shdr[symtab_shdr->link].size, (void **)&strtab);
+            }
 
-                    if (comm_name[0]) {
-                        addr = elf_find_sym(comm_name);
+            if (ret) {
+                break;
+            }
+
+            symtab_index = shdr[i].link;
+            nr_sym = symtab_shdr->size / sizeof(elf32_sym_t);
+        }
+
+        uint32_t nr_reloc = shdr[i].size / sizeof(elf32_rela_t);
+
+        ESP_LOGD(TAG, "Section %d has %d relocations", (int)i, (int)nr_reloc);
+
+        for (uint32_t j = 0; j < nr_reloc && !ret; j += RELA_CHUNK_COUNT) {
+            uint32_t count = MIN(nr_reloc - j, RELA_CHUNK_COUNT);
+
+            ret = elf_read(reader, shdr[i].offset + j * sizeof(elf32_rela_t), rela,
+                           count * sizeof(elf32_rela_t));
+
+            for (uint32_t k = 0; k < count && !ret; k++) {
+                ret = esp_elf_relocate_entry(elf, &rela[k], symtab, nr_sym, strtab);
+            }
+        }
+    }
+
+    free(rela);
+    free(symtab);
+    free(strtab);
+
+    return ret;
+}
+
+/**
+ * @brief Decode and relocate ELF data from a reader.
+ *
+ * @param elf    - ELF object pointer
+ * @param reader - ELF data reader
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+int esp_elf_relocate_stream(esp_elf_t *elf, const esp_elf_reader_t *reader)
+{
+    int ret;
+    elf32_hdr_t ehdr;
+    elf32_shdr_t *shdr;
+
+    if (!elf || !reader || !reader->read) {
+        return -EINVAL;
+    }
+
+    ret = elf_read(reader, 0, &ehdr, sizeof(ehdr));
+    if (ret) {
+        return ret;
+    }
+
+    if (ehdr.ident[0] != 0x7f || ehdr.ident[1] != 'E' || ehdr.ident[2] != 'L' || ehdr.ident[3] != 'F' ||
+            ehdr.shstrndx >= ehdr.shnum) {
+        ESP_LOGE(TAG, "Invalid ELF header");
+        return -EINVAL;
+    }
+
+    ret = elf_read_alloc(reader, ehdr.shoff, ehdr.shnum * sizeof(elf32_shdr_t), (void **)&shdr);
+    if (ret) {
+        return ret;
+    }
+
+    /* Load section or segment to memory space */
 
-                        if (!addr) {
-                            ESP_LOGE(TAG, "Can't find common %s", strtab + sym->name);
-#if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
-                            esp_elf_free(elf->pdata);
-                            esp_elf_free(elf->ptext);
-#else
-                            esp_elf_free(elf->psegment);
-#endif
-                            return -ENOSYS;
-                        }
-
-                        ESP_LOGD(TAG, "Find common %s addr=%x", comm_name, addr);
-                    }
-                } else if (type == STT_FILE) {
-                    const char *func_name = strtab + sym->name;
-
-                    if (sym->value) {
-                        addr = esp_elf_map_sym(elf, sym->value);
-                    } else {
-                        addr = elf_find_sym(func_name);
-                    }
-
-                    if (!addr) {
-                        ESP_LOGE(TAG, "Can't find symbol %s", func_name);
 #if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
-                        esp_elf_free(elf->pdata);
-                        esp_elf_free(elf->ptext);
+    ret = esp_elf_load_section(elf, reader, &ehdr, shdr);
 #else
-                        esp_elf_free(elf->psegment);
+    ret = esp_elf_load_segment(elf, reader, &ehdr);
 #endif
-                        return -ENOSYS;
-                    }
 
-                    ESP_LOGD(TAG, "Find function %s addr=%x", func_name, addr);
-                }
+    if (ret) {
+        ESP_LOGE(TAG, "Error to load elf file, ret=%d", ret);
+        free(shdr);
+        return ret;
+    }
 
-                esp_elf_arch_relocate(elf, &rela_buf, sym, addr);
-            }
-        }
+    ESP_LOGI(TAG, "elf->entry=%p\n", elf->entry);
+
+    /* Relocation section data */
+
+    ret = esp_elf_relocate_sections(elf, reader, &ehdr, shdr);
+    free(shdr);
+
+    if (ret) {
+        esp_elf_free_loaded(elf);
+        return ret;
     }
 
 #ifdef CONFIG_ELF_LOADER_LOAD_PSRAM
@@ -492,6 +755,28 @@ int esp_elf_relocate(esp_elf_t *elf, const uint8_t *pbuf)
     return 0;
 }
 
+/**
+ * @brief Decode and relocate ELF data.
+ *
+ * @param elf - ELF object pointer
+ * @param pbuf - ELF data buffer
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+int esp_elf_relocate(esp_elf_t *elf, const uint8_t *pbuf)
+{
+    if (!pbuf) {
+        return -EINVAL;
+    }
+
+    const esp_elf_reader_t reader = {
+        .read = elf_read_memory,
+        .context = (void *)pbuf
+    };
+
+    return esp_elf_relocate_stream(elf, &reader);
+}
+
 /**
  * @brief Request running relocated ELF function.
  *
@@ -534,8 +819,8 @@ void esp_elf_deinit(esp_elf_t *elf)
     }
 #else
     if (elf->psegment) {
-        esp_elf_free(elf->ptext);
-        elf->ptext = NULL;
+        esp_elf_free(elf->psegment);
+        elf->psegment = NULL;
     }
 #endif
 
@@ -544,6 +829,64 @@ void esp_elf_deinit(esp_elf_t *elf)
 #endif
 }
 
+/**
+ * @brief Get the writable memory of a relocated ELF.
+ *
+ * @param elf   - ELF object pointer
+ * @param pdata - Receives the start of the writable memory
+ * @param size  - Receives the size of the writable memory
+ *
+ * @return ESP_OK if success or other if failed.
+ */
+int esp_elf_get_data(esp_elf_t *elf, uint8_t **pdata, size_t *size)
+{
+    if (!elf || !pdata || !size) {
+        return -EINVAL;
+    }
+
+#if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
+    if (!elf->ptext) {
+        return -EINVAL;
+    }
+
+    *pdata = elf->pdata;
+    *size = elf->sec[ELF_SEC_DATA].size +
+            elf->sec[ELF_SEC_RODATA].size +
+            elf->sec[ELF_SEC_BSS].size +
+            elf->sec[ELF_SEC_DRLRO].size;
+#else
+    if (!elf->psegment) {
+        return -EINVAL;
+    }
+
+    *pdata = elf->psegment + elf->wsoff;
+    *size = elf->wssize;
+#endif
+
+    return 0;
+}
+
+/**
+ * @brief Get the amount of memory that a relocated ELF uses.
+ *
+ * @param elf - ELF object pointer
+ *
+ * @return Memory size in bytes.
+ */
+size_t esp_elf_get_memory_size(esp_elf_t *elf)
+{
+#if CONFIG_ELF_LOADER_BUS_ADDRESS_MIRROR
+    size_t data_size = 0;
+    uint8_t *pdata;
+
+    esp_elf_get_data(elf, &pdata, &data_size);
+
+    return elf->sec[ELF_SEC_TEXT].size + data_size;
+#else
+    return elf->ssize;
+#endif
+}
+
 /**
  * @brief Print header description information of ELF.
  *
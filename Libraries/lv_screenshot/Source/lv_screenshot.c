@@ -3,6 +3,10 @@
 #include "save_png.h"
 #include "save_bmp.h"
 
+#if LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 2)
+#include "lvgl_private.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,6 +33,66 @@ bool lv_screenshot_create(lv_obj_t* obj, lv_100ask_screenshot_sv_t screenshot_sv
     return false;
 }
 
+bool lv_screenshot_take_tile(lv_obj_t* obj, lv_draw_buf_t* draw_buf, int32_t first_row, int32_t row_count) {
+    lv_area_t tile_area;
+    lv_obj_get_coords(obj, &tile_area);
+    tile_area.y1 += first_row;
+    tile_area.y2 = tile_area.y1 + row_count - 1;
+    return lv_screenshot_take_area(obj, draw_buf, &tile_area);
+}
+
+bool lv_screenshot_take_area(lv_obj_t* obj, lv_draw_buf_t* draw_buf, const lv_area_t* area) {
+    lv_area_t obj_area;
+    lv_obj_get_coords(obj, &obj_area);
+
+    if (draw_buf->header.cf != LV_COLOR_FORMAT_RGB888 ||
+        (int32_t)draw_buf->header.w < lv_area_get_width(area) || (int32_t)draw_buf->header.h < lv_area_get_height(area) ||
+        area->x2 < area->x1 || area->y2 < area->y1 || !lv_area_is_in(area, &obj_area, 0)) {
+        return false;
+    }
+
+    lv_area_t tile_area = *area;
+
+    lv_draw_buf_clear(draw_buf, NULL);
+
+    /* Same as lv_snapshot_take_to_draw_buf(), but only for the given area */
+    lv_layer_t layer;
+    lv_memzero(&layer, sizeof(layer));
+    layer.draw_buf = draw_buf;
+    layer.buf_area = tile_area;
+    layer.color_format = LV_COLOR_FORMAT_RGB888;
+
+#if LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 2)
+    layer._clip_area = tile_area;
+    layer.phy_clip_area = tile_area;
+
+    lv_display_t* disp_old = lv_refr_get_disp_refreshing();
+    lv_display_t* disp_new = lv_obj_get_display(obj);
+    lv_layer_t* layer_old = disp_new->layer_head;
+    disp_new->layer_head = &layer;
+    lv_refr_set_disp_refreshing(disp_new);
+
+    lv_obj_redraw(&layer, obj);
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    disp_new->layer_head = layer_old;
+    lv_refr_set_disp_refreshing(disp_old);
+#else
+    layer.clip_area = tile_area;
+
+    lv_obj_redraw(&layer, obj);
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch_layer(NULL, &layer);
+    }
+#endif
+
+    return true;
+}
+
 static void data_pre_processing(lv_draw_buf_t* snapshot, uint16_t bpp, lv_100ask_screenshot_sv_t screenshot_sv) {
     if (bpp == 16) {
         uint16_t rgb565_data = 0;
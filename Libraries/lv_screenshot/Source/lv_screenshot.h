@@ -14,6 +14,25 @@ typedef enum {
 
 bool lv_screenshot_create(lv_obj_t* obj, lv_100ask_screenshot_sv_t screenshot_sv, const char* filename);
 
+/**
+ * Render a horizontal tile of an object, so a screenshot can be taken without allocating a buffer for the full object.
+ * @param obj the object to render (e.g. the active screen)
+ * @param draw_buf an RGB888 buffer that is at least as wide as the object and at least row_count rows high
+ * @param first_row the first row to render, relative to the top of the object
+ * @param row_count the amount of rows to render
+ * @return false when the draw buffer is too small or the rows are outside the object
+ */
+bool lv_screenshot_take_tile(lv_obj_t* obj, lv_draw_buf_t* draw_buf, int32_t first_row, int32_t row_count);
+
+/**
+ * Render an area of an object, so the changed parts of the screen can be captured.
+ * @param obj the object to render (e.g. the active screen)
+ * @param draw_buf an RGB888 buffer that is at least as large as the area
+ * @param area the area to render in display coordinates: it must be inside the object
+ * @return false when the draw buffer is too small or the area is outside the object
+ */
+bool lv_screenshot_take_area(lv_obj_t* obj, lv_draw_buf_t* draw_buf, const lv_area_t* area);
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Tactility/crypt/Sha256.h>
+#include <Tactility/file/TarReader.h>
+
+#include <cstdint>
+#include <string>
+
+namespace tt::app {
+
+/**
+ * Installs an app from an archive that is passed in chunks, e.g. while it is being received.
+ * The archive is extracted into a staging directory without storing the archive itself.
+ * The installation only replaces an existing app when commit() succeeds.
+ * The staging directory is removed when the installation isn't committed.
+ */
+class AppInstallStream final {
+
+    const std::string stagingPath;
+    file::TarExtractor extractor;
+    file::TarReader reader;
+    crypt::Sha256 hash;
+    bool started = false;
+    bool failed = false;
+    bool committed = false;
+
+    bool start();
+
+public:
+
+    /** @param[in] name the name of the staging directory in the app install path, e.g. the archive filename */
+    explicit AppInstallStream(const std::string& name);
+
+    ~AppInstallStream();
+
+    AppInstallStream(const AppInstallStream&) = delete;
+    AppInstallStream& operator=(const AppInstallStream&) = delete;
+
+    /**
+     * Extract the next chunk of the archive.
+     * @return false when the archive is invalid or when it couldn't be extracted
+     */
+    bool write(const uint8_t* data, size_t size);
+
+    /** @return true when the complete archive was received */
+    bool isComplete() const { return !failed && reader.isFinished(); }
+
+    /**
+     * Verify the archive, then install the app by moving the staging directory to its final location.
+     * @param[in] expectedSha256 the lowercase hexadecimal SHA-256 of the archive, or an empty string to skip the verification
+     * @return true when the app was installed
+     */
+    bool commit(const std::string& expectedSha256 = "");
+};
+
+} // namespace tt::app
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Tactility/app/AppManifest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Each apps directory (e.g. /data/app) has an index file with the parsed manifests of its apps.
+ * This allows for registering all apps with a single read, instead of parsing every manifest.properties file.
+ */
+namespace tt::app {
+
+/** The index file name inside an apps directory */
+constexpr auto APP_MANIFEST_INDEX_FILE_NAME = ".index";
+
+struct AppManifestIndexEntry {
+    /** The name of the app directory inside the apps directory */
+    std::string directoryName;
+    /** The modification time of the app's manifest.properties */
+    int64_t manifestModifiedTime = 0;
+    /** The size of the app's manifest.properties */
+    int64_t manifestSize = 0;
+    /** The parsed manifest (the location is not stored) */
+    AppManifest manifest;
+};
+
+/** @return the binary representation of the index entries */
+std::vector<uint8_t> encodeAppManifestIndex(const std::vector<AppManifestIndexEntry>& entries);
+
+/**
+ * @param[in] data the binary index data
+ * @param[in] size the size of the binary index data
+ * @param[out] entries the decoded entries
+ * @return false when the data is not a valid index
+ */
+bool decodeAppManifestIndex(const uint8_t* data, size_t size, std::vector<AppManifestIndexEntry>& entries);
+
+/**
+ * Find the manifests of all apps in an apps directory.
+ * Manifests are taken from the index when their manifest.properties file didn't change.
+ * Other apps are parsed from their manifest.properties file, and the index is updated with the result.
+ * @param[in] appsPath the apps directory (e.g. /data/app)
+ * @return the manifests with their category and location set
+ */
+std::vector<AppManifest> findInstalledAppManifests(const std::string& appsPath);
+
+/**
+ * Add or replace an app in the index of an apps directory.
+ * @param[in] appsPath the apps directory (e.g. /data/app)
+ * @param[in] directoryName the name of the app directory inside the apps directory
+ * @param[in] manifest the parsed manifest of the app
+ * @return true on success
+ */
+bool updateAppManifestIndex(const std::string& appsPath, const std::string& directoryName, const AppManifest& manifest);
+
+/**
+ * Remove an app from the index of an apps directory.
+ * @param[in] appsPath the apps directory (e.g. /data/app)
+ * @param[in] directoryName the name of the app directory inside the apps directory
+ * @return true on success
+ */
+bool removeFromAppManifestIndex(const std::string& appsPath, const std::string& directoryName);
+
+}
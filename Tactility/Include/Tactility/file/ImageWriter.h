@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace tt::file {
+
+/**
+ * Convert pixels from BGR888 (the in-memory order of LVGL's RGB888 format) to RGB888.
+ * Processes 4 pixels at a time with 32-bit words.
+ * @param[in] source the BGR888 pixels
+ * @param[out] destination the RGB888 pixels: can be the same as source
+ * @param[in] pixelCount the amount of pixels to convert
+ */
+void convertBgr888ToRgb888(const uint8_t* source, uint8_t* destination, size_t pixelCount);
+
+/**
+ * Encodes an image row by row, so the full image never has to be in memory.
+ * The encoded data is buffered and passed to the output in blocks of at most the buffer size.
+ */
+class ImageWriter {
+
+public:
+
+    /**
+     * Receives the encoded data.
+     * @return false when the data could not be written: this fails the encoding
+     */
+    typedef std::function<bool(const uint8_t* data, size_t size)> Output;
+
+private:
+
+    Output output;
+    std::vector<uint8_t> buffer;
+    size_t bufferSize;
+    bool failed = false;
+
+protected:
+
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint16_t rowsWritten = 0;
+
+    /** Write data to the output directly, bypassing the buffer */
+    bool writeOutput(const uint8_t* data, size_t size);
+
+    void put(uint8_t value) {
+        buffer.push_back(value);
+        if (buffer.size() >= bufferSize) {
+            flushBuffer();
+        }
+    }
+
+    void put(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            put(data[i]);
+        }
+    }
+
+    /** Pass the buffered data to the output */
+    bool flushBuffer();
+
+    /** Called with the buffered data when the buffer is full or flushed */
+    virtual bool onFlushBuffer(const uint8_t* data, size_t size) { return writeOutput(data, size); }
+
+    virtual bool onBegin() = 0;
+    virtual void onWriteRow(const uint8_t* row) = 0;
+    virtual bool onFinish() = 0;
+
+public:
+
+    /**
+     * @param[in] output receives the encoded data
+     * @param[in] bufferSize the maximum amount of bytes that are buffered before they are passed to the output
+     */
+    ImageWriter(Output output, size_t bufferSize) : output(std::move(output)), bufferSize(bufferSize) {
+        buffer.reserve(bufferSize);
+    }
+
+    virtual ~ImageWriter() = default;
+
+    /** Start a new image (and write its header) */
+    bool begin(uint16_t width, uint16_t height);
+
+    /**
+     * @param[in] row the RGB888 pixels of the next row: 3 bytes per pixel in R, G, B order
+     * @return false when all rows were written already, or when the output failed
+     */
+    bool writeRow(const uint8_t* row);
+
+    /**
+     * Finish the image, after all rows were written.
+     * @return false when rows are missing, or when the output failed
+     */
+    bool finish();
+
+    /** @return the amount of memory that this writer uses for buffering */
+    virtual size_t getMemoryUsage() const { return buffer.capacity(); }
+};
+
+/**
+ * Writes RGB PNG images.
+ * The image data is compressed with fixed Huffman codes and run-length matching on "Sub"-filtered rows:
+ * this compresses flat UI colours well, without the sliding window memory of a full deflate encoder.
+ */
+class PngWriter final : public ImageWriter {
+
+    uint32_t adler = 1;
+    uint32_t bitBuffer = 0;
+    uint8_t bitCount = 0;
+    // Run-length state of the uncompressed stream
+    uint8_t lastByte = 0;
+    bool hasLastByte = false;
+    uint16_t runLength = 0;
+
+    bool writeChunk(const char* type, const uint8_t* data, size_t size);
+    void writeBits(uint32_t bits, uint8_t count);
+    void writeHuffmanCode(uint32_t code, uint8_t length);
+    void writeLiteral(uint8_t value);
+    void writeRun(uint16_t length);
+    void flushRun();
+    void compress(uint8_t value);
+
+protected:
+
+    bool onFlushBuffer(const uint8_t* data, size_t size) override;
+    bool onBegin() override;
+    void onWriteRow(const uint8_t* row) override;
+    bool onFinish() override;
+
+public:
+
+    /** @param[in] chunkSize the maximum size of the image data chunks (the buffer size) */
+    explicit PngWriter(Output output, size_t chunkSize = 4096) : ImageWriter(std::move(output), chunkSize) {}
+};
+
+/**
+ * Writes RGB QOI images (https://qoiformat.org).
+ * QOI is faster to encode than PNG and needs no memory besides the buffer and a 64 entry colour index.
+ */
+class QoiWriter final : public ImageWriter {
+
+    struct Pixel {
+        uint8_t r, g, b, a;
+    };
+
+    Pixel index[64] = {};
+    Pixel previous = { 0, 0, 0, 255 };
+    uint8_t runLength = 0;
+
+    void flushRun();
+
+protected:
+
+    bool onBegin() override;
+    void onWriteRow(const uint8_t* row) override;
+    bool onFinish() override;
+
+public:
+
+    explicit QoiWriter(Output output, size_t bufferSize = 4096) : ImageWriter(std::move(output), bufferSize) {}
+
+    size_t getMemoryUsage() const override { return ImageWriter::getMemoryUsage() + sizeof(index); }
+};
+
+} // namespace tt::file
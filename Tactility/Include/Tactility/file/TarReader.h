@@ -0,0 +1,145 @@
+#pragma once
+
+#include <Tactility/file/File.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace tt::file {
+
+/**
+ * A push-based reader for tar archives (ustar, including GNU long names and pax path records).
+ * Data can be passed in chunks of any size, so an archive can be extracted while it is being received.
+ */
+class TarReader {
+
+public:
+
+    enum class EntryType {
+        File,
+        Directory,
+        /** Links, devices and FIFOs: their data is skipped */
+        Other
+    };
+
+    struct Entry {
+        /** The path inside the archive, without a leading "./" or a trailing "/" */
+        std::string path;
+        EntryType type;
+        /** The tar type flag, e.g. '0' for a file */
+        char typeFlag;
+        uint32_t mode;
+        uint64_t size;
+    };
+
+    /** Receives the entries while the archive is being read */
+    class Handler {
+
+    public:
+
+        virtual ~Handler() = default;
+
+        /** @return false to abort the reading */
+        virtual bool onEntry(const Entry& entry) = 0;
+
+        /**
+         * Receives the contents of the current file entry.
+         * @return false to abort the reading
+         */
+        virtual bool onData(const uint8_t* data, size_t size) = 0;
+
+        /**
+         * Called when all data of the current entry was read.
+         * @return false to abort the reading
+         */
+        virtual bool onEntryFinished() { return true; }
+    };
+
+private:
+
+    enum class State {
+        Header,
+        Data,
+        End,
+        Error
+    };
+
+    static constexpr size_t BLOCK_SIZE = 512;
+    static constexpr size_t MAX_EXTENDED_HEADER_SIZE = 4096;
+
+    Handler& handler;
+    State state = State::Header;
+    uint8_t block[BLOCK_SIZE];
+    size_t blockSize = 0;
+    size_t zeroBlockCount = 0;
+    Entry entry;
+    // Whether the current record is a GNU long name ('L') or pax header ('x', 'g') instead of an entry
+    bool isExtendedHeader = false;
+    std::string extendedHeader;
+    // The path of the next entry, from a long name or pax header
+    std::string nextPath;
+    // The bytes left of the current record, including the padding to a full block
+    uint64_t recordRemaining = 0;
+    uint64_t dataRemaining = 0;
+    size_t entryCount = 0;
+
+    bool onHeaderBlock();
+
+    bool onRecordFinished();
+
+    void fail(const char* reason);
+
+public:
+
+    explicit TarReader(Handler& handler) : handler(handler) {}
+
+    /**
+     * Read the next chunk of the archive.
+     * @return false when the archive is invalid or when the handler aborted
+     */
+    bool write(const uint8_t* data, size_t size);
+
+    /** @return true when the end-of-archive marker was read */
+    bool isFinished() const { return state == State::End; }
+
+    /** @return the amount of entries that were read */
+    size_t getEntryCount() const { return entryCount; }
+};
+
+/**
+ * Extracts the entries of a TarReader into a directory.
+ * Entries with absolute paths or paths that contain ".." are rejected.
+ * The file lock is only held while writing, so other tasks can use the same storage during long extractions.
+ */
+class TarExtractor final : public TarReader::Handler {
+
+    const std::string destinationPath;
+    const std::shared_ptr<Lock> lock;
+    std::unique_ptr<FILE, FileCloser> file;
+    std::string filePath;
+    uint32_t fileMode = 0;
+
+public:
+
+    explicit TarExtractor(std::string destinationPath) :
+        destinationPath(std::move(destinationPath)),
+        lock(getLock(this->destinationPath))
+    {}
+
+    ~TarExtractor() override;
+
+    bool onEntry(const TarReader::Entry& entry) override;
+
+    bool onData(const uint8_t* data, size_t size) override;
+
+    bool onEntryFinished() override;
+};
+
+/**
+ * Checks that a path from an archive stays inside the directory it is extracted to.
+ * @return false for empty and absolute paths, and for paths with a ".." segment
+ */
+bool isSafeRelativePath(const std::string& path);
+
+} // namespace tt::file
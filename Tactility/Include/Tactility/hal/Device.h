@@ -1,8 +1,11 @@
 #pragma once
 
+#include <Tactility/PubSub.h>
+
 #include <functional>
 #include <memory>
 #include <ranges>
+#include <span>
 #include <string>
 #include <vector>
 #include <cassert>
@@ -51,6 +54,44 @@ public:
     virtual std::string getDescription() const = 0;
 };
 
+struct DeviceEvent {
+    enum class Action {
+        Registered,
+        Deregistered
+    };
+
+    Action action;
+    std::shared_ptr<Device> device;
+};
+
+/**
+ * A read-only view of registered devices. Creating it doesn't allocate or lock.
+ * It stays valid while it exists, even when devices are registered or deregistered in the meantime.
+ * @warning Don't store it: replaced registry snapshots are only freed when no DeviceList exists.
+ * Store the devices instead and use getDevicePubsub() to find out when they change.
+ */
+class DeviceList final {
+
+    std::span<const std::shared_ptr<Device>> devices;
+
+    explicit DeviceList(std::span<const std::shared_ptr<Device>> devices) : devices(devices) {}
+
+    friend DeviceList getDeviceList(Device::Type type);
+
+public:
+
+    ~DeviceList();
+
+    DeviceList(const DeviceList&) = delete;
+    DeviceList& operator=(const DeviceList&) = delete;
+
+    auto begin() const { return devices.begin(); }
+    auto end() const { return devices.end(); }
+    size_t size() const { return devices.size(); }
+    bool empty() const { return devices.empty(); }
+    const std::shared_ptr<Device>& operator[](size_t index) const { return devices[index]; }
+};
+
 /**
  * Adds a device to the registry.
  * @warning This will leak memory if you want to destroy a device and don't call deregisterDevice()!
@@ -75,13 +116,19 @@ std::shared_ptr<Device> _Nullable findDevice(Device::Id id);
 /** Find 0, 1 or more devices in the registry by type. */
 std::vector<std::shared_ptr<Device>> findDevices(Device::Type type);
 
+/** Get the devices of the specified type without allocating or locking. */
+DeviceList getDeviceList(Device::Type type);
+
+/** @return the PubSub that publishes a DeviceEvent when a device is registered or deregistered */
+std::shared_ptr<PubSub<DeviceEvent>> getDevicePubsub();
+
 /** Get a copy of the entire device registry in its current state. */
 std::vector<std::shared_ptr<Device>> getDevices();
 
 /** Find devices of a certain type and cast them to the specified class */
 template<class DeviceType>
 std::vector<std::shared_ptr<DeviceType>> findDevices(Device::Type type) {
-    auto devices = findDevices(type);
+    auto devices = getDeviceList(type);
     if (devices.empty()) {
         return {};
     } else {
@@ -98,8 +145,8 @@ std::vector<std::shared_ptr<DeviceType>> findDevices(Device::Type type) {
 
 template<class DeviceType>
 void findDevices(Device::Type type, std::function<bool(const std::shared_ptr<DeviceType>&)> onDeviceFound) {
-    auto devices_view = findDevices(type);
-    for (auto& device : devices_view) {
+    auto devices = getDeviceList(type);
+    for (auto& device : devices) {
         auto typed_device = std::static_pointer_cast<DeviceType>(device);
         if (!onDeviceFound(typed_device)) {
             break;
@@ -110,7 +157,7 @@ void findDevices(Device::Type type, std::function<bool(const std::shared_ptr<Dev
 /** Find the first device of the specified type and cast it to the specified class */
 template<class DeviceType>
 std::shared_ptr<DeviceType> findFirstDevice(Device::Type type) {
-    auto devices = findDevices(type);
+    auto devices = getDeviceList(type);
     if (devices.empty()) {
         return {};
     } else {
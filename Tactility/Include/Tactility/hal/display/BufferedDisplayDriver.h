@@ -0,0 +1,115 @@
+#pragma once
+
+#include "DirtyRegions.h"
+#include "DisplayDriver.h"
+
+#include <Tactility/DispatcherThread.h>
+#include <Tactility/Mutex.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace tt::hal::display {
+
+/**
+ * Wraps a DisplayDriver to batch drawing:
+ * drawn pixels are copied to a frame buffer, and the changed regions are merged and sent to the display on a separate thread.
+ * This turns many small transfers (each with its own command and address overhead) into a few large ones,
+ * and the caller can render its next tile while the previous one is being transferred.
+ *
+ * The frame buffer is the size of the screen, so this is meant for apps that draw directly to the display (after stopLvgl()).
+ * Monochrome displays are not buffered: their pixels are sent directly.
+ *
+ * The flush thread acquires the lock of the wrapped driver for every transfer.
+ * getLock() returns a separate lock, so holding it while calling flush() doesn't block the flush thread.
+ */
+class BufferedDisplayDriver final : public DisplayDriver {
+
+public:
+
+    typedef std::function<void(bool success)> DrawCallback;
+
+    struct Configuration {
+        /** The cost of starting a transfer, expressed in pixels (see DirtyRegions) */
+        int64_t transferOverhead = 256;
+        size_t maxRegionCount = 16;
+        /** The size of each of the 2 transfer buffers. Regions that are larger are sent in multiple bands of rows. */
+        size_t transferBufferSize = 16 * 1024;
+        /** Wait for the tearing effect signal before a flush, when the display supports it */
+        bool syncToTearingEffect = true;
+        TickType_t tearingEffectTimeout = kernel::millisToTicks(50);
+        /** The maximum time to wait for the wrapped driver to finish a transfer (see DisplayDriver::waitForPendingTransfers()) */
+        TickType_t transferTimeout = kernel::millisToTicks(1000);
+    };
+
+private:
+
+    const std::shared_ptr<DisplayDriver> driver;
+    const Configuration configuration;
+    const size_t bytesPerPixel;
+    const uint16_t width;
+    const uint16_t height;
+    const std::shared_ptr<Lock> lock = std::make_shared<Mutex>();
+
+    // Guards frameBuffer, dirtyRegions, pendingCallbacks and isFlushScheduled
+    Mutex mutex;
+    std::vector<uint8_t> frameBuffer;
+    DirtyRegions dirtyRegions;
+    std::vector<DrawCallback> pendingCallbacks;
+    bool isFlushScheduled = false;
+
+    // Only used while holding flushMutex
+    Mutex flushMutex;
+    std::vector<uint8_t> transferBuffers[2];
+    size_t nextTransferBuffer = 0;
+
+    std::unique_ptr<DispatcherThread> flushThread;
+
+    bool queue(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData, const DrawCallback& callback);
+
+    void scheduleFlush();
+
+    bool sendRegion(const Region& region);
+
+public:
+
+    explicit BufferedDisplayDriver(std::shared_ptr<DisplayDriver> driver, const Configuration& configuration);
+
+    explicit BufferedDisplayDriver(std::shared_ptr<DisplayDriver> driver) : BufferedDisplayDriver(std::move(driver), Configuration()) {}
+
+    ~BufferedDisplayDriver() override;
+
+    ColorFormat getColorFormat() const override { return driver->getColorFormat(); }
+    uint16_t getPixelWidth() const override { return width; }
+    uint16_t getPixelHeight() const override { return height; }
+    std::shared_ptr<Lock> getLock() const override { return lock; }
+
+    bool supportsTearingEffectSync() const override { return driver->supportsTearingEffectSync(); }
+    bool waitForTearingEffect(TickType_t timeout) override { return driver->waitForTearingEffect(timeout); }
+
+    /** The pixel data is copied when it is queued, so this returns immediately: use flush() to wait for the display */
+    bool waitForPendingTransfers(size_t maxPendingTransfers, TickType_t timeout) override { return true; }
+
+    /**
+     * Queue pixels to be drawn. The pixel data is copied, so it can be reused when this function returns.
+     * The pixels are sent to the display asynchronously: use flush() to wait for it.
+     * @return false when the area is outside the screen
+     */
+    bool drawBitmap(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData) override;
+
+    /**
+     * Queue pixels to be drawn, like drawBitmap().
+     * @param[in] callback called on the flush thread when the pixels were sent to the display (or failed to be sent).
+     * The callback can queue more pixels, but it must not call flush().
+     */
+    bool drawBitmapAsync(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData, DrawCallback callback);
+
+    /**
+     * Send all queued regions to the display (blocking).
+     * @return false when a transfer failed
+     */
+    bool flush();
+};
+
+} // namespace tt::hal::display
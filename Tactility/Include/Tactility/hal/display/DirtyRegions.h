@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tt::hal::display {
+
+/** A rectangle in pixels, where the end coordinates are exclusive (like DisplayDriver::drawBitmap()) */
+struct Region {
+    int xStart;
+    int yStart;
+    int xEnd;
+    int yEnd;
+
+    int64_t getArea() const { return static_cast<int64_t>(xEnd - xStart) * (yEnd - yStart); }
+    bool isEmpty() const { return xEnd <= xStart || yEnd <= yStart; }
+
+    bool operator==(const Region& other) const = default;
+};
+
+/**
+ * Collects the areas of the screen that changed, and merges them when a single transfer is cheaper than separate ones.
+ * The cost of a transfer is its pixel count plus a fixed overhead for the commands that set the address window.
+ * This merges overlapping and adjacent regions, and regions that are close to each other.
+ */
+class DirtyRegions {
+
+    std::vector<Region> regions;
+    int64_t transferOverhead;
+    size_t maxRegionCount;
+
+    int64_t getCost(const Region& region) const { return transferOverhead + region.getArea(); }
+
+    /** Merge regions until no merge lowers the total cost */
+    void merge();
+
+    /** Merge the pair of regions that increases the cost the least */
+    void mergeCheapestPair();
+
+public:
+
+    /**
+     * @param[in] transferOverhead the cost of starting a transfer, expressed in pixels
+     * @param[in] maxRegionCount when there are more regions, the cheapest ones are merged anyway
+     */
+    explicit DirtyRegions(int64_t transferOverhead = 256, size_t maxRegionCount = 16) :
+        transferOverhead(transferOverhead),
+        maxRegionCount(maxRegionCount)
+    {}
+
+    void add(const Region& region);
+
+    bool isEmpty() const { return regions.empty(); }
+
+    size_t getCount() const { return regions.size(); }
+
+    /** @return the regions in scanline order (top to bottom, then left to right), and clear them */
+    std::vector<Region> take();
+};
+
+} // namespace tt::hal::display
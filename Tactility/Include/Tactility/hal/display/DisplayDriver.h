@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Tactility/Lock.h>
+#include <cstddef>
 #include <cstdint>
 
 namespace tt::hal::display {
@@ -25,6 +26,24 @@ public:
     virtual uint16_t getPixelHeight() const = 0;
     virtual bool drawBitmap(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData) = 0;
     virtual std::shared_ptr<Lock> getLock() const = 0;
+
+    /** @return true when the panel exposes its tearing effect (TE) signal */
+    virtual bool supportsTearingEffectSync() const { return false; }
+
+    /**
+     * Wait for the panel to start a new refresh cycle (the TE signal), so a transfer that starts right after it doesn't tear.
+     * @return false when the signal didn't occur within the timeout or when it isn't supported
+     */
+    virtual bool waitForTearingEffect(TickType_t timeout) { return false; }
+
+    /**
+     * Drivers can return from drawBitmap() while the pixel data is still being transferred (e.g. with DMA).
+     * The pixel data must not be changed until its transfer is finished.
+     * Wait until at most the specified amount of drawBitmap() transfers are still in progress.
+     * @param[in] maxPendingTransfers 0 waits for all transfers
+     * @return false when the transfers didn't finish within the timeout
+     */
+    virtual bool waitForPendingTransfers(size_t maxPendingTransfers, TickType_t timeout) { return true; }
 };
 
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "../Device.h"
 #include "GpsConfiguration.h"
+#include "GpsFix.h"
 #include "Satellites.h"
 
 #include <Tactility/Thread.h>
@@ -10,6 +11,8 @@
 #include <minmea.h>
 #include <utility>
 
+namespace tt::hal::uart { class Uart; }
+
 namespace tt::hal::gps {
 
 enum class GpsResponse {
@@ -25,6 +28,8 @@ public:
 
     typedef int GgaSubscriptionId;
     typedef int RmcSubscriptionId;
+    typedef int FixSubscriptionId;
+    typedef int SatelliteSubscriptionId;
 
     enum class State {
         PendingOn,
@@ -46,19 +51,42 @@ private:
         std::shared_ptr<std::function<void(Device::Id id, const minmea_sentence_rmc&)>> onData;
     };
 
+    struct FixSubscription {
+        FixSubscriptionId id;
+        std::shared_ptr<std::function<void(Device::Id id, const GpsFix&)>> onData;
+    };
+
+    struct SatelliteSubscription {
+        SatelliteSubscriptionId id;
+        std::shared_ptr<std::function<void(Device::Id id, const minmea_sat_info&)>> onData;
+    };
+
     const GpsConfiguration configuration;
     RecursiveMutex mutex;
     std::unique_ptr<Thread> _Nullable thread;
     bool threadInterrupted = false;
     std::vector<GgaSubscription> ggaSubscriptions;
     std::vector<RmcSubscription> rmcSubscriptions;
+    std::vector<FixSubscription> fixSubscriptions;
+    std::vector<SatelliteSubscription> satelliteSubscriptions;
     GgaSubscriptionId lastSatelliteSubscriptionId = 0;
     RmcSubscriptionId lastRmcSubscriptionId = 0;
+    FixSubscriptionId lastFixSubscriptionId = 0;
+    SatelliteSubscriptionId lastSatelliteInfoSubscriptionId = 0;
     GpsModel model = GpsModel::Unknown;
     State state = State::Off;
+    bool navigationMode = false;
 
     int32_t threadMain();
 
+    /** Receive NMEA sentences until the thread is interrupted */
+    void receiveNmea(uart::Uart& uart);
+
+    /** Receive UBX navigation messages until the thread is interrupted */
+    void receiveUbx(uart::Uart& uart);
+
+    void publishRmc(const minmea_sentence_rmc& rmc);
+
     bool isThreadInterrupted() const;
 
     void setState(State newState);
@@ -116,9 +144,50 @@ public:
         std::erase_if(rmcSubscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
     }
 
+    /**
+     * Subscribe to navigation solutions, which are parsed from binary messages without text parsing.
+     * Only u-blox receivers that are in the UBX navigation mode publish these (see CONFIG_TT_GPS_UBX_NAVIGATION_RATE).
+     * These receivers also publish RMC data that is converted from the navigation solutions, but no GGA data.
+     */
+    FixSubscriptionId subscribeFix(const std::function<void(Device::Id deviceId, const GpsFix&)>& onData) {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        fixSubscriptions.push_back({
+            .id = ++lastFixSubscriptionId,
+            .onData = std::make_shared<std::function<void(Device::Id, const GpsFix&)>>(onData)
+        });
+        return lastFixSubscriptionId;
+    }
+
+    void unsubscribeFix(FixSubscriptionId subscriptionId) {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        std::erase_if(fixSubscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
+    }
+
+    /** Subscribe to the satellites in view. Only u-blox 8 and newer publish these when they're in the UBX navigation mode. */
+    SatelliteSubscriptionId subscribeSatellites(const std::function<void(Device::Id deviceId, const minmea_sat_info&)>& onData) {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        satelliteSubscriptions.push_back({
+            .id = ++lastSatelliteInfoSubscriptionId,
+            .onData = std::make_shared<std::function<void(Device::Id, const minmea_sat_info&)>>(onData)
+        });
+        return lastSatelliteInfoSubscriptionId;
+    }
+
+    void unsubscribeSatellites(SatelliteSubscriptionId subscriptionId) {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        std::erase_if(satelliteSubscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
+    }
+
     GpsModel getModel() const;
 
     State getState() const;
+
+    /** @return true when the receiver outputs UBX navigation messages, so fixes are published */
+    bool isNavigationModeEnabled() const;
 };
 
 }
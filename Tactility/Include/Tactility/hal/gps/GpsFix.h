@@ -0,0 +1,83 @@
+#pragma once
+
+#include <minmea.h>
+
+#include <cstdint>
+
+namespace tt::hal::gps {
+
+/** A navigation solution with the position, velocity and time, and their accuracy */
+struct GpsFix {
+
+    enum class Type : uint8_t {
+        None = 0,
+        DeadReckoning = 1,
+        Fix2d = 2,
+        Fix3d = 3,
+        GnssDeadReckoning = 4,
+        TimeOnly = 5
+    };
+
+    Type type;
+    /** True when the receiver considers the position valid (e.g. within its accuracy limits) */
+    bool valid;
+    bool validDate;
+    bool validTime;
+
+    // UTC date and time
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    /** Fraction of the second, which can be negative (range: -1e9 to 1e9) */
+    int32_t nanoseconds;
+
+    /** The amount of satellites used in the navigation solution */
+    uint8_t satelliteCount;
+
+    /** Degrees, in units of 1e-7 */
+    int32_t latitude;
+    /** Degrees, in units of 1e-7 */
+    int32_t longitude;
+    /** Millimeters above the ellipsoid */
+    int32_t height;
+    /** Millimeters above mean sea level */
+    int32_t altitude;
+    /** Millimeters */
+    uint32_t horizontalAccuracy;
+    /** Millimeters */
+    uint32_t verticalAccuracy;
+
+    /** Millimeters per second */
+    int32_t velocityNorth;
+    /** Millimeters per second */
+    int32_t velocityEast;
+    /** Millimeters per second */
+    int32_t velocityDown;
+    /** Millimeters per second (2D) */
+    int32_t groundSpeed;
+    /** Millimeters per second */
+    uint32_t speedAccuracy;
+    /** Heading of motion in degrees, in units of 1e-5 */
+    int32_t heading;
+    /** Degrees, in units of 1e-5 */
+    uint32_t headingAccuracy;
+
+    /** Position dilution of precision, in units of 0.01 */
+    uint16_t positionDop;
+
+    double getLatitudeDegrees() const { return latitude * 1e-7; }
+    double getLongitudeDegrees() const { return longitude * 1e-7; }
+    float getGroundSpeedMetersPerSecond() const { return static_cast<float>(groundSpeed) / 1000.f; }
+    float getHeadingDegrees() const { return static_cast<float>(heading) * 1e-5f; }
+};
+
+/**
+ * Convert an RMC sentence to a fix, for receivers that only output NMEA.
+ * RMC sentences don't contain the altitude, accuracy and satellite count, so these are set to 0.
+ */
+void toFix(const minmea_sentence_rmc& rmc, GpsFix& fix);
+
+} // namespace tt::hal::gps
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "GpsFix.h"
+
+#include <minmea.h>
+
+#include <cstdint>
+#include <functional>
+#include <span>
+
+/**
+ * Parsers for the binary UBX navigation messages.
+ * Frames are complete UBX frames including the sync word and checksum (e.g. from Uart::readUbxFrame()).
+ */
+namespace tt::hal::gps::ublox {
+
+constexpr uint8_t UBX_CLASS_NAV = 0x01;
+constexpr uint8_t UBX_ID_NAV_PVT = 0x07;
+constexpr uint8_t UBX_ID_NAV_SAT = 0x35;
+
+/** @return true when the frame has the specified class and id */
+bool isMessage(std::span<const uint8_t> frame, uint8_t classId, uint8_t messageId);
+
+/**
+ * Parse a UBX-NAV-PVT frame.
+ * @return false when the frame is not a NAV-PVT message or when it's too short
+ */
+bool parseNavPvt(std::span<const uint8_t> frame, GpsFix& fix);
+
+/**
+ * Parse a UBX-NAV-SAT frame.
+ * @param[in] onSatellite called for each satellite (the SNR is the carrier-to-noise ratio in dBHz)
+ * @return false when the frame is not a NAV-SAT message or when it's too short
+ */
+bool parseNavSat(std::span<const uint8_t> frame, const std::function<void(const minmea_sat_info&)>& onSatellite);
+
+/** Convert a fix to an RMC sentence, for subscribers that only use NMEA data */
+void toRmc(const GpsFix& fix, minmea_sentence_rmc& rmc);
+
+} // namespace tt::hal::gps::ublox
@@ -6,6 +6,7 @@
 #include <Tactility/freertoscompat/RTOS.h>
 
 #include <climits>
+#include <cstdint>
 #include <string>
 
 namespace tt::hal::i2c {
@@ -33,6 +34,19 @@ struct Configuration {
     i2c_config_t config;
 };
 
+/** Bus utilisation counters since boot */
+struct Statistics {
+    /** The amount of times that the bus was locked for one or more operations (e.g. a Transaction or a single read) */
+    uint32_t transactionCount;
+    uint32_t operationCount;
+    uint32_t failureCount;
+    uint32_t lockTimeoutCount;
+    /** The time that the bus lock was held for operations */
+    uint64_t busyMicros;
+    /** The time spent waiting for the bus lock before executing operations */
+    uint64_t lockWaitMicros;
+};
+
 enum class Status {
     Started,
     Stopped,
@@ -75,6 +89,8 @@ bool masterWriteRegister(i2c_port_t port, uint8_t address, uint8_t reg, const ui
 /**
  * Write multiple values to multiple registers in master mode.
  * The input is as follows: { register1, value1, register2, value2, ... }
+ * The bus is locked once for all writes and the timeout applies to all of them.
+ * A failed write doesn't stop the remaining writes.
  * @return false if any of the write operations failed
  */
 bool masterWriteRegisterArray(i2c_port_t port, uint8_t address, const uint8_t* data, uint16_t dataSize, TickType_t timeout = defaultTimeout);
@@ -82,9 +98,15 @@ bool masterWriteRegisterArray(i2c_port_t port, uint8_t address, const uint8_t* d
 /** Write bytes and then read the response bytes in master mode*/
 bool masterWriteRead(i2c_port_t port, uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize, TickType_t timeout = defaultTimeout);
 
-/** @return true when a device is detected at the specified address */
+/**
+ * Probe for a device. A missing device isn't logged as an error or counted as a failure in the Statistics.
+ * @return true when a device is detected at the specified address
+ */
 bool masterHasDeviceAtAddress(i2c_port_t port, uint8_t address, TickType_t timeout = defaultTimeout);
 
+/** @return the utilisation counters of the specified bus */
+Statistics getStatistics(i2c_port_t port);
+
 /**
  * The lock for the specified bus.
  * This can be used when calling native I2C functionality outside of Tactility.
@@ -2,6 +2,7 @@
 
 #include "../Device.h"
 #include "I2c.h"
+#include "I2cTransaction.h"
 
 namespace tt::hal::i2c {
 
@@ -29,11 +30,16 @@ protected:
     bool readRegister12(uint8_t reg, float& out) const;
     bool readRegister14(uint8_t reg, float& out) const;
     bool readRegister16(uint8_t reg, uint16_t& out) const;
+    /** Set bits without other tasks accessing the bus in between reading and writing */
     bool bitOn(uint8_t reg, uint8_t bitmask) const;
+    /** Clear bits without other tasks accessing the bus in between reading and writing */
     bool bitOff(uint8_t reg, uint8_t bitmask) const;
     bool bitOnByIndex(uint8_t reg, uint8_t index) const { return bitOn(reg, 1 << index); }
     bool bitOffByIndex(uint8_t reg, uint8_t index) const { return bitOff(reg, 1 << index); }
 
+    /** Execute multiple operations while holding the bus lock. Use getAddress() when adding operations. */
+    bool execute(const Transaction& transaction, TickType_t timeout = DEFAULT_TIMEOUT) const { return transaction.execute(port, timeout); }
+
 public:
 
     explicit I2cDevice(i2c_port_t port, uint32_t address) : port(port), address(address) {}
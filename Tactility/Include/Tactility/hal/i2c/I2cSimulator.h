@@ -0,0 +1,177 @@
+#pragma once
+#ifndef ESP_PLATFORM
+
+#include "I2c.h"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * A virtual I2C bus for the simulator and host tests.
+ * All I2C functions (including transactions) are executed on simulated devices that are attached to a port.
+ * Addresses without a device don't acknowledge, like on a real bus.
+ */
+namespace tt::hal::i2c::simulator {
+
+/** A simulated I2C peripheral. Calls are serialized by the bus lock. */
+class SimulatedDevice {
+
+public:
+
+    virtual ~SimulatedDevice() = default;
+
+    /**
+     * Handle the write phase of a transfer.
+     * @return false to not acknowledge
+     */
+    virtual bool onWrite(const uint8_t* data, size_t dataSize) = 0;
+
+    /**
+     * Handle the read phase of a transfer.
+     * @return false to not acknowledge
+     */
+    virtual bool onRead(uint8_t* data, size_t dataSize) = 0;
+};
+
+/**
+ * A device with 256 8-bit registers, which is how most I2C peripherals work:
+ * the first written byte selects the register, and the following bytes are written to it.
+ * Reads and writes auto-increment the selected register.
+ */
+class RegisterMapDevice : public SimulatedDevice {
+
+public:
+
+    /** Called after a register was written by the bus master, so a model can react to it (e.g. clear a flag) */
+    typedef std::function<void(RegisterMapDevice& device, uint8_t reg, uint8_t value)> WriteHandler;
+    /** Called before a register is read by the bus master, so a model can update it (e.g. pop a FIFO) */
+    typedef std::function<void(RegisterMapDevice& device, uint8_t reg)> ReadHandler;
+
+private:
+
+    std::array<uint8_t, 256> registers = { 0 };
+    uint8_t selectedRegister = 0;
+    WriteHandler writeHandler;
+    ReadHandler readHandler;
+
+public:
+
+    bool onWrite(const uint8_t* data, size_t dataSize) override;
+    bool onRead(uint8_t* data, size_t dataSize) override;
+
+    uint8_t getRegister(uint8_t reg) const { return registers[reg]; }
+    void setRegister(uint8_t reg, uint8_t value) { registers[reg] = value; }
+
+    /** Set 2 registers, starting with the low byte (little endian) */
+    void setRegister16(uint8_t reg, uint16_t value) {
+        registers[reg] = value & 0xFF;
+        registers[static_cast<uint8_t>(reg + 1)] = value >> 8;
+    }
+
+    void setWriteHandler(WriteHandler handler) { writeHandler = std::move(handler); }
+    void setReadHandler(ReadHandler handler) { readHandler = std::move(handler); }
+};
+
+/** One phase of a transfer as it appeared on the bus */
+struct TraceEntry {
+    enum class Direction {
+        Write,
+        Read
+    };
+
+    Direction direction;
+    uint8_t address;
+    bool acknowledged;
+    std::vector<uint8_t> data;
+
+    bool operator==(const TraceEntry& other) const = default;
+};
+
+/**
+ * Answers reads with the data from a trace and checks that the writes match it.
+ * This makes it possible to replay a recorded session against a driver without the original device model.
+ */
+class TraceReplayDevice final : public SimulatedDevice {
+
+    std::vector<TraceEntry> entries;
+    size_t position = 0;
+    size_t mismatchCount = 0;
+
+    const TraceEntry* next(TraceEntry::Direction direction);
+
+public:
+
+    /** @param[in] entries the trace entries of a single address */
+    explicit TraceReplayDevice(std::vector<TraceEntry> entries) : entries(std::move(entries)) {}
+
+    bool onWrite(const uint8_t* data, size_t dataSize) override;
+    bool onRead(uint8_t* data, size_t dataSize) override;
+
+    /** @return true when all entries were replayed without mismatches */
+    bool isFinished() const { return position == entries.size() && mismatchCount == 0; }
+
+    /** @return the amount of phases that didn't match the trace */
+    size_t getMismatchCount() const { return mismatchCount; }
+};
+
+struct Timing {
+    /** 0 means that the bytes on the wire take no time: only the latency is counted */
+    uint32_t clockHz;
+    /** Fixed overhead per transfer (e.g. driver and interrupt latency) */
+    uint32_t transferLatencyMicros;
+    /** When true, transfers take as long as they would on a real bus */
+    bool delay;
+};
+
+/** Counters that show how efficiently drivers use the bus */
+struct Counters {
+    uint32_t transferCount;
+    uint32_t nackCount;
+    /** All bytes on the wire, including address bytes */
+    uint32_t byteCount;
+    /** The time that the transfers would take on a real bus with the configured timing */
+    uint64_t busMicros;
+};
+
+/** Attach a device to a port. It replaces the device that was attached at the same address. */
+void attachDevice(i2c_port_t port, uint8_t address, std::shared_ptr<SimulatedDevice> device);
+
+void detachDevice(i2c_port_t port, uint8_t address);
+
+/** Set the timing of a port. The default is 400 kHz without latency or delay. */
+void setTiming(i2c_port_t port, const Timing& timing);
+
+Counters getCounters(i2c_port_t port);
+
+void resetCounters(i2c_port_t port);
+
+/** Start recording all transfers on a port. This clears the previous recording. */
+void startTrace(i2c_port_t port);
+
+/** Stop recording and return the recorded transfers */
+std::vector<TraceEntry> stopTrace(i2c_port_t port);
+
+/**
+ * Save a trace as text: one entry per line with the direction, address, acknowledgement and data.
+ * Example: "W 55 ACK 08" followed by "R 55 ACK 3C 0F"
+ */
+bool saveTrace(const std::string& path, const std::vector<TraceEntry>& trace);
+
+bool loadTrace(const std::string& path, std::vector<TraceEntry>& trace);
+
+/** @return the entries of the specified address, e.g. to create a TraceReplayDevice */
+std::vector<TraceEntry> filterTrace(const std::vector<TraceEntry>& trace, uint8_t address);
+
+/**
+ * Execute a transfer on the simulated bus: an optional write phase followed by an optional read phase.
+ * This is called by the I2C HAL when it's holding the bus lock.
+ * @return true when all phases were acknowledged
+ */
+bool transfer(i2c_port_t port, uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize);
+
+}
+
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "I2c.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace tt::hal::i2c {
+
+/**
+ * A list of I2C operations that is executed as one unit: the bus is locked once for all operations,
+ * so other tasks can't access the bus in between.
+ *
+ * A transaction can be built once and executed many times (e.g. for polling).
+ * It doesn't copy the read and write buffers that are passed to it, so these must stay in memory until it's executed.
+ */
+class Transaction final {
+
+public:
+
+    struct Operation {
+        enum class Type {
+            /** Write the prefix and the data, then read data when readDataSize is not 0 */
+            Transfer,
+            /** Read a register, change bits and write it back */
+            UpdateRegister8
+        };
+
+        Type type;
+        uint8_t address;
+        /** Bytes that are written before the write data (e.g. a register). They're copied, so they don't have to stay in memory. */
+        uint8_t prefix[2];
+        uint8_t prefixSize;
+        const uint8_t* writeData;
+        size_t writeDataSize;
+        uint8_t* readData;
+        size_t readDataSize;
+        uint8_t setMask;
+        uint8_t clearMask;
+    };
+
+    typedef std::function<void(bool success)> CompletionCallback;
+
+private:
+
+    std::vector<Operation> operations;
+
+    Transaction& addTransfer(uint8_t address, const uint8_t* prefix, uint8_t prefixSize, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize);
+
+public:
+
+    Transaction() = default;
+
+    /** @param[in] operationCount the amount of operations to reserve memory for */
+    explicit Transaction(size_t operationCount) { operations.reserve(operationCount); }
+
+    /** Read bytes from a device. */
+    Transaction& read(uint8_t address, uint8_t* data, size_t dataSize);
+
+    /** Write bytes to a device. */
+    Transaction& write(uint8_t address, const uint8_t* data, size_t dataSize);
+
+    /** Write bytes and then read the response bytes. */
+    Transaction& writeRead(uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize);
+
+    /** Read bytes from the specified register. */
+    Transaction& readRegister(uint8_t address, uint8_t reg, uint8_t* data, size_t dataSize);
+
+    /** Write bytes to the specified register. */
+    Transaction& writeRegister(uint8_t address, uint8_t reg, const uint8_t* data, size_t dataSize);
+
+    /** Write a single byte to the specified register. The value is copied. */
+    Transaction& writeRegister8(uint8_t address, uint8_t reg, uint8_t value);
+
+    /**
+     * Read a register, set and clear bits, and write the result back.
+     * No other task can access the bus in between.
+     */
+    Transaction& updateRegister8(uint8_t address, uint8_t reg, uint8_t setMask, uint8_t clearMask);
+
+    /** Remove all operations, so the transaction can be reused. */
+    void clear() { operations.clear(); }
+
+    const std::vector<Operation>& getOperations() const { return operations; }
+
+    /**
+     * Execute all operations in order, while holding the bus lock.
+     * Execution stops at the first operation that fails.
+     * @param[in] port the port to execute the operations on
+     * @param[in] timeout the maximum time for locking the bus and executing all the operations
+     * @return true when all operations succeeded
+     */
+    bool execute(i2c_port_t port, TickType_t timeout = defaultTimeout) const;
+
+    /**
+     * Execute the transaction on the I2C dispatcher thread.
+     * The transaction is shared, so it stays in memory until it's finished. Its buffers must stay in memory too.
+     * @param[in] transaction the transaction to execute
+     * @param[in] port the port to execute the operations on
+     * @param[in] timeout the maximum time for locking the bus and executing all the operations, starting from this call
+     * @param[in] onCompleted called on the I2C dispatcher thread when the transaction finished (optional)
+     * @return true when the transaction was dispatched
+     */
+    static bool executeAsync(std::shared_ptr<const Transaction> transaction, i2c_port_t port, TickType_t timeout, CompletionCallback onCompleted = nullptr);
+};
+
+} // namespace
@@ -70,9 +70,16 @@ public:
 /** Return the SdCard device if the path is within the SdCard mounted path (path std::string::starts_with() check)*/
 std::shared_ptr<SdCardDevice> _Nullable find(const std::string& path);
 
+/**
+ * Update the mount table that is used by findSdCardLock().
+ * Must be called after mounting or unmounting an SD card.
+ */
+void updateMountTable();
+
 /**
  * Attempt to find an SD card that the specified belongs to,
  * and returns its lock if the SD card is mounted. Otherwise it returns nullptr.
+ * This doesn't lock or allocate: it uses the mount table from the last updateMountTable() call.
  * @param[in] a path on a file system (e.g. file, directory, etc.)
  * @return the lock of a mounted SD card or otherwise null
  */
@@ -64,6 +64,9 @@ private:
     std::string mountPath;
     sdmmc_card_t* card = nullptr;
     std::shared_ptr<Config> config;
+    std::shared_ptr<Lock> lock;
+
+    static std::shared_ptr<Lock> createLock(const Config& config);
 
     bool applyGpioWorkAround();
     bool mountInternal(const std::string& mountPath);
@@ -71,7 +74,8 @@ private:
 public:
 
     explicit SpiSdCardDevice(std::unique_ptr<Config> config) : SdCardDevice(config->mountBehaviourAtBoot),
-        config(std::move(config))
+        config(std::move(config)),
+        lock(createLock(*this->config))
     {}
 
     std::string getName() const override { return "SD Card"; }
@@ -81,13 +85,8 @@ public:
     bool unmount() override;
     std::string getMountPath() const override { return mountPath; }
 
-    std::shared_ptr<Lock> getLock() const override {
-        if (config->customLock != nullptr) {
-            return config->customLock;
-        } else {
-            return spi::getLock(config->spiHost);
-        }
-    }
+    /** @return a Low priority client of the SPI bus arbiter, unless a custom lock is used that doesn't guard the bus */
+    std::shared_ptr<Lock> getLock() const override { return lock; }
 
     State getState(TickType_t timeout) const override;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SpiCompat.h"
+#include "SpiBusArbiter.h"
 
 #include <Tactility/Lock.h>
 #include <Tactility/freertoscompat/RTOS.h>
@@ -44,8 +45,15 @@ bool isStarted(spi_host_device_t device);
 
 /**
  * Return the lock for the specified SPI device. Never returns nullptr.
+ * The lock is a Normal priority client of the bus arbiter.
  * @return the lock that represents the specified device. Can be used with third party SPI implementations or native API calls (e.g. ESP-IDF).
  */
 std::shared_ptr<Lock> getLock(spi_host_device_t device);
 
+/**
+ * Return the arbiter for the specified SPI device, so clients can get a lock with their own priority and statistics.
+ * @return the arbiter or nullptr when the device is not configured
+ */
+std::shared_ptr<SpiBusArbiter> getArbiter(spi_host_device_t device);
+
 } // namespace tt::hal::spi
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Tactility/Lock.h>
+#include <Tactility/Mutex.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tt::hal::spi {
+
+/** Histogram buckets are powers of 2 in milliseconds: < 1 ms, < 2 ms, < 4 ms, ..., < 128 ms, >= 128 ms */
+constexpr size_t SPI_BUS_HISTOGRAM_BUCKETS = 9;
+
+struct SpiBusClientStatistics {
+    std::string name;
+    /** The amount of times the lock was acquired (recursive locking is not counted) */
+    uint32_t lockCount;
+    /** The amount of times the lock was held longer than the maximum hold time */
+    uint32_t holdOverrunCount;
+    int64_t maxWaitMicros;
+    int64_t maxHoldMicros;
+    uint32_t waitHistogram[SPI_BUS_HISTOGRAM_BUCKETS];
+    uint32_t holdHistogram[SPI_BUS_HISTOGRAM_BUCKETS];
+};
+
+/**
+ * Arbitrates a lock that is shared by multiple clients of an SPI bus (e.g. a display and an SD card).
+ * Clients get their own Lock, so they can be used as a regular lock (e.g. as file lock).
+ *
+ * Low priority clients (e.g. storage) that lock and unlock in quick succession yield the bus for a tick
+ * after holding it for their maximum hold time, so that tasks outside the arbiter (e.g. LVGL rendering) can take it.
+ *
+ * The arbiter must outlive its clients.
+ */
+class SpiBusArbiter final {
+
+public:
+
+    enum class Priority {
+        /** Yields the bus after a long series of locks */
+        Low,
+        Normal
+    };
+
+    class Client;
+
+private:
+
+    std::shared_ptr<Lock> busLock;
+    /** The start of the current series of Low priority locks */
+    std::atomic<int64_t> lowPriorityBurstStart = 0;
+    std::atomic<int64_t> lowPriorityLastRelease = 0;
+    mutable Mutex clientsMutex;
+    std::vector<std::weak_ptr<Client>> clients;
+
+    friend class Client;
+
+    /** Yield the bus after a long series of Low priority locks */
+    void yieldAfterLowPriorityBurst(TickType_t maxHoldTime);
+
+public:
+
+    /** @param[in] busLock the lock that guards the bus */
+    explicit SpiBusArbiter(std::shared_ptr<Lock> busLock) : busLock(std::move(busLock)) {}
+
+    /** @return the lock that guards the bus */
+    std::shared_ptr<Lock> getBusLock() const { return busLock; }
+
+    /**
+     * @param[in] name the name that is used for statistics
+     * @param[in] priority Low for clients that should yield the bus during long series of operations
+     * @param[in] maxHoldTime the time the client is expected to hold the bus at most
+     * @return a lock for the bus
+     */
+    std::shared_ptr<Lock> createClient(const std::string& name, Priority priority, TickType_t maxHoldTime);
+
+    /** @return the statistics of all clients that still exist */
+    std::vector<SpiBusClientStatistics> getStatistics() const;
+
+    /** Log the statistics of all clients */
+    void logStatistics() const;
+};
+
+}
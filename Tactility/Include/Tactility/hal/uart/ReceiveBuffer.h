@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+
+namespace tt::hal::uart {
+
+/** The result of searching for a frame in received data */
+struct FrameMatch {
+    /** The amount of bytes before the frame that can't be part of any frame (e.g. noise or a partial frame after an overrun) */
+    size_t skipSize;
+    /** The size of the frame that starts after the skipped bytes, or 0 when the data doesn't contain a complete frame yet */
+    size_t frameSize;
+};
+
+/**
+ * Searches for the first frame in the specified data.
+ * It is called again with the same data plus the newly received bytes when no complete frame was found.
+ */
+typedef std::function<FrameMatch(std::span<const uint8_t> data)> FrameFinder;
+
+/** Find a frame that ends with the specified delimiter (e.g. a line). The delimiter is part of the frame. */
+FrameMatch findDelimitedFrame(std::span<const uint8_t> data, uint8_t delimiter);
+
+/**
+ * Find a frame that contains its payload size in a little endian field.
+ * @param[in] data the received data
+ * @param[in] lengthOffset the offset of the length field in the frame
+ * @param[in] lengthSize the size of the length field: 1 or 2 bytes
+ * @param[in] overheadSize the size of all the frame bytes that are not part of the payload (e.g. header and checksum)
+ */
+FrameMatch findLengthPrefixedFrame(std::span<const uint8_t> data, size_t lengthOffset, uint8_t lengthSize, size_t overheadSize);
+
+/**
+ * Find a u-blox UBX frame: sync word 0xB5 0x62, class, id, 16 bit payload length, payload and checksum.
+ * Data before the sync word and frames with an invalid checksum are skipped.
+ */
+FrameMatch findUbxFrame(std::span<const uint8_t> data);
+
+/**
+ * A buffer for received data that keeps the unprocessed data contiguous, so frames can be used without copying them.
+ * When there is not enough space after the data, the data is moved to the start of the buffer.
+ * It is not thread-safe: it is meant to be used by the task that reads from a UART.
+ */
+class ReceiveBuffer final {
+
+    std::unique_ptr<uint8_t[]> data;
+    size_t capacity;
+    size_t readPosition = 0;
+    size_t writePosition = 0;
+
+public:
+
+    explicit ReceiveBuffer(size_t capacity) : data(std::make_unique<uint8_t[]>(capacity)), capacity(capacity) {}
+
+    size_t getCapacity() const { return capacity; }
+
+    /** @return the amount of bytes that were received and not consumed */
+    size_t size() const { return writePosition - readPosition; }
+
+    bool isFull() const { return size() == capacity; }
+
+    /**
+     * @return the free space to receive data into. Call commit() with the amount of bytes that were written to it.
+     * This might move the data to the start of the buffer, which invalidates the spans that were returned by getData().
+     */
+    std::span<uint8_t> getWritableSpace();
+
+    /** Mark bytes in the writable space as received */
+    void commit(size_t size);
+
+    /** @return the received data that was not consumed yet */
+    std::span<const uint8_t> getData() const { return { data.get() + readPosition, size() }; }
+
+    /** Remove bytes from the start of the data */
+    void consume(size_t size);
+
+    void clear() {
+        readPosition = 0;
+        writePosition = 0;
+    }
+};
+
+} // namespace tt::hal::uart
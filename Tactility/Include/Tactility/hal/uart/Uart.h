@@ -6,14 +6,20 @@
 #include "Tactility/Lock.h"
 #include "UartCompat.h"
 #include "Tactility/hal/uart/Configuration.h"
+#include "Tactility/hal/uart/ReceiveBuffer.h"
 
 #include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 namespace tt::hal::uart {
 
 constexpr TickType_t defaultTimeout = 10 / portTICK_PERIOD_MS;
 
+/** The default size of the buffer that is used for reading frames and lines */
+constexpr size_t defaultReceiveBufferSize = 512;
+
 enum class InitMode {
     ByTactility, // Tactility will initialize it in the correct bootup phase
     ByExternal, // The device is already initialized and Tactility should assume it works
@@ -26,10 +32,48 @@ enum class Status {
     Unknown
 };
 
+struct ReceiveStatistics {
+    /** The amount of bytes that were moved from the driver into the receive buffer */
+    uint64_t byteCount;
+    /** The amount of frames (including lines) that were read */
+    uint32_t frameCount;
+    /** The amount of times the receive buffer was full without containing a frame, so its data was dropped */
+    uint32_t overrunCount;
+    /** Bytes that were dropped due to overruns or because they weren't part of a frame */
+    uint32_t droppedByteCount;
+    /** The amount of times that the buffers of the driver or hardware overflowed (when the driver reports it) */
+    uint32_t driverOverrunCount;
+};
+
 class Uart {
 
     uint32_t id;
 
+    std::unique_ptr<ReceiveBuffer> receiveBuffer;
+    /** The size of the last frame: it stays in the receive buffer until the next frame is read */
+    size_t pendingFrameSize = 0;
+    ReceiveStatistics receiveStatistics = {
+        .byteCount = 0,
+        .frameCount = 0,
+        .overrunCount = 0,
+        .droppedByteCount = 0,
+        .driverOverrunCount = 0
+    };
+
+    /** Move all available bytes from the driver into the receive buffer, waiting up to the timeout for the first byte */
+    bool fillReceiveBuffer(TickType_t timeout);
+
+    /** @return a frame from the data in the receive buffer, or an empty span when it doesn't contain a complete frame */
+    std::span<const uint8_t> extractFrame(const FrameFinder& finder);
+
+protected:
+
+    /** @return the total amount of driver or hardware buffer overflows, or 0 when the driver doesn't report these */
+    virtual uint32_t getDriverOverrunCount() { return 0; }
+
+    /** Discard the data in the buffers of the driver and hardware */
+    virtual void flushDriverInput() = 0;
+
 public:
 
     Uart();
@@ -88,8 +132,8 @@ public:
     /** Get the baud rate for the specified port */
     virtual uint32_t getBaudRate() = 0;
 
-    /** Flush input buffers */
-    virtual void flushInput() = 0;
+    /** Discard all received data: the data in the receive buffer and the buffers of the driver */
+    void flushInput();
 
     /**
      * Write a string (excluding null terminator character)
@@ -99,15 +143,42 @@ public:
      */
     bool writeString(const char* buffer, TickType_t timeout = defaultTimeout);
 
+    /**
+     * Read a frame through the receive buffer. Bytes are moved from the driver in blocks, instead of one by one.
+     * The frame data is not copied: it is valid until the next call to a function that reads a frame or line.
+     * When the receive buffer fills up without containing a frame, its data is dropped and counted as an overrun.
+     * The frame after an overrun might be the end of a dropped frame, unless the frame finder can detect that (e.g. with a checksum).
+     * @warning the receive buffer might contain data after the frame, which is not returned by readBytes() and readByte()
+     * @param[in] finder the function that finds the frame in the received data
+     * @param[in] timeout the maximum time to wait for a complete frame
+     * @return the frame, or an empty span when there was no complete frame before the timeout
+     */
+    std::span<const uint8_t> readFrame(const FrameFinder& finder, TickType_t timeout = defaultTimeout);
+
+    /** Read a frame that ends with the specified delimiter (included in the result). See readFrame() */
+    std::span<const uint8_t> readLine(uint8_t delimiter = '\n', TickType_t timeout = defaultTimeout);
+
+    /** Read a u-blox UBX frame (including sync word and checksum). See readFrame() */
+    std::span<const uint8_t> readUbxFrame(TickType_t timeout = defaultTimeout);
+
+    /** Discard the data in the receive buffer, but not the data that the driver received after it */
+    void clearReceiveBuffer();
+
+    /** Set the size of the receive buffer: it must be able to hold the largest frame. This discards the data in the receive buffer. */
+    void setReceiveBufferSize(size_t size);
+
+    ReceiveStatistics getReceiveStatistics();
+
     /**
      * Read a buffer as a string until the specified character (the "untilChar" is included in the result)
-     * @warning if the input data doesn't return "untilByte" then the device goes out of memory
+     * @return the string, or an empty string when the character wasn't received before the timeout
      */
     std::string readStringUntil(char untilChar, TickType_t timeout = defaultTimeout);
 
     /**
      * Read a buffer as a byte array until the specified character (the "untilChar" is included in the result)
-     * @return the amount of bytes read from UART
+     * This copies a line from the receive buffer: see readLine(). Lines that don't fit the buffer are truncated.
+     * @return the amount of bytes that were copied into the buffer (excluding the null terminator)
      */
     size_t readUntil(std::byte* buffer, size_t bufferSize, uint8_t untilByte, TickType_t timeout = defaultTimeout, bool addNullTerminator = true);
 };
@@ -24,6 +24,10 @@ enum class SystemEvent {
     LvglStopped,
     /** An important system time-related event, such as NTP update or time-zone change */
     Time,
+    /** The SD card was mounted */
+    SdCardMounted,
+    /** The SD card was unmounted, ejected or failed */
+    SdCardUnmounted,
 };
 
 /** Value 0 mean "no subscription" */
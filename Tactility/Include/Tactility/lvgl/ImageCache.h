@@ -0,0 +1,48 @@
+#pragma once
+
+#include <lvgl.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tt::lvgl {
+
+/** A decoded image that can be passed to lv_image_set_src(). It stays in memory while it is referenced. */
+using CachedImage = std::shared_ptr<const lv_image_dsc_t>;
+
+struct ImageCacheStatistics {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    /** Memory used by the decoded images in the cache */
+    size_t usedBytes;
+    size_t capacityBytes;
+};
+
+/**
+ * Get a decoded image from the cache, or decode it and add it to the cache.
+ * System assets (TT_ASSET_FOLDER) are loaded from the pre-decoded asset bundle when it has them.
+ * Least recently used images are evicted when the cache is full, unless they are still referenced.
+ * @warning the LVGL lock must be acquired
+ * @param[in] path an LVGL image path (e.g. "A:/system/spinner.png")
+ * @return the image or nullptr when it failed to load
+ */
+CachedImage getCachedImage(const std::string& path);
+
+/**
+ * Get an image source for lv_image_set_src() or lv_list_add_button() that uses the cache for image files.
+ * @warning the LVGL lock must be acquired
+ * @param[in] source an LVGL image path or symbol
+ * @param[inout] images the list that keeps the cached image alive while it is shown
+ * @return the cached image, or the original source for symbols and images that failed to load
+ */
+const void* getCachedImageSource(const char* source, std::vector<CachedImage>& images);
+
+ImageCacheStatistics getImageCacheStatistics();
+
+/** Remove all images that are not referenced */
+void clearImageCache();
+
+}
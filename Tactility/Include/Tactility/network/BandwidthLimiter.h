@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Tactility/Mutex.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tt::network {
+
+/**
+ * Limits the combined data rate of multiple transfers.
+ * Each transfer reserves the bytes it received and waits until the limit allows them.
+ * Reservations are scheduled back-to-back, so concurrent transfers share the bandwidth.
+ */
+class BandwidthLimiter final {
+
+    mutable Mutex mutex;
+    uint32_t bytesPerSecond;
+    // The time at which the previous reservations are used up
+    int64_t nextFreeTimeMicros = 0;
+
+public:
+
+    /** @param[in] bytesPerSecond the maximum data rate, or 0 for no limit */
+    explicit BandwidthLimiter(uint32_t bytesPerSecond = 0) : bytesPerSecond(bytesPerSecond) {}
+
+    /** @param[in] bytesPerSecond the maximum data rate, or 0 for no limit */
+    void setLimit(uint32_t bytesPerSecond);
+
+    uint32_t getLimit() const;
+
+    /**
+     * Reserve bandwidth for a transfer.
+     * @param[in] size the amount of bytes
+     * @param[in] nowMicros the current time
+     * @return the amount of microseconds to wait before the bytes may be transferred
+     */
+    int64_t reserve(size_t size, int64_t nowMicros);
+
+    /** Reserve bandwidth for a transfer and wait until it is available */
+    void acquire(size_t size);
+};
+
+} // namespace tt::network
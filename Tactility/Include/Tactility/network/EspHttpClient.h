@@ -35,6 +35,11 @@ public:
         return client != nullptr;
     }
 
+    bool setHeader(const char* key, const char* value) const {
+        assert(client != nullptr);
+        return esp_http_client_set_header(client, key, value) == ESP_OK;
+    }
+
     bool open() {
         assert(client != nullptr);
         logger.info("open()");
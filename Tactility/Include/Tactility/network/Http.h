@@ -5,8 +5,10 @@
 
 namespace tt::network::http {
     /**
-     * Download a file from a URL.
-     * The server must send the Content-Length header.
+     * Download a file from a URL with the download service.
+     * Failed connections are retried, continuing from the received data.
+     * The callbacks are called on the main dispatcher.
+     * @see service::download::DownloadService for progress events, resuming earlier downloads and hash verification
      * @param url download source URL
      * @param certFilePath the path to the .pem file
      * @param downloadFilePath The path to downloadd the file to. The parent directories must exist.
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace tt::network {
+
+/** Receives the response of an HTTP GET request while it is being read */
+class HttpStream {
+
+public:
+
+    virtual ~HttpStream() = default;
+
+    /**
+     * Send a GET request and receive the response headers.
+     * @param[in] url an http:// or https:// URL
+     * @param[in] certificatePath the .pem file to verify the server with (HTTPS only)
+     * @param[in] rangeStart when not 0, only the data from this offset is requested (HTTP Range)
+     * @return false when the connection or the request failed
+     */
+    virtual bool open(const std::string& url, const std::string& certificatePath, uint64_t rangeStart) = 0;
+
+    virtual int getStatusCode() const = 0;
+
+    /** @return the Content-Length header value, or -1 when the server didn't send it */
+    virtual int64_t getContentLength() const = 0;
+
+    /** @return the amount of bytes read, 0 at the end of the response or a negative value on failure */
+    virtual int read(uint8_t* data, size_t size) = 0;
+};
+
+/**
+ * Create an HttpStream for the current platform.
+ * On ESP32 it uses esp_http_client. On the simulator it uses POSIX sockets, which only support http:// URLs.
+ */
+std::unique_ptr<HttpStream> createHttpStream();
+
+} // namespace tt::network
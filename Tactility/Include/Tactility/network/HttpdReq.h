@@ -2,6 +2,8 @@
 
 #ifdef ESP_PLATFORM
 
+#include <Tactility/network/MultipartParser.h>
+
 #include <esp_http_server.h>
 #include <map>
 #include <memory>
@@ -26,6 +28,15 @@ bool readAndDiscardOrSendError(httpd_req_t* request, const std::string& toRead);
 
 size_t receiveFile(httpd_req_t* request, size_t length, const std::string& filePath);
 
+/**
+ * Receive the full request body and pass it to a multipart parser.
+ * @param[in] request the request to receive the body of
+ * @param[in] parser the parser that passes the parts to their sinks
+ * @param[in] bufferSize the size of the receive buffer
+ * @return true when the body was received and parsed completely
+ */
+bool receiveMultipart(httpd_req_t* request, MultipartParser& parser, size_t bufferSize = 4096);
+
 }
 
 #endif // ESP_PLATFORM
\ No newline at end of file
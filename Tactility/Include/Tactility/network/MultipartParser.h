@@ -0,0 +1,170 @@
+#pragma once
+
+#include <Tactility/file/File.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace tt::network {
+
+/** Receives the data of a multipart form part while it is being received */
+class PartSink {
+
+public:
+
+    virtual ~PartSink() = default;
+
+    /** @return false to abort the parsing */
+    virtual bool write(const uint8_t* data, size_t size) = 0;
+
+    /**
+     * Called when all data of the part was received.
+     * @return false to abort the parsing
+     */
+    virtual bool finish() { return true; }
+};
+
+/**
+ * Writes a part to a file.
+ * The file is deleted when the part wasn't received completely.
+ * The file lock is only held while writing, so other tasks can use the same storage during long uploads.
+ */
+class FilePartSink final : public PartSink {
+
+    const std::string filePath;
+    const std::shared_ptr<Lock> lock;
+    std::unique_ptr<FILE, file::FileCloser> file;
+    size_t bytesWritten = 0;
+    bool finished = false;
+
+public:
+
+    explicit FilePartSink(std::string filePath) :
+        filePath(std::move(filePath)),
+        lock(file::getLock(this->filePath))
+    {}
+
+    ~FilePartSink() override;
+
+    bool write(const uint8_t* data, size_t size) override;
+
+    bool finish() override;
+
+    size_t getBytesWritten() const { return bytesWritten; }
+};
+
+/** Collects a small part (e.g. a text field) in a string */
+class StringPartSink final : public PartSink {
+
+    std::string& output;
+    const size_t maxSize;
+
+public:
+
+    /**
+     * @param[out] output the string to append the data to
+     * @param[in] maxSize the maximum size of the data: larger parts abort the parsing
+     */
+    StringPartSink(std::string& output, size_t maxSize) : output(output), maxSize(maxSize) {}
+
+    bool write(const uint8_t* data, size_t size) override;
+};
+
+/**
+ * An incremental multipart/form-data parser (RFC 7578).
+ * Data can be passed in chunks of any size: a boundary can span multiple chunks.
+ * The data of a part is passed to its sink directly, without buffering it.
+ */
+class MultipartParser {
+
+public:
+
+    struct Part {
+        std::string name;
+        /** Empty when the part isn't a file */
+        std::string filename;
+        std::string contentType;
+    };
+
+    /**
+     * Called when the headers of a part were parsed.
+     * @return the sink for the data of the part, or nullptr to discard the data
+     */
+    typedef std::function<std::unique_ptr<PartSink>(const Part& part)> CreateSink;
+
+private:
+
+    enum class State {
+        Preamble,
+        AfterDelimiter,
+        Headers,
+        Body,
+        Epilogue,
+        Error
+    };
+
+    static constexpr size_t MAX_HEADERS_SIZE = 2048;
+
+    /** "\r\n--" followed by the boundary */
+    const std::string delimiter;
+    const CreateSink createSink;
+
+    State state = State::Preamble;
+    // The amount of delimiter bytes that matched at the end of the previous data
+    size_t matchLength = 0;
+    // The first character after a delimiter: "--" ends the body, "\r\n" starts a part
+    char afterDelimiterCharacter = 0;
+    std::string headers;
+    std::unique_ptr<PartSink> sink;
+    size_t partCount = 0;
+
+    bool emit(const uint8_t* data, size_t size);
+
+    /**
+     * Find the delimiter and pass the data before it to the current sink.
+     * @return the amount of bytes that were processed
+     */
+    size_t parseBody(const uint8_t* data, size_t size, bool& found);
+
+    bool onDelimiter();
+
+    bool onHeadersReceived();
+
+    void fail(const char* reason);
+
+public:
+
+    /**
+     * @param[in] boundary the boundary parameter of the Content-Type header
+     * @param[in] createSink creates the sink for each part
+     */
+    MultipartParser(const std::string& boundary, CreateSink createSink) :
+        delimiter("\r\n--" + boundary),
+        createSink(std::move(createSink)),
+        // The first delimiter has no preceding line break
+        matchLength(2)
+    {}
+
+    /**
+     * Parse the next chunk of the body.
+     * @return false when the body is invalid or when a sink aborted
+     */
+    bool parse(const uint8_t* data, size_t size);
+
+    /** @return true when the closing delimiter was parsed */
+    bool isFinished() const { return state == State::Epilogue; }
+
+    /** @return the amount of parts that were started */
+    size_t getPartCount() const { return partCount; }
+};
+
+/**
+ * Parse a Content-Disposition header value such as: form-data; name="file"; filename="app.elf"
+ * @return the parameters (without quotes) and "type" for the disposition type
+ */
+std::map<std::string, std::string> parseContentDispositionValue(const std::string& value);
+
+} // namespace tt::network
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Tactility/file/ImageWriter.h>
+#include <Tactility/hal/display/DirtyRegions.h>
+
+#include <cstdint>
+
+namespace tt::service::development {
+
+/**
+ * Encodes screen updates for the /screen endpoint.
+ * All values are big-endian. The stream starts with a header:
+ *
+ *   "TTSS", version (uint8), screen width (uint16), screen height (uint16)
+ *
+ * Followed by frames:
+ *
+ *   "FRAM", frame number (uint32), region count (uint16)
+ *
+ * Each region has a header that is followed by a QOI image (https://qoiformat.org) of the region:
+ *
+ *   x (uint16), y (uint16), width (uint16), height (uint16)
+ *
+ * The first frame contains the full screen. The next frames only contain the regions that changed.
+ * A frame without regions is sent as a keep-alive.
+ */
+class ScreenStreamEncoder {
+
+    file::ImageWriter::Output output;
+    file::QoiWriter writer;
+    uint32_t frameCount = 0;
+
+public:
+
+    static constexpr uint8_t VERSION = 1;
+
+    explicit ScreenStreamEncoder(const file::ImageWriter::Output& output) : output(output), writer(output) {}
+
+    bool writeHeader(uint16_t width, uint16_t height);
+
+    bool beginFrame(uint16_t regionCount);
+
+    bool beginRegion(const hal::display::Region& region);
+
+    /** @param[in] row the RGB888 pixels of the next row of the region, in R, G, B order */
+    bool writeRow(const uint8_t* row) { return writer.writeRow(row); }
+
+    bool finishRegion() { return writer.finish(); }
+
+    uint32_t getFrameCount() const { return frameCount; }
+
+    size_t getMemoryUsage() const { return writer.getMemoryUsage(); }
+};
+
+/**
+ * Adapts the frame rate to the throughput of the connection.
+ * Sending a frame should take at most half of the frame interval, so the link is never saturated:
+ * regions that change while waiting are merged, so slow connections get fewer but larger frames.
+ */
+class FrameRateController {
+
+public:
+
+    struct Configuration {
+        uint32_t minimumIntervalMs = 50;
+        uint32_t maximumIntervalMs = 2000;
+    };
+
+private:
+
+    const Configuration configuration;
+    // Exponential moving averages
+    uint32_t averageSendTimeMs = 0;
+    uint32_t averageThroughput = 0;
+    bool hasSamples = false;
+
+public:
+
+    explicit FrameRateController(const Configuration& configuration) : configuration(configuration) {}
+
+    FrameRateController() : FrameRateController(Configuration()) {}
+
+    /**
+     * @param[in] size the amount of bytes in the frame
+     * @param[in] durationMs the time it took to render and send the frame
+     */
+    void onFrameSent(size_t size, uint32_t durationMs);
+
+    /** @return the time between the start of 2 frames */
+    uint32_t getFrameIntervalMs() const;
+
+    /** @return the average throughput in bytes per second, or 0 when no frames were sent */
+    uint32_t getThroughput() const { return averageThroughput; }
+};
+
+} // namespace tt::service::development
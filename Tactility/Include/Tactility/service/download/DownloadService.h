@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Tactility/DispatcherThread.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/PubSub.h>
+#include <Tactility/network/BandwidthLimiter.h>
+#include <Tactility/service/Service.h>
+#include <Tactility/service/download/Downloader.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace tt::service::download {
+
+typedef uint32_t DownloadId;
+
+enum class DownloadState {
+    Started,
+    Progress,
+    Finished,
+    Failed
+};
+
+struct DownloadEvent {
+    DownloadId id;
+    DownloadState state;
+    uint64_t bytesReceived;
+    /** 0 when the size is unknown */
+    uint64_t totalBytes;
+    /** The reason of a failure (only for DownloadState::Failed) */
+    const char* _Nullable errorMessage;
+};
+
+/**
+ * Downloads files on worker threads, so downloads don't block the main dispatcher.
+ * Downloads are divided over the workers, and the workers share a bandwidth limit.
+ * Progress is published as DownloadEvent via getPubsub().
+ */
+class DownloadService final : public Service {
+
+public:
+
+    struct Configuration {
+        /** The size of the receive buffer of each download */
+        size_t bufferSize = 4096;
+        /** The amount of downloads that can run at the same time */
+        uint8_t maxConcurrentDownloads = 2;
+        /** The combined data rate of all downloads, or 0 for no limit */
+        uint32_t maxBytesPerSecond = 0;
+        /** The amount of times a failed connection is retried, continuing from the received data */
+        uint8_t retryCount = 3;
+    };
+
+    /** Called on the worker thread when a download finished or failed */
+    typedef std::function<void(bool success, const char* _Nullable errorMessage)> OnFinished;
+
+private:
+
+    struct Worker {
+        std::unique_ptr<DispatcherThread> thread;
+        /** The amount of downloads that are dispatched to the thread */
+        size_t downloadCount = 0;
+    };
+
+    mutable Mutex mutex;
+    Configuration configuration;
+    std::vector<Worker> workers;
+    DownloadId lastDownloadId = 0;
+    /** Downloads that are queued or running */
+    std::set<DownloadId> activeDownloadIds;
+    /** The result callbacks of downloads that are queued on a worker but didn't start yet */
+    std::map<DownloadId, OnFinished> queuedDownloads;
+    std::set<DownloadId> cancelledDownloadIds;
+    network::BandwidthLimiter bandwidthLimiter;
+    std::shared_ptr<PubSub<DownloadEvent>> pubSub = std::make_shared<PubSub<DownloadEvent>>();
+    bool started = false;
+
+    void run(DownloadId id, size_t workerIndex, const DownloadRequest& request);
+
+    bool isCancelled(DownloadId id) const;
+
+public:
+
+    bool onStart(ServiceContext& serviceContext) override;
+
+    /** Running downloads are cancelled, and queued downloads fail without starting */
+    void onStop(ServiceContext& serviceContext) override;
+
+    /**
+     * Start a download on a worker thread.
+     * The download is queued when all workers are busy.
+     * @param[in] request
+     * @param[in] onFinished the optional result callback
+     * @return the id of the download, or 0 when the service isn't started
+     */
+    DownloadId download(const DownloadRequest& request, OnFinished onFinished = nullptr);
+
+    /**
+     * Stop a queued or running download. The partial file is kept, so the download can be resumed.
+     * A cancelled download finishes with DownloadState::Failed.
+     */
+    void cancel(DownloadId id);
+
+    /** Changes apply to downloads that start afterwards, except for the bandwidth limit which applies immediately */
+    void setConfiguration(const Configuration& newConfiguration);
+
+    Configuration getConfiguration() const;
+
+    std::shared_ptr<PubSub<DownloadEvent>> getPubsub() const { return pubSub; }
+};
+
+std::shared_ptr<DownloadService> _Nullable findDownloadService();
+
+} // namespace tt::service::download
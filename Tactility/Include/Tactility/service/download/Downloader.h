@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Tactility/crypt/Sha256.h>
+#include <Tactility/network/BandwidthLimiter.h>
+#include <Tactility/network/HttpStream.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace tt::service::download {
+
+struct DownloadRequest {
+    std::string url;
+    /** The .pem file to verify the server with (HTTPS only) */
+    std::string certificatePath;
+    /** The parent directories must exist */
+    std::string filePath;
+    /** The lowercase hexadecimal SHA-256 of the file, or an empty string to skip the verification */
+    std::string sha256;
+    /** Continue from the partial file of an earlier attempt, if the server supports HTTP Range requests */
+    bool resume = true;
+};
+
+/**
+ * Downloads a file to "<filePath>.part" and renames it when the download is complete.
+ * A connection failure doesn't restart the download: it continues from the received data with an HTTP Range request.
+ * The data is hashed while it is received, so the file doesn't have to be read again for the verification.
+ */
+class Downloader final {
+
+public:
+
+    struct Configuration {
+        /** The size of the receive buffer */
+        size_t bufferSize = 4096;
+        /** The amount of times a failed connection is retried */
+        uint8_t retryCount = 3;
+        uint32_t retryDelayMs = 2000;
+        /** The minimum time between progress callbacks */
+        uint32_t progressIntervalMs = 250;
+    };
+
+    typedef std::function<std::unique_ptr<network::HttpStream>()> CreateStream;
+
+    /**
+     * @param[in] bytesReceived the size of the partial file
+     * @param[in] totalBytes the expected size of the file, or 0 when it is unknown
+     */
+    typedef std::function<void(uint64_t bytesReceived, uint64_t totalBytes)> OnProgress;
+
+    typedef std::function<bool()> IsCancelled;
+
+private:
+
+    enum class TransferResult {
+        Finished,
+        Retry,
+        Failed
+    };
+
+    const Configuration configuration;
+    const CreateStream createStream;
+    network::BandwidthLimiter* _Nullable const bandwidthLimiter;
+    const char* errorMessage = nullptr;
+
+    TransferResult transfer(network::HttpStream& stream, const DownloadRequest& request, const std::string& partPath, uint8_t* buffer, uint64_t& offset, crypt::Sha256& hash, const OnProgress& onProgress, const IsCancelled& isCancelled);
+
+    bool hashPartialFile(const std::string& partPath, uint8_t* buffer, uint64_t& size, crypt::Sha256& hash);
+
+public:
+
+    /**
+     * @param[in] configuration
+     * @param[in] createStream creates the HTTP stream for each connection
+     * @param[in] bandwidthLimiter the limiter that is shared with other downloads, or nullptr for no limit
+     */
+    Downloader(const Configuration& configuration, CreateStream createStream, network::BandwidthLimiter* _Nullable bandwidthLimiter = nullptr) :
+        configuration(configuration),
+        createStream(std::move(createStream)),
+        bandwidthLimiter(bandwidthLimiter)
+    {}
+
+    /**
+     * Download a file (blocking).
+     * @return true when the file was downloaded and verified
+     */
+    bool run(const DownloadRequest& request, const OnProgress& onProgress = nullptr, const IsCancelled& isCancelled = nullptr);
+
+    /** @return the reason of the last failure */
+    const char* _Nullable getErrorMessage() const { return errorMessage; }
+};
+
+} // namespace tt::service::download
@@ -16,6 +16,7 @@ class GpsService final : public Service {
         std::shared_ptr<hal::gps::GpsDevice> device = nullptr;
         hal::gps::GpsDevice::GgaSubscriptionId satelliteSubscriptionId = -1;
         hal::gps::GpsDevice::RmcSubscriptionId rmcSubscriptionId = -1;
+        hal::gps::GpsDevice::FixSubscriptionId fixSubscriptionId = -1;
     };
 
     minmea_sentence_rmc rmcRecord;
@@ -25,6 +26,7 @@ class GpsService final : public Service {
     Mutex stateMutex;
     std::vector<GpsDeviceRecord> deviceRecords;
     std::shared_ptr<PubSub<State>> statePubSub = std::make_shared<PubSub<State>>();
+    std::shared_ptr<PubSub<hal::gps::GpsFix>> fixPubSub = std::make_shared<PubSub<hal::gps::GpsFix>>();
     std::unique_ptr<ServicePaths> paths;
     State state = State::Off;
 
@@ -61,6 +63,13 @@ public:
 
     /** @return GPS service pubsub that broadcasts State* objects */
     std::shared_ptr<PubSub<State>> getStatePubsub() const { return statePubSub; }
+
+    /**
+     * @return GPS service pubsub that broadcasts the fixes of all receivers.
+     * Fixes of receivers that only output NMEA are converted from RMC sentences, so they don't have altitude and accuracy data.
+     * Messages are published on the GPS device threads.
+     */
+    std::shared_ptr<PubSub<hal::gps::GpsFix>> getFixPubsub() const { return fixPubSub; }
 };
 
 std::shared_ptr<GpsService> findGpsService();
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+namespace tt::service::trackrecorder {
+
+enum class ExportFormat {
+    Gpx,
+    Csv
+};
+
+/**
+ * Convert a track file to GPX or CSV.
+ * The track is streamed one chunk at a time, so the memory usage doesn't depend on the track length.
+ * This acquires the file locks of both files.
+ * @param[in] trackPath the track file to read
+ * @param[in] outputPath the file to (over)write
+ * @param[in] format the output format
+ * @return true when the output was written, including tracks that ended in a damaged chunk
+ */
+bool exportTrack(const std::string& trackPath, const std::string& outputPath, ExportFormat format);
+
+} // namespace tt::service::trackrecorder
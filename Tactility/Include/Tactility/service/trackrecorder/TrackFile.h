@@ -0,0 +1,129 @@
+#pragma once
+
+#include <Tactility/file/File.h>
+#include <Tactility/hal/gps/GpsFix.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Track files store GPS fixes in chunks of delta-encoded points:
+ * a file header, followed by any number of chunks that each have a header with a CRC32 of their payload.
+ * Every chunk starts its deltas from zero, so chunks can be decoded on their own.
+ * A file that was cut short (e.g. by a crash or power loss) can be read up to the last complete chunk.
+ */
+namespace tt::service::trackrecorder {
+
+constexpr uint32_t TRACK_FILE_IDENTIFIER = 0x4B525454; // "TTRK"
+constexpr uint32_t TRACK_FILE_VERSION = 1;
+constexpr uint32_t TRACK_CHUNK_IDENTIFIER = 0x4B4E4843; // "CHNK"
+
+struct TrackFileHeader {
+    uint32_t identifier = TRACK_FILE_IDENTIFIER;
+    uint32_t version = TRACK_FILE_VERSION;
+};
+
+struct TrackChunkHeader {
+    uint32_t identifier = TRACK_CHUNK_IDENTIFIER;
+    uint16_t pointCount = 0;
+    uint16_t payloadSize = 0;
+    uint32_t crc = 0;
+};
+
+struct TrackPoint {
+    /** Milliseconds since the unix epoch (UTC) */
+    int64_t time;
+    /** Degrees, in units of 1e-7 */
+    int32_t latitude;
+    /** Degrees, in units of 1e-7 */
+    int32_t longitude;
+    /** Millimeters above mean sea level */
+    int32_t altitude;
+    /** Millimeters per second */
+    int32_t groundSpeed;
+    /** Degrees, in units of 1e-5 */
+    int32_t heading;
+    /** Millimeters */
+    uint32_t horizontalAccuracy;
+    uint8_t satelliteCount;
+};
+
+/**
+ * Convert a fix to a track point.
+ * @return false when the fix doesn't have a valid position, date and time
+ */
+bool toTrackPoint(const hal::gps::GpsFix& fix, TrackPoint& point);
+
+/** Encodes points into a single chunk */
+class TrackChunkEncoder {
+
+    std::vector<uint8_t> payload;
+    TrackPoint previous = {};
+    uint16_t pointCount = 0;
+
+public:
+
+    /** The largest payload that a chunk header can describe */
+    static constexpr size_t MAX_PAYLOAD_SIZE = UINT16_MAX;
+    /** The largest size that a single encoded point can take */
+    static constexpr size_t MAX_POINT_SIZE = 80;
+
+    /**
+     * Add a point to the chunk.
+     * @return false when the chunk is full
+     */
+    bool add(const TrackPoint& point);
+
+    size_t getPayloadSize() const { return payload.size(); }
+    uint16_t getPointCount() const { return pointCount; }
+    bool isEmpty() const { return pointCount == 0; }
+
+    /**
+     * Finish the chunk and reset the encoder, so it can start a new chunk.
+     * @return the chunk header and payload
+     */
+    std::vector<uint8_t> finish();
+};
+
+/**
+ * Append encoded chunks to a track file in a single write, and create the file when it doesn't exist yet.
+ * This acquires the file lock.
+ */
+bool appendChunks(const std::string& path, std::span<const std::vector<uint8_t>> chunks);
+
+/**
+ * Reads the points of a track file one chunk at a time.
+ * @warning This does NOT acquire the file lock. Use file::getLock() or file::withLock() when using it.
+ */
+class TrackReader {
+
+    const std::string filePath;
+    std::unique_ptr<FILE, file::FileCloser> file;
+    std::vector<uint8_t> payload;
+    size_t payloadOffset = 0;
+    uint16_t pointsRemaining = 0;
+    TrackPoint previous = {};
+    bool corrupted = false;
+
+    bool readChunk();
+
+public:
+
+    explicit TrackReader(std::string filePath) : filePath(std::move(filePath)) {}
+
+    bool open();
+    void close();
+
+    /**
+     * Read the next point.
+     * @return false when there are no more points, or when the rest of the file is unreadable (see isCorrupted())
+     */
+    bool next(TrackPoint& point);
+
+    /** @return true when reading stopped at an incomplete or damaged chunk */
+    bool isCorrupted() const { return corrupted; }
+};
+
+} // namespace tt::service::trackrecorder
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Tactility/DispatcherThread.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/PubSub.h>
+#include <Tactility/Timer.h>
+#include <Tactility/hal/gps/GpsFix.h>
+#include <Tactility/service/Service.h>
+#include <Tactility/service/gps/GpsState.h>
+#include <Tactility/service/trackrecorder/TrackFile.h>
+
+namespace tt::service::trackrecorder {
+
+/**
+ * Records the fixes of the GPS service to a track file.
+ * Fixes are collected into chunks in memory, and the chunks are appended to the file on a separate thread.
+ * Writing a few kilobytes at a time (instead of a write per fix) keeps the storage from hogging a shared SPI bus.
+ * Recording starts when the GPS service starts receiving and stops when it stops.
+ */
+class TrackRecorderService final : public Service {
+
+public:
+
+    struct Statistics {
+        /** Points that were added to a chunk */
+        uint32_t pointCount;
+        /** Chunks that were written to the track file */
+        uint32_t chunkCount;
+        /** Bytes that were written to the track file */
+        uint32_t byteCount;
+        uint32_t writeFailureCount;
+        /** Chunks that were dropped because they couldn't be written */
+        uint32_t droppedChunkCount;
+    };
+
+private:
+
+    Mutex mutex;
+    std::unique_ptr<DispatcherThread> writerThread;
+    std::unique_ptr<Timer> chunkAgeTimer;
+    std::shared_ptr<PubSub<gps::State>> gpsStatePubSub;
+    PubSub<gps::State>::SubscriptionHandle gpsStateSubscription = nullptr;
+    std::shared_ptr<PubSub<hal::gps::GpsFix>> fixPubSub;
+    PubSub<hal::gps::GpsFix>::SubscriptionHandle fixSubscription = nullptr;
+    TrackChunkEncoder encoder;
+    TickType_t chunkStartTime = 0;
+    std::vector<std::vector<uint8_t>> pendingChunks;
+    std::string trackPath;
+    bool recording = false;
+    Statistics statistics = {};
+
+    void onGpsStateChanged(gps::State state);
+
+    void onFix(const hal::gps::GpsFix& fix);
+
+    /** Write the chunk when it's too old, also when no fixes are received */
+    void onChunkAgeTimer();
+
+    /** @return true when the chunk has points that are older than the maximum age (requires the mutex to be locked) */
+    bool isChunkExpired() const;
+
+    /** Write the pending chunks on the writer thread (requires the mutex to be locked) */
+    void dispatchWrite();
+
+    /** Move the encoded points to the pending chunks (requires the mutex to be locked) */
+    void finishChunk();
+
+    /** Append the pending chunks to the track file */
+    void writePendingChunks();
+
+public:
+
+    bool onStart(ServiceContext& serviceContext) override;
+    void onStop(ServiceContext& serviceContext) override;
+
+    /**
+     * Start recording the GPS fixes. This doesn't start the GPS service.
+     * @param[in] path the track file, which is appended to when it already exists
+     * @return false when a recording is already in progress
+     */
+    bool startRecording(const std::string& path);
+
+    /** Start recording to a new track file in the "tracks" directory of the first mounted SD card */
+    bool startRecording();
+
+    /**
+     * Stop recording and write all recorded points to the track file (blocking).
+     * Don't call this from a GPS fix subscription.
+     */
+    void stopRecording();
+
+    bool isRecording() const;
+
+    /** @return the path of the current or last recording */
+    std::string getTrackPath() const;
+
+    Statistics getStatistics() const;
+};
+
+std::shared_ptr<TrackRecorderService> _Nullable optTrackRecorderService();
+
+} // namespace tt::service::trackrecorder
@@ -0,0 +1,87 @@
+#pragma once
+
+#ifdef ESP_PLATFORM
+
+#include <esp_elf.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace tt::app {
+
+/** A relocated ELF app that can be requested again after restoring its data */
+class ElfImage final {
+
+    esp_elf_t elf {};
+    bool relocated = false;
+    std::unique_ptr<uint8_t[]> dataSnapshot;
+    size_t dataSnapshotSize = 0;
+    uint32_t fingerprint;
+
+public:
+
+    explicit ElfImage(uint32_t fingerprint) : fingerprint(fingerprint) {}
+
+    ~ElfImage();
+
+    ElfImage(const ElfImage&) = delete;
+    ElfImage& operator=(const ElfImage&) = delete;
+
+    /**
+     * Load and relocate the ELF
+     * @return 0 on success, otherwise a negative errno.h value
+     */
+    int relocate(const esp_elf_reader_t& reader);
+
+    /** Run the ELF's main() */
+    bool request();
+
+    uint32_t getFingerprint() const { return fingerprint; }
+
+    /** Copy the writable data right after relocation, so it can be restored for a next launch */
+    bool takeDataSnapshot();
+
+    /** @return false when there is no snapshot */
+    bool restoreDataSnapshot();
+
+    bool hasDataSnapshot() const { return dataSnapshot != nullptr; }
+
+    /** @return the memory that is used by the relocated app and its data snapshot */
+    size_t getMemorySize();
+};
+
+/** @return true when relocated apps can be cached (CONFIG_TT_ELF_APP_CACHE_SIZE is not 0) */
+bool isElfImageCacheEnabled();
+
+/**
+ * Create a fingerprint from the file's size and modification time.
+ * The cache lives in RAM, so the firmware build can't change while an image is cached.
+ * @param[in] elfPath the ELF file path (the file lock must be acquired)
+ * @param[out] fingerprint the resulting fingerprint
+ * @return true on success
+ */
+bool getElfFingerprint(const std::string& elfPath, uint32_t& fingerprint);
+
+/**
+ * Take a relocated app out of the cache.
+ * Images are removed from the cache while they're in use, so an app that runs twice gets loaded twice.
+ * @param[in] appId the app id
+ * @param[in] fingerprint the fingerprint of the app's current ELF file
+ * @return the cached image or nullptr when there is no matching image
+ */
+std::unique_ptr<ElfImage> takeCachedElfImage(const std::string& appId, uint32_t fingerprint);
+
+/**
+ * Hand back an image when the app stops.
+ * The image is freed when it has no data snapshot or when it doesn't fit the cache size.
+ * Least recently used images are evicted to make space.
+ */
+void releaseElfImage(const std::string& appId, std::unique_ptr<ElfImage> image);
+
+/** Remove an app from the cache, e.g. when it is installed or uninstalled */
+void invalidateCachedElfImage(const std::string& appId);
+
+}
+
+#endif // ESP_PLATFORM
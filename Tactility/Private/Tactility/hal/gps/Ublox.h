@@ -24,4 +24,17 @@ GpsModel probe(uart::Uart& uart);
 
 bool init(uart::Uart& uart, GpsModel model);
 
+/** @return true when the model can output UBX-NAV-PVT messages */
+bool supportsNavigationMode(GpsModel model);
+
+/**
+ * Switch the receiver output from NMEA sentences to the binary NAV-PVT (and NAV-SAT, when supported) messages.
+ * This is not saved on the receiver, so it outputs NMEA sentences again after a restart.
+ * @param[in] uart the UART of a receiver that was initialized with init()
+ * @param[in] model the receiver model
+ * @param[in] rateHz the navigation rate (1 to 10 Hz)
+ * @return true when the receiver acknowledged the NAV-PVT configuration
+ */
+bool initNavigationMode(uart::Uart& uart, GpsModel model, uint8_t rateHz);
+
 } // namespace tt::service::gps
@@ -12,6 +12,17 @@ class UartEsp final : public Uart {
     Mutex mutex;
     const Configuration& configuration;
     bool started = false;
+    /** Driver events: only used for counting overflows */
+    QueueHandle_t eventQueue = nullptr;
+    uint32_t driverOverrunCount = 0;
+
+    /** Count the overflows in the queued driver events (requires the mutex to be locked) */
+    void receiveDriverEventsLocked();
+
+protected:
+
+    uint32_t getDriverOverrunCount() override;
+    void flushDriverInput() override;
 
 public:
 
@@ -26,7 +37,6 @@ public:
     size_t available(TickType_t timeout) override;
     bool setBaudRate(uint32_t baudRate, TickType_t timeout) override;
     uint32_t getBaudRate() override;
-    void flushInput() override;
 };
 
 std::unique_ptr<Uart> create(const Configuration& configuration);
@@ -22,7 +22,9 @@ private:
     const Configuration& configuration;
     std::unique_ptr<FILE, AutoCloseFileDeleter> device;
 
-    bool awaitAvailable(TickType_t timeout);
+    size_t availableLocked() const;
+
+    bool awaitAvailableLocked(TickType_t timeout) const;
 
 public:
 
@@ -37,7 +39,7 @@ public:
     size_t available(TickType_t timeout) final;
     bool setBaudRate(uint32_t baudRate, TickType_t timeout) final;
     uint32_t getBaudRate() final;
-    void flushInput() final;
+    void flushDriverInput() final;
 };
 
 std::unique_ptr<Uart> create(const Configuration& configuration);
@@ -4,10 +4,14 @@
 #include <Tactility/service/Service.h>
 
 #include <Tactility/RecursiveMutex.h>
+#include <Tactility/Thread.h>
 
 #include <esp_event.h>
 #include <esp_http_server.h>
 #include <Tactility/network/HttpServer.h>
+#include <Tactility/service/development/ScreenStreamer.h>
+
+#include <atomic>
 
 namespace tt::service::development {
 
@@ -42,10 +46,21 @@ class DevelopmentService final : public Service {
                 .method = HTTP_PUT,
                 .handler = handleAppUninstall,
                 .user_ctx = this
+            },
+            {
+                .uri = "/screen",
+                .method = HTTP_GET,
+                .handler = handleScreen,
+                .user_ctx = this
             }
         }
     );
 
+    // Guarded by mutex
+    std::unique_ptr<Thread> screenStreamThread;
+    std::atomic<bool> screenStreamInterrupted = false;
+    ScreenStreamer screenStreamer;
+
     void startServer();
     void stopServer();
 
@@ -53,6 +68,10 @@ class DevelopmentService final : public Service {
     static esp_err_t handleAppRun(httpd_req_t* request);
     static esp_err_t handleAppInstall(httpd_req_t* request);
     static esp_err_t handleAppUninstall(httpd_req_t* request);
+    static esp_err_t handleScreen(httpd_req_t* request);
+
+    void streamScreen(httpd_req_t* request);
+    void stopScreenStream();
 
 public:
 
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Tactility/hal/display/DirtyRegions.h>
+#include <Tactility/service/development/ScreenStream.h>
+
+#include <functional>
+
+#include <lvgl.h>
+
+namespace tt::service::development {
+
+/**
+ * Streams the screen: it records the areas that LVGL invalidates, renders them again and encodes them with ScreenStreamEncoder.
+ * The regions are rendered in bands, and the LVGL lock is released between bands.
+ */
+class ScreenStreamer {
+
+public:
+
+    typedef std::function<bool()> IsInterrupted;
+
+private:
+
+    static constexpr uint16_t BAND_HEIGHT = 16;
+    static constexpr uint32_t KEEP_ALIVE_INTERVAL_MS = 5000;
+
+    // Guarded by the LVGL lock
+    hal::display::DirtyRegions dirtyRegions = hal::display::DirtyRegions(64, 16);
+    lv_display_t* display = nullptr;
+
+    FrameRateController frameRateController;
+
+    static void onInvalidateArea(lv_event_t* event);
+
+    bool sendRegion(ScreenStreamEncoder& encoder, lv_draw_buf_t* band, const hal::display::Region& region, const IsInterrupted& isInterrupted);
+
+public:
+
+    /**
+     * Stream until the output fails or until the stream is interrupted.
+     * @param[in] output receives the stream data
+     * @param[in] isInterrupted is checked between frames
+     * @return false when streaming could not be started
+     */
+    bool run(const file::ImageWriter::Output& output, const IsInterrupted& isInterrupted);
+
+    /** @return the average throughput of the last stream in bytes per second */
+    uint32_t getThroughput() const { return frameRateController.getThroughput(); }
+};
+
+} // namespace tt::service::development
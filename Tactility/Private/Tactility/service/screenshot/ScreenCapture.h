@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Tactility/TactilityConfig.h>
+
+#if TT_FEATURE_SCREENSHOT_ENABLED
+
+#include <Tactility/file/ImageWriter.h>
+
+namespace tt::service::screenshot {
+
+struct CaptureStatistics {
+    /** The total time to render, convert and encode the screen */
+    uint32_t captureTimeMs = 0;
+    /** The total time that the LVGL lock was held */
+    uint32_t lockedTimeMs = 0;
+    /** The memory used by the capture: the tile buffer and the image writer */
+    size_t peakMemory = 0;
+};
+
+constexpr uint16_t DEFAULT_TILE_HEIGHT = 16;
+
+/**
+ * Render the active screen in horizontal tiles and pass the rows to the writer.
+ * The LVGL lock is only held while a tile is rendered: it's released while the tile is encoded and written.
+ * This means that the UI can change between tiles. The capture fails when the active screen changes.
+ * @param[in] writer the writer to encode the image with
+ * @param[out] statistics the timing and memory of the capture
+ * @param[in] tileHeight the amount of rows to render at a time
+ * @return true when the full screen was written
+ */
+bool captureScreen(file::ImageWriter& writer, CaptureStatistics& statistics, uint16_t tileHeight = DEFAULT_TILE_HEIGHT);
+
+} // namespace
+
+#endif
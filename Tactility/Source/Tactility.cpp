@@ -5,12 +5,11 @@
 #include <Tactility/Tactility.h>
 #include <Tactility/TactilityConfig.h>
 
-#include <Tactility/app/AppManifestParsing.h>
+#include <Tactility/app/AppManifestIndex.h>
 #include <Tactility/app/AppRegistration.h>
 #include <Tactility/DispatcherThread.h>
 #include <Tactility/file/File.h>
 #include <Tactility/file/FileLock.h>
-#include <Tactility/file/PropertiesFile.h>
 #include <Tactility/hal/HalPrivate.h>
 #include <Tactility/Logger.h>
 #include <Tactility/LogMessages.h>
@@ -22,7 +21,6 @@
 #include <Tactility/service/loader/Loader.h>
 #include <Tactility/settings/TimePrivate.h>
 
-#include <map>
 #include <format>
 
 #ifdef ESP_PLATFORM
@@ -41,7 +39,9 @@ namespace service {
     // Primary
     namespace gps { extern const ServiceManifest manifest; }
     namespace wifi { extern const ServiceManifest manifest; }
+    namespace download { extern const ServiceManifest manifest; }
     namespace sdcard { extern const ServiceManifest manifest; }
+    namespace trackrecorder { extern const ServiceManifest manifest; }
 #ifdef ESP_PLATFORM
     namespace development { extern const ServiceManifest manifest; }
 #endif
@@ -179,41 +179,13 @@ static void registerInternalApps() {
     }
 }
 
-static void registerInstalledApp(std::string path) {
-    LOGGER.info("Registering app at {}", path);
-    std::string manifest_path = path + "/manifest.properties";
-    if (!file::isFile(manifest_path)) {
-        LOGGER.error("Manifest not found at {}", manifest_path);
-        return;
-    }
-
-    std::map<std::string, std::string> properties;
-    if (!file::loadPropertiesFile(manifest_path, properties)) {
-        LOGGER.error("Failed to load manifest at {}", manifest_path);
-        return;
-    }
-
-    app::AppManifest manifest;
-    if (!app::parseManifest(properties, manifest)) {
-        LOGGER.error("Failed to parse manifest at {}", manifest_path);
-        return;
-    }
-
-    manifest.appCategory = app::Category::User;
-    manifest.appLocation = app::Location::external(path);
-
-    app::addAppManifest(manifest);
-}
-
 static void registerInstalledApps(const std::string& path) {
     LOGGER.info("Registering apps from {}", path);
 
-    file::listDirectory(path, [&path](const auto& entry) {
-        auto absolute_path = std::format("{}/{}", path, entry.d_name);
-        if (file::isDirectory(absolute_path)) {
-            registerInstalledApp(absolute_path);
-        }
-    });
+    for (const auto& manifest : app::findInstalledAppManifests(path)) {
+        LOGGER.info("Registering app at {}", manifest.appLocation.getPath());
+        app::addAppManifest(manifest);
+    }
 }
 
 static void registerInstalledAppsFromSdCard(const std::shared_ptr<hal::sdcard::SdCardDevice>& sdcard) {
@@ -252,10 +224,12 @@ static void registerAndStartSecondaryServices() {
 static void registerAndStartPrimaryServices() {
     LOGGER.info("Registering and starting primary system services");
     addService(service::gps::manifest);
+    addService(service::trackrecorder::manifest);
     if (hal::hasDevice(hal::Device::Type::SdCard)) {
         addService(service::sdcard::manifest);
     }
     addService(service::wifi::manifest);
+    addService(service::download::manifest);
 #ifdef ESP_PLATFORM
     addService(service::development::manifest);
 #endif
@@ -315,6 +289,10 @@ void run(const Configuration& config) {
     // Assign early so starting services can use it
     config_instance = &config;
 
+#ifdef CONFIG_TT_LOG_BUFFERED
+    startBufferedLogging();
+#endif
+
 #ifdef ESP_PLATFORM
     initEsp();
 #endif
@@ -1,7 +1,10 @@
 #include <Tactility/app/App.h>
+#include <Tactility/app/AppInstall.h>
+#include <Tactility/app/AppManifestIndex.h>
 #include <Tactility/app/AppManifestParsing.h>
 #include <Tactility/app/AppManifest.h>
 #include <Tactility/app/AppRegistration.h>
+#include <Tactility/app/ElfAppCache.h>
 #include <Tactility/file/File.h>
 #include <Tactility/file/FileLock.h>
 #include <Tactility/file/PropertiesFile.h>
@@ -9,146 +12,105 @@
 #include <Tactility/Logger.h>
 #include <Tactility/Paths.h>
 
-#include <cerrno>
 #include <cstdio>
-#include <cstring>
+#include <cstdlib>
 #include <format>
 #include <map>
-#include <unistd.h>
-
-#include <minitar.h>
 
 namespace tt::app {
 
 static const auto LOGGER = Logger("App");
 
-static bool untarFile(minitar* mp, const minitar_entry* entry, const std::string& destinationPath) {
-    const auto absolute_path = destinationPath + "/" + entry->metadata.path;
-    if (!file::findOrCreateDirectory(destinationPath, 0777)) {
-        LOGGER.error("Can't find or create directory {}", destinationPath.c_str());
-        return false;
+constexpr size_t INSTALL_BUFFER_SIZE = 4096;
+
+void cleanupInstallDirectory(const std::string& path) {
+    if (!file::deleteRecursively(path)) {
+        LOGGER.warn("Failed to delete existing installation at {}", path);
     }
+}
 
-    // minitar_read_contents(&mp, &entry, file_buffer, entry.metadata.size);
-    if (!minitar_read_contents_to_file(mp, entry, absolute_path.c_str())) {
-        LOGGER.error("Failed to write data to {}", absolute_path.c_str());
-        return false;
+// region AppInstallStream
+
+AppInstallStream::AppInstallStream(const std::string& name) :
+    stagingPath(std::format("{}/{}", getAppInstallPath(), name)),
+    extractor(stagingPath),
+    reader(extractor)
+{}
+
+AppInstallStream::~AppInstallStream() {
+    if (started && !committed) {
+        cleanupInstallDirectory(stagingPath);
+    }
+}
+
+bool AppInstallStream::start() {
+    started = true;
+
+    if (file::isDirectory(stagingPath) && !file::deleteRecursively(stagingPath)) {
+        LOGGER.warn("Failed to delete {}", stagingPath);
     }
 
-    // Note: fchmod() doesn't exist on ESP-IDF and chmod() does nothing on that platform
-    if (chmod(absolute_path.c_str(), entry->metadata.mode) < 0) {
+    if (!file::findOrCreateDirectory(stagingPath, 0777)) {
+        LOGGER.error("Failed to create directory {}", stagingPath);
         return false;
     }
 
+    LOGGER.info("Extracting app to {}", stagingPath);
     return true;
 }
 
-static bool untarDirectory(const minitar_entry* entry, const std::string& destinationPath) {
-    auto absolute_path = destinationPath + "/" + entry->metadata.path;
-    if (!file::findOrCreateDirectory(absolute_path, 0777)) return false;
-    return true;
-}
+bool AppInstallStream::write(const uint8_t* data, size_t size) {
+    if (failed || committed) {
+        return false;
+    }
 
-static bool untar(const std::string& tarPath, const std::string& destinationPath) {
-    minitar mp;
-    if (minitar_open(tarPath.c_str(), &mp) != 0) {
-        perror(tarPath.c_str());
-        return 1;
-    }
-    bool success = true;
-    minitar_entry entry;
-
-    do {
-        if (minitar_read_entry(&mp, &entry) == 0) {
-            LOGGER.info("Extracting {}", entry.metadata.path);
-            if (entry.metadata.type == MTAR_DIRECTORY) {
-                if (!strcmp(entry.metadata.name, ".") || !strcmp(entry.metadata.name, "..") || !strcmp(entry.metadata.name, "/")) continue;
-                if (!untarDirectory(&entry, destinationPath)) {
-                    LOGGER.error("Failed to create directory {}/{}: {}", destinationPath, entry.metadata.name, strerror(errno));
-                    success = false;
-                    break;
-                }
-            } else if (entry.metadata.type == MTAR_REGULAR) {
-                if (!untarFile(&mp, &entry, destinationPath)) {
-                    LOGGER.error("Failed to extract file {}: {}", entry.metadata.path, strerror(errno));
-                    success = false;
-                    break;
-                }
-            } else if (entry.metadata.type == MTAR_SYMLINK) {
-                LOGGER.error("SYMLINK not supported");
-            } else if (entry.metadata.type == MTAR_HARDLINK) {
-                LOGGER.error("HARDLINK not supported");
-            } else if (entry.metadata.type == MTAR_FIFO) {
-                LOGGER.error("FIFO not supported");
-            } else if (entry.metadata.type == MTAR_BLKDEV) {
-                LOGGER.error("BLKDEV not supported");
-            } else if (entry.metadata.type == MTAR_CHRDEV) {
-                LOGGER.error("CHRDEV not supported");
-            } else {
-                LOGGER.error("Unknown entry type: {}", static_cast<int>(entry.metadata.type));
-                success = false;
-                break;
-            }
-        } else break;
-    } while (true);
-    minitar_close(&mp);
-    return success;
-}
+    if (!started && !start()) {
+        failed = true;
+        return false;
+    }
 
-void cleanupInstallDirectory(const std::string& path) {
-    if (!file::deleteRecursively(path)) {
-        LOGGER.warn("Failed to delete existing installation at {}", path);
+    hash.update(data, size);
+    if (!reader.write(data, size)) {
+        LOGGER.error("Failed to extract");
+        failed = true;
+        return false;
     }
+
+    return true;
 }
 
-bool install(const std::string& path) {
+bool AppInstallStream::commit(const std::string& expectedSha256) {
     // We lock and unlock frequently because SPI SD card devices share
     // the lock with the display. We don't want to lock the display for very long.
 
-    auto app_parent_path = getAppInstallPath();
-    LOGGER.info("Installing app {} to {}", path, app_parent_path);
-
-    auto filename = file::getLastPathSegment(path);
-    const std::string app_target_path = std::format("{}/{}", app_parent_path, filename);
-    if (file::isDirectory(app_target_path) && !file::deleteRecursively(app_target_path)) {
-        LOGGER.warn("Failed to delete {}", app_target_path);
-    }
-
-    if (!file::findOrCreateDirectory(app_target_path, 0777)) {
-        LOGGER.info("Failed to create directory {}", app_target_path);
+    if (!isComplete() || committed) {
+        LOGGER.error("Archive incomplete or invalid");
         return false;
     }
 
-    auto target_path_lock = file::getLock(app_parent_path)->asScopedLock();
-    auto source_path_lock = file::getLock(path)->asScopedLock();
-    target_path_lock.lock();
-    source_path_lock.lock();
-    LOGGER.info("Extracting app from {} to {}", path, app_target_path);
-    if (!untar(path, app_target_path)) {
-        LOGGER.error("Failed to extract");
+    // The hash can only be finished once, so a failed commit can't be retried
+    failed = true;
+    const auto sha256 = hash.finishHex();
+    if (!expectedSha256.empty() && expectedSha256 != sha256) {
+        LOGGER.error("Archive hash mismatch: expected {} but received {}", expectedSha256, sha256);
         return false;
     }
-    source_path_lock.unlock();
-    target_path_lock.unlock();
 
-    auto manifest_path = app_target_path + "/manifest.properties";
+    auto manifest_path = stagingPath + "/manifest.properties";
     if (!file::isFile(manifest_path)) {
         LOGGER.error("Manifest not found at {}", manifest_path);
-        cleanupInstallDirectory(app_target_path);
         return false;
     }
 
     std::map<std::string, std::string> properties;
     if (!file::loadPropertiesFile(manifest_path, properties)) {
         LOGGER.error("Failed to load manifest at {}", manifest_path);
-        cleanupInstallDirectory(app_target_path);
         return false;
     }
 
     AppManifest manifest;
     if (!parseManifest(properties, manifest)) {
         LOGGER.warn("Invalid manifest");
-        cleanupInstallDirectory(app_target_path);
         return false;
     }
 
@@ -157,32 +119,87 @@ bool install(const std::string& path) {
         stopAll(manifest.appId);
     }
 
+    const auto app_parent_path = getAppInstallPath();
     const std::string renamed_target_path = std::format("{}/{}", app_parent_path, manifest.appId);
     if (file::isDirectory(renamed_target_path)) {
         if (!file::deleteRecursively(renamed_target_path)) {
             LOGGER.warn("Failed to delete existing installation at {}", renamed_target_path);
-            cleanupInstallDirectory(app_target_path);
             return false;
         }
     }
 
+    auto target_path_lock = file::getLock(app_parent_path)->asScopedLock();
     target_path_lock.lock();
-    bool rename_success = rename(app_target_path.c_str(), renamed_target_path.c_str()) == 0;
+    bool rename_success = rename(stagingPath.c_str(), renamed_target_path.c_str()) == 0;
     target_path_lock.unlock();
 
     if (!rename_success) {
-        LOGGER.error(R"(Failed to rename "{}" to "{}")", app_target_path, manifest.appId);
-        cleanupInstallDirectory(app_target_path);
+        LOGGER.error(R"(Failed to rename "{}" to "{}")", stagingPath, manifest.appId);
         return false;
     }
 
+    committed = true;
     manifest.appLocation = Location::external(renamed_target_path);
 
+    if (!updateAppManifestIndex(app_parent_path, manifest.appId, manifest)) {
+        LOGGER.warn("Failed to update app index: it will be rebuilt at the next boot");
+    }
+
+#ifdef ESP_PLATFORM
+    invalidateCachedElfImage(manifest.appId);
+#endif
+
     addAppManifest(manifest);
 
+    LOGGER.info("Installed {} (sha256 {})", manifest.appId, sha256);
     return true;
 }
 
+// endregion
+
+bool install(const std::string& path) {
+    LOGGER.info("Installing app {} to {}", path, getAppInstallPath());
+
+    auto source_path_lock = file::getLock(path)->asScopedLock();
+    source_path_lock.lock();
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(path.c_str(), "rb"));
+    source_path_lock.unlock();
+    if (file == nullptr) {
+        LOGGER.error("Failed to open {}", path);
+        return false;
+    }
+
+    auto buffer = std::unique_ptr<uint8_t, decltype(&free)>(static_cast<uint8_t*>(malloc(INSTALL_BUFFER_SIZE)), free);
+    if (buffer == nullptr) {
+        LOGGER.error("Out of memory");
+        return false;
+    }
+
+    // The archive is read in chunks, so the source lock isn't held during the extraction
+    AppInstallStream stream(file::getLastPathSegment(path));
+    while (true) {
+        source_path_lock.lock();
+        const auto read_size = fread(buffer.get(), 1, INSTALL_BUFFER_SIZE, file.get());
+        const bool read_error = ferror(file.get()) != 0;
+        source_path_lock.unlock();
+
+        if (read_error) {
+            LOGGER.error("Failed to read {}", path);
+            return false;
+        }
+
+        if (read_size == 0 || !stream.write(buffer.get(), read_size)) {
+            break;
+        }
+    }
+
+    source_path_lock.lock();
+    file = nullptr;
+    source_path_lock.unlock();
+
+    return stream.commit();
+}
+
 bool uninstall(const std::string& appId) {
     LOGGER.info("Uninstalling app {}", appId);
 
@@ -201,6 +218,14 @@ bool uninstall(const std::string& appId) {
         return false;
     }
 
+    if (!removeFromAppManifestIndex(getAppInstallPath(), appId)) {
+        LOGGER.warn("Failed to update app index: it will be rebuilt at the next boot");
+    }
+
+#ifdef ESP_PLATFORM
+    invalidateCachedElfImage(appId);
+#endif
+
     if (!removeAppManifest(appId)) {
         LOGGER.warn("Failed to remove app {} from registry", appId);
     }
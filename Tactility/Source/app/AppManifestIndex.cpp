@@ -0,0 +1,362 @@
+#include <Tactility/app/AppManifestIndex.h>
+
+#include <Tactility/app/AppManifestParsing.h>
+#include <Tactility/file/File.h>
+#include <Tactility/file/FileLock.h>
+#include <Tactility/file/PropertiesFile.h>
+#include <Tactility/Logger.h>
+#include <Tactility/Mutex.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <map>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace tt::app {
+
+static const auto LOGGER = Logger("AppManifestIndex");
+
+constexpr uint8_t INDEX_MAGIC[4] = { 'T', 'A', 'I', 'X' };
+constexpr uint32_t INDEX_VERSION = 1;
+
+// Serializes read-modify-write operations on index files
+static Mutex indexMutex;
+
+// region Encoding
+
+static uint32_t getChecksum(const uint8_t* data, size_t size) {
+    // FNV-1a
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+class IndexWriter {
+
+    std::vector<uint8_t>& output;
+
+public:
+
+    explicit IndexWriter(std::vector<uint8_t>& output) : output(output) {}
+
+    template<typename T>
+    void write(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        // All supported targets are little endian
+        auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        output.insert(output.end(), bytes, bytes + sizeof(T));
+    }
+
+    void writeString(const std::string& value) {
+        auto length = static_cast<uint16_t>(std::min<size_t>(value.size(), UINT16_MAX));
+        write(length);
+        output.insert(output.end(), value.begin(), value.begin() + length);
+    }
+};
+
+class IndexReader {
+
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool failed = false;
+
+public:
+
+    IndexReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value {};
+        if (failed || size - offset < sizeof(T)) {
+            failed = true;
+            return value;
+        }
+        memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    std::string readString() {
+        auto length = read<uint16_t>();
+        if (failed || size - offset < length) {
+            failed = true;
+            return {};
+        }
+        std::string value(reinterpret_cast<const char*>(data + offset), length);
+        offset += length;
+        return value;
+    }
+
+    bool hasFailed() const { return failed; }
+};
+
+std::vector<uint8_t> encodeAppManifestIndex(const std::vector<AppManifestIndexEntry>& entries) {
+    std::vector<uint8_t> output;
+    IndexWriter writer(output);
+    for (auto byte : INDEX_MAGIC) {
+        writer.write(byte);
+    }
+    writer.write(INDEX_VERSION);
+    writer.write(static_cast<uint32_t>(entries.size()));
+    for (const auto& entry : entries) {
+        writer.writeString(entry.directoryName);
+        writer.write(entry.manifestModifiedTime);
+        writer.write(entry.manifestSize);
+        writer.writeString(entry.manifest.targetSdk);
+        writer.writeString(entry.manifest.targetPlatforms);
+        writer.writeString(entry.manifest.appId);
+        writer.writeString(entry.manifest.appName);
+        writer.writeString(entry.manifest.appIcon);
+        writer.writeString(entry.manifest.appVersionName);
+        writer.write(entry.manifest.appVersionCode);
+        writer.write(entry.manifest.appFlags);
+    }
+    writer.write(getChecksum(output.data(), output.size()));
+    return output;
+}
+
+bool decodeAppManifestIndex(const uint8_t* data, size_t size, std::vector<AppManifestIndexEntry>& entries) {
+    constexpr size_t header_size = sizeof(INDEX_MAGIC) + sizeof(uint32_t) * 2;
+    if (size < header_size + sizeof(uint32_t) || memcmp(data, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) {
+        return false;
+    }
+
+    uint32_t checksum;
+    memcpy(&checksum, data + size - sizeof(uint32_t), sizeof(uint32_t));
+    if (checksum != getChecksum(data, size - sizeof(uint32_t))) {
+        return false;
+    }
+
+    IndexReader reader(data + sizeof(INDEX_MAGIC), size - sizeof(INDEX_MAGIC) - sizeof(uint32_t));
+    if (reader.read<uint32_t>() != INDEX_VERSION) {
+        return false;
+    }
+
+    auto count = reader.read<uint32_t>();
+    std::vector<AppManifestIndexEntry> result;
+    for (uint32_t i = 0; i < count && !reader.hasFailed(); ++i) {
+        AppManifestIndexEntry entry;
+        entry.directoryName = reader.readString();
+        entry.manifestModifiedTime = reader.read<int64_t>();
+        entry.manifestSize = reader.read<int64_t>();
+        entry.manifest.targetSdk = reader.readString();
+        entry.manifest.targetPlatforms = reader.readString();
+        entry.manifest.appId = reader.readString();
+        entry.manifest.appName = reader.readString();
+        entry.manifest.appIcon = reader.readString();
+        entry.manifest.appVersionName = reader.readString();
+        entry.manifest.appVersionCode = reader.read<uint64_t>();
+        entry.manifest.appFlags = reader.read<uint16_t>();
+        entry.manifest.appCategory = Category::User;
+        result.push_back(std::move(entry));
+    }
+
+    if (reader.hasFailed()) {
+        return false;
+    }
+
+    entries = std::move(result);
+    return true;
+}
+
+// endregion
+
+// region Files
+
+static std::string getIndexPath(const std::string& appsPath) {
+    return std::format("{}/{}", appsPath, APP_MANIFEST_INDEX_FILE_NAME);
+}
+
+static bool loadIndex(const std::string& appsPath, std::vector<AppManifestIndexEntry>& entries) {
+    const auto index_path = getIndexPath(appsPath);
+    std::unique_ptr<uint8_t[]> data;
+    size_t size = 0;
+    file::getLock(index_path)->withLock([&index_path, &data, &size] {
+        if (access(index_path.c_str(), F_OK) == 0) {
+            data = file::readBinary(index_path, size);
+        }
+    });
+
+    if (data == nullptr) {
+        return false;
+    }
+
+    if (!decodeAppManifestIndex(data.get(), size, entries)) {
+        LOGGER.warn("Ignoring invalid index {}", index_path);
+        return false;
+    }
+
+    return true;
+}
+
+static bool saveIndex(const std::string& appsPath, const std::vector<AppManifestIndexEntry>& entries) {
+    const auto index_path = getIndexPath(appsPath);
+    const auto data = encodeAppManifestIndex(entries);
+    bool result = false;
+    file::getLock(index_path)->withLock([&index_path, &data, &result] {
+        FILE* file = fopen(index_path.c_str(), "wb");
+        if (file == nullptr) {
+            return;
+        }
+        result = fwrite(data.data(), 1, data.size(), file) == data.size();
+        fclose(file);
+    });
+
+    if (!result) {
+        LOGGER.error("Failed to write {}", index_path);
+    }
+
+    return result;
+}
+
+static bool getManifestFileStat(const std::string& manifestPath, int64_t& modifiedTime, int64_t& size) {
+    struct stat stat_result;
+    bool found = false;
+    file::getLock(manifestPath)->withLock([&manifestPath, &stat_result, &found] {
+        found = stat(manifestPath.c_str(), &stat_result) == 0 && S_ISREG(stat_result.st_mode);
+    });
+
+    if (found) {
+        modifiedTime = static_cast<int64_t>(stat_result.st_mtime);
+        size = static_cast<int64_t>(stat_result.st_size);
+    }
+
+    return found;
+}
+
+static bool parseManifestFile(const std::string& manifestPath, AppManifest& manifest) {
+    std::map<std::string, std::string> properties;
+    if (!file::loadPropertiesFile(manifestPath, properties)) {
+        LOGGER.error("Failed to load manifest at {}", manifestPath);
+        return false;
+    }
+
+    if (!parseManifest(properties, manifest)) {
+        LOGGER.error("Failed to parse manifest at {}", manifestPath);
+        return false;
+    }
+
+    manifest.appCategory = Category::User;
+    return true;
+}
+
+// endregion
+
+std::vector<AppManifest> findInstalledAppManifests(const std::string& appsPath) {
+    auto lock = indexMutex.asScopedLock();
+    lock.lock();
+
+    std::vector<AppManifestIndexEntry> indexed_entries;
+    const bool has_index = loadIndex(appsPath, indexed_entries);
+    if (!has_index) {
+        LOGGER.info("No index for {}: parsing all manifests", appsPath);
+    }
+
+    std::map<std::string, const AppManifestIndexEntry*> indexed_by_directory;
+    for (const auto& entry : indexed_entries) {
+        indexed_by_directory[entry.directoryName] = &entry;
+    }
+
+    std::vector<std::string> directory_names;
+    file::listDirectory(appsPath, [&directory_names](const auto& entry) {
+        if (entry.d_name[0] != '.' && (entry.d_type == file::TT_DT_DIR || entry.d_type == file::TT_DT_UNKNOWN)) {
+            directory_names.emplace_back(entry.d_name);
+        }
+    });
+
+    std::vector<AppManifestIndexEntry> entries;
+    entries.reserve(directory_names.size());
+    size_t parsed_count = 0;
+    for (const auto& directory_name : directory_names) {
+        const auto manifest_path = std::format("{}/{}/manifest.properties", appsPath, directory_name);
+        AppManifestIndexEntry entry;
+        entry.directoryName = directory_name;
+        if (!getManifestFileStat(manifest_path, entry.manifestModifiedTime, entry.manifestSize)) {
+            LOGGER.error("Manifest not found at {}", manifest_path);
+            continue;
+        }
+
+        auto indexed = indexed_by_directory.find(directory_name);
+        if (
+            indexed != indexed_by_directory.end() &&
+            indexed->second->manifestModifiedTime == entry.manifestModifiedTime &&
+            indexed->second->manifestSize == entry.manifestSize
+        ) {
+            entry.manifest = indexed->second->manifest;
+        } else if (parseManifestFile(manifest_path, entry.manifest)) {
+            parsed_count++;
+        } else {
+            continue;
+        }
+
+        entries.push_back(std::move(entry));
+    }
+
+    // Only write when there was no index or when apps were changed, added or removed
+    if (!has_index || parsed_count > 0 || entries.size() != indexed_entries.size()) {
+        LOGGER.info("Updating index of {} ({} manifests parsed)", appsPath, parsed_count);
+        saveIndex(appsPath, entries);
+    }
+
+    lock.unlock();
+
+    std::vector<AppManifest> manifests;
+    manifests.reserve(entries.size());
+    for (auto& entry : entries) {
+        entry.manifest.appLocation = Location::external(std::format("{}/{}", appsPath, entry.directoryName));
+        manifests.push_back(std::move(entry.manifest));
+    }
+    return manifests;
+}
+
+bool updateAppManifestIndex(const std::string& appsPath, const std::string& directoryName, const AppManifest& manifest) {
+    const auto manifest_path = std::format("{}/{}/manifest.properties", appsPath, directoryName);
+    AppManifestIndexEntry new_entry;
+    new_entry.directoryName = directoryName;
+    new_entry.manifest = manifest;
+    new_entry.manifest.appLocation = Location::internal();
+    if (!getManifestFileStat(manifest_path, new_entry.manifestModifiedTime, new_entry.manifestSize)) {
+        LOGGER.error("Manifest not found at {}", manifest_path);
+        return false;
+    }
+
+    auto lock = indexMutex.asScopedLock();
+    lock.lock();
+
+    std::vector<AppManifestIndexEntry> entries;
+    // A missing or invalid index is rebuilt at the next boot, so we only add to a valid one
+    if (!loadIndex(appsPath, entries)) {
+        return false;
+    }
+
+    std::erase_if(entries, [&directoryName](const auto& entry) { return entry.directoryName == directoryName; });
+    entries.push_back(std::move(new_entry));
+    return saveIndex(appsPath, entries);
+}
+
+bool removeFromAppManifestIndex(const std::string& appsPath, const std::string& directoryName) {
+    auto lock = indexMutex.asScopedLock();
+    lock.lock();
+
+    std::vector<AppManifestIndexEntry> entries;
+    if (!loadIndex(appsPath, entries)) {
+        return false;
+    }
+
+    if (std::erase_if(entries, [&directoryName](const auto& entry) { return entry.directoryName == directoryName; }) == 0) {
+        return true;
+    }
+
+    return saveIndex(appsPath, entries);
+}
+
+}
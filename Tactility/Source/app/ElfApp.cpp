@@ -2,13 +2,16 @@
 
 #include <Tactility/app/alertdialog/AlertDialog.h>
 #include <Tactility/app/ElfApp.h>
+#include <Tactility/app/ElfAppCache.h>
 #include <Tactility/file/File.h>
 #include <Tactility/file/FileLock.h>
+#include <Tactility/kernel/Kernel.h>
 #include <Tactility/Logger.h>
 #include <Tactility/service/loader/Loader.h>
 #include <Tactility/StringUtils.h>
 
 #include <esp_elf.h>
+#include <cstdio>
 #include <string>
 #include <utility>
 
@@ -24,11 +27,57 @@ static std::string getErrorCodeString(int error_code) {
             return "missing symbol";
         case EINVAL:
             return "invalid argument or main() missing";
+        case EIO:
+            return "failed to read file";
         default:
             return std::format("code {}", error_code);
     }
 }
 
+/**
+ * Streams ELF data from a file.
+ * The file lock is only held while reading, so other devices on the same bus aren't blocked during relocation.
+ */
+class ElfFileReader final {
+
+    FILE* file;
+    std::shared_ptr<Lock> lock;
+    long position = 0;
+    int64_t readMicros = 0;
+
+    static int read(void* context, size_t offset, void* buffer, size_t size) {
+        auto* reader = static_cast<ElfFileReader*>(context);
+        const auto start_time = kernel::getMicrosSinceBoot();
+        bool success = false;
+        reader->lock->withLock([reader, offset, buffer, size, &success] {
+            if (reader->position != static_cast<long>(offset)) {
+                if (fseek(reader->file, static_cast<long>(offset), SEEK_SET) != 0) {
+                    reader->position = -1;
+                    return;
+                }
+            }
+            success = fread(buffer, 1, size, reader->file) == size;
+            reader->position = success ? static_cast<long>(offset + size) : -1;
+        });
+        reader->readMicros += kernel::getMicrosSinceBoot() - start_time;
+        return success ? 0 : -EIO;
+    }
+
+public:
+
+    ElfFileReader(FILE* file, std::shared_ptr<Lock> lock) : file(file), lock(std::move(lock)) {}
+
+    esp_elf_reader_t getReader() {
+        return {
+            .read = read,
+            .context = this
+        };
+    }
+
+    /** @return the total time spent in reading */
+    int64_t getReadMicros() const { return readMicros; }
+};
+
 class ElfApp final : public App {
 
 public:
@@ -54,81 +103,99 @@ private:
     static size_t staticParametersSetCount;
     static std::shared_ptr<Lock> staticParametersLock;
 
+    const std::string appId;
     const std::string appPath;
-    std::unique_ptr<uint8_t[]> elfFileData;
-    esp_elf_t elf {
-        .psegment = nullptr,
-        .svaddr = 0,
-        .ptext = nullptr,
-        .pdata = nullptr,
-        .sec = { },
-        .entry = nullptr
-    };
-    bool shouldCleanupElf = false; // Whether we have to clean up the above "elf" object
+    std::unique_ptr<ElfImage> image;
     std::unique_ptr<Parameters> manifest;
     void* data = nullptr;
     std::string lastError = "";
 
-    bool startElf() {
-        const std::string elf_path = std::format("{}/elf/{}.elf", appPath, CONFIG_IDF_TARGET);
-        LOGGER.info("Starting ELF {}", elf_path);
-        assert(elfFileData == nullptr);
-
-        size_t size = 0;
-        file::getLock(elf_path)->withLock([this, &elf_path, &size]{
-            elfFileData = file::readBinary(elf_path, size);
+    bool loadElf(const std::string& elfPath, const std::shared_ptr<Lock>& lock, uint32_t fingerprint, int64_t& readMicros) {
+        const auto start_time = kernel::getMicrosSinceBoot();
+        FILE* file = nullptr;
+        lock->withLock([&elfPath, &file] {
+            file = fopen(elfPath.c_str(), "rb");
         });
+        const auto open_micros = kernel::getMicrosSinceBoot() - start_time;
 
-        if (elfFileData == nullptr) {
+        if (file == nullptr) {
+            lastError = "Failed to open file";
+            LOGGER.error("{}: {}", lastError, elfPath);
             return false;
         }
 
-        if (esp_elf_init(&elf) != ESP_OK) {
-            lastError = "Failed to initialize";
-            LOGGER.error("{}", lastError);
-            elfFileData  = nullptr;
-            return false;
-        }
+        // Sections are streamed into their final memory, so the file is never fully in RAM
+        auto new_image = std::make_unique<ElfImage>(fingerprint);
+        ElfFileReader file_reader(file, lock);
+        auto reader = file_reader.getReader();
+        auto relocate_result = new_image->relocate(reader);
+        lock->withLock([file] { fclose(file); });
+        readMicros = open_micros + file_reader.getReadMicros();
 
-        auto relocate_result = esp_elf_relocate(&elf, elfFileData.get());
         if (relocate_result != 0) {
             // Note: the result code maps to values from cstdlib's errno.h
             lastError = getErrorCodeString(-relocate_result);
             LOGGER.error("Application failed to load: {}", lastError);
-            elfFileData  = nullptr;
             return false;
         }
 
-        int argc = 0;
-        char* argv[] = {};
+        if (isElfImageCacheEnabled() && !new_image->takeDataSnapshot()) {
+            LOGGER.warn("Failed to take data snapshot: app won't be cached");
+        }
+
+        image = std::move(new_image);
+        return true;
+    }
+
+    bool startElf() {
+        const std::string elf_path = std::format("{}/elf/{}.elf", appPath, CONFIG_IDF_TARGET);
+        LOGGER.info("Starting ELF {}", elf_path);
 
-        if (esp_elf_request(&elf, 0, argc, argv) != ESP_OK) {
+        const auto start_time = kernel::getMicrosSinceBoot();
+        auto lock = file::getLock(elf_path);
+        uint32_t fingerprint = 0;
+        if (isElfImageCacheEnabled()) {
+            bool has_fingerprint = false;
+            lock->withLock([&elf_path, &fingerprint, &has_fingerprint] {
+                has_fingerprint = getElfFingerprint(elf_path, fingerprint);
+            });
+            if (has_fingerprint) {
+                image = takeCachedElfImage(appId, fingerprint);
+            }
+        }
+
+        int64_t read_micros = 0;
+        const bool is_cached = (image != nullptr && image->restoreDataSnapshot());
+        if (!is_cached) {
+            image = nullptr;
+            if (!loadElf(elf_path, lock, fingerprint, read_micros)) {
+                return false;
+            }
+        }
+        const auto relocated_time = kernel::getMicrosSinceBoot();
+
+        if (!image->request()) {
             lastError = "Executable returned error code";
             LOGGER.error("{}", lastError);
-            esp_elf_deinit(&elf);
-            elfFileData  = nullptr;
+            image = nullptr;
             return false;
         }
 
-        shouldCleanupElf = true;
+        const auto relocate_micros = relocated_time - start_time - read_micros;
+        const auto init_micros = kernel::getMicrosSinceBoot() - relocated_time;
+        LOGGER.info("Launch timing ({}): read {} us, relocate {} us, init {} us", is_cached ? "cached" : "loaded", read_micros, relocate_micros, init_micros);
+
         return true;
     }
 
     void stopElf() {
         LOGGER.info("Cleaning up ELF");
-
-        if (shouldCleanupElf) {
-            esp_elf_deinit(&elf);
-        }
-
-        if (elfFileData != nullptr) {
-            elfFileData = nullptr;
-        }
+        releaseElfImage(appId, std::move(image));
     }
 
 public:
 
-    explicit ElfApp(std::string appPath) : appPath(std::move(appPath)) {}
+    ElfApp(std::string appId, std::string appPath) : appId(std::move(appId)), appPath(std::move(appPath)) {}
 
     void onCreate(AppContext& appContext) override {
         // Because we use global variables, we have to ensure that we are not starting 2 apps in parallel
@@ -225,7 +292,7 @@ std::shared_ptr<App> createElfApp(const std::shared_ptr<AppManifest>& manifest)
     LOGGER.info("createElfApp");
     assert(manifest != nullptr);
     assert(manifest->appLocation.isExternal());
-    return std::make_shared<ElfApp>(manifest->appLocation.getPath());
+    return std::make_shared<ElfApp>(manifest->appId, manifest->appLocation.getPath());
 }
 
 } // namespace
@@ -0,0 +1,203 @@
+#ifdef ESP_PLATFORM
+
+#include <Tactility/app/ElfAppCache.h>
+
+#include <Tactility/Logger.h>
+#include <Tactility/Mutex.h>
+
+#include <cstring>
+#include <list>
+#include <sys/stat.h>
+
+namespace tt::app {
+
+static const auto LOGGER = Logger("ElfAppCache");
+
+constexpr size_t CACHE_SIZE = CONFIG_TT_ELF_APP_CACHE_SIZE * 1024U;
+
+struct CacheEntry {
+    std::string appId;
+    std::unique_ptr<ElfImage> image;
+    size_t size;
+};
+
+static Mutex cacheMutex;
+// Most recently used entries are at the front
+static std::list<CacheEntry> cacheEntries;
+static size_t cacheUsed = 0;
+
+// region ElfImage
+
+ElfImage::~ElfImage() {
+    if (relocated) {
+        esp_elf_deinit(&elf);
+    }
+}
+
+int ElfImage::relocate(const esp_elf_reader_t& reader) {
+    assert(!relocated);
+    if (esp_elf_init(&elf) != ESP_OK) {
+        return -EINVAL;
+    }
+
+    auto result = esp_elf_relocate_stream(&elf, &reader);
+    relocated = (result == 0);
+    return result;
+}
+
+bool ElfImage::request() {
+    assert(relocated);
+    int argc = 0;
+    char* argv[] = {};
+    return esp_elf_request(&elf, 0, argc, argv) == ESP_OK;
+}
+
+bool ElfImage::takeDataSnapshot() {
+    uint8_t* data;
+    size_t size;
+    if (esp_elf_get_data(&elf, &data, &size) != ESP_OK) {
+        return false;
+    }
+
+    dataSnapshot = std::make_unique<uint8_t[]>(size);
+    if (dataSnapshot == nullptr) {
+        return false;
+    }
+
+    memcpy(dataSnapshot.get(), data, size);
+    dataSnapshotSize = size;
+    return true;
+}
+
+bool ElfImage::restoreDataSnapshot() {
+    uint8_t* data;
+    size_t size;
+    if (dataSnapshot == nullptr || esp_elf_get_data(&elf, &data, &size) != ESP_OK || size != dataSnapshotSize) {
+        return false;
+    }
+
+    memcpy(data, dataSnapshot.get(), size);
+    return true;
+}
+
+size_t ElfImage::getMemorySize() {
+    return esp_elf_get_memory_size(&elf) + dataSnapshotSize;
+}
+
+// endregion
+
+// region Cache
+
+bool isElfImageCacheEnabled() {
+    return CACHE_SIZE > 0U;
+}
+
+bool getElfFingerprint(const std::string& elfPath, uint32_t& fingerprint) {
+    struct stat file_stat;
+    if (stat(elfPath.c_str(), &file_stat) != 0) {
+        return false;
+    }
+
+    // FNV-1a
+    uint32_t hash = 2166136261U;
+    auto add = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= static_cast<uint8_t>(value >> (i * 8));
+            hash *= 16777619U;
+        }
+    };
+    add(static_cast<uint64_t>(file_stat.st_size));
+    add(static_cast<uint64_t>(file_stat.st_mtime));
+    fingerprint = hash;
+    return true;
+}
+
+std::unique_ptr<ElfImage> takeCachedElfImage(const std::string& appId, uint32_t fingerprint) {
+    if (!isElfImageCacheEnabled()) {
+        return nullptr;
+    }
+
+    auto lock = cacheMutex.asScopedLock();
+    lock.lock();
+
+    for (auto it = cacheEntries.begin(); it != cacheEntries.end(); ++it) {
+        if (it->appId == appId) {
+            auto image = std::move(it->image);
+            cacheUsed -= it->size;
+            cacheEntries.erase(it);
+            if (image->getFingerprint() != fingerprint) {
+                LOGGER.info("Discarding outdated image of {}", appId);
+                return nullptr;
+            }
+            return image;
+        }
+    }
+
+    return nullptr;
+}
+
+void releaseElfImage(const std::string& appId, std::unique_ptr<ElfImage> image) {
+    if (!isElfImageCacheEnabled() || image == nullptr || !image->hasDataSnapshot()) {
+        return;
+    }
+
+    const auto size = image->getMemorySize();
+    if (size > CACHE_SIZE) {
+        LOGGER.info("Not caching {}: {} bytes exceeds the cache size", appId, size);
+        return;
+    }
+
+    // Freeing images might take a while, so we do it after unlocking
+    std::list<CacheEntry> evicted;
+
+    auto lock = cacheMutex.asScopedLock();
+    lock.lock();
+
+    // Replace the image from an earlier instance of the same app
+    for (auto it = cacheEntries.begin(); it != cacheEntries.end(); ++it) {
+        if (it->appId == appId) {
+            cacheUsed -= it->size;
+            evicted.splice(evicted.end(), cacheEntries, it);
+            break;
+        }
+    }
+
+    while (cacheUsed + size > CACHE_SIZE && !cacheEntries.empty()) {
+        LOGGER.info("Evicting {}", cacheEntries.back().appId);
+        cacheUsed -= cacheEntries.back().size;
+        evicted.splice(evicted.end(), cacheEntries, std::prev(cacheEntries.end()));
+    }
+
+    cacheEntries.push_front({
+        .appId = appId,
+        .image = std::move(image),
+        .size = size
+    });
+    cacheUsed += size;
+    LOGGER.info("Cached {} ({} bytes, {}/{} used)", appId, size, cacheUsed, CACHE_SIZE);
+
+    lock.unlock();
+}
+
+void invalidateCachedElfImage(const std::string& appId) {
+    std::list<CacheEntry> removed;
+
+    auto lock = cacheMutex.asScopedLock();
+    lock.lock();
+
+    for (auto it = cacheEntries.begin(); it != cacheEntries.end(); ++it) {
+        if (it->appId == appId) {
+            cacheUsed -= it->size;
+            removed.splice(removed.end(), cacheEntries, it);
+            break;
+        }
+    }
+
+    lock.unlock();
+}
+
+// endregion
+
+}
+
+#endif // ESP_PLATFORM
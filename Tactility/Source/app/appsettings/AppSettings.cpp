@@ -1,6 +1,7 @@
 #include <Tactility/app/appdetails/AppDetails.h>
 #include <Tactility/app/AppRegistration.h>
 #include <Tactility/service/loader/Loader.h>
+#include <Tactility/lvgl/ImageCache.h>
 #include <Tactility/lvgl/Toolbar.h>
 
 #include <Tactility/Assets.h>
@@ -17,8 +18,12 @@ class AppSettingsApp final : public App {
         appdetails::start(manifest->appId);
     }
 
-    static void createAppWidget(const std::shared_ptr<AppManifest>& manifest, lv_obj_t* list) {
-        const void* icon = !manifest->appIcon.empty() ? manifest->appIcon.c_str() : TT_ASSETS_APP_ICON_FALLBACK;
+    // Keeps the icons alive while they are shown
+    std::vector<lvgl::CachedImage> icons;
+
+    void createAppWidget(const std::shared_ptr<AppManifest>& manifest, lv_obj_t* list) {
+        const char* icon_source = !manifest->appIcon.empty() ? manifest->appIcon.c_str() : TT_ASSETS_APP_ICON_FALLBACK;
+        const void* icon = lvgl::getCachedImageSource(icon_source, icons);
         lv_obj_t* btn = lv_list_add_button(list, icon, manifest->appName.c_str());
         lv_obj_add_event_cb(btn, &onAppPressed, LV_EVENT_SHORT_CLICKED, manifest.get());
     }
@@ -29,6 +34,8 @@ public:
         auto* toolbar = lvgl::toolbar_create(parent, "External Apps");
         lv_obj_align(toolbar, LV_ALIGN_TOP_MID, 0, 0);
 
+        icons.clear();
+
         lv_obj_t* list = lv_list_create(parent);
         lv_obj_set_width(list, LV_PCT(100));
         lv_obj_align_to(list, toolbar, LV_ALIGN_OUT_BOTTOM_MID, 0, 0);
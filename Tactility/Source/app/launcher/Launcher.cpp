@@ -4,6 +4,7 @@
 #include <Tactility/app/AppPaths.h>
 #include <Tactility/app/AppRegistration.h>
 #include <Tactility/hal/power/PowerDevice.h>
+#include <Tactility/lvgl/ImageCache.h>
 #include <Tactility/lvgl/Lvgl.h>
 #include <Tactility/service/loader/Loader.h>
 #include <Tactility/settings/BootSettings.h>
@@ -24,7 +25,10 @@ static int getButtonSize(hal::UiScale scale) {
 
 class LauncherApp final : public App {
 
-    static lv_obj_t* createAppButton(lv_obj_t* parent, hal::UiScale uiScale, const char* imageFile, const char* appId, int32_t itemMargin, bool isLandscape) {
+    // Keeps the button images alive while they are shown
+    std::vector<lvgl::CachedImage> buttonImages;
+
+    lv_obj_t* createAppButton(lv_obj_t* parent, hal::UiScale uiScale, const char* imageFile, const char* appId, int32_t itemMargin, bool isLandscape) {
         auto button_size = getButtonSize(uiScale);
 
         auto* apps_button = lv_button_create(parent);
@@ -40,7 +44,7 @@ class LauncherApp final : public App {
 
         // create the image first
         auto* button_image = lv_image_create(apps_button);
-        lv_image_set_src(button_image, imageFile);
+        lv_image_set_src(button_image, lvgl::getCachedImageSource(imageFile, buttonImages));
 
         // Recolor handling:
         // For color builds use theme primary color
@@ -136,6 +140,7 @@ public:
             margin = std::min<int32_t>(available_height / 16, button_size);
         }
 
+        buttonImages.clear();
         const auto paths = app.getPaths();
         const auto apps_icon_path = lvgl::PATH_PREFIX + paths->getAssetsPath("icon_apps.png");
         const auto files_icon_path = lvgl::PATH_PREFIX + paths->getAssetsPath("icon_files.png");
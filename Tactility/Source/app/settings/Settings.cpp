@@ -1,4 +1,5 @@
 #include <Tactility/app/AppRegistration.h>
+#include <Tactility/lvgl/ImageCache.h>
 #include <Tactility/lvgl/Toolbar.h>
 #include <Tactility/service/loader/Loader.h>
 
@@ -15,17 +16,23 @@ static void onAppPressed(lv_event_t* e) {
     start(manifest->appId);
 }
 
-static void createWidget(const std::shared_ptr<AppManifest>& manifest, void* parent) {
+static void createWidget(const std::shared_ptr<AppManifest>& manifest, void* parent, std::vector<lvgl::CachedImage>& icons) {
     tt_check(parent);
     auto* list = (lv_obj_t*)parent;
-    const void* icon = !manifest->appIcon.empty() ? manifest->appIcon.c_str() : TT_ASSETS_APP_ICON_FALLBACK;
+    const char* icon_source = !manifest->appIcon.empty() ? manifest->appIcon.c_str() : TT_ASSETS_APP_ICON_FALLBACK;
+    const void* icon = lvgl::getCachedImageSource(icon_source, icons);
     auto* btn = lv_list_add_button(list, icon, manifest->appName.c_str());
     lv_obj_add_event_cb(btn, &onAppPressed, LV_EVENT_SHORT_CLICKED, (void*)manifest.get());
 }
 
 class SettingsApp final : public App {
 
+    // Keeps the icons alive while they are shown
+    std::vector<lvgl::CachedImage> icons;
+
     void onShow(AppContext& app, lv_obj_t* parent) override {
+        icons.clear();
+
         lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_COLUMN);
         lv_obj_set_style_pad_row(parent, 0, LV_STATE_DEFAULT);
 
@@ -39,7 +46,7 @@ class SettingsApp final : public App {
         std::ranges::sort(manifests, SortAppManifestByName);
         for (const auto& manifest: manifests) {
             if (manifest->appCategory == Category::Settings) {
-                createWidget(manifest, list);
+                createWidget(manifest, list, icons);
             }
         }
     }
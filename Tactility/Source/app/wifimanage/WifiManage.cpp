@@ -132,9 +132,11 @@ void WifiManage::onShow(AppContext& app, lv_obj_t* parent) {
 }
 
 void WifiManage::onHide(TT_UNUSED AppContext& app) {
-    lock();
+    // Don't hold the lock: unsubscribe() waits for a running onWifiEvent(), which locks it
     service::wifi::getPubsub()->unsubscribe(wifiSubscription);
     wifiSubscription = nullptr;
+
+    lock();
     isViewEnabled = false;
     unlock();
 }
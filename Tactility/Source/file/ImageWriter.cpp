@@ -0,0 +1,348 @@
+#include <Tactility/file/ImageWriter.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace tt::file {
+
+// region Colour conversion
+
+void convertBgr888ToRgb888(const uint8_t* source, uint8_t* destination, size_t pixelCount) {
+    size_t i = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        // 4 pixels are 3 words: [B0 G0 R0 B1] [G1 R1 B2 G2] [R2 B3 G3 R3] (first byte is the least significant)
+        // All 3 words are read before they are written, so this also works in place.
+        for (; i + 4 <= pixelCount; i += 4) {
+            uint32_t w0, w1, w2;
+            memcpy(&w0, source, 4);
+            memcpy(&w1, source + 4, 4);
+            memcpy(&w2, source + 8, 4);
+            const uint32_t o0 = ((w0 >> 16) & 0xFFU) | (w0 & 0xFF00U) | ((w0 & 0xFFU) << 16) | ((w1 & 0xFF00U) << 16);
+            const uint32_t o1 = (w1 & 0xFFU) | ((w0 >> 16) & 0xFF00U) | ((w2 & 0xFFU) << 16) | (w1 & 0xFF000000U);
+            const uint32_t o2 = ((w1 >> 16) & 0xFFU) | ((w2 >> 16) & 0xFF00U) | (w2 & 0xFF0000U) | ((w2 & 0xFF00U) << 16);
+            memcpy(destination, &o0, 4);
+            memcpy(destination + 4, &o1, 4);
+            memcpy(destination + 8, &o2, 4);
+            source += 12;
+            destination += 12;
+        }
+    }
+
+    for (; i < pixelCount; ++i) {
+        const uint8_t blue = source[0];
+        destination[1] = source[1];
+        destination[0] = source[2];
+        destination[2] = blue;
+        source += 3;
+        destination += 3;
+    }
+}
+
+// endregion
+
+// region ImageWriter
+
+bool ImageWriter::writeOutput(const uint8_t* data, size_t size) {
+    if (!failed && size > 0 && !output(data, size)) {
+        failed = true;
+    }
+    return !failed;
+}
+
+bool ImageWriter::flushBuffer() {
+    if (!buffer.empty()) {
+        onFlushBuffer(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    return !failed;
+}
+
+bool ImageWriter::begin(uint16_t newWidth, uint16_t newHeight) {
+    width = newWidth;
+    height = newHeight;
+    rowsWritten = 0;
+    failed = false;
+    buffer.clear();
+    return onBegin() && !failed;
+}
+
+bool ImageWriter::writeRow(const uint8_t* row) {
+    if (failed || rowsWritten >= height) {
+        return false;
+    }
+    onWriteRow(row);
+    rowsWritten++;
+    return !failed;
+}
+
+bool ImageWriter::finish() {
+    if (failed || rowsWritten != height) {
+        return false;
+    }
+    return onFinish() && flushBuffer();
+}
+
+// endregion
+
+// region PngWriter
+
+static void putUint32(uint8_t* destination, uint32_t value) {
+    destination[0] = value >> 24;
+    destination[1] = value >> 16;
+    destination[2] = value >> 8;
+    destination[3] = value;
+}
+
+static uint32_t updateCrc(uint32_t crc, const uint8_t* data, size_t size) {
+    static constexpr uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return crc;
+}
+
+// Deflate length codes 257 to 285
+static constexpr uint16_t LENGTH_BASES[] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static constexpr uint8_t LENGTH_EXTRA_BITS[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static constexpr uint16_t MIN_RUN_LENGTH = 3;
+static constexpr uint16_t MAX_RUN_LENGTH = 258;
+
+bool PngWriter::writeChunk(const char* type, const uint8_t* data, size_t size) {
+    uint8_t header[8];
+    putUint32(header, size);
+    memcpy(header + 4, type, 4);
+    uint8_t footer[4];
+    uint32_t crc = updateCrc(0xFFFFFFFF, header + 4, 4);
+    crc = updateCrc(crc, data, size);
+    putUint32(footer, ~crc);
+    return writeOutput(header, sizeof(header)) && writeOutput(data, size) && writeOutput(footer, sizeof(footer));
+}
+
+bool PngWriter::onFlushBuffer(const uint8_t* data, size_t size) {
+    return writeChunk("IDAT", data, size);
+}
+
+void PngWriter::writeBits(uint32_t bits, uint8_t count) {
+    bitBuffer |= bits << bitCount;
+    bitCount += count;
+    while (bitCount >= 8) {
+        put(static_cast<uint8_t>(bitBuffer));
+        bitBuffer >>= 8;
+        bitCount -= 8;
+    }
+}
+
+void PngWriter::writeHuffmanCode(uint32_t code, uint8_t length) {
+    // Huffman codes are stored starting with their most significant bit
+    uint32_t reversed = 0;
+    for (uint8_t i = 0; i < length; ++i) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    writeBits(reversed, length);
+}
+
+void PngWriter::writeLiteral(uint8_t value) {
+    if (value < 144) {
+        writeHuffmanCode(0x30 + value, 8);
+    } else {
+        writeHuffmanCode(0x190 + (value - 144), 9);
+    }
+}
+
+void PngWriter::writeRun(uint16_t length) {
+    uint8_t code_index = 0;
+    while (code_index + 1 < std::size(LENGTH_BASES) && LENGTH_BASES[code_index + 1] <= length) {
+        code_index++;
+    }
+    const uint16_t symbol = 257 + code_index;
+    if (symbol < 280) {
+        writeHuffmanCode(symbol - 256, 7);
+    } else {
+        writeHuffmanCode(0xC0 + (symbol - 280), 8);
+    }
+    writeBits(length - LENGTH_BASES[code_index], LENGTH_EXTRA_BITS[code_index]);
+    // Distance code 0 (distance 1: repeat the last byte) with 5 bits
+    writeBits(0, 5);
+}
+
+void PngWriter::flushRun() {
+    while (runLength >= MIN_RUN_LENGTH) {
+        auto length = std::min(runLength, MAX_RUN_LENGTH);
+        // Don't leave a remainder that is too short for a run when it can be avoided
+        if (runLength > MAX_RUN_LENGTH && runLength - MAX_RUN_LENGTH < MIN_RUN_LENGTH) {
+            length = runLength - MIN_RUN_LENGTH;
+        }
+        writeRun(length);
+        runLength -= length;
+    }
+    for (; runLength > 0; --runLength) {
+        writeLiteral(lastByte);
+    }
+}
+
+void PngWriter::compress(uint8_t value) {
+    // Adler-32 of the uncompressed data
+    const uint32_t a = (adler & 0xFFFF) + value;
+    const uint32_t s1 = a >= 65521 ? a - 65521 : a;
+    const uint32_t b = (adler >> 16) + s1;
+    const uint32_t s2 = b >= 65521 ? b - 65521 : b;
+    adler = (s2 << 16) | s1;
+
+    if (hasLastByte && value == lastByte) {
+        runLength++;
+        if (runLength == UINT16_MAX) {
+            flushRun();
+        }
+    } else {
+        flushRun();
+        writeLiteral(value);
+        lastByte = value;
+        hasLastByte = true;
+    }
+}
+
+bool PngWriter::onBegin() {
+    adler = 1;
+    bitBuffer = 0;
+    bitCount = 0;
+    hasLastByte = false;
+    runLength = 0;
+
+    static constexpr uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    uint8_t header[13];
+    putUint32(header, width);
+    putUint32(header + 4, height);
+    header[8] = 8; // Bit depth
+    header[9] = 2; // Colour type: RGB
+    header[10] = 0; // Compression: deflate
+    header[11] = 0; // Filter method: adaptive
+    header[12] = 0; // No interlacing
+    if (!writeOutput(signature, sizeof(signature)) || !writeChunk("IHDR", header, sizeof(header))) {
+        return false;
+    }
+
+    // zlib header (deflate with a 32 KB window, no preset dictionary)
+    put(0x78);
+    put(0x01);
+    // A single final block with fixed Huffman codes
+    writeBits(1, 1);
+    writeBits(1, 2);
+    return true;
+}
+
+void PngWriter::onWriteRow(const uint8_t* row) {
+    // The "Sub" filter stores the difference with the pixel on the left, which turns flat colours into zeroes
+    const size_t row_size = static_cast<size_t>(width) * 3;
+    compress(1);
+    for (size_t i = 0; i < row_size; ++i) {
+        compress(i < 3 ? row[i] : row[i] - row[i - 3]);
+    }
+}
+
+bool PngWriter::onFinish() {
+    flushRun();
+    // End of block
+    writeHuffmanCode(0, 7);
+    if (bitCount > 0) {
+        writeBits(0, 8 - bitCount);
+    }
+    put(adler >> 24);
+    put(adler >> 16);
+    put(adler >> 8);
+    put(adler);
+    return flushBuffer() && writeChunk("IEND", nullptr, 0);
+}
+
+// endregion
+
+// region QoiWriter
+
+static constexpr uint8_t QOI_OP_INDEX = 0x00;
+static constexpr uint8_t QOI_OP_DIFF = 0x40;
+static constexpr uint8_t QOI_OP_LUMA = 0x80;
+static constexpr uint8_t QOI_OP_RUN = 0xC0;
+static constexpr uint8_t QOI_OP_RGB = 0xFE;
+static constexpr uint8_t QOI_MAX_RUN_LENGTH = 62;
+
+void QoiWriter::flushRun() {
+    if (runLength > 0) {
+        put(QOI_OP_RUN | (runLength - 1));
+        runLength = 0;
+    }
+}
+
+bool QoiWriter::onBegin() {
+    memset(index, 0, sizeof(index));
+    previous = { 0, 0, 0, 255 };
+    runLength = 0;
+
+    uint8_t header[14] = { 'q', 'o', 'i', 'f' };
+    putUint32(header + 4, width);
+    putUint32(header + 8, height);
+    header[12] = 3; // Channels: RGB
+    header[13] = 0; // sRGB with linear alpha
+    put(header, sizeof(header));
+    return true;
+}
+
+void QoiWriter::onWriteRow(const uint8_t* row) {
+    for (uint16_t x = 0; x < width; ++x, row += 3) {
+        const Pixel pixel = { row[0], row[1], row[2], 255 };
+        if (pixel.r == previous.r && pixel.g == previous.g && pixel.b == previous.b) {
+            runLength++;
+            if (runLength == QOI_MAX_RUN_LENGTH) {
+                flushRun();
+            }
+            continue;
+        }
+
+        flushRun();
+
+        const uint8_t hash = (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+        const auto& indexed = index[hash];
+        if (indexed.r == pixel.r && indexed.g == pixel.g && indexed.b == pixel.b && indexed.a == pixel.a) {
+            put(QOI_OP_INDEX | hash);
+        } else {
+            index[hash] = pixel;
+            const int8_t dr = static_cast<int8_t>(pixel.r - previous.r);
+            const int8_t dg = static_cast<int8_t>(pixel.g - previous.g);
+            const int8_t db = static_cast<int8_t>(pixel.b - previous.b);
+            const int8_t dr_dg = static_cast<int8_t>(dr - dg);
+            const int8_t db_dg = static_cast<int8_t>(db - dg);
+            if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                put(QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+            } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+                put(QOI_OP_LUMA | (dg + 32));
+                put(((dr_dg + 8) << 4) | (db_dg + 8));
+            } else {
+                put(QOI_OP_RGB);
+                put(pixel.r);
+                put(pixel.g);
+                put(pixel.b);
+            }
+        }
+
+        previous = pixel;
+    }
+}
+
+bool QoiWriter::onFinish() {
+    flushRun();
+    static constexpr uint8_t end_marker[] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    put(end_marker, sizeof(end_marker));
+    return true;
+}
+
+// endregion
+
+} // namespace tt::file
@@ -0,0 +1,352 @@
+#include <Tactility/file/TarReader.h>
+
+#include <Tactility/Logger.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sys/stat.h>
+
+namespace tt::file {
+
+static const auto LOGGER = Logger("TarReader");
+
+// Header field offsets and sizes (POSIX ustar)
+constexpr size_t NAME_OFFSET = 0;
+constexpr size_t NAME_SIZE = 100;
+constexpr size_t MODE_OFFSET = 100;
+constexpr size_t MODE_SIZE = 8;
+constexpr size_t SIZE_OFFSET = 124;
+constexpr size_t SIZE_SIZE = 12;
+constexpr size_t CHECKSUM_OFFSET = 148;
+constexpr size_t CHECKSUM_SIZE = 8;
+constexpr size_t TYPE_OFFSET = 156;
+constexpr size_t MAGIC_OFFSET = 257;
+constexpr size_t PREFIX_OFFSET = 345;
+constexpr size_t PREFIX_SIZE = 155;
+
+/** Parse a numeric field: octal text, or big-endian binary when the high bit is set (GNU extension for large sizes) */
+static bool parseNumber(const uint8_t* field, size_t size, uint64_t& result) {
+    result = 0;
+    if ((field[0] & 0x80) != 0) {
+        for (size_t i = 1; i < size; ++i) {
+            if (result > (UINT64_MAX >> 8)) {
+                return false;
+            }
+            result = (result << 8) | field[i];
+        }
+        return true;
+    }
+
+    size_t index = 0;
+    while (index < size && field[index] == ' ') {
+        index++;
+    }
+    while (index < size && field[index] >= '0' && field[index] <= '7') {
+        result = (result << 3) | (field[index] - '0');
+        index++;
+    }
+    return index == size || field[index] == ' ' || field[index] == '\0';
+}
+
+static std::string parseString(const uint8_t* field, size_t size) {
+    const auto* end = static_cast<const uint8_t*>(memchr(field, '\0', size));
+    return { reinterpret_cast<const char*>(field), end != nullptr ? static_cast<size_t>(end - field) : size };
+}
+
+static void normalizePath(std::string& path) {
+    while (path.starts_with("./")) {
+        path.erase(0, 2);
+    }
+    while (path.ends_with('/')) {
+        path.pop_back();
+    }
+    if (path == ".") {
+        path.clear();
+    }
+}
+
+/** Find the "path" record in pax extended header data: records are formatted as "<length> <key>=<value>\n" */
+static bool findPaxPath(const std::string& data, std::string& path) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        const auto space_index = data.find(' ', offset);
+        if (space_index == std::string::npos) {
+            return false;
+        }
+        const auto length = strtoul(data.c_str() + offset, nullptr, 10);
+        if (length <= space_index - offset || offset + length > data.size()) {
+            return false;
+        }
+        const auto record = data.substr(space_index + 1, offset + length - space_index - 2);
+        if (record.starts_with("path=")) {
+            path = record.substr(5);
+        }
+        offset += length;
+    }
+    return true;
+}
+
+// region TarReader
+
+void TarReader::fail(const char* reason) {
+    LOGGER.error("{}", reason);
+    state = State::Error;
+}
+
+bool TarReader::onHeaderBlock() {
+    if (std::all_of(block, block + BLOCK_SIZE, [](uint8_t value) { return value == 0; })) {
+        // The archive ends with 2 empty blocks
+        zeroBlockCount++;
+        if (zeroBlockCount == 2) {
+            state = State::End;
+        }
+        return true;
+    }
+    zeroBlockCount = 0;
+
+    // The checksum is calculated with the checksum field filled with spaces
+    uint64_t expected_checksum;
+    if (!parseNumber(block + CHECKSUM_OFFSET, CHECKSUM_SIZE, expected_checksum)) {
+        fail("Invalid header checksum field");
+        return false;
+    }
+    uint32_t checksum = ' ' * CHECKSUM_SIZE;
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        if (i < CHECKSUM_OFFSET || i >= CHECKSUM_OFFSET + CHECKSUM_SIZE) {
+            checksum += block[i];
+        }
+    }
+    if (checksum != expected_checksum) {
+        fail("Header checksum mismatch");
+        return false;
+    }
+
+    uint64_t size, mode;
+    if (!parseNumber(block + SIZE_OFFSET, SIZE_SIZE, size) || !parseNumber(block + MODE_OFFSET, MODE_SIZE, mode)) {
+        fail("Invalid header field");
+        return false;
+    }
+
+    const char type_flag = static_cast<char>(block[TYPE_OFFSET]);
+    recordRemaining = (size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+    dataRemaining = size;
+
+    if (type_flag == 'L' || type_flag == 'x' || type_flag == 'g') {
+        if (size > MAX_EXTENDED_HEADER_SIZE) {
+            fail("Extended header too large");
+            return false;
+        }
+        isExtendedHeader = true;
+        extendedHeader.clear();
+        extendedHeader.reserve(size);
+        entry.typeFlag = type_flag;
+    } else {
+        isExtendedHeader = false;
+        if (!nextPath.empty()) {
+            entry.path = std::move(nextPath);
+            nextPath.clear();
+        } else {
+            entry.path = parseString(block + NAME_OFFSET, NAME_SIZE);
+            const auto prefix = parseString(block + PREFIX_OFFSET, PREFIX_SIZE);
+            if (memcmp(block + MAGIC_OFFSET, "ustar", 5) == 0 && !prefix.empty()) {
+                entry.path = prefix + "/" + entry.path;
+            }
+        }
+        normalizePath(entry.path);
+        entry.typeFlag = type_flag;
+        entry.mode = static_cast<uint32_t>(mode);
+        entry.size = size;
+        if (type_flag == '0' || type_flag == '\0' || type_flag == '7') {
+            entry.type = EntryType::File;
+        } else if (type_flag == '5') {
+            entry.type = EntryType::Directory;
+        } else {
+            entry.type = EntryType::Other;
+        }
+
+        entryCount++;
+        if (!handler.onEntry(entry)) {
+            fail("Entry rejected");
+            return false;
+        }
+    }
+
+    if (recordRemaining == 0) {
+        return onRecordFinished();
+    }
+
+    state = State::Data;
+    return true;
+}
+
+bool TarReader::onRecordFinished() {
+    state = State::Header;
+
+    if (!isExtendedHeader) {
+        if (!handler.onEntryFinished()) {
+            fail("Failed to finish entry");
+            return false;
+        }
+        return true;
+    }
+
+    isExtendedHeader = false;
+    if (entry.typeFlag == 'L') {
+        nextPath = parseString(reinterpret_cast<const uint8_t*>(extendedHeader.data()), extendedHeader.size());
+    } else if (entry.typeFlag == 'x' && !findPaxPath(extendedHeader, nextPath)) {
+        fail("Invalid pax header");
+        return false;
+    }
+    return true;
+}
+
+bool TarReader::write(const uint8_t* data, size_t size) {
+    size_t offset = 0;
+    while (offset < size && (state == State::Header || state == State::Data)) {
+        if (state == State::Header) {
+            const auto copy_size = std::min(BLOCK_SIZE - blockSize, size - offset);
+            memcpy(block + blockSize, data + offset, copy_size);
+            blockSize += copy_size;
+            offset += copy_size;
+            if (blockSize == BLOCK_SIZE) {
+                blockSize = 0;
+                onHeaderBlock();
+            }
+        } else {
+            const auto record_size = static_cast<size_t>(std::min<uint64_t>(recordRemaining, size - offset));
+            const auto data_size = static_cast<size_t>(std::min<uint64_t>(dataRemaining, record_size));
+            if (data_size > 0) {
+                if (isExtendedHeader) {
+                    extendedHeader.append(reinterpret_cast<const char*>(data + offset), data_size);
+                } else if (entry.type == EntryType::File && !handler.onData(data + offset, data_size)) {
+                    fail("Failed to process entry data");
+                    break;
+                }
+            }
+            dataRemaining -= data_size;
+            recordRemaining -= record_size;
+            offset += record_size;
+            if (recordRemaining == 0) {
+                onRecordFinished();
+            }
+        }
+    }
+
+    // Data after the end-of-archive marker is padding
+    return state != State::Error;
+}
+
+// endregion
+
+// region TarExtractor
+
+TarExtractor::~TarExtractor() {
+    if (file != nullptr) {
+        auto scoped_lock = lock->asScopedLock();
+        scoped_lock.lock();
+        file = nullptr;
+    }
+}
+
+bool TarExtractor::onEntry(const TarReader::Entry& entry) {
+    if (entry.path.empty() && entry.type == TarReader::EntryType::Directory) {
+        return true;
+    }
+
+    if (!isSafeRelativePath(entry.path)) {
+        LOGGER.error("Refusing to extract {}", entry.path);
+        return false;
+    }
+
+    LOGGER.info("Extracting {}", entry.path);
+    const auto absolute_path = destinationPath + "/" + entry.path;
+    switch (entry.type) {
+        case TarReader::EntryType::Directory:
+            if (!findOrCreateDirectory(absolute_path, 0777)) {
+                LOGGER.error("Failed to create directory {}", absolute_path);
+                return false;
+            }
+            return true;
+        case TarReader::EntryType::File: {
+            if (!findOrCreateParentDirectory(absolute_path, 0777)) {
+                LOGGER.error("Can't find or create parent directory of {}", absolute_path);
+                return false;
+            }
+
+            auto scoped_lock = lock->asScopedLock();
+            scoped_lock.lock();
+            file = std::unique_ptr<FILE, FileCloser>(fopen(absolute_path.c_str(), "wb"));
+            if (file == nullptr) {
+                LOGGER.error("Failed to open {}", absolute_path);
+                return false;
+            }
+            filePath = absolute_path;
+            fileMode = entry.mode;
+            return true;
+        }
+        case TarReader::EntryType::Other:
+            LOGGER.error("Entry type '{}' not supported: skipping {}", entry.typeFlag, entry.path);
+            return true;
+    }
+    return false;
+}
+
+bool TarExtractor::onData(const uint8_t* data, size_t size) {
+    if (file == nullptr) {
+        return false;
+    }
+
+    auto scoped_lock = lock->asScopedLock();
+    scoped_lock.lock();
+    if (fwrite(data, 1, size, file.get()) != size) {
+        LOGGER.error("Failed to write to {}", filePath);
+        return false;
+    }
+    return true;
+}
+
+bool TarExtractor::onEntryFinished() {
+    if (file == nullptr) {
+        return true;
+    }
+
+    auto scoped_lock = lock->asScopedLock();
+    scoped_lock.lock();
+    const bool flushed = fflush(file.get()) == 0;
+    file = nullptr;
+    if (!flushed) {
+        LOGGER.error("Failed to write to {}", filePath);
+        return false;
+    }
+
+    // Note: fchmod() doesn't exist on ESP-IDF and chmod() does nothing on that platform
+    if (chmod(filePath.c_str(), fileMode) < 0) {
+        LOGGER.error("Failed to set the mode of {}", filePath);
+        return false;
+    }
+
+    return true;
+}
+
+// endregion
+
+bool isSafeRelativePath(const std::string& path) {
+    if (path.empty() || path[0] == '/' || path[0] == '\\') {
+        return false;
+    }
+
+    size_t segment_start = 0;
+    while (segment_start <= path.size()) {
+        auto segment_end = path.find_first_of("/\\", segment_start);
+        if (segment_end == std::string::npos) {
+            segment_end = path.size();
+        }
+        if (path.compare(segment_start, segment_end - segment_start, "..") == 0) {
+            return false;
+        }
+        segment_start = segment_end + 1;
+    }
+    return true;
+}
+
+} // namespace tt::file
@@ -2,74 +2,186 @@
 
 #include <Tactility/Logger.h>
 #include <Tactility/RecursiveMutex.h>
+
 #include <algorithm>
+#include <array>
+#include <atomic>
 
 namespace tt::hal {
 
-std::vector<std::shared_ptr<Device>> devices;
-RecursiveMutex mutex;
+constexpr size_t DEVICE_TYPE_COUNT = static_cast<size_t>(Device::Type::Other) + 1;
+
+/**
+ * Immutable state of the registry (RCU-style, like PubSub):
+ * readers use the current snapshot without locking, while registering and deregistering swap in a new snapshot.
+ */
+struct Registry {
+    std::vector<std::shared_ptr<Device>> devices;
+    std::array<std::vector<std::shared_ptr<Device>>, DEVICE_TYPE_COUNT> devicesByType;
+};
+
+// nullptr means that no devices were registered yet
+static std::atomic<const Registry*> snapshot = nullptr;
+static std::atomic<uint32_t> activeReaders = 0;
+static std::atomic<bool> hasRetired = false;
+
+// Guarded by mutex
+static RecursiveMutex mutex;
+static std::vector<const Registry*> retired;
+
 static Device::Id nextId = 0;
 
 static const auto LOGGER = Logger("Devices");
 
 Device::Device() : id(nextId++) {}
 
-template <std::ranges::range RangeType>
-auto toVector(RangeType&& range) {
-    auto view = range | std::views::common;
-    return std::vector(view.begin(), view.end());
+// region Snapshots
+
+/** Free retired snapshots if no DeviceList is using them. Must be called with the mutex locked. */
+static void reclaimRetiredLocked() {
+    if (activeReaders == 0U) {
+        for (auto* item : retired) {
+            delete item;
+        }
+        retired.clear();
+        hasRetired = false;
+    }
+}
+
+/** Publish a new snapshot with the specified devices and retire the old one. Must be called with the mutex locked. */
+static void replaceSnapshotLocked(std::vector<std::shared_ptr<Device>> devices) {
+    auto* new_snapshot = new Registry();
+    for (const auto& device : devices) {
+        new_snapshot->devicesByType[static_cast<size_t>(device->getType())].push_back(device);
+    }
+    new_snapshot->devices = std::move(devices);
+
+    auto* old_snapshot = snapshot.exchange(new_snapshot);
+    if (old_snapshot != nullptr) {
+        retired.push_back(old_snapshot);
+        hasRetired = true;
+    }
+    reclaimRetiredLocked();
+}
+
+/** Free retired snapshots if no DeviceList is using them, unless the mutex is in use. */
+static void tryReclaimRetired() {
+    // Don't block the reader: if a registry change is in progress, it will reclaim instead.
+    // When that change happened before the last reader was done, the next reader reclaims.
+    if (hasRetired && activeReaders == 0U && mutex.lock(0)) {
+        reclaimRetiredLocked();
+        mutex.unlock();
+    }
+}
+
+static std::span<const std::shared_ptr<Device>> acquireDevices(Device::Type type) {
+    tryReclaimRetired();
+    activeReaders++;
+    const auto* current = snapshot.load();
+    if (current == nullptr) {
+        return {};
+    }
+    return current->devicesByType[static_cast<size_t>(type)];
+}
+
+static std::span<const std::shared_ptr<Device>> acquireDevices() {
+    tryReclaimRetired();
+    activeReaders++;
+    const auto* current = snapshot.load();
+    if (current == nullptr) {
+        return {};
+    }
+    return current->devices;
+}
+
+static void releaseDevices() {
+    activeReaders--;
+    tryReclaimRetired();
+}
+
+DeviceList::~DeviceList() {
+    releaseDevices();
 }
 
+DeviceList getDeviceList(Device::Type type) {
+    return DeviceList(acquireDevices(type));
+}
+
+// endregion
+
 void registerDevice(const std::shared_ptr<Device>& device) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
+    mutex.lock();
 
+    bool registered = false;
     if (findDevice(device->getId()) == nullptr) {
+        auto devices = getDevices();
         devices.push_back(device);
+        replaceSnapshotLocked(std::move(devices));
+        registered = true;
         LOGGER.info("Registered {} with id {}", device->getName(), device->getId());
     } else {
         LOGGER.warn("Device {} with id {} was already registered", device->getName(), device->getId());
     }
+
+    mutex.unlock();
+
+    if (registered) {
+        getDevicePubsub()->publish({
+            .action = DeviceEvent::Action::Registered,
+            .device = device
+        });
+    }
 }
 
 void deregisterDevice(const std::shared_ptr<Device>& device) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
+    mutex.lock();
 
     auto id_to_remove = device->getId();
+    auto devices = getDevices();
     auto remove_iterator = std::remove_if(devices.begin(), devices.end(), [id_to_remove](const auto& device) {
         return device->getId() == id_to_remove;
     });
+    bool deregistered = false;
     if (remove_iterator != devices.end()) {
         LOGGER.info("Deregistering {} with id {}", device->getName(), device->getId());
-        devices.erase(remove_iterator);
+        devices.erase(remove_iterator, devices.end());
+        replaceSnapshotLocked(std::move(devices));
+        deregistered = true;
     } else {
         LOGGER.warn("Deregistering {} with id {} failed: not found", device->getName(), device->getId());
     }
+
+    mutex.unlock();
+
+    if (deregistered) {
+        getDevicePubsub()->publish({
+            .action = DeviceEvent::Action::Deregistered,
+            .device = device
+        });
+    }
 }
 
 std::vector<std::shared_ptr<Device>> findDevices(const std::function<bool(const std::shared_ptr<Device>&)>& filterFunction) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
-
-    auto devices_view = devices | std::views::filter([&filterFunction](auto& device) {
-        return filterFunction(device);
-    });
-    return toVector(devices_view);
+    std::vector<std::shared_ptr<Device>> result;
+    for (const auto& device : acquireDevices()) {
+        if (filterFunction(device)) {
+            result.push_back(device);
+        }
+    }
+    releaseDevices();
+    return result;
 }
 
 std::shared_ptr<Device> _Nullable findDevice(const std::function<bool(const std::shared_ptr<Device>&)>& filterFunction) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
-
-    auto result_set = devices | std::views::filter([&filterFunction](auto& device) {
-         return filterFunction(device);
-    });
-    if (!result_set.empty()) {
-        return result_set.front();
-    } else {
-        return nullptr;
+    std::shared_ptr<Device> result;
+    for (const auto& device : acquireDevices()) {
+        if (filterFunction(device)) {
+            result = device;
+            break;
+        }
     }
+    releaseDevices();
+    return result;
 }
 
 std::shared_ptr<Device> _Nullable findDevice(std::string name) {
@@ -85,22 +197,24 @@ std::shared_ptr<Device> _Nullable findDevice(Device::Id id) {
 }
 
 std::vector<std::shared_ptr<Device>> findDevices(Device::Type type) {
-    return findDevices([type](auto& device) {
-        return device->getType() == type;
-    });
+    auto devices = getDeviceList(type);
+    return std::vector<std::shared_ptr<Device>>(devices.begin(), devices.end());
 }
 
 std::vector<std::shared_ptr<Device>> getDevices() {
-    return devices;
+    auto devices = acquireDevices();
+    std::vector<std::shared_ptr<Device>> result(devices.begin(), devices.end());
+    releaseDevices();
+    return result;
 }
 
 bool hasDevice(Device::Type type) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
-    auto result_set = devices | std::views::filter([&type](auto& device) {
-         return device->getType() == type;
-    });
-    return !result_set.empty();
+    return !getDeviceList(type).empty();
+}
+
+std::shared_ptr<PubSub<DeviceEvent>> getDevicePubsub() {
+    static auto pubsub = std::make_shared<PubSub<DeviceEvent>>();
+    return pubsub;
 }
 
 }
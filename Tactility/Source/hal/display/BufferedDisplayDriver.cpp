@@ -0,0 +1,192 @@
+#include <Tactility/hal/display/BufferedDisplayDriver.h>
+
+#include <Tactility/Logger.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tt::hal::display {
+
+static const auto LOGGER = Logger("BufferedDisplay");
+
+/** @return the amount of bytes per pixel, or 0 when pixels don't take a whole amount of bytes */
+static size_t getBytesPerPixel(ColorFormat colorFormat) {
+    switch (colorFormat) {
+        case ColorFormat::BGR565:
+        case ColorFormat::BGR565Swapped:
+        case ColorFormat::RGB565:
+        case ColorFormat::RGB565Swapped:
+            return 2;
+        case ColorFormat::RGB888:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+BufferedDisplayDriver::BufferedDisplayDriver(std::shared_ptr<DisplayDriver> driver, const Configuration& configuration) :
+    driver(std::move(driver)),
+    configuration(configuration),
+    bytesPerPixel(getBytesPerPixel(this->driver->getColorFormat())),
+    width(this->driver->getPixelWidth()),
+    height(this->driver->getPixelHeight()),
+    dirtyRegions(configuration.transferOverhead, configuration.maxRegionCount)
+{
+    if (bytesPerPixel == 0) {
+        LOGGER.warn("Color format not supported: drawing without buffering");
+        return;
+    }
+
+    frameBuffer.resize(static_cast<size_t>(width) * height * bytesPerPixel);
+    // A band contains at least 1 row
+    const auto transfer_buffer_size = std::max(configuration.transferBufferSize, static_cast<size_t>(width) * bytesPerPixel);
+    for (auto& transfer_buffer : transferBuffers) {
+        transfer_buffer.resize(transfer_buffer_size);
+    }
+
+    flushThread = std::make_unique<DispatcherThread>("display_flush", 4096);
+    flushThread->start();
+}
+
+BufferedDisplayDriver::~BufferedDisplayDriver() {
+    if (flushThread != nullptr) {
+        flushThread->stop();
+        flush();
+    }
+}
+
+bool BufferedDisplayDriver::drawBitmap(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData) {
+    return queue(xStart, yStart, xEnd, yEnd, pixelData, nullptr);
+}
+
+bool BufferedDisplayDriver::drawBitmapAsync(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData, DrawCallback callback) {
+    return queue(xStart, yStart, xEnd, yEnd, pixelData, callback);
+}
+
+bool BufferedDisplayDriver::queue(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData, const DrawCallback& callback) {
+    if (xStart < 0 || yStart < 0 || xEnd > width || yEnd > height || xEnd <= xStart || yEnd <= yStart) {
+        LOGGER.error("Invalid area: ({}, {}) to ({}, {})", xStart, yStart, xEnd, yEnd);
+        return false;
+    }
+
+    if (frameBuffer.empty()) {
+        auto driver_lock = driver->getLock()->asScopedLock();
+        driver_lock.lock();
+        const bool success = driver->drawBitmap(xStart, yStart, xEnd, yEnd, pixelData);
+        if (callback != nullptr) {
+            callback(success);
+        }
+        return success;
+    }
+
+    const size_t row_size = static_cast<size_t>(xEnd - xStart) * bytesPerPixel;
+    const auto* source = static_cast<const uint8_t*>(pixelData);
+
+    mutex.lock();
+    for (int y = yStart; y < yEnd; ++y) {
+        auto* destination = frameBuffer.data() + (static_cast<size_t>(y) * width + xStart) * bytesPerPixel;
+        memcpy(destination, source, row_size);
+        source += row_size;
+    }
+    dirtyRegions.add({ .xStart = xStart, .yStart = yStart, .xEnd = xEnd, .yEnd = yEnd });
+    if (callback != nullptr) {
+        pendingCallbacks.push_back(callback);
+    }
+    mutex.unlock();
+
+    scheduleFlush();
+    return true;
+}
+
+void BufferedDisplayDriver::scheduleFlush() {
+    mutex.lock();
+    const bool should_dispatch = !isFlushScheduled;
+    isFlushScheduled = true;
+    mutex.unlock();
+
+    if (should_dispatch) {
+        flushThread->dispatch([this] {
+            flush();
+        });
+    }
+}
+
+bool BufferedDisplayDriver::sendRegion(const Region& region) {
+    const size_t row_size = static_cast<size_t>(region.xEnd - region.xStart) * bytesPerPixel;
+    const int rows_per_band = static_cast<int>(transferBuffers[0].size() / row_size);
+
+    for (int band_start = region.yStart; band_start < region.yEnd; band_start += rows_per_band) {
+        const int band_end = std::min(band_start + rows_per_band, region.yEnd);
+
+        // Alternate between the transfer buffers, so the next band is copied while the driver is still sending the previous one.
+        // The band before that used the same buffer: wait until only the previous band is pending.
+        if (!driver->waitForPendingTransfers(1, configuration.transferTimeout)) {
+            LOGGER.error("Transfer timed out");
+            return false;
+        }
+        auto& transfer_buffer = transferBuffers[nextTransferBuffer];
+        nextTransferBuffer = (nextTransferBuffer + 1) % 2;
+
+        mutex.lock();
+        auto* destination = transfer_buffer.data();
+        for (int y = band_start; y < band_end; ++y) {
+            memcpy(destination, frameBuffer.data() + (static_cast<size_t>(y) * width + region.xStart) * bytesPerPixel, row_size);
+            destination += row_size;
+        }
+        mutex.unlock();
+
+        if (!driver->drawBitmap(region.xStart, band_start, region.xEnd, band_end, transfer_buffer.data())) {
+            LOGGER.error("Failed to draw ({}, {}) to ({}, {})", region.xStart, band_start, region.xEnd, band_end);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BufferedDisplayDriver::flush() {
+    if (frameBuffer.empty()) {
+        return true;
+    }
+
+    auto flush_lock = flushMutex.asScopedLock();
+    flush_lock.lock();
+
+    mutex.lock();
+    isFlushScheduled = false;
+    const auto regions = dirtyRegions.take();
+    auto callbacks = std::move(pendingCallbacks);
+    pendingCallbacks.clear();
+    mutex.unlock();
+
+    bool success = true;
+    if (!regions.empty()) {
+        auto driver_lock = driver->getLock()->asScopedLock();
+        driver_lock.lock();
+
+        if (configuration.syncToTearingEffect && driver->supportsTearingEffectSync() && !driver->waitForTearingEffect(configuration.tearingEffectTimeout)) {
+            LOGGER.warn("Tearing effect signal timed out");
+        }
+
+        for (const auto& region : regions) {
+            if (!sendRegion(region)) {
+                success = false;
+                break;
+            }
+        }
+
+        // The callbacks report that the pixels were sent, and the transfer buffers must be free for the next flush
+        if (!driver->waitForPendingTransfers(0, configuration.transferTimeout)) {
+            LOGGER.error("Transfer timed out");
+            success = false;
+        }
+    }
+
+    for (const auto& callback : callbacks) {
+        callback(success);
+    }
+
+    return success;
+}
+
+} // namespace tt::hal::display
@@ -0,0 +1,77 @@
+#include <Tactility/hal/display/DirtyRegions.h>
+
+#include <algorithm>
+
+namespace tt::hal::display {
+
+static Region getBounds(const Region& first, const Region& second) {
+    return {
+        .xStart = std::min(first.xStart, second.xStart),
+        .yStart = std::min(first.yStart, second.yStart),
+        .xEnd = std::max(first.xEnd, second.xEnd),
+        .yEnd = std::max(first.yEnd, second.yEnd)
+    };
+}
+
+void DirtyRegions::add(const Region& region) {
+    if (region.isEmpty()) {
+        return;
+    }
+
+    regions.push_back(region);
+    merge();
+
+    while (regions.size() > maxRegionCount) {
+        mergeCheapestPair();
+    }
+}
+
+void DirtyRegions::merge() {
+    bool merged;
+    do {
+        merged = false;
+        for (size_t i = 0; i < regions.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < regions.size(); ++j) {
+                const auto bounds = getBounds(regions[i], regions[j]);
+                if (getCost(bounds) <= getCost(regions[i]) + getCost(regions[j])) {
+                    regions[i] = bounds;
+                    regions.erase(regions.begin() + j);
+                    // The bigger region might now be mergeable with earlier regions
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    } while (merged);
+}
+
+void DirtyRegions::mergeCheapestPair() {
+    size_t best_first = 0;
+    size_t best_second = 1;
+    int64_t best_increase = INT64_MAX;
+    for (size_t i = 0; i < regions.size(); ++i) {
+        for (size_t j = i + 1; j < regions.size(); ++j) {
+            const auto increase = getCost(getBounds(regions[i], regions[j])) - getCost(regions[i]) - getCost(regions[j]);
+            if (increase < best_increase) {
+                best_increase = increase;
+                best_first = i;
+                best_second = j;
+            }
+        }
+    }
+
+    regions[best_first] = getBounds(regions[best_first], regions[best_second]);
+    regions.erase(regions.begin() + best_second);
+    merge();
+}
+
+std::vector<Region> DirtyRegions::take() {
+    std::ranges::sort(regions, [](const Region& left, const Region& right) {
+        return left.yStart != right.yStart ? left.yStart < right.yStart : left.xStart < right.xStart;
+    });
+    auto result = std::move(regions);
+    regions.clear();
+    return result;
+}
+
+} // namespace tt::hal::display
@@ -1,61 +1,40 @@
 #include <Tactility/hal/gps/GpsDevice.h>
 #include <Tactility/hal/gps/GpsInit.h>
 #include <Tactility/hal/gps/Probe.h>
+#include <Tactility/hal/gps/Ublox.h>
+#include <Tactility/hal/gps/UbloxNavigation.h>
 #include <Tactility/hal/uart/Uart.h>
 #include <Tactility/Logger.h>
 
 #include <cstring>
 #include <minmea.h>
 
+#ifndef CONFIG_TT_GPS_UBX_NAVIGATION_RATE
+#define CONFIG_TT_GPS_UBX_NAVIGATION_RATE 5
+#endif
+
 namespace tt::hal::gps {
 
 constexpr uint32_t GPS_UART_BUFFER_SIZE = 256;
+// Fits a NAV-SAT message with 64 satellites
+constexpr size_t UBX_RECEIVE_BUFFER_SIZE = 1024;
 
 static const auto LOGGER = Logger("GpsDevice");
 
-int32_t GpsDevice::threadMain() {
-    uint8_t buffer[GPS_UART_BUFFER_SIZE];
-
-    auto uart = uart::open(configuration.uartName);
-    if (uart == nullptr) {
-        LOGGER.error("Failed to open UART {}", configuration.uartName);
-        return -1;
-    }
-
-    if (!uart->start()) {
-        LOGGER.error("Failed to start UART {}", configuration.uartName);
-        return -1;
-    }
-
-    if (!uart->setBaudRate(static_cast<int>(configuration.baudRate))) {
-        LOGGER.error("Failed to set baud rate to {} for UART {}", configuration.baudRate, configuration.uartName);
-        return -1;
-    }
-
-    GpsModel model = configuration.model;
-    if (model == GpsModel::Unknown) {
-        model = probe(*uart);
-        if (model == GpsModel::Unknown) {
-            LOGGER.error("Probe failed");
-            setState(State::Error);
-            return -1;
-        }
-    }
+void GpsDevice::publishRmc(const minmea_sentence_rmc& rmc) {
     mutex.lock();
-    this->model = model;
-    mutex.unlock();
-
-    if (!init(*uart, model)) {
-        LOGGER.error("Init failed");
-        setState(State::Error);
-        return -1;
+    for (auto& subscription : rmcSubscriptions) {
+        (*subscription.onData)(getId(), rmc);
     }
+    mutex.unlock();
+}
 
-    setState(State::On);
+void GpsDevice::receiveNmea(uart::Uart& uart) {
+    uint8_t buffer[GPS_UART_BUFFER_SIZE];
 
     // Reference: https://gpsd.gitlab.io/gpsd/NMEA.html
     while (!isThreadInterrupted()) {
-        size_t bytes_read = uart->readUntil(reinterpret_cast<std::byte*>(buffer), GPS_UART_BUFFER_SIZE, '\n', 100 / portTICK_PERIOD_MS);
+        size_t bytes_read = uart.readUntil(reinterpret_cast<std::byte*>(buffer), GPS_UART_BUFFER_SIZE, '\n', 100 / portTICK_PERIOD_MS);
 
         // Thread might've been interrupted in the meanwhile
         if (isThreadInterrupted()) {
@@ -64,17 +43,15 @@ int32_t GpsDevice::threadMain() {
 
         if (bytes_read > 0U) {
 
-            LOGGER.info("[{}] {}", bytes_read, reinterpret_cast<const char*>(buffer));
+            if (LOGGER.isLoggingDebug()) {
+                LOGGER.debug("[{}] {}", bytes_read, reinterpret_cast<const char*>(buffer));
+            }
 
             switch (minmea_sentence_id((char*)buffer, false)) {
                 case MINMEA_SENTENCE_RMC:
                     minmea_sentence_rmc rmc_frame;
                     if (minmea_parse_rmc(&rmc_frame, (char*)buffer)) {
-                        mutex.lock();
-                        for (auto& subscription : rmcSubscriptions) {
-                            (*subscription.onData)(getId(), rmc_frame);
-                        }
-                        mutex.unlock();
+                        publishRmc(rmc_frame);
                         if (LOGGER.isLoggingDebug()) {
                             LOGGER.debug("RMC {} lat, {} lon, {} m/s", minmea_tocoord(&rmc_frame.latitude), minmea_tocoord(&rmc_frame.longitude), minmea_tofloat(&rmc_frame.speed));
                         }
@@ -102,6 +79,105 @@ int32_t GpsDevice::threadMain() {
             }
         }
     }
+}
+
+void GpsDevice::receiveUbx(uart::Uart& uart) {
+    // NAV-SAT messages grow with the amount of satellites in view
+    uart.setReceiveBufferSize(UBX_RECEIVE_BUFFER_SIZE);
+
+    GpsFix fix;
+    while (!isThreadInterrupted()) {
+        auto frame = uart.readUbxFrame(100 / portTICK_PERIOD_MS);
+
+        // Thread might've been interrupted in the meanwhile
+        if (isThreadInterrupted()) {
+            break;
+        }
+
+        if (frame.empty()) {
+            continue;
+        }
+
+        if (ublox::parseNavPvt(frame, fix)) {
+            mutex.lock();
+            for (auto& subscription : fixSubscriptions) {
+                (*subscription.onData)(getId(), fix);
+            }
+            mutex.unlock();
+
+            minmea_sentence_rmc rmc;
+            ublox::toRmc(fix, rmc);
+            publishRmc(rmc);
+
+            if (LOGGER.isLoggingDebug()) {
+                LOGGER.debug("PVT {} lat, {} lon, {} m/s, {} satellites", fix.getLatitudeDegrees(), fix.getLongitudeDegrees(), fix.getGroundSpeedMetersPerSecond(), fix.satelliteCount);
+            }
+        } else if (ublox::isMessage(frame, ublox::UBX_CLASS_NAV, ublox::UBX_ID_NAV_SAT)) {
+            mutex.lock();
+            if (!ublox::parseNavSat(frame, [this](const minmea_sat_info& satellite) {
+                for (auto& subscription : satelliteSubscriptions) {
+                    (*subscription.onData)(getId(), satellite);
+                }
+            })) {
+                LOGGER.error("NAV-SAT parse error");
+            }
+            mutex.unlock();
+        }
+    }
+}
+
+int32_t GpsDevice::threadMain() {
+    auto uart = uart::open(configuration.uartName);
+    if (uart == nullptr) {
+        LOGGER.error("Failed to open UART {}", configuration.uartName);
+        return -1;
+    }
+
+    if (!uart->start()) {
+        LOGGER.error("Failed to start UART {}", configuration.uartName);
+        return -1;
+    }
+
+    if (!uart->setBaudRate(static_cast<int>(configuration.baudRate))) {
+        LOGGER.error("Failed to set baud rate to {} for UART {}", configuration.baudRate, configuration.uartName);
+        return -1;
+    }
+
+    GpsModel model = configuration.model;
+    if (model == GpsModel::Unknown) {
+        model = probe(*uart);
+        if (model == GpsModel::Unknown) {
+            LOGGER.error("Probe failed");
+            setState(State::Error);
+            return -1;
+        }
+    }
+    mutex.lock();
+    this->model = model;
+    mutex.unlock();
+
+    if (!init(*uart, model)) {
+        LOGGER.error("Init failed");
+        setState(State::Error);
+        return -1;
+    }
+
+    // NMEA remains the fallback when the receiver doesn't accept the UBX configuration
+    const bool use_ubx = (CONFIG_TT_GPS_UBX_NAVIGATION_RATE > 0) &&
+        ublox::supportsNavigationMode(model) &&
+        ublox::initNavigationMode(*uart, model, CONFIG_TT_GPS_UBX_NAVIGATION_RATE);
+
+    mutex.lock();
+    navigationMode = use_ubx;
+    mutex.unlock();
+
+    setState(State::On);
+
+    if (use_ubx) {
+        receiveUbx(*uart);
+    } else {
+        receiveNmea(*uart);
+    }
 
     if (uart->isStarted() && !uart->stop()) {
         LOGGER.warn("Failed to stop UART {}", configuration.uartName);
@@ -120,6 +196,7 @@ bool GpsDevice::start() {
     }
 
     threadInterrupted = false;
+    navigationMode = false;
 
     LOGGER.info("Starting thread");
     setState(State::PendingOn);
@@ -177,6 +254,12 @@ GpsModel GpsDevice::getModel() const {
     return model; // Make copy because of thread safety
 }
 
+bool GpsDevice::isNavigationModeEnabled() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return navigationMode;
+}
+
 GpsDevice::State GpsDevice::getState() const {
     auto lock = mutex.asScopedLock();
     lock.lock();
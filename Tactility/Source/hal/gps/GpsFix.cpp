@@ -0,0 +1,61 @@
+#include <Tactility/hal/gps/GpsFix.h>
+
+namespace tt::hal::gps {
+
+// 1 knot is 514.444 mm/s
+constexpr int64_t MILLIMETERS_PER_SECOND_PER_KILOKNOT = 514444;
+
+/** Convert a coordinate in the NMEA format (DDDMM.MMMMM) to degrees in units of 1e-7, without losing precision to floats */
+static int32_t toCoordinate(const minmea_float& value) {
+    if (value.scale == 0) {
+        return 0;
+    }
+
+    const int64_t scaled_degree = static_cast<int64_t>(value.scale) * 100;
+    const int64_t degrees = value.value / scaled_degree;
+    const int64_t minutes = value.value % scaled_degree;
+    return static_cast<int32_t>(degrees * 10000000 + minutes * 10000000 / (60 * static_cast<int64_t>(value.scale)));
+}
+
+/** @return the value multiplied by the factor, or 0 when the value is not set */
+static int64_t toScaled(const minmea_float& value, int64_t factor) {
+    if (value.scale == 0) {
+        return 0;
+    }
+    return value.value * factor / value.scale;
+}
+
+void toFix(const minmea_sentence_rmc& rmc, GpsFix& fix) {
+    const bool valid_date = rmc.date.year >= 0 && rmc.date.month > 0 && rmc.date.day > 0;
+    fix = {
+        .type = rmc.valid ? GpsFix::Type::Fix2d : GpsFix::Type::None,
+        .valid = rmc.valid,
+        .validDate = valid_date,
+        .validTime = rmc.time.hours >= 0,
+        // Same as minmea_getdatetime(): 2 digit years before 80 are in the 21st century
+        .year = static_cast<uint16_t>(valid_date ? (rmc.date.year < 80 ? 2000 + rmc.date.year : 1900 + rmc.date.year) : 0),
+        .month = static_cast<uint8_t>(rmc.date.month),
+        .day = static_cast<uint8_t>(rmc.date.day),
+        .hour = static_cast<uint8_t>(rmc.time.hours),
+        .minute = static_cast<uint8_t>(rmc.time.minutes),
+        .second = static_cast<uint8_t>(rmc.time.seconds),
+        .nanoseconds = rmc.time.microseconds * 1000,
+        .satelliteCount = 0,
+        .latitude = toCoordinate(rmc.latitude),
+        .longitude = toCoordinate(rmc.longitude),
+        .height = 0,
+        .altitude = 0,
+        .horizontalAccuracy = 0,
+        .verticalAccuracy = 0,
+        .velocityNorth = 0,
+        .velocityEast = 0,
+        .velocityDown = 0,
+        .groundSpeed = static_cast<int32_t>(toScaled(rmc.speed, MILLIMETERS_PER_SECOND_PER_KILOKNOT) / 1000),
+        .speedAccuracy = 0,
+        .heading = static_cast<int32_t>(toScaled(rmc.course, 100000)),
+        .headingAccuracy = 0,
+        .positionDop = 0
+    };
+}
+
+} // namespace tt::hal::gps
@@ -4,6 +4,7 @@
 #include <Tactility/kernel/Kernel.h>
 #include <Tactility/Logger.h>
 
+#include <cassert>
 #include <cstring>
 
 namespace tt::hal::gps::ublox {
@@ -17,7 +18,7 @@ bool initUblox10(uart::Uart& uart);
 #define SEND_UBX_PACKET(UART, BUFFER, TYPE, ID, DATA, ERRMSG, TIMEOUT) \
     do { \
         auto msglen = makePacket(TYPE, ID, DATA, sizeof(DATA), BUFFER); \
-        UART.writeBytes(BUFFER, sizeof(BUFFER)); \
+        UART.writeBytes(BUFFER, msglen); \
         if (getAck(UART, TYPE, ID, TIMEOUT) != GpsResponse::Ok) { \
             LOGGER.info("Sending packet failed: {}", #ERRMSG); \
         } \
@@ -445,6 +446,82 @@ bool initUblox789(uart::Uart& uart, GpsModel model) {
     return true;
 }
 
+static bool sendConfiguration(uart::Uart& uart, uint8_t classId, uint8_t messageId, const uint8_t* payload, uint8_t payloadSize, const char* description) {
+    uint8_t buffer[64];
+    assert(payloadSize + 8U <= sizeof(buffer));
+    auto packet_size = makePacket(classId, messageId, payload, payloadSize, buffer);
+    uart.writeBytes(buffer, packet_size);
+    if (getAck(uart, classId, messageId, 500) != GpsResponse::Ok) {
+        LOGGER.warn("Sending packet failed: {}", description);
+        return false;
+    }
+    return true;
+}
+
+bool supportsNavigationMode(GpsModel model) {
+    // NAV-PVT was introduced in protocol version 14 (u-blox 7)
+    switch (model) {
+        case GpsModel::UBLOX7:
+        case GpsModel::UBLOX8:
+        case GpsModel::UBLOX9:
+        case GpsModel::UBLOX10:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool initNavigationMode(uart::Uart& uart, GpsModel model, uint8_t rateHz) {
+    assert(rateHz > 0 && rateHz <= 10);
+    LOGGER.info("Switching to UBX navigation messages at {} Hz", rateHz);
+
+    const uint16_t measurement_period = 1000 / rateHz;
+    const uint8_t measurement_period_low = measurement_period & 0xFF;
+    const uint8_t measurement_period_high = measurement_period >> 8;
+
+    // The configuration is only applied to RAM: after a restart, the receiver falls back to the saved NMEA configuration
+    if (model == GpsModel::UBLOX10) {
+        const uint8_t valset_navigation_ram[] = {
+            0x00, 0x01, 0x00, 0x00, // Version, RAM layer, reserved
+            0x01, 0x00, 0x21, 0x30, measurement_period_low, measurement_period_high, // CFG-RATE-MEAS
+            0x07, 0x00, 0x91, 0x20, 0x01, // CFG-MSGOUT-UBX_NAV_PVT_UART1: every solution
+            0x16, 0x00, 0x91, 0x20, rateHz, // CFG-MSGOUT-UBX_NAV_SAT_UART1: once per second
+            0xbb, 0x00, 0x91, 0x20, 0x00, // CFG-MSGOUT-NMEA_ID_GGA_UART1: off
+            0xac, 0x00, 0x91, 0x20, 0x00 // CFG-MSGOUT-NMEA_ID_RMC_UART1: off
+        };
+        return sendConfiguration(uart, 0x06, 0x8A, valset_navigation_ram, sizeof(valset_navigation_ram), "configure UBX navigation for M10");
+    }
+
+    const uint8_t rate[] = {
+        measurement_period_low, measurement_period_high, // Measurement period
+        0x01, 0x00, // Navigation rate: a solution for every measurement
+        0x01, 0x00 // Time reference: GPS time
+    };
+    if (!sendConfiguration(uart, 0x06, 0x08, rate, sizeof(rate), "set navigation rate")) {
+        return false;
+    }
+
+    // CFG-MSG with class, id and the rate for the current port (relative to the navigation rate)
+    const uint8_t enable_pvt[] = { 0x01, 0x07, 0x01 };
+    if (!sendConfiguration(uart, 0x06, 0x01, enable_pvt, sizeof(enable_pvt), "enable UBX NAV-PVT")) {
+        return false;
+    }
+
+    // NAV-SAT was introduced in protocol version 15 (u-blox 8)
+    if (model != GpsModel::UBLOX7) {
+        const uint8_t enable_sat[] = { 0x01, 0x35, rateHz };
+        sendConfiguration(uart, 0x06, 0x01, enable_sat, sizeof(enable_sat), "enable UBX NAV-SAT");
+    }
+
+    const uint8_t disable_gga[] = { 0xF0, 0x00, 0x00 };
+    const uint8_t disable_gsa[] = { 0xF0, 0x02, 0x00 };
+    const uint8_t disable_rmc[] = { 0xF0, 0x04, 0x00 };
+    sendConfiguration(uart, 0x06, 0x01, disable_gga, sizeof(disable_gga), "disable NMEA GGA");
+    sendConfiguration(uart, 0x06, 0x01, disable_gsa, sizeof(disable_gsa), "disable NMEA GSA");
+    sendConfiguration(uart, 0x06, 0x01, disable_rmc, sizeof(disable_rmc), "disable NMEA RMC");
+    return true;
+}
+
 bool initUblox6(uart::Uart& uart) {
     uint8_t buffer[256];
 
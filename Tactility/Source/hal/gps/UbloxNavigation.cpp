@@ -0,0 +1,165 @@
+#include <Tactility/hal/gps/UbloxNavigation.h>
+
+#include <cstdlib>
+
+namespace tt::hal::gps::ublox {
+
+// Sync word, class, id and payload length
+constexpr size_t HEADER_SIZE = 6;
+constexpr size_t CHECKSUM_SIZE = 2;
+// The u-blox 7 version of NAV-PVT is shorter than later versions, but it contains all fields that are parsed
+constexpr size_t NAV_PVT_MINIMUM_PAYLOAD_SIZE = 84;
+constexpr size_t NAV_SAT_HEADER_SIZE = 8;
+constexpr size_t NAV_SAT_BLOCK_SIZE = 12;
+
+// 1 knot is 514.444 mm/s
+constexpr int64_t MILLIMETERS_PER_SECOND_PER_KILOKNOT = 514444;
+
+static uint16_t readU2(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+static uint32_t readU4(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) |
+        (static_cast<uint32_t>(data[1]) << 8) |
+        (static_cast<uint32_t>(data[2]) << 16) |
+        (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static int32_t readI4(const uint8_t* data) {
+    return static_cast<int32_t>(readU4(data));
+}
+
+static std::span<const uint8_t> getPayload(std::span<const uint8_t> frame) {
+    if (frame.size() < HEADER_SIZE + CHECKSUM_SIZE) {
+        return {};
+    }
+    const size_t payload_size = readU2(&frame[4]);
+    if (frame.size() < HEADER_SIZE + payload_size + CHECKSUM_SIZE) {
+        return {};
+    }
+    return frame.subspan(HEADER_SIZE, payload_size);
+}
+
+bool isMessage(std::span<const uint8_t> frame, uint8_t classId, uint8_t messageId) {
+    return frame.size() >= HEADER_SIZE && frame[2] == classId && frame[3] == messageId;
+}
+
+bool parseNavPvt(std::span<const uint8_t> frame, GpsFix& fix) {
+    if (!isMessage(frame, UBX_CLASS_NAV, UBX_ID_NAV_PVT)) {
+        return false;
+    }
+
+    const auto payload = getPayload(frame);
+    if (payload.size() < NAV_PVT_MINIMUM_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    const auto* data = payload.data();
+    const uint8_t valid_flags = data[11];
+    const uint8_t fix_flags = data[21];
+    fix = {
+        .type = static_cast<GpsFix::Type>(data[20]),
+        .valid = (fix_flags & 0x01U) != 0U,
+        .validDate = (valid_flags & 0x01U) != 0U,
+        .validTime = (valid_flags & 0x02U) != 0U,
+        .year = readU2(&data[4]),
+        .month = data[6],
+        .day = data[7],
+        .hour = data[8],
+        .minute = data[9],
+        .second = data[10],
+        .nanoseconds = readI4(&data[16]),
+        .satelliteCount = data[23],
+        .latitude = readI4(&data[28]),
+        .longitude = readI4(&data[24]),
+        .height = readI4(&data[32]),
+        .altitude = readI4(&data[36]),
+        .horizontalAccuracy = readU4(&data[40]),
+        .verticalAccuracy = readU4(&data[44]),
+        .velocityNorth = readI4(&data[48]),
+        .velocityEast = readI4(&data[52]),
+        .velocityDown = readI4(&data[56]),
+        .groundSpeed = readI4(&data[60]),
+        .speedAccuracy = readU4(&data[68]),
+        .heading = readI4(&data[64]),
+        .headingAccuracy = readU4(&data[72]),
+        .positionDop = readU2(&data[76])
+    };
+    return true;
+}
+
+bool parseNavSat(std::span<const uint8_t> frame, const std::function<void(const minmea_sat_info&)>& onSatellite) {
+    if (!isMessage(frame, UBX_CLASS_NAV, UBX_ID_NAV_SAT)) {
+        return false;
+    }
+
+    const auto payload = getPayload(frame);
+    if (payload.size() < NAV_SAT_HEADER_SIZE) {
+        return false;
+    }
+
+    const size_t satellite_count = payload[5];
+    if (payload.size() < NAV_SAT_HEADER_SIZE + satellite_count * NAV_SAT_BLOCK_SIZE) {
+        return false;
+    }
+
+    for (size_t i = 0; i < satellite_count; ++i) {
+        const auto* block = payload.data() + NAV_SAT_HEADER_SIZE + i * NAV_SAT_BLOCK_SIZE;
+        onSatellite({
+            .nr = block[1],
+            .elevation = static_cast<int8_t>(block[3]),
+            .azimuth = static_cast<int16_t>(readU2(&block[4])),
+            .snr = block[2]
+        });
+    }
+    return true;
+}
+
+/** Convert degrees in units of 1e-7 to the NMEA format (DDDMM.MMMMM) */
+static minmea_float toNmeaCoordinate(int32_t coordinate) {
+    const int64_t absolute = std::llabs(coordinate);
+    const int64_t degrees = absolute / 10000000;
+    // Minutes in units of 1e-5
+    const int64_t minutes = (absolute % 10000000) * 60 / 100;
+    const int64_t value = degrees * 100 * 100000 + minutes;
+    return {
+        .value = static_cast<int_least32_t>(coordinate < 0 ? -value : value),
+        .scale = 100000
+    };
+}
+
+void toRmc(const GpsFix& fix, minmea_sentence_rmc& rmc) {
+    rmc = {
+        .time = {
+            .hours = fix.hour,
+            .minutes = fix.minute,
+            .seconds = fix.second,
+            .microseconds = fix.nanoseconds > 0 ? fix.nanoseconds / 1000 : 0
+        },
+        .valid = fix.valid && (fix.type == GpsFix::Type::Fix2d || fix.type == GpsFix::Type::Fix3d || fix.type == GpsFix::Type::GnssDeadReckoning),
+        .latitude = toNmeaCoordinate(fix.latitude),
+        .longitude = toNmeaCoordinate(fix.longitude),
+        // Knots, in units of 1e-3
+        .speed = {
+            .value = static_cast<int_least32_t>(static_cast<int64_t>(fix.groundSpeed) * 1000000 / MILLIMETERS_PER_SECOND_PER_KILOKNOT),
+            .scale = 1000
+        },
+        .course = {
+            .value = fix.heading,
+            .scale = 100000
+        },
+        .date = {
+            .day = fix.day,
+            .month = fix.month,
+            // RMC sentences only contain 2 digits
+            .year = fix.year % 100
+        },
+        .variation = {
+            .value = 0,
+            .scale = 0
+        }
+    };
+}
+
+} // namespace tt::hal::gps::ublox
@@ -1,9 +1,17 @@
 #include <Tactility/hal/i2c/I2c.h>
+#include <Tactility/hal/i2c/I2cTransaction.h>
+#ifndef ESP_PLATFORM
+#include <Tactility/hal/i2c/I2cSimulator.h>
+#endif
 
 #include <Tactility/Check.h>
+#include <Tactility/kernel/Kernel.h>
 #include <Tactility/Logger.h>
 #include <Tactility/Mutex.h>
 
+#include <atomic>
+#include <span>
+
 namespace tt::hal::i2c {
 
 static const auto LOGGER = Logger("I2C");
@@ -13,6 +21,16 @@ struct Data {
     bool isConfigured = false;
     bool isStarted = false;
     Configuration configuration;
+    // Guarded by mutex, except for lockTimeoutCount
+    Statistics statistics = {
+        .transactionCount = 0,
+        .operationCount = 0,
+        .failureCount = 0,
+        .lockTimeoutCount = 0,
+        .busyMicros = 0,
+        .lockWaitMicros = 0
+    };
+    std::atomic<uint32_t> lockTimeoutCount = 0;
 };
 
 static const uint8_t ACK_CHECK_EN = 1;
@@ -136,145 +154,218 @@ bool isStarted(i2c_port_t port) {
     return dataArray[port].isStarted;
 }
 
-bool masterRead(i2c_port_t port, uint8_t address, uint8_t* data, size_t dataSize, TickType_t timeout) {
-    auto lock = getLock(port).asScopedLock();
-    if (!lock.lock(timeout)) {
-        LOGGER.error("({}) Mutex timeout", static_cast<int>(port));
-        return false;
-    }
+// region Operations
 
-#ifdef ESP_PLATFORM
-    auto result = i2c_master_read_from_device(port, address, data, dataSize, timeout);
-    ESP_ERROR_CHECK_WITHOUT_ABORT(result);
-    return result == ESP_OK;
-#else
-    return false;
-#endif // ESP_PLATFORM
+/** @return the ticks that are left until the timeout expires, or 0 when it expired */
+static TickType_t getRemainingTicks(TickType_t startTicks, TickType_t timeout) {
+    if (timeout == kernel::MAX_TICKS) {
+        return kernel::MAX_TICKS;
+    }
+    const auto elapsed = kernel::getTicks() - startTicks;
+    return (elapsed < timeout) ? (timeout - elapsed) : 0;
 }
 
-bool masterReadRegister(i2c_port_t port, uint8_t address, uint8_t reg, uint8_t* data, size_t dataSize, TickType_t timeout) {
-    auto lock = getLock(port).asScopedLock();
-    if (!lock.lock(timeout)) {
-        LOGGER.error("({}) Mutex timeout", static_cast<int>(port));
-        return false;
-    }
+/** How executeOperations() handles failed operations */
+enum class FailureMode {
+    /** Skip the remaining operations */
+    Stop,
+    /** Execute the remaining operations too, like separate calls would */
+    Continue,
+    /** Probing for a device: no acknowledgement is an expected result, so it isn't logged or counted as a failure */
+    Probe
+};
 
+static bool executeTransferLocked(i2c_port_t port, const Transaction::Operation& operation, TickType_t timeout, bool logError) {
 #ifdef ESP_PLATFORM
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    // Set address pointer
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN);
-    i2c_master_write(cmd, &reg, 1, ACK_CHECK_EN);
-    // Read length of response from current pointer
+    // A static command link avoids a heap allocation for every transfer
+    uint8_t link_buffer[I2C_LINK_RECOMMENDED_SIZE(3)] = { 0 };
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link_buffer, sizeof(link_buffer));
     i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_READ, ACK_CHECK_EN);
-    if (dataSize > 1) {
-        i2c_master_read(cmd, data, dataSize - 1, I2C_MASTER_ACK);
+    const bool has_write = operation.prefixSize > 0 || operation.writeDataSize > 0;
+    if (has_write) {
+        i2c_master_write_byte(cmd, (operation.address << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN);
+        if (operation.prefixSize > 0) {
+            i2c_master_write(cmd, operation.prefix, operation.prefixSize, ACK_CHECK_EN);
+        }
+        if (operation.writeDataSize > 0) {
+            i2c_master_write(cmd, operation.writeData, operation.writeDataSize, ACK_CHECK_EN);
+        }
+    }
+    if (operation.readDataSize > 0) {
+        if (has_write) {
+            // Repeated start
+            i2c_master_start(cmd);
+        }
+        i2c_master_write_byte(cmd, (operation.address << 1) | I2C_MASTER_READ, ACK_CHECK_EN);
+        i2c_master_read(cmd, operation.readData, operation.readDataSize, I2C_MASTER_LAST_NACK);
     }
-    i2c_master_read_byte(cmd, data + dataSize - 1, I2C_MASTER_NACK);
     i2c_master_stop(cmd);
-    // TODO: We're passing an inaccurate timeout value as we already lost time with locking
     esp_err_t result = i2c_master_cmd_begin(port, cmd, timeout);
-    i2c_cmd_link_delete(cmd);
-
-    ESP_ERROR_CHECK_WITHOUT_ABORT(result);
+    i2c_cmd_link_delete_static(cmd);
 
+    if (logError) {
+        ESP_ERROR_CHECK_WITHOUT_ABORT(result);
+    }
     return result == ESP_OK;
 #else
-    return false;
+    // The simulated bus receives the write phase as a single buffer, like a real device would
+    std::vector<uint8_t> write_data(operation.prefix, operation.prefix + operation.prefixSize);
+    if (operation.writeDataSize > 0) {
+        write_data.insert(write_data.end(), operation.writeData, operation.writeData + operation.writeDataSize);
+    }
+    return simulator::transfer(port, operation.address, write_data.data(), write_data.size(), operation.readData, operation.readDataSize);
 #endif // ESP_PLATFORM
 }
 
-bool masterWrite(i2c_port_t port, uint8_t address, const uint8_t* data, uint16_t dataSize, TickType_t timeout) {
-    auto lock = getLock(port).asScopedLock();
-    if (!lock.lock(timeout)) {
-        LOGGER.error("({}) Mutex timeout", static_cast<int>(port));
+static bool executeOperationLocked(i2c_port_t port, const Transaction::Operation& operation, TickType_t timeout, bool logError) {
+    if (operation.type == Transaction::Operation::Type::Transfer) {
+        return executeTransferLocked(port, operation, timeout, logError);
+    }
+
+    uint8_t value;
+    auto transfer = Transaction::Operation {
+        .type = Transaction::Operation::Type::Transfer,
+        .address = operation.address,
+        .prefix = { operation.prefix[0], 0 },
+        .prefixSize = 1,
+        .writeData = nullptr,
+        .writeDataSize = 0,
+        .readData = &value,
+        .readDataSize = 1,
+        .setMask = 0,
+        .clearMask = 0
+    };
+    if (!executeTransferLocked(port, transfer, timeout, logError)) {
         return false;
     }
 
-#ifdef ESP_PLATFORM
-    auto result = i2c_master_write_to_device(port, address, data, dataSize, timeout);
-    ESP_ERROR_CHECK_WITHOUT_ABORT(result);
-    return result == ESP_OK;
-#else
-    return false;
-#endif // ESP_PLATFORM
+    transfer.prefix[1] = (value & ~operation.clearMask) | operation.setMask;
+    transfer.prefixSize = 2;
+    transfer.readData = nullptr;
+    transfer.readDataSize = 0;
+    return executeTransferLocked(port, transfer, timeout, logError);
 }
 
-bool masterWriteRegister(i2c_port_t port, uint8_t address, uint8_t reg, const uint8_t* data, uint16_t dataSize, TickType_t timeout) {
-    tt_check(reg != 0);
+/**
+ * Lock the bus once and execute all operations before the timeout expires.
+ * The first operation always gets at least 1 tick: the default timeout is often only a single tick.
+ */
+static bool executeOperations(i2c_port_t port, std::span<const Transaction::Operation> operations, TickType_t timeout, FailureMode failureMode = FailureMode::Stop) {
+    const auto start_ticks = kernel::getTicks();
+    const auto lock_start_time = kernel::getMicrosSinceBoot();
+    Data& data = dataArray[port];
 
-    auto lock = getLock(port).asScopedLock();
+    auto lock = data.mutex.asScopedLock();
     if (!lock.lock(timeout)) {
+        data.lockTimeoutCount++;
         LOGGER.error("({}) Mutex timeout", static_cast<int>(port));
         return false;
     }
 
-#ifdef ESP_PLATFORM
+    const auto busy_start_time = kernel::getMicrosSinceBoot();
+    bool success = true;
+    for (size_t i = 0; i < operations.size(); ++i) {
+        auto remaining = getRemainingTicks(start_ticks, timeout);
+        if (remaining == 0) {
+            if (i > 0) {
+                LOGGER.error("({}) Timeout after {} of {} operations", static_cast<int>(port), i, operations.size());
+                success = false;
+                break;
+            }
+            remaining = 1;
+        }
 
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, ACK_CHECK_EN);
-    i2c_master_write_byte(cmd, reg, ACK_CHECK_EN);
-    i2c_master_write(cmd, (uint8_t*) data, dataSize, ACK_CHECK_EN);
-    i2c_master_stop(cmd);
-    // TODO: We're passing an inaccurate timeout value as we already lost time with locking
-    esp_err_t result = i2c_master_cmd_begin(port, cmd, timeout);
-    i2c_cmd_link_delete(cmd);
+        if (!executeOperationLocked(port, operations[i], remaining, failureMode != FailureMode::Probe)) {
+            success = false;
+            if (failureMode != FailureMode::Continue) {
+                break;
+            }
+        }
+    }
 
-    ESP_ERROR_CHECK_WITHOUT_ABORT(result);
-    return result == ESP_OK;
-#else
-    return false;
-#endif // ESP_PLATFORM
+    const auto end_time = kernel::getMicrosSinceBoot();
+    data.statistics.transactionCount++;
+    data.statistics.operationCount += operations.size();
+    data.statistics.busyMicros += end_time - busy_start_time;
+    data.statistics.lockWaitMicros += busy_start_time - lock_start_time;
+    if (!success && failureMode != FailureMode::Probe) {
+        data.statistics.failureCount++;
+    }
+
+    return success;
+}
+
+bool Transaction::execute(i2c_port_t port, TickType_t timeout) const {
+    return executeOperations(port, operations, timeout);
+}
+
+static bool executeOperation(i2c_port_t port, const Transaction::Operation& operation, TickType_t timeout, FailureMode failureMode = FailureMode::Stop) {
+    return executeOperations(port, std::span(&operation, 1), timeout, failureMode);
+}
+
+static Transaction::Operation createTransfer(uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize) {
+    return {
+        .type = Transaction::Operation::Type::Transfer,
+        .address = address,
+        .prefix = { 0, 0 },
+        .prefixSize = 0,
+        .writeData = writeData,
+        .writeDataSize = writeDataSize,
+        .readData = readData,
+        .readDataSize = readDataSize,
+        .setMask = 0,
+        .clearMask = 0
+    };
+}
+
+// endregion
+
+bool masterRead(i2c_port_t port, uint8_t address, uint8_t* data, size_t dataSize, TickType_t timeout) {
+    return executeOperation(port, createTransfer(address, nullptr, 0, data, dataSize), timeout);
+}
+
+bool masterReadRegister(i2c_port_t port, uint8_t address, uint8_t reg, uint8_t* data, size_t dataSize, TickType_t timeout) {
+    return executeOperation(port, createTransfer(address, &reg, 1, data, dataSize), timeout);
+}
+
+bool masterWrite(i2c_port_t port, uint8_t address, const uint8_t* data, uint16_t dataSize, TickType_t timeout) {
+    return executeOperation(port, createTransfer(address, data, dataSize, nullptr, 0), timeout);
+}
+
+bool masterWriteRegister(i2c_port_t port, uint8_t address, uint8_t reg, const uint8_t* data, uint16_t dataSize, TickType_t timeout) {
+    tt_check(reg != 0);
+
+    auto operation = createTransfer(address, data, dataSize, nullptr, 0);
+    operation.prefix[0] = reg;
+    operation.prefixSize = 1;
+    return executeOperation(port, operation, timeout);
 }
 
 bool masterWriteRegisterArray(i2c_port_t port, uint8_t address, const uint8_t* data, uint16_t dataSize, TickType_t timeout) {
-#ifdef ESP_PLATFORM
     assert(dataSize % 2 == 0);
-    bool result = true;
+    Transaction transaction(dataSize / 2);
     for (int i = 0; i < dataSize; i += 2) {
-        // TODO: We're passing an inaccurate timeout value as we already lost time with locking and previous writes in this loop
-        if (!masterWriteRegister(port, address, data[i], &data[i + 1], 1, timeout)) {
-            result = false;
-        }
+        transaction.writeRegister8(address, data[i], data[i + 1]);
     }
-    return result;
-#else
-    return false;
-#endif // ESP_PLATFORM
+    return executeOperations(port, transaction.getOperations(), timeout, FailureMode::Continue);
 }
 
 bool masterWriteRead(i2c_port_t port, uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize, TickType_t timeout) {
-    auto lock = getLock(port).asScopedLock();
-    if (!lock.lock(timeout)) {
-        LOGGER.error("({}) Mutex timeout", static_cast<int>(port));
-        return false;
-    }
-
-#ifdef ESP_PLATFORM
-    esp_err_t result = i2c_master_write_read_device(port, address, writeData, writeDataSize, readData, readDataSize, timeout);
-    ESP_ERROR_CHECK_WITHOUT_ABORT(result);
-    return result == ESP_OK;
-#else
-    return false;
-#endif // ESP_PLATFORM
+    return executeOperation(port, createTransfer(address, writeData, writeDataSize, readData, readDataSize), timeout);
 }
 
 bool masterHasDeviceAtAddress(i2c_port_t port, uint8_t address, TickType_t timeout) {
-    auto lock = getLock(port).asScopedLock();
-    if (!lock.lock(timeout)) {
-        LOGGER.error("({}) Mutex timeout", static_cast<int>(port));
-        return false;
-    }
-
-#ifdef ESP_PLATFORM
     uint8_t message[2] = { 0, 0 };
-    // TODO: We're passing an inaccurate timeout value as we already lost time with locking
-    return i2c_master_write_to_device(port, address, message, 2, timeout) == ESP_OK;
-#else
-    return false;
-#endif // ESP_PLATFORM
+    return executeOperation(port, createTransfer(address, message, 2, nullptr, 0), timeout, FailureMode::Probe);
+}
+
+Statistics getStatistics(i2c_port_t port) {
+    Data& data = dataArray[port];
+    auto lock = data.mutex.asScopedLock();
+    lock.lock();
+    auto statistics = data.statistics;
+    statistics.lockTimeoutCount = data.lockTimeoutCount;
+    return statistics;
 }
 
 Lock& getLock(i2c_port_t port) {
@@ -59,23 +59,11 @@ bool I2cDevice::writeRegister8(uint8_t reg, uint8_t value) const {
 }
 
 bool I2cDevice::bitOn(uint8_t reg, uint8_t bitmask) const {
-    uint8_t state;
-    if (readRegister8(reg, state)) {
-        state |= bitmask;
-        return writeRegister8(reg, state);
-    } else {
-        return false;
-    }
+    return execute(Transaction(1).updateRegister8(address, reg, bitmask, 0));
 }
 
 bool I2cDevice::bitOff(uint8_t reg, uint8_t bitmask) const {
-    uint8_t state;
-    if (readRegister8(reg, state)) {
-        state &= ~bitmask;
-        return writeRegister8(reg, state);
-    } else {
-        return false;
-    }
+    return execute(Transaction(1).updateRegister8(address, reg, 0, bitmask));
 }
 
 } // namespace tt::hal::i2c
@@ -0,0 +1,302 @@
+#ifndef ESP_PLATFORM
+
+#include <Tactility/hal/i2c/I2cSimulator.h>
+
+#include <Tactility/file/File.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Logger.h>
+#include <Tactility/Mutex.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <map>
+#include <sstream>
+
+namespace tt::hal::i2c::simulator {
+
+static const auto LOGGER = Logger("I2cSimulator");
+
+// Start and stop conditions take about a bit each
+constexpr uint32_t CONDITION_BITS = 2;
+// 8 data bits and an acknowledgement bit
+constexpr uint32_t BITS_PER_BYTE = 9;
+
+struct PortState {
+    std::map<uint8_t, std::shared_ptr<SimulatedDevice>> devices;
+    Timing timing = {
+        .clockHz = 400000,
+        .transferLatencyMicros = 0,
+        .delay = false
+    };
+    Counters counters = {
+        .transferCount = 0,
+        .nackCount = 0,
+        .byteCount = 0,
+        .busMicros = 0
+    };
+    bool tracing = false;
+    std::vector<TraceEntry> trace;
+};
+
+static Mutex mutex;
+static PortState ports[I2C_NUM_MAX];
+
+// region Devices
+
+bool RegisterMapDevice::onWrite(const uint8_t* data, size_t dataSize) {
+    if (dataSize == 0) {
+        return true;
+    }
+
+    selectedRegister = data[0];
+    for (size_t i = 1; i < dataSize; ++i) {
+        const uint8_t reg = selectedRegister++;
+        registers[reg] = data[i];
+        if (writeHandler != nullptr) {
+            writeHandler(*this, reg, data[i]);
+        }
+    }
+    return true;
+}
+
+bool RegisterMapDevice::onRead(uint8_t* data, size_t dataSize) {
+    for (size_t i = 0; i < dataSize; ++i) {
+        const uint8_t reg = selectedRegister++;
+        if (readHandler != nullptr) {
+            readHandler(*this, reg);
+        }
+        data[i] = registers[reg];
+    }
+    return true;
+}
+
+const TraceEntry* TraceReplayDevice::next(TraceEntry::Direction direction) {
+    if (position >= entries.size()) {
+        LOGGER.warn("Replay: unexpected transfer after the end of the trace");
+        mismatchCount++;
+        return nullptr;
+    }
+
+    const auto& entry = entries[position++];
+    if (entry.direction != direction) {
+        LOGGER.warn("Replay: expected a {} at entry {}", entry.direction == TraceEntry::Direction::Write ? "write" : "read", position - 1);
+        mismatchCount++;
+        return nullptr;
+    }
+
+    return &entry;
+}
+
+bool TraceReplayDevice::onWrite(const uint8_t* data, size_t dataSize) {
+    const auto* entry = next(TraceEntry::Direction::Write);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    if (entry->data.size() != dataSize || memcmp(entry->data.data(), data, dataSize) != 0) {
+        LOGGER.warn("Replay: written data differs at entry {}", position - 1);
+        mismatchCount++;
+    }
+
+    return entry->acknowledged;
+}
+
+bool TraceReplayDevice::onRead(uint8_t* data, size_t dataSize) {
+    const auto* entry = next(TraceEntry::Direction::Read);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    if (entry->data.size() != dataSize) {
+        LOGGER.warn("Replay: read size differs at entry {}", position - 1);
+        mismatchCount++;
+    }
+
+    memset(data, 0, dataSize);
+    memcpy(data, entry->data.data(), std::min(dataSize, entry->data.size()));
+    return entry->acknowledged;
+}
+
+// endregion
+
+// region Bus
+
+void attachDevice(i2c_port_t port, uint8_t address, std::shared_ptr<SimulatedDevice> device) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ports[port].devices[address] = std::move(device);
+}
+
+void detachDevice(i2c_port_t port, uint8_t address) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ports[port].devices.erase(address);
+}
+
+void setTiming(i2c_port_t port, const Timing& timing) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ports[port].timing = timing;
+}
+
+Counters getCounters(i2c_port_t port) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return ports[port].counters;
+}
+
+void resetCounters(i2c_port_t port) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ports[port].counters = {
+        .transferCount = 0,
+        .nackCount = 0,
+        .byteCount = 0,
+        .busMicros = 0
+    };
+}
+
+void startTrace(i2c_port_t port) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ports[port].trace.clear();
+    ports[port].tracing = true;
+}
+
+std::vector<TraceEntry> stopTrace(i2c_port_t port) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    ports[port].tracing = false;
+    return std::move(ports[port].trace);
+}
+
+bool transfer(i2c_port_t port, uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize) {
+    std::shared_ptr<SimulatedDevice> device;
+    Timing timing;
+    {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        auto iterator = ports[port].devices.find(address);
+        if (iterator != ports[port].devices.end()) {
+            device = iterator->second;
+        }
+        timing = ports[port].timing;
+    }
+
+    std::vector<TraceEntry> entries;
+    uint32_t byte_count = 0;
+    bool acknowledged = true;
+
+    const bool has_write = writeDataSize > 0 || readDataSize == 0;
+    if (has_write) {
+        acknowledged = (device != nullptr) && device->onWrite(writeData, writeDataSize);
+        // Without an acknowledgement, only the address byte is on the wire
+        byte_count += acknowledged ? (1 + writeDataSize) : 1;
+        entries.push_back({
+            .direction = TraceEntry::Direction::Write,
+            .address = address,
+            .acknowledged = acknowledged,
+            .data = std::vector(writeData, writeData + writeDataSize)
+        });
+    }
+
+    if (acknowledged && readDataSize > 0) {
+        acknowledged = (device != nullptr) && device->onRead(readData, readDataSize);
+        byte_count += acknowledged ? (1 + readDataSize) : 1;
+        entries.push_back({
+            .direction = TraceEntry::Direction::Read,
+            .address = address,
+            .acknowledged = acknowledged,
+            .data = acknowledged ? std::vector(readData, readData + readDataSize) : std::vector<uint8_t>()
+        });
+    }
+
+    const uint32_t bits = byte_count * BITS_PER_BYTE + CONDITION_BITS * entries.size();
+    const uint64_t wire_micros = (timing.clockHz != 0) ? static_cast<uint64_t>(bits) * 1000000U / timing.clockHz : 0;
+    const uint64_t bus_micros = wire_micros + timing.transferLatencyMicros;
+
+    {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        auto& state = ports[port];
+        state.counters.transferCount++;
+        state.counters.byteCount += byte_count;
+        state.counters.busMicros += bus_micros;
+        if (!acknowledged) {
+            state.counters.nackCount++;
+        }
+        if (state.tracing) {
+            state.trace.insert(state.trace.end(), entries.begin(), entries.end());
+        }
+    }
+
+    if (timing.delay) {
+        kernel::delayMicros(bus_micros);
+    }
+
+    return acknowledged;
+}
+
+// endregion
+
+// region Traces
+
+bool saveTrace(const std::string& path, const std::vector<TraceEntry>& trace) {
+    std::string content;
+    for (const auto& entry : trace) {
+        content += std::format(
+            "{} {:02X} {}",
+            entry.direction == TraceEntry::Direction::Write ? 'W' : 'R',
+            entry.address,
+            entry.acknowledged ? "ACK" : "NACK"
+        );
+        for (auto byte : entry.data) {
+            content += std::format(" {:02X}", byte);
+        }
+        content += '\n';
+    }
+    return file::writeString(path, content);
+}
+
+bool loadTrace(const std::string& path, std::vector<TraceEntry>& trace) {
+    bool valid = true;
+    trace.clear();
+    bool read = file::readLines(path, true, [&trace, &valid](const char* line) {
+        std::istringstream stream(line);
+        std::string direction, address, acknowledgement, byte;
+        if (!(stream >> direction >> address >> acknowledgement)) {
+            // Ignore empty lines
+            valid = valid && (line[0] == '\0');
+            return;
+        }
+
+        TraceEntry entry = {
+            .direction = (direction == "W") ? TraceEntry::Direction::Write : TraceEntry::Direction::Read,
+            .address = static_cast<uint8_t>(strtoul(address.c_str(), nullptr, 16)),
+            .acknowledged = (acknowledgement == "ACK"),
+            .data = {}
+        };
+        while (stream >> byte) {
+            entry.data.push_back(static_cast<uint8_t>(strtoul(byte.c_str(), nullptr, 16)));
+        }
+        trace.push_back(std::move(entry));
+    });
+    return read && valid;
+}
+
+std::vector<TraceEntry> filterTrace(const std::vector<TraceEntry>& trace, uint8_t address) {
+    std::vector<TraceEntry> result;
+    for (const auto& entry : trace) {
+        if (entry.address == address) {
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+// endregion
+
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include <Tactility/hal/i2c/I2cTransaction.h>
+
+#include <Tactility/DispatcherThread.h>
+#include <Tactility/kernel/Kernel.h>
+
+namespace tt::hal::i2c {
+
+// Note: execute() is implemented in I2c.cpp, because it uses the internal state of the bus
+
+static DispatcherThread& getDispatcherThread() {
+    // Never destroyed, so transactions can't be dispatched to a stopped thread during shutdown
+    static auto* dispatcher_thread = [] {
+        auto* thread = new DispatcherThread("i2c_dispatcher", 3072);
+        thread->start();
+        return thread;
+    }();
+    return *dispatcher_thread;
+}
+
+Transaction& Transaction::addTransfer(uint8_t address, const uint8_t* prefix, uint8_t prefixSize, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize) {
+    Operation operation = {
+        .type = Operation::Type::Transfer,
+        .address = address,
+        .prefix = { 0, 0 },
+        .prefixSize = prefixSize,
+        .writeData = writeData,
+        .writeDataSize = writeDataSize,
+        .readData = readData,
+        .readDataSize = readDataSize,
+        .setMask = 0,
+        .clearMask = 0
+    };
+    for (uint8_t i = 0; i < prefixSize; ++i) {
+        operation.prefix[i] = prefix[i];
+    }
+    operations.push_back(operation);
+    return *this;
+}
+
+Transaction& Transaction::read(uint8_t address, uint8_t* data, size_t dataSize) {
+    return addTransfer(address, nullptr, 0, nullptr, 0, data, dataSize);
+}
+
+Transaction& Transaction::write(uint8_t address, const uint8_t* data, size_t dataSize) {
+    return addTransfer(address, nullptr, 0, data, dataSize, nullptr, 0);
+}
+
+Transaction& Transaction::writeRead(uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize) {
+    return addTransfer(address, nullptr, 0, writeData, writeDataSize, readData, readDataSize);
+}
+
+Transaction& Transaction::readRegister(uint8_t address, uint8_t reg, uint8_t* data, size_t dataSize) {
+    return addTransfer(address, &reg, 1, nullptr, 0, data, dataSize);
+}
+
+Transaction& Transaction::writeRegister(uint8_t address, uint8_t reg, const uint8_t* data, size_t dataSize) {
+    return addTransfer(address, &reg, 1, data, dataSize, nullptr, 0);
+}
+
+Transaction& Transaction::writeRegister8(uint8_t address, uint8_t reg, uint8_t value) {
+    const uint8_t prefix[2] = { reg, value };
+    return addTransfer(address, prefix, 2, nullptr, 0, nullptr, 0);
+}
+
+Transaction& Transaction::updateRegister8(uint8_t address, uint8_t reg, uint8_t setMask, uint8_t clearMask) {
+    operations.push_back({
+        .type = Operation::Type::UpdateRegister8,
+        .address = address,
+        .prefix = { reg, 0 },
+        .prefixSize = 1,
+        .writeData = nullptr,
+        .writeDataSize = 0,
+        .readData = nullptr,
+        .readDataSize = 0,
+        .setMask = setMask,
+        .clearMask = clearMask
+    });
+    return *this;
+}
+
+bool Transaction::executeAsync(std::shared_ptr<const Transaction> transaction, i2c_port_t port, TickType_t timeout, CompletionCallback onCompleted) {
+    const auto start_ticks = kernel::getTicks();
+    return getDispatcherThread().dispatch([transaction, port, timeout, start_ticks, onCompleted] {
+        // The timeout started when the transaction was dispatched
+        TickType_t remaining = timeout;
+        if (timeout != kernel::MAX_TICKS) {
+            const auto elapsed = kernel::getTicks() - start_ticks;
+            remaining = (elapsed < timeout) ? (timeout - elapsed) : 0;
+        }
+
+        const bool success = (remaining > 0) && transaction->execute(port, remaining);
+        if (onCompleted != nullptr) {
+            onCompleted(success);
+        }
+    }, timeout);
+}
+
+} // namespace
@@ -1,12 +1,47 @@
 #include "Tactility/hal/Device.h"
 #include "Tactility/hal/sdcard/SdCardDevice.h"
 
+#include <Tactility/Mutex.h>
+
+#include <algorithm>
+#include <atomic>
+
 namespace tt::hal::sdcard {
 
+struct MountTableEntry {
+    std::string mountPath;
+    std::shared_ptr<Lock> lock;
+
+    bool operator==(const MountTableEntry& other) const = default;
+};
+
+/** Immutable: a new table is published when SD cards are mounted or unmounted */
+struct MountTable {
+    /** Sorted by descending mount path length, so the first match is the most specific mount point */
+    std::vector<MountTableEntry> entries;
+};
+
+static Mutex mountTableMutex;
+static std::atomic<const MountTable*> currentMountTable = nullptr;
+/**
+ * Published tables are never deleted, so readers don't need a lock or a reference count.
+ * Identical tables are reused, so this only grows with the amount of distinct mount configurations (usually 2).
+ */
+static std::vector<std::unique_ptr<const MountTable>> mountTables;
+
+static bool isOnMountPath(const std::string& path, const std::string& mountPath) {
+    if (!path.starts_with(mountPath)) {
+        return false;
+    }
+
+    // Ensure that "/sdcard10/file" doesn't match "/sdcard1"
+    return path.size() == mountPath.size() || path[mountPath.size()] == '/' || mountPath.ends_with('/');
+}
+
 std::shared_ptr<SdCardDevice> _Nullable find(const std::string& path) {
     auto sdcards = findDevices<SdCardDevice>(Device::Type::SdCard);
     for (auto& sdcard : sdcards) {
-        if (sdcard->isMounted() && path.starts_with(sdcard->getMountPath())) {
+        if (sdcard->isMounted() && isOnMountPath(path, sdcard->getMountPath())) {
             return sdcard;
         }
     }
@@ -14,10 +49,49 @@ std::shared_ptr<SdCardDevice> _Nullable find(const std::string& path) {
     return nullptr;
 }
 
+void updateMountTable() {
+    std::vector<MountTableEntry> entries;
+    for (const auto& sdcard : findDevices<SdCardDevice>(Device::Type::SdCard)) {
+        // The mount path is empty when the SD card isn't mounted
+        auto mount_path = sdcard->getMountPath();
+        if (!mount_path.empty()) {
+            entries.push_back({
+                .mountPath = std::move(mount_path),
+                .lock = sdcard->getLock()
+            });
+        }
+    }
+
+    std::ranges::sort(entries, [](const auto& left, const auto& right) {
+        return left.mountPath.size() > right.mountPath.size();
+    });
+
+    auto lock = mountTableMutex.asScopedLock();
+    lock.lock();
+
+    auto existing = std::ranges::find_if(mountTables, [&entries](const auto& table) {
+        return table->entries == entries;
+    });
+
+    if (existing != mountTables.end()) {
+        currentMountTable.store(existing->get(), std::memory_order_release);
+    } else {
+        auto table = std::make_unique<const MountTable>(std::move(entries));
+        currentMountTable.store(table.get(), std::memory_order_release);
+        mountTables.push_back(std::move(table));
+    }
+}
+
 std::shared_ptr<Lock> findSdCardLock(const std::string& path) {
-    auto sdcard = find(path);
-    if (sdcard != nullptr) {
-        return sdcard->getLock();
+    const auto* table = currentMountTable.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        return nullptr;
+    }
+
+    for (const auto& entry : table->entries) {
+        if (isOnMountPath(path, entry.mountPath)) {
+            return entry.lock;
+        }
     }
 
     return nullptr;
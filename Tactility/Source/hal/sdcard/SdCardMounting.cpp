@@ -31,6 +31,8 @@ void mountAll() {
             mount(sdcard, mount_path);
         }
     }
+
+    updateMountTable();
 }
 
 }
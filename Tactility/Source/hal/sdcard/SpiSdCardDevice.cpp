@@ -11,6 +11,22 @@ namespace tt::hal::sdcard {
 
 static const auto LOGGER = Logger("SpiSdCardDevice");
 
+std::shared_ptr<Lock> SpiSdCardDevice::createLock(const Config& config) {
+    auto arbiter = spi::getArbiter(config.spiHost);
+    auto bus_client = spi::getLock(config.spiHost);
+    if (config.customLock != nullptr && config.customLock != bus_client && (arbiter == nullptr || config.customLock != arbiter->getBusLock())) {
+        // The custom lock doesn't guard the bus, so it can't be arbitrated
+        return config.customLock;
+    }
+
+    if (arbiter == nullptr) {
+        return bus_client;
+    }
+
+    // File operations are interleaved with display flushes on a shared bus
+    return arbiter->createClient("SD card", spi::SpiBusArbiter::Priority::Low, pdMS_TO_TICKS(CONFIG_TT_SPI_BUS_MAX_HOLD_TIME));
+}
+
 /**
  * Before we can initialize the sdcard's SPI communications, we have to set all
  * other SPI pins on the board high.
@@ -3,11 +3,19 @@
 #include <Tactility/Logger.h>
 #include <Tactility/RecursiveMutex.h>
 
+#ifndef CONFIG_TT_SPI_BUS_MAX_HOLD_TIME
+#define CONFIG_TT_SPI_BUS_MAX_HOLD_TIME 20
+#endif
+
 namespace tt::hal::spi {
 
 static const auto LOGGER = Logger("SPI");
 
+constexpr TickType_t MAX_HOLD_TIME = pdMS_TO_TICKS(CONFIG_TT_SPI_BUS_MAX_HOLD_TIME);
+
 struct Data {
+    std::shared_ptr<SpiBusArbiter> arbiter;
+    /** The Normal priority client of the arbiter */
     std::shared_ptr<Lock> lock;
     bool isConfigured = false;
     bool isStarted = false;
@@ -22,11 +30,9 @@ bool init(const std::vector<Configuration>& configurations) {
         Data& data = dataArray[configuration.device];
         data.configuration = configuration;
         data.isConfigured = true;
-        if (configuration.lock != nullptr) {
-            data.lock = configuration.lock;
-        } else {
-            data.lock = std::make_shared<RecursiveMutex>();
-        }
+        auto bus_lock = (configuration.lock != nullptr) ? configuration.lock : std::make_shared<RecursiveMutex>();
+        data.arbiter = std::make_shared<SpiBusArbiter>(bus_lock);
+        data.lock = data.arbiter->createClient("Default", SpiBusArbiter::Priority::Normal, MAX_HOLD_TIME);
     }
 
     for (const auto& config: configurations) {
@@ -143,4 +149,8 @@ std::shared_ptr<Lock> getLock(spi_host_device_t device) {
     return dataArray[device].lock;
 }
 
+std::shared_ptr<SpiBusArbiter> getArbiter(spi_host_device_t device) {
+    return dataArray[device].arbiter;
+}
+
 }
@@ -0,0 +1,189 @@
+#include <Tactility/hal/spi/SpiBusArbiter.h>
+
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Logger.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace tt::hal::spi {
+
+static const auto LOGGER = Logger("SpiBusArbiter");
+
+constexpr int64_t TICK_MICROS = portTICK_PERIOD_MS * 1000;
+
+static size_t getHistogramBucket(int64_t micros) {
+    auto millis = static_cast<uint64_t>(micros / 1000);
+    return std::min<size_t>(std::bit_width(millis), SPI_BUS_HISTOGRAM_BUCKETS - 1);
+}
+
+static std::string histogramToString(const uint32_t (&histogram)[SPI_BUS_HISTOGRAM_BUCKETS]) {
+    std::string result;
+    for (size_t i = 0; i < SPI_BUS_HISTOGRAM_BUCKETS; ++i) {
+        if (i > 0) {
+            result += " ";
+        }
+        result += std::to_string(histogram[i]);
+    }
+    return result;
+}
+
+// region Client
+
+class SpiBusArbiter::Client final : public Lock {
+
+    SpiBusArbiter& arbiter;
+    Priority priority;
+    TickType_t maxHoldTime;
+    mutable std::atomic<TaskHandle_t> owner = nullptr;
+    // Only accessed by the owner
+    mutable uint32_t depth = 0;
+    mutable int64_t holdStart = 0;
+    Mutex statisticsMutex;
+    mutable SpiBusClientStatistics statistics {};
+
+public:
+
+    Client(SpiBusArbiter& arbiter, const std::string& name, Priority priority, TickType_t maxHoldTime) :
+        arbiter(arbiter),
+        priority(priority),
+        maxHoldTime(maxHoldTime)
+    {
+        statistics.name = name;
+    }
+
+    bool lock(TickType_t timeout) const override {
+        auto* current_task = xTaskGetCurrentTaskHandle();
+        if (owner == current_task) {
+            // Recursive locking requires a recursive bus lock
+            if (!arbiter.busLock->lock(timeout)) {
+                return false;
+            }
+            depth++;
+            return true;
+        }
+
+        const auto start_ticks = kernel::getTicks();
+        const auto start_time = kernel::getMicrosSinceBoot();
+        if (priority == Priority::Low && timeout != 0) {
+            arbiter.yieldAfterLowPriorityBurst(maxHoldTime);
+        }
+
+        TickType_t remaining = timeout;
+        if (timeout != kernel::MAX_TICKS) {
+            const auto waited = kernel::getTicks() - start_ticks;
+            remaining = (waited < timeout) ? (timeout - waited) : 0;
+        }
+
+        if (!arbiter.busLock->lock(remaining)) {
+            return false;
+        }
+
+        owner = current_task;
+        depth = 1;
+        holdStart = kernel::getMicrosSinceBoot();
+
+        const auto wait_time = holdStart - start_time;
+        statisticsMutex.withLock([this, wait_time] {
+            statistics.lockCount++;
+            statistics.maxWaitMicros = std::max(statistics.maxWaitMicros, wait_time);
+            statistics.waitHistogram[getHistogramBucket(wait_time)]++;
+        });
+
+        return true;
+    }
+
+    void unlock() const override {
+        // Not owned: e.g. a ScopedLock that failed to lock. We forward it, as the bus lock did before.
+        if (owner != xTaskGetCurrentTaskHandle()) {
+            arbiter.busLock->unlock();
+            return;
+        }
+
+        if (depth > 1) {
+            depth--;
+            arbiter.busLock->unlock();
+            return;
+        }
+
+        const auto now = kernel::getMicrosSinceBoot();
+        const auto hold_time = now - holdStart;
+        depth = 0;
+        owner = nullptr;
+        if (priority == Priority::Low) {
+            arbiter.lowPriorityLastRelease = now;
+        }
+        arbiter.busLock->unlock();
+
+        const bool overrun = hold_time > static_cast<int64_t>(maxHoldTime) * TICK_MICROS;
+        statisticsMutex.withLock([this, hold_time, overrun] {
+            statistics.maxHoldMicros = std::max(statistics.maxHoldMicros, hold_time);
+            statistics.holdHistogram[getHistogramBucket(hold_time)]++;
+            if (overrun) {
+                statistics.holdOverrunCount++;
+            }
+        });
+    }
+
+    SpiBusClientStatistics getStatistics() const {
+        auto lock = statisticsMutex.asScopedLock();
+        lock.lock();
+        return statistics;
+    }
+};
+
+// endregion
+
+// region Arbiter
+
+void SpiBusArbiter::yieldAfterLowPriorityBurst(TickType_t maxHoldTime) {
+    const auto now = kernel::getMicrosSinceBoot();
+    if (now - lowPriorityLastRelease > TICK_MICROS) {
+        // The bus was released for a while, so this starts a new series of locks
+        lowPriorityBurstStart = now;
+    } else if (now - lowPriorityBurstStart > static_cast<int64_t>(maxHoldTime) * TICK_MICROS) {
+        // Give waiting tasks a chance to take the bus
+        kernel::delayTicks(1);
+        lowPriorityBurstStart = kernel::getMicrosSinceBoot();
+    }
+}
+
+std::shared_ptr<Lock> SpiBusArbiter::createClient(const std::string& name, Priority priority, TickType_t maxHoldTime) {
+    auto client = std::make_shared<Client>(*this, name, priority, maxHoldTime);
+    auto lock = clientsMutex.asScopedLock();
+    lock.lock();
+    std::erase_if(clients, [](const auto& item) { return item.expired(); });
+    clients.push_back(client);
+    return client;
+}
+
+std::vector<SpiBusClientStatistics> SpiBusArbiter::getStatistics() const {
+    std::vector<SpiBusClientStatistics> result;
+    auto lock = clientsMutex.asScopedLock();
+    lock.lock();
+    for (const auto& item : clients) {
+        if (auto client = item.lock()) {
+            result.push_back(client->getStatistics());
+        }
+    }
+    return result;
+}
+
+void SpiBusArbiter::logStatistics() const {
+    for (const auto& statistics : getStatistics()) {
+        LOGGER.info(
+            "{}: {} locks, {} overruns, max wait {} us, max hold {} us",
+            statistics.name,
+            statistics.lockCount,
+            statistics.holdOverrunCount,
+            statistics.maxWaitMicros,
+            statistics.maxHoldMicros
+        );
+        LOGGER.info("{} wait histogram (ms buckets <1 <2 ... <128 >=128): {}", statistics.name, histogramToString(statistics.waitHistogram));
+        LOGGER.info("{} hold histogram (ms buckets <1 <2 ... <128 >=128): {}", statistics.name, histogramToString(statistics.holdHistogram));
+    }
+}
+
+// endregion
+
+}
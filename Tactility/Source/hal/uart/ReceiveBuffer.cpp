@@ -0,0 +1,115 @@
+#include <Tactility/hal/uart/ReceiveBuffer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace tt::hal::uart {
+
+constexpr uint8_t UBX_SYNC_1 = 0xB5;
+constexpr uint8_t UBX_SYNC_2 = 0x62;
+// Sync word, class, id and payload length
+constexpr size_t UBX_HEADER_SIZE = 6;
+constexpr size_t UBX_CHECKSUM_SIZE = 2;
+
+// region Framing
+
+FrameMatch findDelimitedFrame(std::span<const uint8_t> data, uint8_t delimiter) {
+    const auto* found = static_cast<const uint8_t*>(memchr(data.data(), delimiter, data.size()));
+    if (found == nullptr) {
+        return { .skipSize = 0, .frameSize = 0 };
+    }
+    return { .skipSize = 0, .frameSize = static_cast<size_t>(found - data.data()) + 1 };
+}
+
+FrameMatch findLengthPrefixedFrame(std::span<const uint8_t> data, size_t lengthOffset, uint8_t lengthSize, size_t overheadSize) {
+    assert(lengthSize == 1 || lengthSize == 2);
+    if (data.size() < lengthOffset + lengthSize) {
+        return { .skipSize = 0, .frameSize = 0 };
+    }
+
+    size_t payload_size = data[lengthOffset];
+    if (lengthSize == 2) {
+        payload_size |= static_cast<size_t>(data[lengthOffset + 1]) << 8;
+    }
+
+    const size_t frame_size = overheadSize + payload_size;
+    if (data.size() < frame_size) {
+        return { .skipSize = 0, .frameSize = 0 };
+    }
+    return { .skipSize = 0, .frameSize = frame_size };
+}
+
+FrameMatch findUbxFrame(std::span<const uint8_t> data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        const auto* sync = static_cast<const uint8_t*>(memchr(data.data() + offset, UBX_SYNC_1, data.size() - offset));
+        if (sync == nullptr) {
+            // Nothing in the data can be the start of a frame
+            return { .skipSize = data.size(), .frameSize = 0 };
+        }
+
+        offset = sync - data.data();
+        auto frame = data.subspan(offset);
+        if (frame.size() >= 2 && frame[1] != UBX_SYNC_2) {
+            offset++;
+            continue;
+        }
+
+        auto match = findLengthPrefixedFrame(frame, 4, 2, UBX_HEADER_SIZE + UBX_CHECKSUM_SIZE);
+        if (match.frameSize == 0) {
+            // Wait for the rest of the frame
+            return { .skipSize = offset, .frameSize = 0 };
+        }
+
+        // 8-bit Fletcher checksum over class, id, length and payload
+        uint8_t checksum_a = 0;
+        uint8_t checksum_b = 0;
+        const size_t checksum_offset = match.frameSize - UBX_CHECKSUM_SIZE;
+        for (size_t i = 2; i < checksum_offset; ++i) {
+            checksum_a += frame[i];
+            checksum_b += checksum_a;
+        }
+
+        if (frame[checksum_offset] == checksum_a && frame[checksum_offset + 1] == checksum_b) {
+            return { .skipSize = offset, .frameSize = match.frameSize };
+        }
+
+        // The sync word was part of other data or the frame is corrupted
+        offset++;
+    }
+
+    return { .skipSize = data.size(), .frameSize = 0 };
+}
+
+// endregion
+
+// region ReceiveBuffer
+
+std::span<uint8_t> ReceiveBuffer::getWritableSpace() {
+    // Only move the data when less than half the buffer is free at the end, so moving stays cheap
+    if (readPosition > 0 && (capacity - writePosition) < (capacity / 2)) {
+        const auto data_size = size();
+        memmove(data.get(), data.get() + readPosition, data_size);
+        readPosition = 0;
+        writePosition = data_size;
+    }
+    return { data.get() + writePosition, capacity - writePosition };
+}
+
+void ReceiveBuffer::commit(size_t size) {
+    assert(writePosition + size <= capacity);
+    writePosition += size;
+}
+
+void ReceiveBuffer::consume(size_t size) {
+    assert(size <= this->size());
+    readPosition += size;
+    if (readPosition == writePosition) {
+        clear();
+    }
+}
+
+// endregion
+
+} // namespace tt::hal::uart
@@ -2,7 +2,9 @@
 
 #include <Tactility/Logger.h>
 #include <Tactility/Mutex.h>
+#include <Tactility/kernel/Kernel.h>
 
+#include <algorithm>
 #include <ranges>
 #include <cstring>
 #include <Tactility/Tactility.h>
@@ -47,59 +49,142 @@ bool Uart::writeString(const char* buffer, TickType_t timeout) {
     return true;
 }
 
-size_t Uart::readUntil(std::byte* buffer, size_t bufferSize, uint8_t untilByte, TickType_t timeout, bool addNullTerminator) {
-    TickType_t start_time = kernel::getTicks();
-    auto* buffer_write_ptr = reinterpret_cast<uint8_t*>(buffer);
-    uint8_t* buffer_limit = buffer_write_ptr + bufferSize - 1; // Keep 1 extra char as mull terminator
-    TickType_t timeout_left = timeout;
-    while (readByte(reinterpret_cast<std::byte*>(buffer_write_ptr), timeout_left) && buffer_write_ptr < buffer_limit) {
-#ifdef DEBUG_READ_UNTIL
-        // If first successful read and we're not receiving an empty response
-        if (buffer_write_ptr == buffer && *buffer_write_ptr != 0x00U && *buffer_write_ptr != untilByte) {
-            printf(">>");
-        }
-#endif
+// region Receive buffer
 
-        if (*buffer_write_ptr == untilByte) {
-            // TODO: Fix when untilByte is null terminator char already
-            if (addNullTerminator) {
-                buffer_write_ptr++;
-                *buffer_write_ptr = 0x00U;
+bool Uart::fillReceiveBuffer(TickType_t timeout) {
+    auto space = receiveBuffer->getWritableSpace();
+    assert(!space.empty());
+
+    auto* space_data = reinterpret_cast<std::byte*>(space.data());
+    size_t read_size;
+    auto available_size = available(0);
+    if (available_size > 0) {
+        read_size = readBytes(space_data, std::min(available_size, space.size()), 0);
+    } else {
+        // Wait for the first byte, then take everything that arrived with it
+        read_size = readBytes(space_data, 1, timeout);
+        if (read_size > 0 && space.size() > 1) {
+            available_size = available(0);
+            if (available_size > 0) {
+                read_size += readBytes(space_data + 1, std::min(available_size, space.size() - 1), 0);
             }
-            break;
         }
+    }
 
-#ifdef DEBUG_READ_UNTIL
-        printf("%c", *buffer_write_ptr);
-#endif
+    receiveBuffer->commit(read_size);
+    receiveStatistics.byteCount += read_size;
+    return read_size > 0;
+}
 
-        buffer_write_ptr++;
+std::span<const uint8_t> Uart::extractFrame(const FrameFinder& finder) {
+    auto data = receiveBuffer->getData();
+    if (data.empty()) {
+        return {};
+    }
 
-        TickType_t now = kernel::getTicks();
-        if (now > (start_time + timeout)) {
-#ifdef DEBUG_READ_UNTIL
-            LOGGER.warn("readUntil() timeout");
-#endif
-            break;
-        } else {
-            timeout_left = timeout - (now - start_time);
+    auto match = finder(data);
+    if (match.skipSize > 0) {
+        receiveBuffer->consume(match.skipSize);
+        receiveStatistics.droppedByteCount += match.skipSize;
+    }
+
+    if (match.frameSize == 0) {
+        if (receiveBuffer->isFull()) {
+            LOGGER.warn("Receive buffer overrun: dropping {} bytes", receiveBuffer->size());
+            receiveStatistics.overrunCount++;
+            receiveStatistics.droppedByteCount += receiveBuffer->size();
+            receiveBuffer->clear();
         }
+        return {};
     }
 
-#ifdef DEBUG_READ_UNTIL
-    // If we read data and it's not an empty response
-    if (buffer_write_ptr != buffer && *buffer != 0x00U && *buffer != untilByte) {
-        printf("\n");
+    pendingFrameSize = match.frameSize;
+    receiveStatistics.frameCount++;
+    return receiveBuffer->getData().first(match.frameSize);
+}
+
+std::span<const uint8_t> Uart::readFrame(const FrameFinder& finder, TickType_t timeout) {
+    if (receiveBuffer == nullptr) {
+        receiveBuffer = std::make_unique<ReceiveBuffer>(defaultReceiveBufferSize);
     }
-#endif
 
-    if (addNullTerminator && (buffer_write_ptr > reinterpret_cast<uint8_t*>(buffer))) {
-        return reinterpret_cast<size_t>(buffer_write_ptr) - reinterpret_cast<size_t>(buffer) - 1UL;
-    } else {
-        return reinterpret_cast<size_t>(buffer_write_ptr) - reinterpret_cast<size_t>(buffer);
+    // Release the previous frame
+    receiveBuffer->consume(pendingFrameSize);
+    pendingFrameSize = 0;
+
+    const auto start_time = kernel::getTicks();
+    while (true) {
+        auto frame = extractFrame(finder);
+        if (!frame.empty()) {
+            return frame;
+        }
+
+        const auto elapsed = kernel::getTicks() - start_time;
+        if (elapsed > timeout || !fillReceiveBuffer(timeout - elapsed)) {
+            return {};
+        }
+    }
+}
+
+std::span<const uint8_t> Uart::readLine(uint8_t delimiter, TickType_t timeout) {
+    return readFrame([delimiter](auto data) {
+        return findDelimitedFrame(data, delimiter);
+    }, timeout);
+}
+
+std::span<const uint8_t> Uart::readUbxFrame(TickType_t timeout) {
+    return readFrame(findUbxFrame, timeout);
+}
+
+void Uart::flushInput() {
+    flushDriverInput();
+    clearReceiveBuffer();
+}
+
+void Uart::clearReceiveBuffer() {
+    if (receiveBuffer != nullptr) {
+        receiveBuffer->clear();
+    }
+    pendingFrameSize = 0;
+}
+
+void Uart::setReceiveBufferSize(size_t size) {
+    receiveBuffer = std::make_unique<ReceiveBuffer>(size);
+    pendingFrameSize = 0;
+}
+
+ReceiveStatistics Uart::getReceiveStatistics() {
+    auto statistics = receiveStatistics;
+    statistics.driverOverrunCount = getDriverOverrunCount();
+    return statistics;
+}
+
+std::string Uart::readStringUntil(char untilChar, TickType_t timeout) {
+    auto line = readLine(static_cast<uint8_t>(untilChar), timeout);
+    return { reinterpret_cast<const char*>(line.data()), line.size() };
+}
+
+size_t Uart::readUntil(std::byte* buffer, size_t bufferSize, uint8_t untilByte, TickType_t timeout, bool addNullTerminator) {
+    if (bufferSize == 0 || (addNullTerminator && bufferSize == 1)) {
+        return 0;
     }
+
+    auto line = readLine(untilByte, timeout);
+    const auto copy_limit = addNullTerminator ? (bufferSize - 1) : bufferSize;
+    const auto copy_size = std::min(line.size(), copy_limit);
+    if (line.size() > copy_limit) {
+        LOGGER.warn("readUntil() truncated {} bytes", line.size() - copy_limit);
+    }
+
+    memcpy(buffer, line.data(), copy_size);
+    if (addNullTerminator) {
+        buffer[copy_size] = std::byte { 0 };
+    }
+    return copy_size;
 }
 
+// endregion
+
 static std::unique_ptr<Uart> open(UartEntry& entry) {
     if (entry.usageId != uartIdNotInUse) {
         LOGGER.error("UART in use: {}", entry.configuration.name);
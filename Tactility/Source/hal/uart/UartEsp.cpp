@@ -13,6 +13,9 @@ namespace tt::hal::uart {
 
 static const auto LOGGER = Logger("UART");
 
+// Only used for counting overflows: the queue is emptied with every read, so a small queue is sufficient
+constexpr int EVENT_QUEUE_SIZE = 8;
+
 bool UartEsp::start() {
     LOGGER.info("[{}] Starting", configuration.name);
 
@@ -48,7 +51,7 @@ bool UartEsp::start() {
         return false;
     }
 
-    result = uart_driver_install(configuration.port, (int)configuration.rxBufferSize, (int)configuration.txBufferSize, 0, nullptr, intr_alloc_flags);
+    result = uart_driver_install(configuration.port, (int)configuration.rxBufferSize, (int)configuration.txBufferSize, EVENT_QUEUE_SIZE, &eventQueue, intr_alloc_flags);
     if (result != ESP_OK) {
         LOGGER.error("[{}] Starting: Failed to install driver: {}", configuration.name, esp_err_to_name(result));
         return false;
@@ -78,6 +81,7 @@ bool UartEsp::stop() {
     }
 
     started = false;
+    eventQueue = nullptr;
 
     LOGGER.info("[{}] Stopped", configuration.name);
     return true;
@@ -95,11 +99,14 @@ size_t UartEsp::readBytes(std::byte* buffer, size_t bufferSize, TickType_t timeo
         return false;
     }
 
+    receiveDriverEventsLocked();
+
     auto start_time = kernel::getTicks();
     auto lock_time = kernel::getTicks() - start_time;
     auto remaining_timeout = std::max(timeout - lock_time, 0UL);
-    auto result = uart_read_bytes(configuration.port, buffer, bufferSize, remaining_timeout);
-    return result;
+    const int result = uart_read_bytes(configuration.port, buffer, bufferSize, remaining_timeout);
+    // -1 on error: report it as "nothing read", because the return type is unsigned
+    return (result > 0) ? static_cast<size_t>(result) : 0;
 }
 
 bool UartEsp::readByte(std::byte* output, TickType_t timeout) {
@@ -126,10 +133,31 @@ size_t UartEsp::available(TickType_t timeout) {
     return size;
 }
 
-void UartEsp::flushInput() {
+void UartEsp::flushDriverInput() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    receiveDriverEventsLocked();
     uart_flush_input(configuration.port);
 }
 
+void UartEsp::receiveDriverEventsLocked() {
+    if (eventQueue != nullptr) {
+        uart_event_t event;
+        while (xQueueReceive(eventQueue, &event, 0) == pdTRUE) {
+            if (event.type == UART_FIFO_OVF || event.type == UART_BUFFER_FULL) {
+                driverOverrunCount++;
+            }
+        }
+    }
+}
+
+uint32_t UartEsp::getDriverOverrunCount() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    receiveDriverEventsLocked();
+    return driverOverrunCount;
+}
+
 uint32_t UartEsp::getBaudRate() {
     uint32_t baud_rate = 0;
     auto result = uart_get_baudrate(configuration.port, &baud_rate);
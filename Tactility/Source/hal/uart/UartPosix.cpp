@@ -5,6 +5,7 @@
 #include <Tactility/kernel/Kernel.h>
 #include <Tactility/Logger.h>
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 #include <sys/ioctl.h>
@@ -95,45 +96,55 @@ bool UartPosix::isStarted() const {
 size_t UartPosix::readBytes(std::byte* buffer, size_t bufferSize, TickType_t timeout) {
     auto lock = mutex.asScopedLock();
     if (!lock.lock(timeout)) {
-        return false;
+        return 0;
     }
 
-    if (awaitAvailable(timeout)) {
-        return read(fileno(device.get()), buffer, bufferSize);
-    } else {
+    if (!awaitAvailableLocked(timeout)) {
         return 0;
     }
+
+    // Reads everything that is available, up to the buffer size
+    auto result = read(fileno(device.get()), buffer, bufferSize);
+    return (result > 0) ? static_cast<size_t>(result) : 0;
 }
 
 bool UartPosix::readByte(std::byte* output, TickType_t timeout) {
-    if (awaitAvailable(timeout)) {
-        return read(fileno(device.get()), output, 1) == 1;
-    } else {
-        return false;
-    }
+    return readBytes(output, 1, timeout) == 1;
 }
 
 size_t UartPosix::writeBytes(const std::byte* buffer, size_t bufferSize, TickType_t timeout) {
-    if (!mutex.lock(timeout)) {
-        return false;
+    auto lock = mutex.asScopedLock();
+    if (!lock.lock(timeout)) {
+        return 0;
     }
 
-    return write(fileno(device.get()), buffer, bufferSize);
+    auto result = write(fileno(device.get()), buffer, bufferSize);
+    return (result > 0) ? static_cast<size_t>(result) : 0;
+}
+
+size_t UartPosix::availableLocked() const {
+    int bytes_available = 0;
+    if (ioctl(fileno(device.get()), FIONREAD, &bytes_available) != 0) {
+        return 0;
+    }
+    return static_cast<size_t>(bytes_available);
 }
 
 size_t UartPosix::available(TickType_t timeout) {
     auto lock = mutex.asScopedLock();
     if (!lock.lock(timeout)) {
-        return false;
+        return 0;
     }
 
-    uint32_t bytes_available = 0;
-    ioctl(fileno(device.get()), FIONREAD, bytes_available);
-    return bytes_available;
+    return availableLocked();
 }
 
-void UartPosix::flushInput() {
-    // TODO
+void UartPosix::flushDriverInput() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    if (device != nullptr) {
+        tcflush(fileno(device.get()), TCIFLUSH);
+    }
 }
 
 uint32_t UartPosix::getBaudRate() {
@@ -171,15 +182,16 @@ bool UartPosix::setBaudRate(uint32_t baudRate, TickType_t timeout) {
     return true;
 }
 
-bool UartPosix::awaitAvailable(TickType_t timeout) {
-    auto start_time = kernel::getTicks();
-    do {
-        if (available(timeout) > 0) {
-            return true;
+bool UartPosix::awaitAvailableLocked(TickType_t timeout) const {
+    const auto start_time = kernel::getTicks();
+    const auto poll_interval = std::max<TickType_t>(timeout / 10, 1);
+    while (availableLocked() == 0) {
+        if ((kernel::getTicks() - start_time) >= timeout) {
+            return false;
         }
-        kernel::delayTicks(timeout / 10);
-    } while ((kernel::getTicks() - start()) < timeout);
-    return false;
+        kernel::delayTicks(poll_interval);
+    }
+    return true;
 }
 
 std::unique_ptr<Uart> create(const Configuration& configuration) {
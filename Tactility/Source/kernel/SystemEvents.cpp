@@ -51,6 +51,10 @@ static const char* getEventName(SystemEvent event) {
             return TT_STRINGIFY(LvglStopped);
         case Time:
             return TT_STRINGIFY(Time);
+        case SdCardMounted:
+            return TT_STRINGIFY(SdCardMounted);
+        case SdCardUnmounted:
+            return TT_STRINGIFY(SdCardUnmounted);
     }
 
     tt_crash(); // Missing case above
@@ -0,0 +1,313 @@
+#define LV_USE_PRIVATE_API 1 // For lv_image_decoder_dsc_t declaration
+
+#include <Tactility/lvgl/ImageCache.h>
+
+#include <Tactility/Assets.h>
+#include <Tactility/file/File.h>
+#include <Tactility/file/FileLock.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Logger.h>
+#include <Tactility/MountPoints.h>
+#include <Tactility/Mutex.h>
+
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <list>
+#include <map>
+
+#ifndef CONFIG_TT_LVGL_IMAGE_CACHE_SIZE
+#define CONFIG_TT_LVGL_IMAGE_CACHE_SIZE 24
+#endif
+
+namespace tt::lvgl {
+
+static const auto LOGGER = Logger("ImageCache");
+
+constexpr size_t CACHE_SIZE = CONFIG_TT_LVGL_IMAGE_CACHE_SIZE * 1024U;
+
+// Created by Buildscripts/asset-bundle.py
+constexpr auto* BUNDLE_FILE_NAME = "assets.bundle";
+constexpr uint8_t BUNDLE_MAGIC[4] = { 'T', 'T', 'A', 'B' };
+constexpr uint32_t BUNDLE_VERSION = 1;
+
+struct ImageData {
+    lv_draw_buf_t* buffer;
+    lv_image_dsc_t descriptor;
+
+    explicit ImageData(lv_draw_buf_t* buffer) : buffer(buffer), descriptor() {
+        lv_draw_buf_to_image(buffer, &descriptor);
+    }
+
+    ~ImageData() {
+        lv_draw_buf_destroy(buffer);
+    }
+};
+
+struct CacheEntry {
+    std::string path;
+    CachedImage image;
+    size_t size;
+};
+
+struct BundleEntry {
+    uint32_t offset;
+    uint32_t size;
+};
+
+static Mutex cacheMutex;
+// Most recently used entries are at the front
+static std::list<CacheEntry> cacheEntries;
+static ImageCacheStatistics statistics = {
+    .hits = 0,
+    .misses = 0,
+    .evictions = 0,
+    .usedBytes = 0,
+    .capacityBytes = CACHE_SIZE
+};
+
+static bool bundleLoaded = false;
+// Keys are paths relative to the system mount point
+static std::map<std::string, BundleEntry> bundleEntries;
+
+// region Bundle
+
+static std::string getBundlePath() {
+    return std::format("{}/{}", file::MOUNT_POINT_SYSTEM, BUNDLE_FILE_NAME);
+}
+
+static bool readBundleIndex(FILE* file) {
+    uint8_t magic[4];
+    uint32_t header[3]; // version, color depth, entry count
+    if (
+        fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, BUNDLE_MAGIC, sizeof(magic)) != 0 ||
+        fread(header, sizeof(uint32_t), 3, file) != 3
+    ) {
+        LOGGER.error("Invalid bundle header");
+        return false;
+    }
+
+    if (header[0] != BUNDLE_VERSION || header[1] != static_cast<uint32_t>(LV_COLOR_DEPTH)) {
+        LOGGER.warn("Ignoring bundle with version {} and color depth {}", header[0], header[1]);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header[2]; ++i) {
+        uint16_t path_length;
+        BundleEntry entry;
+        std::string path;
+        if (fread(&path_length, sizeof(path_length), 1, file) != 1) {
+            return false;
+        }
+        path.resize(path_length);
+        if (
+            fread(path.data(), 1, path_length, file) != path_length ||
+            fread(&entry.offset, sizeof(uint32_t), 1, file) != 1 ||
+            fread(&entry.size, sizeof(uint32_t), 1, file) != 1
+        ) {
+            return false;
+        }
+        bundleEntries[path] = entry;
+    }
+
+    return true;
+}
+
+static void loadBundleIndex() {
+    bundleLoaded = true;
+    const auto bundle_path = getBundlePath();
+    bool success = false;
+    file::getLock(bundle_path)->withLock([&bundle_path, &success] {
+        FILE* file = fopen(bundle_path.c_str(), "rb");
+        if (file != nullptr) {
+            success = readBundleIndex(file);
+            fclose(file);
+        }
+    });
+
+    if (success) {
+        LOGGER.info("Loaded bundle with {} images", bundleEntries.size());
+    } else {
+        bundleEntries.clear();
+    }
+}
+
+static lv_draw_buf_t* loadBundledImage(const BundleEntry& entry) {
+    const auto bundle_path = getBundlePath();
+    lv_draw_buf_t* result = nullptr;
+    file::getLock(bundle_path)->withLock([&bundle_path, &entry, &result] {
+        FILE* file = fopen(bundle_path.c_str(), "rb");
+        if (file == nullptr) {
+            return;
+        }
+
+        lv_image_header_t header;
+        if (
+            fseek(file, entry.offset, SEEK_SET) == 0 &&
+            fread(&header, sizeof(header), 1, file) == 1 &&
+            header.magic == LV_IMAGE_HEADER_MAGIC
+        ) {
+            auto* buffer = lv_draw_buf_create(header.w, header.h, static_cast<lv_color_format_t>(header.cf), header.stride);
+            const auto data_size = entry.size - sizeof(header);
+            if (buffer != nullptr && data_size <= buffer->data_size && fread(buffer->data, 1, data_size, file) == data_size) {
+                result = buffer;
+            } else if (buffer != nullptr) {
+                lv_draw_buf_destroy(buffer);
+            }
+        }
+
+        fclose(file);
+    });
+
+    return result;
+}
+
+// endregion
+
+// region Cache
+
+static lv_draw_buf_t* decodeImage(const std::string& path) {
+    lv_image_decoder_dsc_t decoder_dsc;
+    if (lv_image_decoder_open(&decoder_dsc, path.c_str(), nullptr) != LV_RESULT_OK) {
+        return nullptr;
+    }
+
+    // The decoded data is freed when closing, because LVGL's own cache is disabled
+    lv_draw_buf_t* result = nullptr;
+    if (decoder_dsc.decoded != nullptr) {
+        result = lv_draw_buf_dup(decoder_dsc.decoded);
+    }
+
+    lv_image_decoder_close(&decoder_dsc);
+    return result;
+}
+
+static lv_draw_buf_t* loadImage(const std::string& path) {
+    if (!bundleLoaded) {
+        loadBundleIndex();
+    }
+
+    if (path.starts_with(TT_ASSET_FOLDER)) {
+        auto bundle_entry = bundleEntries.find(path.substr(strlen(TT_ASSET_FOLDER)));
+        if (bundle_entry != bundleEntries.end()) {
+            auto* buffer = loadBundledImage(bundle_entry->second);
+            if (buffer != nullptr) {
+                return buffer;
+            }
+            LOGGER.warn("Failed to load {} from bundle", path);
+        }
+    }
+
+    return decodeImage(path);
+}
+
+// Must be called with the cache mutex locked
+static void evictUnusedImages(size_t requiredSize) {
+    auto it = cacheEntries.end();
+    while (statistics.usedBytes + requiredSize > CACHE_SIZE && it != cacheEntries.begin()) {
+        --it;
+        // Images that are still referenced outside the cache are pinned
+        if (it->image.use_count() == 1) {
+            statistics.usedBytes -= it->size;
+            statistics.evictions++;
+            it = cacheEntries.erase(it);
+        }
+    }
+}
+
+CachedImage getCachedImage(const std::string& path) {
+    auto lock = cacheMutex.asScopedLock();
+    lock.lock();
+
+    for (auto it = cacheEntries.begin(); it != cacheEntries.end(); ++it) {
+        if (it->path == path) {
+            statistics.hits++;
+            cacheEntries.splice(cacheEntries.begin(), cacheEntries, it);
+            return it->image;
+        }
+    }
+
+    statistics.misses++;
+    const auto start_time = kernel::getMicrosSinceBoot();
+    auto* buffer = loadImage(path);
+    if (buffer == nullptr) {
+        LOGGER.error("Failed to load {}", path);
+        return nullptr;
+    }
+
+    auto data = std::make_shared<ImageData>(buffer);
+    CachedImage image(data, &data->descriptor);
+    const size_t size = buffer->data_size;
+    if (LOGGER.isLoggingDebug()) {
+        LOGGER.debug(
+            "Loaded {} in {} us ({} hits, {} misses)",
+            path,
+            kernel::getMicrosSinceBoot() - start_time,
+            statistics.hits,
+            statistics.misses
+        );
+    }
+
+    evictUnusedImages(size);
+    if (statistics.usedBytes + size > CACHE_SIZE) {
+        if (LOGGER.isLoggingDebug()) {
+            LOGGER.debug("Not caching {}: {} bytes doesn't fit", path, size);
+        }
+        return image;
+    }
+
+    cacheEntries.push_front({
+        .path = path,
+        .image = image,
+        .size = size
+    });
+    statistics.usedBytes += size;
+    return image;
+}
+
+const void* getCachedImageSource(const char* source, std::vector<CachedImage>& images) {
+    if (lv_image_src_get_type(source) != LV_IMAGE_SRC_FILE) {
+        return source;
+    }
+
+    auto image = getCachedImage(source);
+    if (image == nullptr) {
+        return source;
+    }
+
+    images.push_back(image);
+    return image.get();
+}
+
+ImageCacheStatistics getImageCacheStatistics() {
+    auto lock = cacheMutex.asScopedLock();
+    lock.lock();
+    return statistics;
+}
+
+void clearImageCache() {
+    auto lock = cacheMutex.asScopedLock();
+    lock.lock();
+    cacheEntries.remove_if([](const auto& entry) {
+        if (entry.image.use_count() == 1) {
+            statistics.usedBytes -= entry.size;
+            statistics.evictions++;
+            return true;
+        } else {
+            return false;
+        }
+    });
+    LOGGER.info(
+        "Cleared: {} hits, {} misses, {} evictions, {}/{} bytes used",
+        statistics.hits,
+        statistics.misses,
+        statistics.evictions,
+        statistics.usedBytes,
+        CACHE_SIZE
+    );
+}
+
+// endregion
+
+}
@@ -2,11 +2,9 @@
 
 #include <Tactility/kernel/SystemEvents.h>
 #include <Tactility/Logger.h>
-#include <Tactility/LogMessages.h>
-#include <Tactility/lvgl/LvglSync.h>
+#include <Tactility/lvgl/ImageCache.h>
 #include <Tactility/lvgl/Statusbar.h>
 #include <Tactility/lvgl/Style.h>
-#include <Tactility/PubSub.h>
 #include <Tactility/RecursiveMutex.h>
 #include <Tactility/settings/Time.h>
 #include <Tactility/Tactility.h>
@@ -15,6 +13,12 @@
 
 #include <lvgl.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 namespace tt::lvgl {
 
 static const auto LOGGER = Logger("statusbar");
@@ -27,9 +31,16 @@ struct StatusbarIcon {
     bool claimed = false;
 };
 
+struct Statusbar;
+
 struct StatusbarData {
     RecursiveMutex mutex;
-    std::shared_ptr<PubSub<void*>> pubsub = std::make_shared<PubSub<void*>>();
+    /** Changes are applied by updateTimer, so that all changes within a frame result in a single update */
+    std::atomic<bool> updatePending = false;
+    /** Only accessed with the LVGL lock */
+    std::vector<Statusbar*> statusbars;
+    /** Only accessed with the LVGL lock */
+    lv_timer_t* updateTimer = nullptr;
     StatusbarIcon icons[STATUSBAR_ICON_LIMIT] = {};
     Timer* time_update_timer = new Timer(Timer::Type::Once, 200 / portTICK_PERIOD_MS, [] { onUpdateTime(); });
     uint8_t time_hours = 0;
@@ -40,13 +51,14 @@ struct StatusbarData {
 
 static StatusbarData statusbar_data;
 
-typedef struct {
+struct Statusbar {
     lv_obj_t obj;
     lv_obj_t* time;
     lv_obj_t* icons[STATUSBAR_ICON_LIMIT];
+    // Keeps the images of the icons alive while they are shown
+    std::array<CachedImage, STATUSBAR_ICON_LIMIT> icon_images;
     lv_obj_t* battery_icon;
-    PubSub<void*>::SubscriptionHandle pubsub_subscription;
-} Statusbar;
+};
 
 static void statusbar_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj);
 static void statusbar_destructor(const lv_obj_class_t* class_p, lv_obj_t* obj);
@@ -79,7 +91,7 @@ static void onUpdateTime() {
             statusbar_data.time_update_timer->reset(getNextUpdateTime());
 
             // Notify widget
-            statusbar_data.pubsub->publish(nullptr);
+            statusbar_data.updatePending = true;
         } else {
             statusbar_data.time_update_timer->reset(pdMS_TO_TICKS(60000U));
         }
@@ -103,16 +115,13 @@ static const lv_obj_class_t statusbar_class = {
     .theme_inheritable = false
 };
 
-static void statusbar_pubsub_event(Statusbar* statusbar) {
-    if (LOGGER.isLoggingDebug()) {
-        LOGGER.debug("Update event");
-    }
-    if (lock(defaultLockTime)) {
-        update_main(statusbar);
-        lv_obj_invalidate(&statusbar->obj);
-        unlock();
-    } else {
-        LOGGER.warn(LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "Statusbar");
+static void onUpdateTimer(TT_UNUSED lv_timer_t* timer) {
+    // LVGL timers run with the LVGL lock acquired
+    if (statusbar_data.updatePending.exchange(false)) {
+        for (auto* statusbar : statusbar_data.statusbars) {
+            update_main(statusbar);
+            lv_obj_invalidate(&statusbar->obj);
+        }
     }
 }
 
@@ -129,9 +138,12 @@ static void statusbar_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj)
     lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
     LV_TRACE_OBJ_CREATE("finished");
     auto* statusbar = (Statusbar*)obj;
-    statusbar->pubsub_subscription = statusbar_data.pubsub->subscribe([statusbar](auto) {
-        statusbar_pubsub_event(statusbar);
-    });
+    // LVGL allocates the object, so we construct the C++ members ourselves
+    new (&statusbar->icon_images) std::array<CachedImage, STATUSBAR_ICON_LIMIT>();
+    statusbar_data.statusbars.push_back(statusbar);
+    if (statusbar_data.updateTimer == nullptr) {
+        statusbar_data.updateTimer = lv_timer_create(onUpdateTimer, LV_DEF_REFR_PERIOD, nullptr);
+    }
 
     if (!statusbar_data.time_update_timer->isRunning()) {
         statusbar_data.time_update_timer->start();
@@ -144,12 +156,24 @@ static void statusbar_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj)
 
 static void statusbar_destructor(TT_UNUSED const lv_obj_class_t* class_p, lv_obj_t* obj) {
     auto* statusbar = (Statusbar*)obj;
-    statusbar_data.pubsub->unsubscribe(statusbar->pubsub_subscription);
+    std::erase(statusbar_data.statusbars, statusbar);
+    if (statusbar_data.statusbars.empty() && statusbar_data.updateTimer != nullptr) {
+        lv_timer_delete(statusbar_data.updateTimer);
+        statusbar_data.updateTimer = nullptr;
+    }
+    std::destroy_at(&statusbar->icon_images);
 }
 
-static void update_icon(lv_obj_t* image, const StatusbarIcon* icon) {
+static void update_icon(lv_obj_t* image, CachedImage& cachedImage, const StatusbarIcon* icon) {
     if (!icon->image.empty() && icon->visible && icon->claimed) {
-        lv_image_set_src(image, icon->image.c_str());
+        auto new_image = getCachedImage(icon->image);
+        if (new_image == nullptr) {
+            lv_image_set_src(image, icon->image.c_str());
+        } else if (new_image != cachedImage) {
+            lv_image_set_src(image, new_image.get());
+        }
+        // Release the old image after LVGL stopped referring to it
+        cachedImage = std::move(new_image);
         lv_obj_remove_flag(image, LV_OBJ_FLAG_HIDDEN);
     } else {
         lv_obj_add_flag(image, LV_OBJ_FLAG_HIDDEN);
@@ -187,7 +211,7 @@ lv_obj_t* statusbar_create(lv_obj_t* parent) {
         obj_set_style_bg_blacken(image);
         statusbar->icons[i] = image;
 
-        update_icon(image, &(statusbar_data.icons[i]));
+        update_icon(image, statusbar->icon_images[i], &(statusbar_data.icons[i]));
     }
     statusbar_data.mutex.unlock();
 
@@ -209,7 +233,7 @@ static void update_main(Statusbar* statusbar) {
 
     if (statusbar_data.mutex.lock(200 / portTICK_PERIOD_MS)) {
         for (int i = 0; i < STATUSBAR_ICON_LIMIT; ++i) {
-            update_icon(statusbar->icons[i], &(statusbar_data.icons[i]));
+            update_icon(statusbar->icons[i], statusbar->icon_images[i], &(statusbar_data.icons[i]));
         }
         statusbar_data.mutex.unlock();
     }
@@ -246,7 +270,7 @@ int8_t statusbar_icon_add(const std::string& image, bool visible) {
         }
     }
     statusbar_data.mutex.unlock();
-    statusbar_data.pubsub->publish(nullptr);
+    statusbar_data.updatePending = true;
     return result;
 }
 
@@ -265,7 +289,7 @@ void statusbar_icon_remove(int8_t id) {
     icon->visible = false;
     icon->image = "";
     statusbar_data.mutex.unlock();
-    statusbar_data.pubsub->publish(nullptr);
+    statusbar_data.updatePending = true;
 }
 
 void statusbar_icon_set_image(int8_t id, const std::string& image) {
@@ -282,7 +306,7 @@ void statusbar_icon_set_image(int8_t id, const std::string& image) {
     tt_check(icon->claimed);
     icon->image = image;
     statusbar_data.mutex.unlock();
-    statusbar_data.pubsub->publish(nullptr);
+    statusbar_data.updatePending = true;
 }
 
 void statusbar_icon_set_visibility(int8_t id, bool visible) {
@@ -295,7 +319,7 @@ void statusbar_icon_set_visibility(int8_t id, bool visible) {
     tt_check(icon->claimed);
     icon->visible = visible;
     statusbar_data.mutex.unlock();
-    statusbar_data.pubsub->publish(nullptr);
+    statusbar_data.updatePending = true;
 }
 
 } // namespace
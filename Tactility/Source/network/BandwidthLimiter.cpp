@@ -0,0 +1,43 @@
+#include <Tactility/network/BandwidthLimiter.h>
+
+#include <Tactility/kernel/Kernel.h>
+
+#include <algorithm>
+
+namespace tt::network {
+
+void BandwidthLimiter::setLimit(uint32_t newBytesPerSecond) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    bytesPerSecond = newBytesPerSecond;
+    nextFreeTimeMicros = 0;
+}
+
+uint32_t BandwidthLimiter::getLimit() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return bytesPerSecond;
+}
+
+int64_t BandwidthLimiter::reserve(size_t size, int64_t nowMicros) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (bytesPerSecond == 0) {
+        return 0;
+    }
+
+    // Unused bandwidth isn't saved up: an idle period doesn't allow a burst afterwards
+    const auto start_time = std::max(nextFreeTimeMicros, nowMicros);
+    nextFreeTimeMicros = start_time + static_cast<int64_t>(size) * 1000000 / bytesPerSecond;
+    return start_time - nowMicros;
+}
+
+void BandwidthLimiter::acquire(size_t size) {
+    const auto wait_time = reserve(size, kernel::getMicrosSinceBoot());
+    if (wait_time > 0) {
+        kernel::delayMillis(static_cast<uint32_t>((wait_time + 999) / 1000));
+    }
+}
+
+} // namespace tt::network
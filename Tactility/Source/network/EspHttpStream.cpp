@@ -0,0 +1,181 @@
+#ifdef ESP_PLATFORM
+
+#include <Tactility/network/HttpStream.h>
+
+#include <Tactility/Logger.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/file/File.h>
+#include <Tactility/network/EspHttpClient.h>
+
+#include <esp_tls.h>
+
+#include <cassert>
+#include <format>
+#include <map>
+
+namespace tt::network {
+
+static const auto LOGGER = Logger("EspHttpStream");
+
+// region Certificates
+
+static Mutex certificateMutex;
+// The PEM files that were loaded, by path
+static std::map<std::string, std::shared_ptr<const std::string>> certificates;
+// The certificate that was parsed into the esp-tls global CA store, and the amount of streams that use it
+static std::string globalCaStorePath;
+static size_t globalCaStoreUsers = 0;
+
+static std::shared_ptr<const std::string> _Nullable loadCertificate(const std::string& path) {
+    auto lock = certificateMutex.asScopedLock();
+    lock.lock();
+
+    auto iterator = certificates.find(path);
+    if (iterator != certificates.end()) {
+        return iterator->second;
+    }
+
+    LOGGER.info("Loading certificate {}", path);
+    auto data = file::readString(path);
+    if (data == nullptr) {
+        return nullptr;
+    }
+
+    auto certificate = std::make_shared<const std::string>(reinterpret_cast<const char*>(data.get()));
+    certificates[path] = certificate;
+    return certificate;
+}
+
+/**
+ * Use the global CA store for a certificate, so it isn't parsed for every connection.
+ * The store holds a single certificate: it can only be replaced while no stream uses it.
+ * @return true when the global CA store holds the certificate
+ */
+static bool acquireGlobalCaStore(const std::string& path, const std::string& certificate) {
+    auto lock = certificateMutex.asScopedLock();
+    lock.lock();
+
+    if (globalCaStorePath != path) {
+        if (globalCaStoreUsers > 0) {
+            return false;
+        }
+
+        // Parsing appends to the existing chain: free it, so the previous certificate isn't trusted anymore
+        esp_tls_free_global_ca_store();
+        globalCaStorePath.clear();
+        if (esp_tls_init_global_ca_store() != ESP_OK) {
+            return false;
+        }
+
+        // The length includes the null terminator for PEM data
+        const auto* data = reinterpret_cast<const unsigned char*>(certificate.c_str());
+        if (esp_tls_set_global_ca_store(data, certificate.size() + 1) != ESP_OK) {
+            LOGGER.error("Failed to parse certificate {}", path);
+            esp_tls_free_global_ca_store();
+            globalCaStorePath.clear();
+            return false;
+        }
+        globalCaStorePath = path;
+    }
+
+    globalCaStoreUsers++;
+    return true;
+}
+
+static void releaseGlobalCaStore() {
+    auto lock = certificateMutex.asScopedLock();
+    lock.lock();
+    globalCaStoreUsers--;
+}
+
+// endregion
+
+class EspHttpStream final : public HttpStream {
+
+    std::string url;
+    std::string rangeHeader;
+    std::shared_ptr<const std::string> certificate;
+    bool usesGlobalCaStore = false;
+    std::unique_ptr<EspHttpClient> client;
+    int statusCode = 0;
+    int64_t contentLength = -1;
+
+public:
+
+    ~EspHttpStream() override {
+        // The client must be closed before the certificate is released
+        client = nullptr;
+        if (usesGlobalCaStore) {
+            releaseGlobalCaStore();
+        }
+    }
+
+    bool open(const std::string& inUrl, const std::string& certificatePath, uint64_t rangeStart) override {
+        assert(client == nullptr);
+        url = inUrl;
+        const bool is_https = url.starts_with("https://");
+
+        auto config = std::make_unique<esp_http_client_config_t>();
+        config->url = url.c_str();
+        config->auth_type = HTTP_AUTH_TYPE_NONE;
+        config->method = HTTP_METHOD_GET;
+        config->timeout_ms = 5000;
+
+        if (is_https) {
+            certificate = loadCertificate(certificatePath);
+            if (certificate == nullptr) {
+                LOGGER.error("Failed to read certificate {}", certificatePath);
+                return false;
+            }
+
+            usesGlobalCaStore = acquireGlobalCaStore(certificatePath, *certificate);
+            if (usesGlobalCaStore) {
+                config->use_global_ca_store = true;
+            } else {
+                config->cert_pem = certificate->c_str();
+                config->cert_len = certificate->size() + 1;
+            }
+            config->tls_version = ESP_HTTP_CLIENT_TLS_VER_TLS_1_3;
+            config->transport_type = HTTP_TRANSPORT_OVER_SSL;
+        } else {
+            config->transport_type = HTTP_TRANSPORT_OVER_TCP;
+        }
+
+        client = std::make_unique<EspHttpClient>();
+        if (!client->init(std::move(config))) {
+            LOGGER.error("Failed to initialize client");
+            return false;
+        }
+
+        if (rangeStart > 0) {
+            rangeHeader = std::format("bytes={}-", rangeStart);
+            if (!client->setHeader("Range", rangeHeader.c_str())) {
+                return false;
+            }
+        }
+
+        if (!client->open() || !client->fetchHeaders()) {
+            return false;
+        }
+
+        statusCode = client->getStatusCode();
+        contentLength = client->getContentLength();
+        return true;
+    }
+
+    int getStatusCode() const override { return statusCode; }
+
+    int64_t getContentLength() const override { return contentLength; }
+
+    int read(uint8_t* data, size_t size) override {
+        return client->read(reinterpret_cast<char*>(data), static_cast<int>(size));
+    }
+};
+
+std::unique_ptr<HttpStream> createHttpStream() {
+    return std::make_unique<EspHttpStream>();
+}
+
+} // namespace tt::network
+
+#endif
@@ -4,9 +4,9 @@
 #include <Tactility/StringUtils.h>
 #include <Tactility/file/File.h>
 
+#include <algorithm>
 #include <memory>
 #include <ranges>
-#include <sstream>
 
 #ifdef ESP_PLATFORM
 
@@ -14,6 +14,9 @@ namespace tt::network {
 
 static const auto LOGGER = Logger("HttpdReq");
 
+// The amount of receive timeouts in a row before a request is considered dead
+constexpr int MAX_RECEIVE_TIMEOUT_RETRIES = 5;
+
 bool getHeaderOrSendError(httpd_req_t* request, const std::string& name, std::string& value) {
     size_t header_size = httpd_req_get_hdr_value_len(request, name.c_str());
     if (header_size == 0) {
@@ -98,21 +101,17 @@ std::unique_ptr<char[]> receiveByteArray(httpd_req_t* request, size_t length, si
 }
 
 std::string receiveTextUntil(httpd_req_t* request, const std::string& terminator) {
-    size_t read_index = 0;
-    std::stringstream result;
-    while (!result.str().ends_with(terminator)) {
+    // Reading 1 byte at a time ensures that we don't read past the terminator
+    std::string result;
+    while (!result.ends_with(terminator)) {
         char buffer;
-        size_t bytes_read = httpd_req_recv(request, &buffer, 1);
-        if (bytes_read <= 0) {
+        if (httpd_req_recv(request, &buffer, 1) <= 0) {
             return "";
-        } else {
-            read_index += bytes_read;
         }
-
-        result << buffer;
+        result += buffer;
     }
 
-    return result.str();
+    return result;
 }
 
 std::map<std::string, std::string> parseContentDisposition(const std::vector<std::string>& input) {
@@ -164,8 +163,13 @@ bool readAndDiscardOrSendError(httpd_req_t* request, const std::string& toRead)
 }
 
 size_t receiveFile(httpd_req_t* request, size_t length, const std::string& filePath) {
-    constexpr auto BUFFER_SIZE = 512;
-    char buffer[BUFFER_SIZE];
+    constexpr auto BUFFER_SIZE = 4096;
+    auto buffer_holder = std::unique_ptr<char, decltype(&free)>(static_cast<char*>(malloc(BUFFER_SIZE)), free);
+    auto* buffer = buffer_holder.get();
+    if (buffer == nullptr) {
+        LOGGER.error(LOG_MESSAGE_ALLOC_FAILED_FMT, BUFFER_SIZE);
+        return 0;
+    }
     size_t bytes_received = 0;
 
     auto lock = file::getLock(filePath)->asScopedLock();
@@ -179,12 +183,12 @@ size_t receiveFile(httpd_req_t* request, size_t length, const std::string& fileP
 
     while (bytes_received < length) {
         auto expected_chunk_size = std::min<size_t>(BUFFER_SIZE, length - bytes_received);
-        size_t receive_chunk_size = httpd_req_recv(request, buffer, expected_chunk_size);
+        const int receive_chunk_size = httpd_req_recv(request, buffer, expected_chunk_size);
         if (receive_chunk_size <= 0) {
             LOGGER.error("Receive failed");
             break;
         }
-        if (fwrite(buffer, 1, receive_chunk_size, file) != receive_chunk_size) {
+        if (fwrite(buffer, 1, receive_chunk_size, file) != static_cast<size_t>(receive_chunk_size)) {
             LOGGER.error("Failed to write all bytes");
             break;
         }
@@ -196,6 +200,41 @@ size_t receiveFile(httpd_req_t* request, size_t length, const std::string& fileP
     return bytes_received;
 }
 
+bool receiveMultipart(httpd_req_t* request, MultipartParser& parser, size_t bufferSize) {
+    // We have to use malloc() because make_unique() throws an exception
+    auto buffer_holder = std::unique_ptr<uint8_t, decltype(&free)>(static_cast<uint8_t*>(malloc(bufferSize)), free);
+    auto* buffer = buffer_holder.get();
+    if (buffer == nullptr) {
+        LOGGER.error(LOG_MESSAGE_ALLOC_FAILED_FMT, bufferSize);
+        return false;
+    }
+
+    size_t content_left = request->content_len;
+    int timeout_count = 0;
+    while (content_left > 0) {
+        const int bytes_received = httpd_req_recv(request, reinterpret_cast<char*>(buffer), std::min(bufferSize, content_left));
+        if (bytes_received == HTTPD_SOCK_ERR_TIMEOUT && ++timeout_count <= MAX_RECEIVE_TIMEOUT_RETRIES) {
+            continue;
+        } else if (bytes_received <= 0) {
+            LOGGER.error("Receive failed with {} after {} bytes", bytes_received, request->content_len - content_left);
+            return false;
+        }
+        timeout_count = 0;
+
+        if (!parser.parse(buffer, bytes_received)) {
+            return false;
+        }
+        content_left -= bytes_received;
+    }
+
+    if (!parser.isFinished()) {
+        LOGGER.error("Multipart body ended without closing boundary");
+        return false;
+    }
+
+    return true;
+}
+
 }
 
 #endif // ESP_PLATFORM
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include <Tactility/network/MultipartParser.h>
+
+#include <Tactility/Logger.h>
+#include <Tactility/StringUtils.h>
+
+#include <cstring>
+
+namespace tt::network {
+
+static const auto LOGGER = Logger("MultipartParser");
+
+// region Sinks
+
+FilePartSink::~FilePartSink() {
+    if (file != nullptr && !finished) {
+        auto scoped_lock = lock->asScopedLock();
+        scoped_lock.lock();
+        file = nullptr;
+        if (remove(filePath.c_str()) != 0) {
+            LOGGER.warn("Failed to remove incomplete file {}", filePath);
+        }
+    }
+}
+
+bool FilePartSink::write(const uint8_t* data, size_t size) {
+    auto scoped_lock = lock->asScopedLock();
+    scoped_lock.lock();
+
+    if (file == nullptr) {
+        file = std::unique_ptr<FILE, file::FileCloser>(fopen(filePath.c_str(), "wb"));
+        if (file == nullptr) {
+            LOGGER.error("Failed to open {}", filePath);
+            return false;
+        }
+    }
+
+    if (fwrite(data, 1, size, file.get()) != size) {
+        LOGGER.error("Failed to write to {}", filePath);
+        return false;
+    }
+
+    bytesWritten += size;
+    return true;
+}
+
+bool FilePartSink::finish() {
+    // Create the file for empty parts
+    if (file == nullptr && !write(nullptr, 0)) {
+        return false;
+    }
+
+    auto scoped_lock = lock->asScopedLock();
+    scoped_lock.lock();
+    if (fflush(file.get()) != 0) {
+        // The destructor removes the file
+        LOGGER.error("Failed to write to {}", filePath);
+        return false;
+    }
+    file = nullptr;
+    finished = true;
+    return true;
+}
+
+bool StringPartSink::write(const uint8_t* data, size_t size) {
+    if (output.size() + size > maxSize) {
+        LOGGER.error("Part is larger than {} bytes", maxSize);
+        return false;
+    }
+    output.append(reinterpret_cast<const char*>(data), size);
+    return true;
+}
+
+// endregion
+
+// region MultipartParser
+
+void MultipartParser::fail(const char* reason) {
+    LOGGER.error("{}", reason);
+    state = State::Error;
+    sink = nullptr;
+}
+
+bool MultipartParser::emit(const uint8_t* data, size_t size) {
+    if (size == 0 || state == State::Preamble || sink == nullptr) {
+        return true;
+    }
+    return sink->write(data, size);
+}
+
+size_t MultipartParser::parseBody(const uint8_t* data, size_t size, bool& found) {
+    found = false;
+    size_t index = 0;
+
+    // Continue a match that started in the previous data
+    if (matchLength > 0) {
+        while (index < size && matchLength < delimiter.size() && data[index] == static_cast<uint8_t>(delimiter[matchLength])) {
+            index++;
+            matchLength++;
+        }
+
+        if (matchLength == delimiter.size()) {
+            matchLength = 0;
+            found = true;
+            return index;
+        } else if (index == size) {
+            return index;
+        }
+
+        // The matched bytes turned out to be data.
+        // The delimiter only contains '\r' as its first character, so none of these bytes can start a new match.
+        if (!emit(reinterpret_cast<const uint8_t*>(delimiter.data()), matchLength)) {
+            fail("Part sink failed");
+            return size;
+        }
+        matchLength = 0;
+    }
+
+    const size_t emit_start = index;
+    while (index < size) {
+        const auto* candidate = static_cast<const uint8_t*>(memchr(data + index, '\r', size - index));
+        if (candidate == nullptr) {
+            break;
+        }
+
+        const size_t candidate_index = candidate - data;
+        size_t match_index = candidate_index;
+        size_t match_length = 0;
+        while (match_index < size && match_length < delimiter.size() && data[match_index] == static_cast<uint8_t>(delimiter[match_length])) {
+            match_index++;
+            match_length++;
+        }
+
+        if (match_length == delimiter.size() || match_index == size) {
+            if (!emit(data + emit_start, candidate_index - emit_start)) {
+                fail("Part sink failed");
+                return size;
+            }
+
+            if (match_length == delimiter.size()) {
+                found = true;
+            } else {
+                // The data ends with the start of a delimiter: the next data decides whether it is one
+                matchLength = match_length;
+            }
+            return match_index;
+        }
+
+        index = candidate_index + 1;
+    }
+
+    if (!emit(data + emit_start, size - emit_start)) {
+        fail("Part sink failed");
+    }
+    return size;
+}
+
+bool MultipartParser::onDelimiter() {
+    if (state == State::Body && sink != nullptr && !sink->finish()) {
+        fail("Part sink failed to finish");
+        return false;
+    }
+
+    sink = nullptr;
+    state = State::AfterDelimiter;
+    return true;
+}
+
+bool MultipartParser::onHeadersReceived() {
+    Part part;
+    bool has_disposition = false;
+    string::split(headers, "\r\n", [&part, &has_disposition](const std::string& line) {
+        const auto separator_index = line.find(':');
+        if (separator_index == std::string::npos) {
+            return;
+        }
+
+        const auto key = string::lowercase(line.substr(0, separator_index));
+        const auto value = string::trim(line.substr(separator_index + 1), " \t");
+        if (key == "content-disposition") {
+            auto parameters = parseContentDispositionValue(value);
+            part.name = parameters["name"];
+            part.filename = parameters["filename"];
+            has_disposition = parameters["type"] == "form-data";
+        } else if (key == "content-type") {
+            part.contentType = value;
+        }
+    });
+
+    if (!has_disposition || part.name.empty()) {
+        fail("Part has no form-data disposition with a name");
+        return false;
+    }
+
+    partCount++;
+    sink = createSink(part);
+    state = State::Body;
+    matchLength = 0;
+    return true;
+}
+
+bool MultipartParser::parse(const uint8_t* data, size_t size) {
+    if (state == State::Preamble && (delimiter.size() <= 4 || delimiter.find('\r', 1) != std::string::npos)) {
+        fail("Invalid boundary");
+    }
+
+    size_t offset = 0;
+    while (offset < size && state != State::Error && state != State::Epilogue) {
+        switch (state) {
+            case State::Preamble:
+            case State::Body: {
+                bool found;
+                offset += parseBody(data + offset, size - offset, found);
+                if (found) {
+                    onDelimiter();
+                }
+                break;
+            }
+            case State::AfterDelimiter: {
+                const char character = static_cast<char>(data[offset++]);
+                if (afterDelimiterCharacter == 0) {
+                    if (character != '-' && character != '\r') {
+                        fail("Invalid data after boundary");
+                    }
+                    afterDelimiterCharacter = character;
+                } else {
+                    if (afterDelimiterCharacter == '-' && character == '-') {
+                        state = State::Epilogue;
+                    } else if (afterDelimiterCharacter == '\r' && character == '\n') {
+                        state = State::Headers;
+                        headers.clear();
+                    } else {
+                        fail("Invalid data after boundary");
+                    }
+                    afterDelimiterCharacter = 0;
+                }
+                break;
+            }
+            case State::Headers: {
+                // Headers are small, so they are collected before parsing them
+                headers += static_cast<char>(data[offset++]);
+                if (headers.size() > MAX_HEADERS_SIZE) {
+                    fail("Part headers too large");
+                } else if (headers == "\r\n" || headers.ends_with("\r\n\r\n")) {
+                    onHeadersReceived();
+                }
+                break;
+            }
+            case State::Epilogue:
+            case State::Error:
+                break;
+        }
+    }
+
+    return state != State::Error;
+}
+
+// endregion
+
+std::map<std::string, std::string> parseContentDispositionValue(const std::string& value) {
+    std::map<std::string, std::string> result;
+
+    // Split on semicolons, except for those in quoted strings
+    std::vector<std::string> tokens(1);
+    bool is_quoted = false;
+    for (size_t i = 0; i < value.size(); ++i) {
+        const char character = value[i];
+        if (is_quoted && character == '\\' && i + 1 < value.size()) {
+            tokens.back() += value[++i];
+        } else if (character == '"') {
+            is_quoted = !is_quoted;
+        } else if (character == ';' && !is_quoted) {
+            tokens.emplace_back();
+        } else {
+            tokens.back() += character;
+        }
+    }
+
+    result["type"] = string::lowercase(string::trim(tokens[0], " \t"));
+    for (size_t i = 1; i < tokens.size(); ++i) {
+        const auto separator_index = tokens[i].find('=');
+        if (separator_index != std::string::npos) {
+            const auto key = string::lowercase(string::trim(tokens[i].substr(0, separator_index), " \t"));
+            result[key] = tokens[i].substr(separator_index + 1);
+        }
+    }
+
+    return result;
+}
+
+} // namespace tt::network
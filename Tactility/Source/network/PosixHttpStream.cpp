@@ -0,0 +1,214 @@
+#ifndef ESP_PLATFORM
+
+#include <Tactility/network/HttpStream.h>
+
+#include <Tactility/Logger.h>
+#include <Tactility/StringUtils.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace tt::network {
+
+static const auto LOGGER = Logger("PosixHttpStream");
+
+constexpr int TIMEOUT_SECONDS = 5;
+constexpr size_t MAX_HEADERS_SIZE = 8192;
+
+/** The simulator's scheduler interrupts blocking calls with signals: retry those */
+static ssize_t receive(int socketHandle, void* data, size_t size) {
+    ssize_t result;
+    do {
+        result = recv(socketHandle, data, size, 0);
+    } while (result < 0 && errno == EINTR);
+    return result;
+}
+
+/**
+ * A minimal HTTP/1.0 client for the simulator.
+ * HTTP/1.0 responses aren't chunked and end when the server closes the connection.
+ */
+class PosixHttpStream final : public HttpStream {
+
+    int socketHandle = -1;
+    int statusCode = 0;
+    int64_t contentLength = -1;
+    // Body data that was received together with the headers
+    std::string pendingData;
+    size_t pendingOffset = 0;
+
+    bool connectTo(const std::string& host, const std::string& port) {
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+            LOGGER.error("Failed to resolve {}", host);
+            return false;
+        }
+
+        for (auto* address = addresses; address != nullptr; address = address->ai_next) {
+            socketHandle = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (socketHandle < 0) {
+                continue;
+            }
+
+            timeval timeout = { .tv_sec = TIMEOUT_SECONDS, .tv_usec = 0 };
+            setsockopt(socketHandle, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            setsockopt(socketHandle, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            if (connect(socketHandle, address->ai_addr, address->ai_addrlen) == 0) {
+                break;
+            }
+
+            close(socketHandle);
+            socketHandle = -1;
+        }
+
+        freeaddrinfo(addresses);
+        if (socketHandle < 0) {
+            LOGGER.error("Failed to connect to {}:{}", host, port);
+            return false;
+        }
+        return true;
+    }
+
+    bool sendAll(const std::string& data) const {
+        size_t offset = 0;
+        while (offset < data.size()) {
+            const auto sent = send(socketHandle, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            } else if (sent <= 0) {
+                return false;
+            }
+            offset += sent;
+        }
+        return true;
+    }
+
+    bool receiveHeaders(std::string& headers) {
+        char buffer[1024];
+        size_t header_end;
+        while ((header_end = headers.find("\r\n\r\n")) == std::string::npos) {
+            if (headers.size() > MAX_HEADERS_SIZE) {
+                LOGGER.error("Response headers too large");
+                return false;
+            }
+            const auto received = receive(socketHandle, buffer, sizeof(buffer));
+            if (received <= 0) {
+                LOGGER.error("Failed to receive response headers");
+                return false;
+            }
+            headers.append(buffer, received);
+        }
+
+        pendingData = headers.substr(header_end + 4);
+        headers.resize(header_end);
+        return true;
+    }
+
+    void parseHeaders(const std::string& headers) {
+        bool is_status_line = true;
+        string::split(headers, "\r\n", [this, &is_status_line](const std::string& line) {
+            if (is_status_line) {
+                // e.g. "HTTP/1.0 206 Partial Content"
+                const auto space_index = line.find(' ');
+                if (line.starts_with("HTTP/") && space_index != std::string::npos) {
+                    statusCode = atoi(line.c_str() + space_index + 1);
+                }
+                is_status_line = false;
+                return;
+            }
+
+            const auto separator_index = line.find(':');
+            if (separator_index != std::string::npos && string::lowercase(line.substr(0, separator_index)) == "content-length") {
+                contentLength = strtoll(line.c_str() + separator_index + 1, nullptr, 10);
+            }
+        });
+    }
+
+public:
+
+    ~PosixHttpStream() override {
+        if (socketHandle >= 0) {
+            close(socketHandle);
+        }
+    }
+
+    /** The certificate isn't used, because HTTPS isn't supported */
+    bool open(const std::string& url, const std::string&, uint64_t rangeStart) override {
+        constexpr std::string_view SCHEME = "http://";
+        if (!url.starts_with(SCHEME)) {
+            LOGGER.error("Only http:// URLs are supported: {}", url);
+            return false;
+        }
+
+        // Split "http://host:port/path"
+        const auto path_index = url.find('/', SCHEME.size());
+        const auto authority = url.substr(SCHEME.size(), path_index == std::string::npos ? std::string::npos : path_index - SCHEME.size());
+        const auto path = path_index == std::string::npos ? "/" : url.substr(path_index);
+        const auto port_index = authority.rfind(':');
+        const bool has_port = port_index != std::string::npos && authority.find(']', port_index) == std::string::npos;
+        auto host = has_port ? authority.substr(0, port_index) : authority;
+        const auto port = has_port ? authority.substr(port_index + 1) : "80";
+        if (host.starts_with('[') && host.ends_with(']')) {
+            host = host.substr(1, host.size() - 2);
+        }
+
+        if (host.empty() || !connectTo(host, port)) {
+            return false;
+        }
+
+        auto request = std::format("GET {} HTTP/1.0\r\nHost: {}\r\nUser-Agent: Tactility\r\nConnection: close\r\n", path, authority);
+        if (rangeStart > 0) {
+            request += std::format("Range: bytes={}-\r\n", rangeStart);
+        }
+        request += "\r\n";
+        if (!sendAll(request)) {
+            LOGGER.error("Failed to send request");
+            return false;
+        }
+
+        std::string headers;
+        if (!receiveHeaders(headers)) {
+            return false;
+        }
+
+        parseHeaders(headers);
+        return statusCode != 0;
+    }
+
+    int getStatusCode() const override { return statusCode; }
+
+    int64_t getContentLength() const override { return contentLength; }
+
+    int read(uint8_t* data, size_t size) override {
+        if (pendingOffset < pendingData.size()) {
+            const auto copy_size = std::min(size, pendingData.size() - pendingOffset);
+            memcpy(data, pendingData.data() + pendingOffset, copy_size);
+            pendingOffset += copy_size;
+            return static_cast<int>(copy_size);
+        }
+
+        const auto received = receive(socketHandle, data, size);
+        return received < 0 ? -1 : static_cast<int>(received);
+    }
+};
+
+std::unique_ptr<HttpStream> createHttpStream() {
+    return std::make_unique<PosixHttpStream>();
+}
+
+} // namespace tt::network
+
+#endif
@@ -3,17 +3,15 @@
 #include <Tactility/service/development/DevelopmentService.h>
 
 #include <Tactility/app/App.h>
+#include <Tactility/app/AppInstall.h>
 #include <Tactility/app/AppRegistration.h>
-#include <Tactility/file/File.h>
 #include <Tactility/network/HttpdReq.h>
 #include <Tactility/network/Url.h>
 #include <Tactility/Logger.h>
-#include <Tactility/Paths.h>
 #include <Tactility/service/development/DevelopmentSettings.h>
 #include <Tactility/service/ServiceRegistration.h>
 #include <Tactility/StringUtils.h>
 
-#include <ranges>
 #include <sstream>
 
 namespace tt::service::development {
@@ -22,6 +20,28 @@ extern const ServiceManifest manifest;
 
 static const auto LOGGER = Logger("DevService");
 
+/** Passes an uploaded app archive to an install stream */
+class AppInstallPartSink final : public network::PartSink {
+
+    app::AppInstallStream& stream;
+
+public:
+
+    explicit AppInstallPartSink(app::AppInstallStream& stream) : stream(stream) {}
+
+    bool write(const uint8_t* data, size_t size) override {
+        return stream.write(data, size);
+    }
+
+    bool finish() override {
+        if (!stream.isComplete()) {
+            LOGGER.error("Uploaded archive is incomplete");
+            return false;
+        }
+        return true;
+    }
+};
+
 bool DevelopmentService::onStart(ServiceContext& service) {
     std::stringstream stream;
     stream << "{";
@@ -40,6 +60,17 @@ void DevelopmentService::onStop(ServiceContext& service) {
     setEnabled(false);
 }
 
+void DevelopmentService::stopScreenStream() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (screenStreamThread != nullptr) {
+        screenStreamInterrupted = true;
+        screenStreamThread->join();
+        screenStreamThread = nullptr;
+    }
+}
+
 // region Enable/disable
 
 void DevelopmentService::setEnabled(bool enabled) {
@@ -51,6 +82,8 @@ void DevelopmentService::setEnabled(bool enabled) {
             httpServer.start();
         }
     } else {
+        // The stream holds a request of the server
+        stopScreenStream();
         if (httpServer.isStarted()) {
             httpServer.stop();
         }
@@ -118,76 +151,49 @@ esp_err_t DevelopmentService::handleAppInstall(httpd_req_t* request) {
 
     std::string boundary;
     if (!network::getMultiPartBoundaryOrSendError(request, boundary)) {
-        return false;
-    }
-
-    size_t content_left = request->content_len;
-
-    // Skip newline after reading boundary
-    auto content_headers_data = network::receiveTextUntil(request, "\r\n\r\n");
-    content_left -= content_headers_data.length();
-    auto content_headers = string::split(content_headers_data, "\r\n")
-        | std::views::filter([](const std::string& line) {
-            return line.length() > 0;
-        })
-        | std::ranges::to<std::vector>();
-
-    auto content_disposition_map = network::parseContentDisposition(content_headers);
-    if (content_disposition_map.empty()) {
-        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Multipart form error: invalid content disposition");
-        return ESP_FAIL;
-    }
-
-    auto name_entry = content_disposition_map.find("name");
-    auto filename_entry = content_disposition_map.find("filename");
-    if (
-        name_entry == content_disposition_map.end() ||
-        filename_entry == content_disposition_map.end() ||
-        name_entry->second != "elf"
-    ) {
-        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Multipart form error: name or filename parameter missing or mismatching");
         return ESP_FAIL;
     }
 
-    // Receive boundary
-    auto boundary_and_newlines_after_file = std::format("\r\n--{}--\r\n", boundary);
-    auto file_size = content_left - boundary_and_newlines_after_file.length();
+    // The archive is extracted while it is received: it is never stored as a whole
+    std::unique_ptr<app::AppInstallStream> install_stream;
+    std::string filename;
+    std::string expected_sha256;
+    bool has_invalid_filename = false;
+    network::MultipartParser parser(boundary, [&](const network::MultipartParser::Part& part) -> std::unique_ptr<network::PartSink> {
+        if (part.name == "sha256") {
+            return std::make_unique<network::StringPartSink>(expected_sha256, 64);
+        }
 
-    // Create tmp directory
-    const std::string tmp_path = getTempPath();
-    if (!file::findOrCreateDirectory(tmp_path, 0777)) {
-        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to save file");
-        return ESP_FAIL;
-    }
+        if (part.name != "elf" || install_stream != nullptr) {
+            return nullptr;
+        }
 
-    auto file_path = std::format("{}/{}", tmp_path, filename_entry->second);
-    if (network::receiveFile(request, file_size, file_path) != file_size) {
-        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to save file");
-        return ESP_FAIL;
-    }
+        if (part.filename.empty() || part.filename == "." || part.filename == ".." || part.filename.find_first_of("/\\") != std::string::npos) {
+            has_invalid_filename = true;
+            return nullptr;
+        }
 
-    content_left -= file_size;
+        filename = part.filename;
+        install_stream = std::make_unique<app::AppInstallStream>(filename);
+        return std::make_unique<AppInstallPartSink>(*install_stream);
+    });
 
-    // Read and verify part
-    if (!network::readAndDiscardOrSendError(request, boundary_and_newlines_after_file)) {
+    if (!network::receiveMultipart(request, parser)) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Multipart form error: failed to receive or extract the form data");
         return ESP_FAIL;
     }
-    content_left -= boundary_and_newlines_after_file.length();
 
-    if (content_left != 0) {
-        LOGGER.warn("We have more bytes at the end of the request parsing?!");
+    if (has_invalid_filename || install_stream == nullptr) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Multipart form error: elf part or filename missing or invalid");
+        return ESP_FAIL;
     }
 
-    if (!app::install(file_path)) {
+    if (!install_stream->commit(string::lowercase(string::trim(expected_sha256, " \t\r\n")))) {
         httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to install");
         return ESP_FAIL;
     }
 
-    if (!file::deleteFile(file_path)) {
-        LOGGER.warn("Failed to delete {}", file_path);
-    }
-
-    LOGGER.info("[200] /app/install -> {}", file_path);
+    LOGGER.info("[200] /app/install -> {}", filename);
 
     httpd_resp_send(request, nullptr, 0);
 
@@ -227,6 +233,69 @@ esp_err_t DevelopmentService::handleAppUninstall(httpd_req_t* request) {
     }
 }
 
+esp_err_t DevelopmentService::handleScreen(httpd_req_t* request) {
+    LOGGER.info("GET /screen");
+
+    auto* service = static_cast<DevelopmentService*>(request->user_ctx);
+    auto lock = service->mutex.asScopedLock();
+    lock.lock();
+
+    if (service->screenStreamThread != nullptr) {
+        if (service->screenStreamThread->getState() != Thread::State::Stopped) {
+            LOGGER.warn("[409] /screen is already streaming");
+            httpd_resp_set_status(request, "409 Conflict");
+            httpd_resp_sendstr(request, "Already streaming");
+            return ESP_OK;
+        }
+        service->screenStreamThread->join();
+        service->screenStreamThread = nullptr;
+    }
+
+    // The stream runs on its own thread, so the server can keep handling other requests
+    httpd_req_t* async_request;
+    if (httpd_req_async_handler_begin(request, &async_request) != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to start stream");
+        return ESP_FAIL;
+    }
+
+    service->screenStreamInterrupted = false;
+    service->screenStreamThread = std::make_unique<Thread>(
+        "screen_stream",
+        6144,
+        [service, async_request] {
+            service->streamScreen(async_request);
+            return 0;
+        }
+    );
+    service->screenStreamThread->start();
+
+    return ESP_OK;
+}
+
+void DevelopmentService::streamScreen(httpd_req_t* request) {
+    httpd_resp_set_type(request, "application/octet-stream");
+    httpd_resp_set_hdr(request, "Cache-Control", "no-store");
+
+    const bool started = screenStreamer.run(
+        [request](const uint8_t* data, size_t size) {
+            return httpd_resp_send_chunk(request, reinterpret_cast<const char*>(data), size) == ESP_OK;
+        },
+        [this] {
+            return screenStreamInterrupted.load();
+        }
+    );
+
+    if (started) {
+        // Ends the chunked response (which fails silently when the client disconnected)
+        httpd_resp_send_chunk(request, nullptr, 0);
+        LOGGER.info("[200] /screen");
+    } else {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to start stream");
+    }
+
+    httpd_req_async_handler_complete(request);
+}
+
 // endregion
 
 std::shared_ptr<DevelopmentService> findService() {
@@ -0,0 +1,71 @@
+#include <Tactility/service/development/ScreenStream.h>
+
+#include <algorithm>
+
+namespace tt::service::development {
+
+static void putUint16(uint8_t* destination, uint16_t value) {
+    destination[0] = value >> 8;
+    destination[1] = value;
+}
+
+static void putUint32(uint8_t* destination, uint32_t value) {
+    destination[0] = value >> 24;
+    destination[1] = value >> 16;
+    destination[2] = value >> 8;
+    destination[3] = value;
+}
+
+// region ScreenStreamEncoder
+
+bool ScreenStreamEncoder::writeHeader(uint16_t width, uint16_t height) {
+    uint8_t header[9] = { 'T', 'T', 'S', 'S', VERSION };
+    putUint16(header + 5, width);
+    putUint16(header + 7, height);
+    frameCount = 0;
+    return output(header, sizeof(header));
+}
+
+bool ScreenStreamEncoder::beginFrame(uint16_t regionCount) {
+    uint8_t header[10] = { 'F', 'R', 'A', 'M' };
+    putUint32(header + 4, frameCount);
+    putUint16(header + 8, regionCount);
+    frameCount++;
+    return output(header, sizeof(header));
+}
+
+bool ScreenStreamEncoder::beginRegion(const hal::display::Region& region) {
+    const auto width = static_cast<uint16_t>(region.xEnd - region.xStart);
+    const auto height = static_cast<uint16_t>(region.yEnd - region.yStart);
+    uint8_t header[8];
+    putUint16(header, region.xStart);
+    putUint16(header + 2, region.yStart);
+    putUint16(header + 4, width);
+    putUint16(header + 6, height);
+    return output(header, sizeof(header)) && writer.begin(width, height);
+}
+
+// endregion
+
+// region FrameRateController
+
+void FrameRateController::onFrameSent(size_t size, uint32_t durationMs) {
+    const uint32_t throughput = static_cast<uint32_t>(std::min<uint64_t>(size * 1000ULL / std::max<uint32_t>(durationMs, 1), UINT32_MAX));
+    if (!hasSamples) {
+        averageSendTimeMs = durationMs;
+        averageThroughput = throughput;
+        hasSamples = true;
+    } else {
+        // Weigh the new sample for 1/4th, so a single slow frame doesn't halve the frame rate
+        averageSendTimeMs = (averageSendTimeMs * 3 + durationMs) / 4;
+        averageThroughput = static_cast<uint32_t>((static_cast<uint64_t>(averageThroughput) * 3 + throughput) / 4);
+    }
+}
+
+uint32_t FrameRateController::getFrameIntervalMs() const {
+    return std::clamp(averageSendTimeMs * 2, configuration.minimumIntervalMs, configuration.maximumIntervalMs);
+}
+
+// endregion
+
+} // namespace tt::service::development
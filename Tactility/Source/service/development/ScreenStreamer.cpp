@@ -0,0 +1,139 @@
+#include <Tactility/service/development/ScreenStreamer.h>
+
+#include <Tactility/Logger.h>
+#include <Tactility/LogMessages.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/lvgl/LvglSync.h>
+
+#include <lv_screenshot.h>
+
+#include <algorithm>
+
+namespace tt::service::development {
+
+static const auto LOGGER = Logger("ScreenStreamer");
+
+constexpr TickType_t BAND_LOCK_TIMEOUT = 100 / portTICK_PERIOD_MS;
+
+void ScreenStreamer::onInvalidateArea(lv_event_t* event) {
+    auto* streamer = static_cast<ScreenStreamer*>(lv_event_get_user_data(event));
+    const auto* area = static_cast<const lv_area_t*>(lv_event_get_param(event));
+    streamer->dirtyRegions.add({
+        .xStart = area->x1,
+        .yStart = area->y1,
+        .xEnd = area->x2 + 1,
+        .yEnd = area->y2 + 1
+    });
+}
+
+bool ScreenStreamer::sendRegion(ScreenStreamEncoder& encoder, lv_draw_buf_t* band, const hal::display::Region& region, const IsInterrupted& isInterrupted) {
+    if (!encoder.beginRegion(region)) {
+        return false;
+    }
+
+    const auto width = region.xEnd - region.xStart;
+    for (int band_start = region.yStart; band_start < region.yEnd; band_start += BAND_HEIGHT) {
+        const int band_end = std::min<int>(band_start + BAND_HEIGHT, region.yEnd);
+        const lv_area_t area = {
+            .x1 = region.xStart,
+            .y1 = band_start,
+            .x2 = region.xEnd - 1,
+            .y2 = band_end - 1
+        };
+
+        // The region was started, so wait for the lock instead of ending the stream when LVGL is busy
+        while (!lvgl::lock(BAND_LOCK_TIMEOUT)) {
+            if (isInterrupted()) {
+                return false;
+            }
+        }
+        const bool rendered = lv_screenshot_take_area(lv_display_get_screen_active(display), band, &area);
+        lvgl::unlock();
+
+        if (!rendered) {
+            LOGGER.error("Failed to render ({}, {}) to ({}, {})", area.x1, area.y1, area.x2, area.y2);
+            return false;
+        }
+
+        // LVGL stores RGB888 as B, G, R in memory
+        for (int row = 0; row < band_end - band_start; ++row) {
+            auto* row_data = band->data + static_cast<size_t>(row) * band->header.stride;
+            file::convertBgr888ToRgb888(row_data, row_data, width);
+            if (!encoder.writeRow(row_data)) {
+                return false;
+            }
+        }
+    }
+
+    return encoder.finishRegion();
+}
+
+bool ScreenStreamer::run(const file::ImageWriter::Output& output, const IsInterrupted& isInterrupted) {
+    size_t bytes_sent = 0;
+    ScreenStreamEncoder encoder([&output, &bytes_sent](const uint8_t* data, size_t size) {
+        bytes_sent += size;
+        return output(data, size);
+    });
+
+    if (!lvgl::lock(lvgl::defaultLockTime)) {
+        LOGGER.error(LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
+        return false;
+    }
+    display = lv_display_get_default();
+    const auto width = static_cast<uint16_t>(lv_display_get_horizontal_resolution(display));
+    const auto height = static_cast<uint16_t>(lv_display_get_vertical_resolution(display));
+    lv_draw_buf_t* band = lv_draw_buf_create(width, BAND_HEIGHT, LV_COLOR_FORMAT_RGB888, LV_STRIDE_AUTO);
+    // The first frame contains the full screen
+    dirtyRegions.take();
+    dirtyRegions.add({ .xStart = 0, .yStart = 0, .xEnd = width, .yEnd = height });
+    lv_display_add_event_cb(display, onInvalidateArea, LV_EVENT_INVALIDATE_AREA, this);
+    lvgl::unlock();
+
+    bool started = false;
+    if (band == nullptr) {
+        LOGGER.error("Failed to allocate a band of {}x{}", width, BAND_HEIGHT);
+    } else if (encoder.writeHeader(width, height)) {
+        started = true;
+        LOGGER.info("Streaming {}x{}", width, height);
+        auto last_frame_time = kernel::getMillis();
+        bool success = true;
+        while (success && !isInterrupted()) {
+            kernel::delayMillis(frameRateController.getFrameIntervalMs());
+
+            if (!lvgl::lock(BAND_LOCK_TIMEOUT)) {
+                continue;
+            }
+            const auto regions = dirtyRegions.take();
+            lvgl::unlock();
+
+            const auto frame_start_time = kernel::getMillis();
+            if (regions.empty() && frame_start_time - last_frame_time < KEEP_ALIVE_INTERVAL_MS) {
+                continue;
+            }
+
+            bytes_sent = 0;
+            success = encoder.beginFrame(regions.size());
+            for (const auto& region : regions) {
+                if (!success) {
+                    break;
+                }
+                success = sendRegion(encoder, band, region, isInterrupted);
+            }
+
+            last_frame_time = kernel::getMillis();
+            frameRateController.onFrameSent(bytes_sent, last_frame_time - frame_start_time);
+        }
+        LOGGER.info("Stopped streaming after {} frames ({} bytes/s)", encoder.getFrameCount(), frameRateController.getThroughput());
+    }
+
+    lvgl::lock(portMAX_DELAY);
+    lv_display_remove_event_cb_with_user_data(display, onInvalidateArea, this);
+    if (band != nullptr) {
+        lv_draw_buf_destroy(band);
+    }
+    lvgl::unlock();
+
+    return started;
+}
+
+} // namespace tt::service::development
@@ -7,6 +7,8 @@
 #include <Tactility/settings/DisplaySettings.h>
 #include <Tactility/Timer.h>
 
+#include <atomic>
+
 namespace tt::service::displayidle {
 
 class DisplayIdleService final : public Service {
@@ -15,8 +17,16 @@ class DisplayIdleService final : public Service {
     bool displayDimmed = false;
     settings::display::DisplaySettings cachedDisplaySettings;
 
-    static std::shared_ptr<hal::display::DisplayDevice> getDisplay() {
-        return hal::findFirstDevice<hal::display::DisplayDevice>(hal::Device::Type::Display);
+    std::shared_ptr<hal::display::DisplayDevice> cachedDisplay;
+    std::atomic<bool> displayChanged = true;
+    PubSub<hal::DeviceEvent>::SubscriptionHandle deviceSubscription = nullptr;
+
+    std::shared_ptr<hal::display::DisplayDevice> getDisplay() {
+        // Only query the device registry when a display was registered or deregistered
+        if (displayChanged.exchange(false)) {
+            cachedDisplay = hal::findFirstDevice<hal::display::DisplayDevice>(hal::Device::Type::Display);
+        }
+        return cachedDisplay;
     }
 
     void tick() {
@@ -67,6 +77,12 @@ public:
         // Note: Settings changes require service restart to take effect
         // TODO: Add DisplaySettingsChanged events for dynamic updates
         
+        deviceSubscription = hal::getDevicePubsub()->subscribe([this](const auto& event) {
+            if (event.device->getType() == hal::Device::Type::Display) {
+                displayChanged = true;
+            }
+        });
+
         timer = std::make_unique<Timer>(Timer::Type::Periodic, kernel::millisToTicks(250), [this]{ this->tick(); });
         timer->setCallbackPriority(Thread::Priority::Lower);
         timer->start();
@@ -78,6 +94,11 @@ public:
             timer->stop();
             timer = nullptr;
         }
+        if (deviceSubscription != nullptr) {
+            // Waits for a callback that is running, so the callback doesn't use this service after it's stopped
+            hal::getDevicePubsub()->unsubscribe(deviceSubscription);
+            deviceSubscription = nullptr;
+        }
         // Ensure display restored on stop
         auto display = getDisplay();
         if (display && displayDimmed) {
@@ -0,0 +1,186 @@
+#include <Tactility/service/download/DownloadService.h>
+
+#include <Tactility/Logger.h>
+#include <Tactility/service/ServiceManifest.h>
+#include <Tactility/service/ServiceRegistration.h>
+
+#include <algorithm>
+#include <format>
+
+namespace tt::service::download {
+
+static const auto LOGGER = Logger("DownloadService");
+extern const ServiceManifest manifest;
+
+// TLS handshakes need a large stack
+constexpr size_t WORKER_STACK_SIZE = 8192;
+
+bool DownloadService::onStart(ServiceContext& serviceContext) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    started = true;
+    return true;
+}
+
+void DownloadService::onStop(ServiceContext& serviceContext) {
+    mutex.lock();
+    started = false;
+    // The workers won't run the queued downloads anymore
+    auto cancelled_downloads = std::move(queuedDownloads);
+    queuedDownloads.clear();
+    for (const auto& cancelled_download : cancelled_downloads) {
+        activeDownloadIds.erase(cancelled_download.first);
+    }
+    // Make the running downloads stop at their next read
+    cancelledDownloadIds = activeDownloadIds;
+    auto stopped_workers = std::move(workers);
+    workers.clear();
+    mutex.unlock();
+
+    // Don't hold the mutex, because the downloads check for cancellation
+    for (auto& worker : stopped_workers) {
+        if (worker.thread != nullptr) {
+            worker.thread->stop();
+        }
+    }
+
+    for (const auto& [id, on_finished] : cancelled_downloads) {
+        LOGGER.info("Cancelled queued download {}", id);
+        pubSub->publish({ .id = id, .state = DownloadState::Failed, .bytesReceived = 0, .totalBytes = 0, .errorMessage = "Cancelled" });
+        if (on_finished != nullptr) {
+            on_finished(false, "Cancelled");
+        }
+    }
+}
+
+bool DownloadService::isCancelled(DownloadId id) const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return cancelledDownloadIds.contains(id);
+}
+
+void DownloadService::run(DownloadId id, size_t workerIndex, const DownloadRequest& request) {
+    mutex.lock();
+    auto queued_download = queuedDownloads.find(id);
+    if (queued_download == queuedDownloads.end()) {
+        // The service was stopped and onStop() already reported the failure
+        mutex.unlock();
+        return;
+    }
+    const auto on_finished = std::move(queued_download->second);
+    queuedDownloads.erase(queued_download);
+    const Downloader::Configuration downloader_configuration = {
+        .bufferSize = configuration.bufferSize,
+        .retryCount = configuration.retryCount
+    };
+    mutex.unlock();
+
+    bool success = false;
+    const char* error_message = "Cancelled";
+    if (!isCancelled(id)) {
+        pubSub->publish({ .id = id, .state = DownloadState::Started, .bytesReceived = 0, .totalBytes = 0, .errorMessage = nullptr });
+
+        Downloader downloader(downloader_configuration, network::createHttpStream, &bandwidthLimiter);
+        success = downloader.run(
+            request,
+            [this, id](uint64_t bytesReceived, uint64_t totalBytes) {
+                pubSub->publish({ .id = id, .state = DownloadState::Progress, .bytesReceived = bytesReceived, .totalBytes = totalBytes, .errorMessage = nullptr });
+            },
+            [this, id] {
+                return isCancelled(id);
+            }
+        );
+        error_message = downloader.getErrorMessage();
+    }
+
+    mutex.lock();
+    activeDownloadIds.erase(id);
+    cancelledDownloadIds.erase(id);
+    if (workerIndex < workers.size()) {
+        workers[workerIndex].downloadCount--;
+    }
+    mutex.unlock();
+
+    pubSub->publish({
+        .id = id,
+        .state = success ? DownloadState::Finished : DownloadState::Failed,
+        .bytesReceived = 0,
+        .totalBytes = 0,
+        .errorMessage = success ? nullptr : error_message
+    });
+
+    if (on_finished != nullptr) {
+        on_finished(success, success ? nullptr : error_message);
+    }
+}
+
+DownloadId DownloadService::download(const DownloadRequest& request, OnFinished onFinished) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (!started) {
+        LOGGER.error("Can't download {}: service not started", request.url);
+        return 0;
+    }
+
+    // Use the worker with the least downloads
+    const size_t worker_count = std::max<size_t>(configuration.maxConcurrentDownloads, 1);
+    if (workers.size() < worker_count) {
+        workers.resize(worker_count);
+    }
+    size_t worker_index = 0;
+    for (size_t i = 1; i < worker_count; ++i) {
+        if (workers[i].downloadCount < workers[worker_index].downloadCount) {
+            worker_index = i;
+        }
+    }
+
+    auto& worker = workers[worker_index];
+    if (worker.thread == nullptr) {
+        worker.thread = std::make_unique<DispatcherThread>(std::format("download_{}", worker_index), WORKER_STACK_SIZE);
+        worker.thread->start();
+    }
+
+    const auto id = ++lastDownloadId;
+    worker.downloadCount++;
+    activeDownloadIds.insert(id);
+    queuedDownloads[id] = std::move(onFinished);
+    worker.thread->dispatch([this, id, worker_index, request] {
+        run(id, worker_index, request);
+    });
+
+    LOGGER.info("Queued download {} of {}", id, request.url);
+    return id;
+}
+
+void DownloadService::cancel(DownloadId id) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    if (activeDownloadIds.contains(id)) {
+        cancelledDownloadIds.insert(id);
+    }
+}
+
+void DownloadService::setConfiguration(const Configuration& newConfiguration) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    configuration = newConfiguration;
+    bandwidthLimiter.setLimit(newConfiguration.maxBytesPerSecond);
+}
+
+DownloadService::Configuration DownloadService::getConfiguration() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return configuration;
+}
+
+std::shared_ptr<DownloadService> _Nullable findDownloadService() {
+    return findServiceById<DownloadService>(manifest.id);
+}
+
+extern const ServiceManifest manifest = {
+    .id = "Download",
+    .createService = create<DownloadService>
+};
+
+} // namespace tt::service::download
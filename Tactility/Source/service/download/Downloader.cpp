@@ -0,0 +1,217 @@
+#include <Tactility/service/download/Downloader.h>
+
+#include <Tactility/Logger.h>
+#include <Tactility/file/File.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace tt::service::download {
+
+static const auto LOGGER = Logger("Downloader");
+
+bool Downloader::hashPartialFile(const std::string& partPath, uint8_t* buffer, uint64_t& size, crypt::Sha256& hash) {
+    auto lock = file::getLock(partPath)->asScopedLock();
+    lock.lock();
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(partPath.c_str(), "rb"));
+    lock.unlock();
+    if (file == nullptr) {
+        return false;
+    }
+
+    // The lock is only held per read, so a large partial file doesn't block a shared SPI bus
+    size = 0;
+    while (true) {
+        lock.lock();
+        const auto read_size = fread(buffer, 1, configuration.bufferSize, file.get());
+        const bool read_error = ferror(file.get()) != 0;
+        lock.unlock();
+
+        if (read_error) {
+            return false;
+        } else if (read_size == 0) {
+            break;
+        }
+
+        hash.update(buffer, read_size);
+        size += read_size;
+    }
+
+    lock.lock();
+    file = nullptr;
+    return true;
+}
+
+Downloader::TransferResult Downloader::transfer(
+    network::HttpStream& stream,
+    const DownloadRequest& request,
+    const std::string& partPath,
+    uint8_t* buffer,
+    uint64_t& offset,
+    crypt::Sha256& hash,
+    const OnProgress& onProgress,
+    const IsCancelled& isCancelled
+) {
+    if (!stream.open(request.url, request.certificatePath, offset)) {
+        errorMessage = "Failed to open connection";
+        return TransferResult::Retry;
+    }
+
+    const auto status_code = stream.getStatusCode();
+    if (status_code == 200 && offset > 0) {
+        // The server doesn't support range requests: start over
+        LOGGER.info("Server ignored range request: restarting download");
+        offset = 0;
+        hash.reset();
+    } else if (status_code == 416 && offset > 0) {
+        // The partial file isn't a part of the current file
+        LOGGER.warn("Partial file is larger than the file: restarting download");
+        offset = 0;
+        hash.reset();
+        errorMessage = "Range not satisfiable";
+        return TransferResult::Retry;
+    } else if (status_code >= 500) {
+        errorMessage = "Server error";
+        return TransferResult::Retry;
+    } else if (status_code != 200 && status_code != 206) {
+        LOGGER.error("Unexpected status code {}", status_code);
+        errorMessage = "Server response is not OK";
+        return TransferResult::Failed;
+    }
+
+    const auto content_length = stream.getContentLength();
+    const uint64_t total_bytes = content_length >= 0 ? offset + content_length : 0;
+
+    auto lock = file::getLock(partPath)->asScopedLock();
+    lock.lock();
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(partPath.c_str(), offset == 0 ? "wb" : "ab"));
+    lock.unlock();
+    if (file == nullptr) {
+        errorMessage = "Failed to open file";
+        return TransferResult::Failed;
+    }
+
+    auto result = TransferResult::Finished;
+    auto last_progress_time = kernel::getMillis();
+    while (total_bytes == 0 || offset < total_bytes) {
+        if (isCancelled != nullptr && isCancelled()) {
+            errorMessage = "Cancelled";
+            result = TransferResult::Failed;
+            break;
+        }
+
+        const int read_size = stream.read(buffer, configuration.bufferSize);
+        if (read_size < 0 || (read_size == 0 && total_bytes != 0)) {
+            errorMessage = "Failed to read data";
+            result = TransferResult::Retry;
+            break;
+        } else if (read_size == 0) {
+            // The end of a response without a Content-Length
+            break;
+        }
+
+        if (bandwidthLimiter != nullptr) {
+            bandwidthLimiter->acquire(read_size);
+        }
+
+        lock.lock();
+        const bool write_success = fwrite(buffer, 1, read_size, file.get()) == static_cast<size_t>(read_size);
+        lock.unlock();
+        if (!write_success) {
+            errorMessage = "Failed to write all bytes";
+            result = TransferResult::Failed;
+            break;
+        }
+
+        hash.update(buffer, read_size);
+        offset += read_size;
+
+        const auto now = kernel::getMillis();
+        if (onProgress != nullptr && now - last_progress_time >= configuration.progressIntervalMs) {
+            last_progress_time = now;
+            onProgress(offset, total_bytes);
+        }
+    }
+
+    lock.lock();
+    // Data that couldn't be flushed isn't part of the file
+    if (fflush(file.get()) != 0) {
+        errorMessage = "Failed to write all bytes";
+        result = TransferResult::Failed;
+    }
+    file = nullptr;
+    lock.unlock();
+
+    if (result == TransferResult::Finished && onProgress != nullptr) {
+        onProgress(offset, total_bytes);
+    }
+    return result;
+}
+
+bool Downloader::run(const DownloadRequest& request, const OnProgress& onProgress, const IsCancelled& isCancelled) {
+    LOGGER.info("Downloading {} to {}", request.url, request.filePath);
+    errorMessage = nullptr;
+
+    auto buffer = std::unique_ptr<uint8_t, decltype(&free)>(static_cast<uint8_t*>(malloc(configuration.bufferSize)), free);
+    if (buffer == nullptr) {
+        errorMessage = "Out of memory";
+        return false;
+    }
+
+    const auto part_path = request.filePath + ".part";
+    crypt::Sha256 hash;
+    uint64_t offset = 0;
+    if (request.resume && file::isFile(part_path)) {
+        if (hashPartialFile(part_path, buffer.get(), offset, hash)) {
+            LOGGER.info("Resuming download at {} bytes", offset);
+        } else {
+            offset = 0;
+            hash.reset();
+        }
+    }
+
+    uint8_t retry_count = 0;
+    while (true) {
+        auto stream = createStream();
+        const auto result = transfer(*stream, request, part_path, buffer.get(), offset, hash, onProgress, isCancelled);
+        stream = nullptr;
+
+        if (result == TransferResult::Finished) {
+            break;
+        } else if (result == TransferResult::Failed || retry_count >= configuration.retryCount || (isCancelled != nullptr && isCancelled())) {
+            LOGGER.error("Download of {} failed: {}", request.url, errorMessage);
+            // The partial file is kept, so the download can be resumed later
+            return false;
+        }
+
+        retry_count++;
+        LOGGER.warn("{}: retrying download at {} bytes ({}/{})", errorMessage, offset, retry_count, configuration.retryCount);
+        kernel::delayMillis(configuration.retryDelayMs);
+    }
+
+    const auto sha256 = hash.finishHex();
+    if (!request.sha256.empty() && sha256 != request.sha256) {
+        LOGGER.error("Hash mismatch for {}: expected {} but received {}", request.url, request.sha256, sha256);
+        errorMessage = "File hash mismatch";
+        file::deleteFile(part_path);
+        return false;
+    }
+
+    auto lock = file::getLock(request.filePath)->asScopedLock();
+    lock.lock();
+    // rename() doesn't replace existing files on all file systems
+    remove(request.filePath.c_str());
+    const bool rename_success = rename(part_path.c_str(), request.filePath.c_str()) == 0;
+    lock.unlock();
+
+    if (!rename_success) {
+        errorMessage = "Failed to rename file";
+        return false;
+    }
+
+    LOGGER.info("Downloaded {} to {}", request.url, request.filePath);
+    return true;
+}
+
+} // namespace tt::service::download
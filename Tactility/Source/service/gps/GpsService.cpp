@@ -91,7 +91,9 @@ bool GpsService::startGpsDevice(GpsDeviceRecord& record) {
         mutex.unlock();
     });
 
-    record.rmcSubscriptionId = device->subscribeRmc([this](hal::Device::Id deviceId, auto& record) {
+    // The device outlives its subscriptions, because they're removed before it's stopped
+    auto* device_pointer = device.get();
+    record.rmcSubscriptionId = device->subscribeRmc([this, device_pointer](hal::Device::Id deviceId, auto& record) {
         mutex.lock();
         if (record.longitude.value != 0 && record.longitude.scale != 0) {
             rmcRecord = record;
@@ -99,6 +101,17 @@ bool GpsService::startGpsDevice(GpsDeviceRecord& record) {
         }
         onRmcSentence(deviceId, record);
         mutex.unlock();
+
+        // Receivers in navigation mode publish their own fixes
+        if (!device_pointer->isNavigationModeEnabled()) {
+            hal::gps::GpsFix fix;
+            hal::gps::toFix(record, fix);
+            fixPubSub->publish(fix);
+        }
+    });
+
+    record.fixSubscriptionId = device->subscribeFix([this](hal::Device::Id deviceId, auto& fix) {
+        fixPubSub->publish(fix);
     });
 
     return true;
@@ -111,9 +124,11 @@ bool GpsService::stopGpsDevice(GpsDeviceRecord& record) {
 
     device->unsubscribeGga(record.satelliteSubscriptionId);
     device->unsubscribeRmc(record.rmcSubscriptionId);
+    device->unsubscribeFix(record.fixSubscriptionId);
 
     record.satelliteSubscriptionId = -1;
     record.rmcSubscriptionId = -1;
+    record.fixSubscriptionId = -1;
 
     if (!device->stop()) {
         LOGGER.error("[device {}] stopping failed", record.device->getId());
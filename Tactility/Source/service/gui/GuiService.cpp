@@ -170,12 +170,13 @@ bool GuiService::onStart(TT_UNUSED ServiceContext& service) {
 }
 
 void GuiService::onStop(TT_UNUSED ServiceContext& service) {
-    lock();
-
+    // Unsubscribe before locking: it waits for a running onLoaderEvent(), which locks too
     const auto loader = findLoaderService();
     assert(loader != nullptr);
     loader->getPubsub()->unsubscribe(loader_pubsub_subscription);
 
+    lock();
+
     appToRender = nullptr;
     isStarted = false;
 
@@ -9,6 +9,8 @@
 #include <Tactility/settings/KeyboardSettings.h>
 #include <Tactility/Timer.h>
 
+#include <atomic>
+
 namespace keyboardbacklight {
     bool setBrightness(uint8_t brightness);
 }
@@ -21,8 +23,16 @@ class KeyboardIdleService final : public Service {
     bool keyboardDimmed = false;
     settings::keyboard::KeyboardSettings cachedKeyboardSettings;
 
-    static std::shared_ptr<hal::keyboard::KeyboardDevice> getKeyboard() {
-        return hal::findFirstDevice<hal::keyboard::KeyboardDevice>(hal::Device::Type::Keyboard);
+    std::shared_ptr<hal::keyboard::KeyboardDevice> cachedKeyboard;
+    std::atomic<bool> keyboardChanged = true;
+    PubSub<hal::DeviceEvent>::SubscriptionHandle deviceSubscription = nullptr;
+
+    std::shared_ptr<hal::keyboard::KeyboardDevice> getKeyboard() {
+        // Only query the device registry when a keyboard was registered or deregistered
+        if (keyboardChanged.exchange(false)) {
+            cachedKeyboard = hal::findFirstDevice<hal::keyboard::KeyboardDevice>(hal::Device::Type::Keyboard);
+        }
+        return cachedKeyboard;
     }
 
     void tick() {
@@ -66,6 +76,12 @@ public:
         // Note: Settings changes require service restart to take effect
         // TODO: Add KeyboardSettingsChanged events for dynamic updates
         
+        deviceSubscription = hal::getDevicePubsub()->subscribe([this](const auto& event) {
+            if (event.device->getType() == hal::Device::Type::Keyboard) {
+                keyboardChanged = true;
+            }
+        });
+
         timer = std::make_unique<Timer>(Timer::Type::Periodic, kernel::millisToTicks(250), [this]{ this->tick(); });
         timer->setCallbackPriority(Thread::Priority::Lower);
         timer->start();
@@ -77,6 +93,11 @@ public:
             timer->stop();
             timer = nullptr;
         }
+        if (deviceSubscription != nullptr) {
+            // Waits for a callback that is running, so the callback doesn't use this service after it's stopped
+            hal::getDevicePubsub()->unsubscribe(deviceSubscription);
+            deviceSubscription = nullptr;
+        }
         // Ensure keyboard restored on stop
         auto keyboard = getKeyboard();
         if (keyboard && keyboardDimmed) {
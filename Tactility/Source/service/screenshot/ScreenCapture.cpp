@@ -0,0 +1,82 @@
+#include <Tactility/TactilityConfig.h>
+
+#if TT_FEATURE_SCREENSHOT_ENABLED
+
+#include <Tactility/service/screenshot/ScreenCapture.h>
+
+#include <Tactility/Logger.h>
+#include <Tactility/LogMessages.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/lvgl/LvglSync.h>
+
+#include <lv_screenshot.h>
+
+#include <algorithm>
+
+namespace tt::service::screenshot {
+
+static const auto LOGGER = Logger("ScreenCapture");
+
+constexpr TickType_t TILE_LOCK_TIMEOUT = 50 / portTICK_PERIOD_MS;
+
+bool captureScreen(file::ImageWriter& writer, CaptureStatistics& statistics, uint16_t tileHeight) {
+    const auto start_time = kernel::getMillis();
+    statistics = {};
+
+    if (!lvgl::lock(TILE_LOCK_TIMEOUT)) {
+        LOGGER.error(LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
+        return false;
+    }
+    lv_obj_t* screen = lv_screen_active();
+    const auto width = static_cast<uint16_t>(lv_obj_get_width(screen));
+    const auto height = static_cast<uint16_t>(lv_obj_get_height(screen));
+    tileHeight = std::clamp<uint16_t>(tileHeight, 1, height);
+    lv_draw_buf_t* tile = lv_draw_buf_create(width, tileHeight, LV_COLOR_FORMAT_RGB888, LV_STRIDE_AUTO);
+    lvgl::unlock();
+
+    if (tile == nullptr) {
+        LOGGER.error("Failed to allocate a tile of {}x{}", width, tileHeight);
+        return false;
+    }
+
+    bool success = writer.begin(width, height);
+    for (uint16_t first_row = 0; success && first_row < height; first_row += tileHeight) {
+        const uint16_t row_count = std::min<uint16_t>(tileHeight, height - first_row);
+
+        if (!lvgl::lock(TILE_LOCK_TIMEOUT)) {
+            LOGGER.error(LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
+            success = false;
+            break;
+        }
+        const auto lock_time = kernel::getMillis();
+        if (lv_screen_active() != screen) {
+            LOGGER.warn("Screen changed during capture");
+            success = false;
+        } else {
+            success = lv_screenshot_take_tile(screen, tile, first_row, row_count);
+        }
+        statistics.lockedTimeMs += kernel::getMillis() - lock_time;
+        lvgl::unlock();
+
+        // LVGL stores RGB888 as B, G, R in memory
+        for (uint16_t row = 0; success && row < row_count; ++row) {
+            auto* row_data = tile->data + static_cast<size_t>(row) * tile->header.stride;
+            file::convertBgr888ToRgb888(row_data, row_data, width);
+            success = writer.writeRow(row_data);
+        }
+    }
+
+    success = success && writer.finish();
+    statistics.peakMemory = tile->data_size + writer.getMemoryUsage();
+
+    lvgl::lock(portMAX_DELAY);
+    lv_draw_buf_destroy(tile);
+    lvgl::unlock();
+
+    statistics.captureTimeMs = kernel::getMillis() - start_time;
+    return success;
+}
+
+} // namespace
+
+#endif
@@ -5,13 +5,13 @@
 #include <Tactility/CpuAffinity.h>
 #include <Tactility/Logger.h>
 #include <Tactility/LogMessages.h>
-#include <Tactility/lvgl/LvglSync.h>
+#include <Tactility/file/File.h>
+#include <Tactility/file/ImageWriter.h>
+#include <Tactility/service/screenshot/ScreenCapture.h>
 #include <Tactility/service/screenshot/ScreenshotTask.h>
 #include <Tactility/service/loader/Loader.h>
 #include <Tactility/TactilityCore.h>
 
-#include <lv_screenshot.h>
-
 #include <format>
 
 namespace tt::service::screenshot {
@@ -49,15 +49,37 @@ void ScreenshotTask::setFinished() {
 }
 
 static void makeScreenshot(const std::string& filename) {
-    if (lvgl::lock(50 / portTICK_PERIOD_MS)) {
-        if (lv_screenshot_create(lv_scr_act(), LV_100ASK_SCREENSHOT_SV_PNG, filename.c_str())) {
-            LOGGER.info("Screenshot saved to {}", filename);
-        } else {
-            LOGGER.error("Screenshot not saved to {}", filename);
-        }
-        lvgl::unlock();
+    // The file lock is only held while writing, because it can be the SPI bus lock that the display also needs
+    const auto file_lock = file::getLock(filename);
+    file_lock->lock();
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(filename.c_str(), "wb"));
+    file_lock->unlock();
+
+    if (file == nullptr) {
+        LOGGER.error("Failed to open {}", filename);
+        return;
+    }
+
+    file::PngWriter writer([&file, &file_lock](const uint8_t* data, size_t size) {
+        auto lock = file_lock->asScopedLock();
+        lock.lock();
+        return fwrite(data, 1, size, file.get()) == size;
+    });
+
+    CaptureStatistics statistics;
+    const bool success = captureScreen(writer, statistics);
+
+    file_lock->lock();
+    file = nullptr;
+    if (!success) {
+        remove(filename.c_str());
+    }
+    file_lock->unlock();
+
+    if (success) {
+        LOGGER.info("Screenshot saved to {} in {} ms ({} ms rendering, {} bytes of memory)", filename, statistics.captureTimeMs, statistics.lockedTimeMs, statistics.peakMemory);
     } else {
-        LOGGER.error(LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
+        LOGGER.error("Screenshot not saved to {}", filename);
     }
 }
 
@@ -1,4 +1,5 @@
 #include <Tactility/hal/sdcard/SdCardDevice.h>
+#include <Tactility/kernel/SystemEvents.h>
 #include <Tactility/Logger.h>
 #include <Tactility/LogMessages.h>
 #include <Tactility/Mutex.h>
@@ -17,7 +18,7 @@ class SdCardService final : public Service {
 
     Mutex mutex;
     std::unique_ptr<Timer> updateTimer;
-    hal::sdcard::SdCardDevice::State lastState = hal::sdcard::SdCardDevice::State::Unmounted;
+    bool lastMounted = false;
 
     bool lock(TickType_t timeout) const {
         return mutex.lock(timeout);
@@ -40,13 +41,23 @@ class SdCardService final : public Service {
             if (new_state == hal::sdcard::SdCardDevice::State::Error) {
                 LOGGER.error("Sdcard error - unmounting. Did you eject the card in an unsafe manner?");
                 sdcard->unmount();
+                hal::sdcard::updateMountTable();
             }
 
-            if (new_state != lastState) {
-                lastState = new_state;
+            bool changed = false;
+            if (new_state != hal::sdcard::SdCardDevice::State::Timeout) {
+                bool mounted = (new_state == hal::sdcard::SdCardDevice::State::Mounted);
+                changed = (mounted != lastMounted);
+                lastMounted = mounted;
             }
 
+            bool is_mounted = lastMounted;
             unlock();
+
+            if (changed) {
+                hal::sdcard::updateMountTable();
+                kernel::publishSystemEvent(is_mounted ? kernel::SystemEvent::SdCardMounted : kernel::SystemEvent::SdCardUnmounted);
+            }
         } else {
             LOGGER.warn(LOG_MESSAGE_MUTEX_LOCK_FAILED);
         }
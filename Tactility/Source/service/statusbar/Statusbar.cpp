@@ -2,9 +2,8 @@
 
 #include <Tactility/hal/power/PowerDevice.h>
 #include <Tactility/hal/sdcard/SdCardDevice.h>
+#include <Tactility/kernel/SystemEvents.h>
 #include <Tactility/Logger.h>
-#include <Tactility/lvgl/Lvgl.h>
-#include <Tactility/lvgl/LvglSync.h>
 #include <Tactility/Mutex.h>
 #include <Tactility/service/ServiceContext.h>
 #include <Tactility/service/ServicePaths.h>
@@ -44,6 +43,9 @@ constexpr auto* STATUSBAR_ICON_POWER_100 = "power_100.png";
 // GPS
 constexpr auto* STATUSBAR_ICON_GPS = "location.png";
 
+// Power and wifi signal strength don't have change events
+constexpr TickType_t SAMPLE_INTERVAL = pdMS_TO_TICKS(15000);
+
 extern const ServiceManifest manifest;
 
 const char* getWifiStatusIconForRssi(int rssi) {
@@ -139,9 +141,13 @@ static _Nullable const char* getPowerStatusIcon() {
 class StatusbarService final : public Service {
 
     Mutex mutex;
-    std::unique_ptr<Timer> updateTimer;
+    std::unique_ptr<Timer> sampleTimer;
+    PubSub<gps::State>::SubscriptionHandle gpsSubscription = nullptr;
+    PubSub<wifi::WifiEvent>::SubscriptionHandle wifiSubscription = nullptr;
+    kernel::SystemEventSubscription sdcardMountedSubscription = kernel::NoSystemEventSubscription;
+    kernel::SystemEventSubscription sdcardUnmountedSubscription = kernel::NoSystemEventSubscription;
     int8_t gps_icon_id;
-    bool gps_last_state = false;
+    const char* gps_last_icon = nullptr;
     int8_t wifi_icon_id;
     const char* wifi_last_icon = nullptr;
     int8_t sdcard_icon_id;
@@ -151,87 +157,61 @@ class StatusbarService final : public Service {
 
     std::unique_ptr<ServicePaths> paths;
 
-    void lock() const {
-        mutex.lock();
-    }
-
-    void unlock() const {
-        mutex.unlock();
-    }
-
-    void updateGpsIcon() {
-        auto gps_state = gps::findGpsService()->getState();
-        bool show_icon = (gps_state == gps::State::OnPending) || (gps_state == gps::State::On);
-        if (gps_last_state != show_icon) {
-            if (show_icon) {
-                auto icon_path = "A:" + paths->getAssetsPath(STATUSBAR_ICON_GPS);
-                lvgl::statusbar_icon_set_image(gps_icon_id, icon_path);
-                lvgl::statusbar_icon_set_visibility(gps_icon_id, true);
+    /**
+     * Only changes the statusbar when the icon changed.
+     * The statusbar widgets apply all changes at their next frame.
+     */
+    void setIcon(int8_t iconId, const char*& lastIcon, const char* desiredIcon) {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        if (lastIcon != desiredIcon) {
+            if (desiredIcon != nullptr) {
+                auto icon_path = "A:" + paths->getAssetsPath(desiredIcon);
+                lvgl::statusbar_icon_set_image(iconId, icon_path);
+                lvgl::statusbar_icon_set_visibility(iconId, true);
             } else {
-                lvgl::statusbar_icon_set_visibility(gps_icon_id, false);
+                lvgl::statusbar_icon_set_visibility(iconId, false);
             }
-            gps_last_state = show_icon;
+            lastIcon = desiredIcon;
         }
     }
 
+    void updateGpsIcon(gps::State gpsState) {
+        bool show_icon = (gpsState == gps::State::OnPending) || (gpsState == gps::State::On);
+        setIcon(gps_icon_id, gps_last_icon, show_icon ? STATUSBAR_ICON_GPS : nullptr);
+    }
+
     void updateWifiIcon() {
         wifi::RadioState radio_state = wifi::getRadioState();
         bool is_secure = wifi::isConnectionSecure();
-        const char* desired_icon = getWifiStatusIcon(radio_state, is_secure);
-        if (wifi_last_icon != desired_icon) {
-            if (desired_icon != nullptr) {
-                auto icon_path = "A:" + paths->getAssetsPath(desired_icon);
-                lvgl::statusbar_icon_set_image(wifi_icon_id, icon_path);
-                lvgl::statusbar_icon_set_visibility(wifi_icon_id, true);
-            } else {
-                lvgl::statusbar_icon_set_visibility(wifi_icon_id, false);
-            }
-            wifi_last_icon = desired_icon;
-        }
+        setIcon(wifi_icon_id, wifi_last_icon, getWifiStatusIcon(radio_state, is_secure));
     }
 
     void updatePowerStatusIcon() {
-        const char* desired_icon = getPowerStatusIcon();
-        if (power_last_icon != desired_icon) {
-            if (desired_icon != nullptr) {
-                auto icon_path = "A:" + paths->getAssetsPath(desired_icon);
-                lvgl::statusbar_icon_set_image(power_icon_id, icon_path);
-                lvgl::statusbar_icon_set_visibility(power_icon_id, true);
-            } else {
-                lvgl::statusbar_icon_set_visibility(power_icon_id, false);
-            }
-            power_last_icon = desired_icon;
-        }
+        setIcon(power_icon_id, power_last_icon, getPowerStatusIcon());
     }
 
-    void updateSdCardIcon() {
-        auto sdcards = hal::findDevices<hal::sdcard::SdCardDevice>(hal::Device::Type::SdCard);
+    void updateSdCardIcon(bool mounted) {
+        setIcon(sdcard_icon_id, sdcard_last_icon, mounted ? STATUSBAR_ICON_SDCARD : STATUSBAR_ICON_SDCARD_ALERT);
+    }
+
+    void updateSdCardIconFromDevice() {
         // TODO: Support multiple SD cards
-        auto sdcard = sdcards.empty() ? nullptr : sdcards[0];
+        auto sdcard = hal::findFirstDevice<hal::sdcard::SdCardDevice>(hal::Device::Type::SdCard);
         if (sdcard != nullptr) {
+            // Later changes are published by the SD card service
             auto state = sdcard->getState(50 / portTICK_PERIOD_MS);
             if (state != hal::sdcard::SdCardDevice::State::Timeout) {
-                auto* desired_icon = getSdCardStatusIcon(state);
-                if (sdcard_last_icon != desired_icon) {
-                    auto icon_path = "A:" + paths->getAssetsPath(desired_icon);
-                    lvgl::statusbar_icon_set_image(sdcard_icon_id, icon_path);
-                    lvgl::statusbar_icon_set_visibility(sdcard_icon_id, true);
-                    sdcard_last_icon = desired_icon;
-                }
+                setIcon(sdcard_icon_id, sdcard_last_icon, getSdCardStatusIcon(state));
             }
-            // TODO: Consider tracking how long the SD card has been in unknown status and then show error
         }
     }
 
-    void update() {
-        if (lvgl::isStarted()) {
-            if (lvgl::lock(100)) {
-                updateGpsIcon();
-                updateWifiIcon();
-                updateSdCardIcon();
-                updatePowerStatusIcon();
-                lvgl::unlock();
-            }
+    /** Power and wifi signal strength don't have change events, so they are sampled at a low rate */
+    void sample() {
+        updatePowerStatusIcon();
+        if (wifi::getRadioState() == wifi::RadioState::ConnectionActive) {
+            updateWifiIcon();
         }
     }
 
@@ -259,28 +239,45 @@ public:
 
         paths = serviceContext.getPaths();
 
-        // TODO: Make thread-safe for LVGL
-        lvgl::statusbar_icon_set_visibility(wifi_icon_id, true);
-
         auto service = findServiceById<StatusbarService>(manifest.id);
         assert(service);
-        service->update();
 
-        updateTimer = std::make_unique<Timer>(Timer::Type::Periodic, pdMS_TO_TICKS(1000), [service] {
-            service->update();
+        auto gps_service = gps::findGpsService();
+        gpsSubscription = gps_service->getStatePubsub()->subscribe([service](gps::State state) {
+            service->updateGpsIcon(state);
+        });
+        wifiSubscription = wifi::getPubsub()->subscribe([service](wifi::WifiEvent) {
+            service->updateWifiIcon();
+        });
+        sdcardMountedSubscription = kernel::subscribeSystemEvent(kernel::SystemEvent::SdCardMounted, [service](auto) {
+            service->updateSdCardIcon(true);
+        });
+        sdcardUnmountedSubscription = kernel::subscribeSystemEvent(kernel::SystemEvent::SdCardUnmounted, [service](auto) {
+            service->updateSdCardIcon(false);
         });
 
-        updateTimer->setCallbackPriority(Thread::Priority::Lower);
+        // Initial state
+        updateGpsIcon(gps_service->getState());
+        updateWifiIcon();
+        updateSdCardIconFromDevice();
+        updatePowerStatusIcon();
 
-        // We want to try and scan more often in case of startup or scan lock failure
-        updateTimer->start();
+        sampleTimer = std::make_unique<Timer>(Timer::Type::Periodic, SAMPLE_INTERVAL, [service] {
+            service->sample();
+        });
+        sampleTimer->setCallbackPriority(Thread::Priority::Lower);
+        sampleTimer->start();
 
         return true;
     }
 
-    void onStop(ServiceContext& service) override{
-        updateTimer->stop();
-        updateTimer = nullptr;
+    void onStop(ServiceContext& service) override {
+        sampleTimer->stop();
+        sampleTimer = nullptr;
+        gps::findGpsService()->getStatePubsub()->unsubscribe(gpsSubscription);
+        wifi::getPubsub()->unsubscribe(wifiSubscription);
+        kernel::unsubscribeSystemEvent(sdcardMountedSubscription);
+        kernel::unsubscribeSystemEvent(sdcardUnmountedSubscription);
     }
 };
 
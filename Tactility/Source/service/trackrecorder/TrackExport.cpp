@@ -0,0 +1,156 @@
+#include <Tactility/service/trackrecorder/TrackExport.h>
+#include <Tactility/service/trackrecorder/TrackFile.h>
+
+#include <Tactility/Logger.h>
+
+#include <format>
+
+namespace tt::service::trackrecorder {
+
+static const auto LOGGER = Logger("TrackExport");
+
+// Output is written in batches of this size, to avoid a write per point
+constexpr size_t OUTPUT_BATCH_SIZE = 4096;
+
+/** Format a fixed point value without losing precision to floats (e.g. 1234 with 3 decimals becomes "1.234") */
+static std::string toDecimal(int64_t value, int decimals) {
+    int64_t divisor = 1;
+    for (int i = 0; i < decimals; ++i) {
+        divisor *= 10;
+    }
+
+    const uint64_t absolute = value < 0 ? -static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    auto fraction = std::to_string(absolute % divisor);
+    fraction.insert(0, decimals - fraction.size(), '0');
+    return std::format("{}{}.{}", value < 0 ? "-" : "", absolute / divisor, fraction);
+}
+
+/** Format milliseconds since the unix epoch as ISO 8601 (UTC) */
+static std::string toIsoTime(int64_t time) {
+    int64_t days = time / 86400000;
+    int64_t milliseconds = time % 86400000;
+    if (milliseconds < 0) {
+        milliseconds += 86400000;
+        days--;
+    }
+
+    // Convert days since the unix epoch to a date in the proleptic Gregorian calendar
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const auto day_of_era = static_cast<uint32_t>(days - era * 146097);
+    const uint32_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const uint32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const uint32_t month_index = (5 * day_of_year + 2) / 153;
+    const uint32_t day = day_of_year - (153 * month_index + 2) / 5 + 1;
+    const uint32_t month = month_index < 10 ? month_index + 3 : month_index - 9;
+    const int64_t year = static_cast<int64_t>(year_of_era) + era * 400 + (month <= 2 ? 1 : 0);
+
+    return std::format(
+        "{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:03}Z",
+        year,
+        month,
+        day,
+        milliseconds / 3600000,
+        (milliseconds / 60000) % 60,
+        (milliseconds / 1000) % 60,
+        milliseconds % 1000
+    );
+}
+
+static void appendCsv(std::string& output, const TrackPoint& point) {
+    output += std::format(
+        "{},{},{},{},{},{},{},{}\n",
+        toIsoTime(point.time),
+        toDecimal(point.latitude, 7),
+        toDecimal(point.longitude, 7),
+        toDecimal(point.altitude, 3),
+        toDecimal(point.groundSpeed, 3),
+        toDecimal(point.heading, 5),
+        toDecimal(point.horizontalAccuracy, 3),
+        point.satelliteCount
+    );
+}
+
+static void appendGpx(std::string& output, const TrackPoint& point) {
+    output += std::format(
+        "<trkpt lat=\"{}\" lon=\"{}\"><ele>{}</ele><time>{}</time><sat>{}</sat></trkpt>\n",
+        toDecimal(point.latitude, 7),
+        toDecimal(point.longitude, 7),
+        toDecimal(point.altitude, 3),
+        toIsoTime(point.time),
+        point.satelliteCount
+    );
+}
+
+static bool write(FILE* file, const std::string& data) {
+    return fwrite(data.data(), 1, data.size(), file) == data.size();
+}
+
+static bool exportTrackLocked(const std::string& trackPath, const std::string& outputPath, ExportFormat format) {
+    TrackReader reader(trackPath);
+    if (!reader.open()) {
+        return false;
+    }
+
+    auto output_file = std::unique_ptr<FILE, file::FileCloser>(fopen(outputPath.c_str(), "wb"));
+    if (output_file == nullptr) {
+        LOGGER.error("Failed to open {}", outputPath);
+        return false;
+    }
+
+    std::string output;
+    output.reserve(OUTPUT_BATCH_SIZE + 256);
+    if (format == ExportFormat::Gpx) {
+        output += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<gpx version=\"1.1\" creator=\"Tactility\" xmlns=\"http://www.topografix.com/GPX/1/1\">\n"
+            "<trk><trkseg>\n";
+    } else {
+        output += "time,latitude,longitude,altitude,speed,heading,horizontal_accuracy,satellites\n";
+    }
+
+    TrackPoint point;
+    uint32_t point_count = 0;
+    while (reader.next(point)) {
+        if (format == ExportFormat::Gpx) {
+            appendGpx(output, point);
+        } else {
+            appendCsv(output, point);
+        }
+        point_count++;
+
+        if (output.size() >= OUTPUT_BATCH_SIZE) {
+            if (!write(output_file.get(), output)) {
+                LOGGER.error("Failed to write to {}", outputPath);
+                return false;
+            }
+            output.clear();
+        }
+    }
+
+    if (format == ExportFormat::Gpx) {
+        output += "</trkseg></trk>\n</gpx>\n";
+    }
+
+    if (!write(output_file.get(), output)) {
+        LOGGER.error("Failed to write to {}", outputPath);
+        return false;
+    }
+
+    if (reader.isCorrupted()) {
+        LOGGER.warn("Exported {} points from damaged track {}", point_count, trackPath);
+    } else {
+        LOGGER.info("Exported {} points to {}", point_count, outputPath);
+    }
+
+    return true;
+}
+
+bool exportTrack(const std::string& trackPath, const std::string& outputPath, ExportFormat format) {
+    auto track_lock = file::getLock(trackPath)->asScopedLock();
+    track_lock.lock();
+    auto output_lock = file::getLock(outputPath)->asScopedLock();
+    output_lock.lock();
+    return exportTrackLocked(trackPath, outputPath, format);
+}
+
+} // namespace tt::service::trackrecorder
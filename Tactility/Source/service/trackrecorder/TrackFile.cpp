@@ -0,0 +1,289 @@
+#include <Tactility/service/trackrecorder/TrackFile.h>
+
+#include <Tactility/Logger.h>
+
+#include <cstring>
+
+namespace tt::service::trackrecorder {
+
+static const auto LOGGER = Logger("TrackFile");
+
+static_assert(sizeof(TrackFileHeader) == 8);
+static_assert(sizeof(TrackChunkHeader) == 12);
+
+static uint32_t calculateCrc(std::span<const uint8_t> data) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (auto byte : data) {
+        crc ^= byte;
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+// region Encoding
+
+/** Days since the unix epoch for a date in the proleptic Gregorian calendar */
+static int64_t toDays(int32_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2 ? 1 : 0;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto year_of_era = static_cast<uint32_t>(year - era * 400);
+    const uint32_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<int64_t>(day_of_era) - 719468;
+}
+
+bool toTrackPoint(const hal::gps::GpsFix& fix, TrackPoint& point) {
+    using hal::gps::GpsFix;
+    const bool has_position = fix.valid && (fix.type == GpsFix::Type::Fix2d || fix.type == GpsFix::Type::Fix3d || fix.type == GpsFix::Type::GnssDeadReckoning);
+    if (!has_position || !fix.validDate || !fix.validTime || fix.month < 1 || fix.month > 12 || fix.day < 1 || fix.day > 31) {
+        return false;
+    }
+
+    const int64_t seconds = toDays(fix.year, fix.month, fix.day) * 86400 + fix.hour * 3600 + fix.minute * 60 + fix.second;
+    point = {
+        .time = seconds * 1000 + fix.nanoseconds / 1000000,
+        .latitude = fix.latitude,
+        .longitude = fix.longitude,
+        .altitude = fix.altitude,
+        .groundSpeed = fix.groundSpeed,
+        .heading = fix.heading,
+        .horizontalAccuracy = fix.horizontalAccuracy,
+        .satelliteCount = fix.satelliteCount
+    };
+    return true;
+}
+
+static void writeVarint(std::vector<uint8_t>& output, int64_t value) {
+    // Zigzag encoding keeps small negative values small
+    auto encoded = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    while (encoded >= 0x80) {
+        output.push_back(static_cast<uint8_t>(encoded | 0x80));
+        encoded >>= 7;
+    }
+    output.push_back(static_cast<uint8_t>(encoded));
+}
+
+bool TrackChunkEncoder::add(const TrackPoint& point) {
+    if (pointCount == UINT16_MAX || payload.size() + MAX_POINT_SIZE > MAX_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    writeVarint(payload, point.time - previous.time);
+    writeVarint(payload, static_cast<int64_t>(point.latitude) - previous.latitude);
+    writeVarint(payload, static_cast<int64_t>(point.longitude) - previous.longitude);
+    writeVarint(payload, static_cast<int64_t>(point.altitude) - previous.altitude);
+    writeVarint(payload, static_cast<int64_t>(point.groundSpeed) - previous.groundSpeed);
+    writeVarint(payload, static_cast<int64_t>(point.heading) - previous.heading);
+    writeVarint(payload, static_cast<int64_t>(point.horizontalAccuracy) - previous.horizontalAccuracy);
+    writeVarint(payload, static_cast<int64_t>(point.satelliteCount) - previous.satelliteCount);
+
+    previous = point;
+    pointCount++;
+    return true;
+}
+
+std::vector<uint8_t> TrackChunkEncoder::finish() {
+    const TrackChunkHeader header = {
+        .pointCount = pointCount,
+        .payloadSize = static_cast<uint16_t>(payload.size()),
+        .crc = calculateCrc(payload)
+    };
+
+    std::vector<uint8_t> chunk(sizeof(TrackChunkHeader) + payload.size());
+    memcpy(chunk.data(), &header, sizeof(TrackChunkHeader));
+    memcpy(chunk.data() + sizeof(TrackChunkHeader), payload.data(), payload.size());
+
+    payload.clear();
+    previous = {};
+    pointCount = 0;
+    return chunk;
+}
+
+bool appendChunks(const std::string& path, std::span<const std::vector<uint8_t>> chunks) {
+    auto lock = file::getLock(path)->asScopedLock();
+    lock.lock();
+
+    const bool is_new_file = !file::isFile(path);
+
+    // Write everything at once, because every write can contend with other users of the storage bus
+    std::vector<uint8_t> data;
+    if (is_new_file) {
+        const TrackFileHeader header;
+        data.resize(sizeof(TrackFileHeader));
+        memcpy(data.data(), &header, sizeof(TrackFileHeader));
+    }
+    for (const auto& chunk : chunks) {
+        data.insert(data.end(), chunk.begin(), chunk.end());
+    }
+
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(path.c_str(), "ab"));
+    if (file == nullptr) {
+        LOGGER.error("Failed to open {}", path);
+        return false;
+    }
+
+    if (fwrite(data.data(), 1, data.size(), file.get()) != data.size()) {
+        LOGGER.error("Failed to write {} bytes to {}", data.size(), path);
+        return false;
+    }
+
+    return fflush(file.get()) == 0;
+}
+
+// endregion Encoding
+
+// region Decoding
+
+static bool readVarint(std::span<const uint8_t> data, size_t& offset, int64_t& value) {
+    uint64_t encoded = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (offset >= data.size()) {
+            return false;
+        }
+        const auto byte = data[offset++];
+        encoded |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TrackReader::open() {
+    auto opening_file = std::unique_ptr<FILE, file::FileCloser>(fopen(filePath.c_str(), "rb"));
+    if (opening_file == nullptr) {
+        LOGGER.error("Failed to open {}", filePath);
+        return false;
+    }
+
+    TrackFileHeader header;
+    if (fread(&header, sizeof(TrackFileHeader), 1, opening_file.get()) != 1) {
+        LOGGER.error("Failed to read file header from {}", filePath);
+        return false;
+    }
+
+    if (header.identifier != TRACK_FILE_IDENTIFIER) {
+        LOGGER.error("Invalid file type for {}", filePath);
+        return false;
+    }
+
+    if (header.version != TRACK_FILE_VERSION) {
+        LOGGER.error("Unknown version for {}: {}", filePath, header.version);
+        return false;
+    }
+
+    file = std::move(opening_file);
+    corrupted = false;
+    return true;
+}
+
+void TrackReader::close() {
+    file = nullptr;
+    payload.clear();
+    payloadOffset = 0;
+    pointsRemaining = 0;
+    previous = {};
+}
+
+/** Move the file position to the next chunk identifier after the damaged chunk */
+static bool findNextChunk(FILE* file, long damagedChunkPosition) {
+    if (fseek(file, damagedChunkPosition + 1, SEEK_SET) != 0) {
+        return false;
+    }
+
+    uint32_t window = 0;
+    int bytes_read = 0;
+    int byte;
+    while ((byte = fgetc(file)) != EOF) {
+        window = (window >> 8) | (static_cast<uint32_t>(byte) << 24);
+        if (++bytes_read >= 4 && window == TRACK_CHUNK_IDENTIFIER) {
+            return fseek(file, -4, SEEK_CUR) == 0;
+        }
+    }
+    return false;
+}
+
+bool TrackReader::readChunk() {
+    while (true) {
+        const long chunk_position = ftell(file.get());
+        TrackChunkHeader header;
+        const size_t header_size = fread(&header, 1, sizeof(TrackChunkHeader), file.get());
+        if (header_size == 0) {
+            return false;
+        } else if (header_size != sizeof(TrackChunkHeader)) {
+            LOGGER.warn("Incomplete chunk header in {}", filePath);
+            corrupted = true;
+            return false;
+        }
+
+        bool valid = header.identifier == TRACK_CHUNK_IDENTIFIER;
+        if (valid) {
+            payload.resize(header.payloadSize);
+            if (fread(payload.data(), 1, payload.size(), file.get()) != payload.size()) {
+                // The last write was interrupted
+                LOGGER.warn("Incomplete chunk in {}", filePath);
+                corrupted = true;
+                return false;
+            }
+            valid = calculateCrc(payload) == header.crc;
+        }
+
+        if (valid) {
+            payloadOffset = 0;
+            pointsRemaining = header.pointCount;
+            previous = {};
+            return true;
+        }
+
+        // Later chunks might have been appended after an interrupted write
+        LOGGER.warn("Damaged chunk at offset {} in {}", chunk_position, filePath);
+        corrupted = true;
+        if (!findNextChunk(file.get(), chunk_position)) {
+            return false;
+        }
+    }
+}
+
+bool TrackReader::next(TrackPoint& point) {
+    if (file == nullptr) {
+        LOGGER.error("File not open");
+        return false;
+    }
+
+    while (pointsRemaining == 0) {
+        if (!readChunk()) {
+            return false;
+        }
+    }
+
+    int64_t deltas[8];
+    for (auto& delta : deltas) {
+        if (!readVarint(payload, payloadOffset, delta)) {
+            LOGGER.warn("Invalid point data in {}", filePath);
+            corrupted = true;
+            pointsRemaining = 0;
+            return next(point);
+        }
+    }
+
+    point = {
+        .time = previous.time + deltas[0],
+        .latitude = static_cast<int32_t>(previous.latitude + deltas[1]),
+        .longitude = static_cast<int32_t>(previous.longitude + deltas[2]),
+        .altitude = static_cast<int32_t>(previous.altitude + deltas[3]),
+        .groundSpeed = static_cast<int32_t>(previous.groundSpeed + deltas[4]),
+        .heading = static_cast<int32_t>(previous.heading + deltas[5]),
+        .horizontalAccuracy = static_cast<uint32_t>(previous.horizontalAccuracy + deltas[6]),
+        .satelliteCount = static_cast<uint8_t>(previous.satelliteCount + deltas[7])
+    };
+    previous = point;
+    pointsRemaining--;
+    return true;
+}
+
+// endregion Decoding
+
+} // namespace tt::service::trackrecorder
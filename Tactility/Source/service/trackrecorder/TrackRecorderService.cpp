@@ -0,0 +1,276 @@
+#include <Tactility/service/trackrecorder/TrackRecorderService.h>
+
+#include <Tactility/Logger.h>
+#include <Tactility/file/File.h>
+#include <Tactility/hal/sdcard/SdCardDevice.h>
+#include <Tactility/service/ServiceContext.h>
+#include <Tactility/service/ServiceManifest.h>
+#include <Tactility/service/ServiceRegistration.h>
+#include <Tactility/service/gps/GpsService.h>
+
+#include <algorithm>
+#include <ctime>
+#include <format>
+
+namespace tt::service::trackrecorder {
+
+static const auto LOGGER = Logger("TrackRecorder");
+extern const ServiceManifest manifest;
+
+// A chunk is written when it reaches this size or age, whichever comes first
+constexpr size_t CHUNK_PAYLOAD_SIZE = 4096;
+constexpr uint32_t CHUNK_MAX_AGE_SECONDS = 60;
+// The age is also checked without new fixes, so the last points are written when the receiver loses its fix
+constexpr uint32_t CHUNK_AGE_CHECK_INTERVAL_SECONDS = 5;
+// When writes keep failing, the oldest chunks are dropped to limit the memory usage
+constexpr size_t MAX_PENDING_CHUNKS = 8;
+
+bool TrackRecorderService::onStart(ServiceContext& serviceContext) {
+    auto gps_service = gps::findGpsService();
+    if (gps_service == nullptr) {
+        LOGGER.error("GPS service not found");
+        return false;
+    }
+
+    gpsStatePubSub = gps_service->getStatePubsub();
+
+    // Record while the GPS service is receiving
+    gpsStateSubscription = gpsStatePubSub->subscribe([this](gps::State state) {
+        onGpsStateChanged(state);
+    });
+
+    if (gps_service->getState() == gps::State::On) {
+        startRecording();
+    }
+    return true;
+}
+
+void TrackRecorderService::onStop(ServiceContext& serviceContext) {
+    // Don't hold the mutex: unsubscribe() waits for a running callback, which can lock the mutex
+    gpsStatePubSub->unsubscribe(gpsStateSubscription);
+    gpsStateSubscription = nullptr;
+    stopRecording();
+}
+
+void TrackRecorderService::onGpsStateChanged(gps::State state) {
+    if (state == gps::State::On) {
+        if (!isRecording()) {
+            startRecording();
+        }
+    } else if (state == gps::State::OffPending || state == gps::State::Off) {
+        stopRecording();
+    }
+}
+
+void TrackRecorderService::onFix(const hal::gps::GpsFix& fix) {
+    TrackPoint point;
+    if (!toTrackPoint(fix, point)) {
+        return;
+    }
+
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    // The subscription can receive a fix after it was removed
+    if (!recording) {
+        return;
+    }
+
+    if (encoder.isEmpty()) {
+        chunkStartTime = kernel::getTicks();
+    }
+
+    if (!encoder.add(point)) {
+        finishChunk();
+        chunkStartTime = kernel::getTicks();
+        encoder.add(point);
+    }
+    statistics.pointCount++;
+
+    const bool is_chunk_full = encoder.getPayloadSize() >= CHUNK_PAYLOAD_SIZE;
+    if (is_chunk_full || isChunkExpired()) {
+        finishChunk();
+        dispatchWrite();
+    }
+}
+
+void TrackRecorderService::onChunkAgeTimer() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    if (recording && isChunkExpired()) {
+        finishChunk();
+        dispatchWrite();
+    }
+}
+
+bool TrackRecorderService::isChunkExpired() const {
+    return !encoder.isEmpty() && (kernel::getTicks() - chunkStartTime) >= kernel::secondsToTicks(CHUNK_MAX_AGE_SECONDS);
+}
+
+void TrackRecorderService::dispatchWrite() {
+    writerThread->dispatch([this] {
+        writePendingChunks();
+    });
+}
+
+void TrackRecorderService::finishChunk() {
+    if (encoder.isEmpty()) {
+        return;
+    }
+
+    if (pendingChunks.size() >= MAX_PENDING_CHUNKS) {
+        LOGGER.warn("Dropping chunk, because too many chunks are pending");
+        pendingChunks.erase(pendingChunks.begin());
+        statistics.droppedChunkCount++;
+    }
+
+    pendingChunks.push_back(encoder.finish());
+}
+
+void TrackRecorderService::writePendingChunks() {
+    mutex.lock();
+    auto chunks = std::move(pendingChunks);
+    pendingChunks.clear();
+    const auto path = trackPath;
+    mutex.unlock();
+
+    if (chunks.empty()) {
+        return;
+    }
+
+    // Don't hold the mutex while writing, so fixes can still be recorded
+    const bool success = appendChunks(path, chunks);
+
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    if (success) {
+        statistics.chunkCount += chunks.size();
+        for (const auto& chunk : chunks) {
+            statistics.byteCount += chunk.size();
+        }
+    } else {
+        statistics.writeFailureCount++;
+        // Retry with the next write
+        pendingChunks.insert(pendingChunks.begin(), std::make_move_iterator(chunks.begin()), std::make_move_iterator(chunks.end()));
+        while (pendingChunks.size() > MAX_PENDING_CHUNKS) {
+            pendingChunks.erase(pendingChunks.begin());
+            statistics.droppedChunkCount++;
+        }
+    }
+}
+
+bool TrackRecorderService::startRecording(const std::string& path) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    // The writer thread exists until stopRecording() has written the last chunks
+    if (writerThread != nullptr) {
+        LOGGER.warn("Already recording to {}", trackPath);
+        return false;
+    }
+
+    trackPath = path;
+    statistics = {};
+    pendingChunks.clear();
+    writerThread = std::make_unique<DispatcherThread>("track_writer", 4096);
+    writerThread->start();
+    chunkAgeTimer = std::make_unique<Timer>(Timer::Type::Periodic, kernel::secondsToTicks(CHUNK_AGE_CHECK_INTERVAL_SECONDS), [this] {
+        onChunkAgeTimer();
+    });
+    chunkAgeTimer->start();
+    recording = true;
+
+    fixPubSub = gps::findGpsService()->getFixPubsub();
+    fixSubscription = fixPubSub->subscribe([this](const auto& fix) {
+        onFix(fix);
+    });
+
+    LOGGER.info("Recording to {}", path);
+    return true;
+}
+
+bool TrackRecorderService::startRecording() {
+    // Don't wear out the internal flash with a write per chunk
+    const auto sdcards = hal::findDevices<hal::sdcard::SdCardDevice>(hal::Device::Type::SdCard);
+    const auto sdcard = std::ranges::find_if(sdcards, [](const auto& device) { return device->isMounted(); });
+    if (sdcard == sdcards.end()) {
+        LOGGER.error("Can't start recording: no SD card mounted");
+        return false;
+    }
+    const auto directory = file::getChildPath((*sdcard)->getMountPath(), "tracks");
+
+    if (!file::findOrCreateDirectory(directory, 0777)) {
+        LOGGER.error("Failed to find or create path {}", directory);
+        return false;
+    }
+
+    // The clock might not be set, so make sure not to append to an older track
+    const auto time = ::time(nullptr);
+    auto path = std::format("{}/track_{}.trk", directory, time);
+    for (int index = 1; file::isFile(path); ++index) {
+        path = std::format("{}/track_{}_{}.trk", directory, time, index);
+    }
+
+    return startRecording(path);
+}
+
+void TrackRecorderService::stopRecording() {
+    mutex.lock();
+    if (!recording) {
+        mutex.unlock();
+        return;
+    }
+
+    // Fixes and timer callbacks that arrive from now on are ignored
+    recording = false;
+    auto fix_subscription = fixSubscription;
+    fixSubscription = nullptr;
+    auto timer = std::move(chunkAgeTimer);
+    mutex.unlock();
+
+    // Don't hold the mutex: unsubscribe() waits for a running onFix(), which locks the mutex
+    fixPubSub->unsubscribe(fix_subscription);
+    timer->stop();
+
+    mutex.lock();
+    finishChunk();
+    mutex.unlock();
+
+    // Wait for the last dispatched write and then write what's left
+    writerThread->stop();
+    writePendingChunks();
+
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    writerThread = nullptr;
+    LOGGER.info("Recorded {} points to {}", statistics.pointCount, trackPath);
+}
+
+bool TrackRecorderService::isRecording() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return recording;
+}
+
+std::string TrackRecorderService::getTrackPath() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return trackPath;
+}
+
+TrackRecorderService::Statistics TrackRecorderService::getStatistics() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return statistics;
+}
+
+std::shared_ptr<TrackRecorderService> _Nullable optTrackRecorderService() {
+    return findServiceById<TrackRecorderService>(manifest.id);
+}
+
+extern const ServiceManifest manifest = {
+    .id = "TrackRecorder",
+    .createService = create<TrackRecorderService>
+};
+
+} // namespace tt::service::trackrecorder
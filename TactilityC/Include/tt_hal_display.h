@@ -34,6 +34,18 @@ bool tt_hal_display_driver_supported(DeviceId displayId);
  */
 DisplayDriverHandle tt_hal_display_driver_alloc(DeviceId displayId);
 
+/**
+ * Allocate a buffered driver object for the specified displayId.
+ * Draw calls copy the pixels into a screen-sized frame buffer, and the changed areas are merged
+ * and sent to the display on a separate thread. Call tt_hal_display_driver_flush() to wait for them.
+ * This speeds up many small draw calls, but the frame buffer takes width * height * bytes per pixel of memory.
+ * Monochrome displays are not buffered.
+ * @warning check whether the driver is supported by calling tt_hal_display_driver_supported() first
+ * @param[in] displayId the identifier of the display device
+ * @return the driver handle
+ */
+DisplayDriverHandle tt_hal_display_driver_alloc_buffered(DeviceId displayId);
+
 /**
  * Free the memory for the display driver.
  * @param[in] handle the display driver handle
@@ -86,6 +98,15 @@ uint16_t tt_hal_display_driver_get_pixel_height(DisplayDriverHandle handle);
  */
 void tt_hal_display_driver_draw_bitmap(DisplayDriverHandle handle, int xStart, int yStart, int xEnd, int yEnd, const void* pixelData);
 
+/**
+ * Wait until the pixels of all earlier draw calls are sent to the display.
+ * For a buffered driver, this sends the queued areas. Other drivers can still be sending the pixel data
+ * of the last draw call when it returns, so call this before changing that data.
+ * @param[in] handle the display driver handle
+ * @return false when sending failed
+ */
+bool tt_hal_display_driver_flush(DisplayDriverHandle handle);
+
 #ifdef __cplusplus
 }
 #endif
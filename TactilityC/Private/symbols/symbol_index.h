@@ -0,0 +1,34 @@
+#pragma once
+
+#include <private/elf_symbol.h>
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+/**
+ * A name-sorted index over multiple symbol tables, so that lookups take O(log n) string comparisons
+ * instead of a linear scan over all exported symbols.
+ * When a name is exported by multiple tables, the table that was specified first takes precedence.
+ */
+class SymbolIndex final {
+
+    std::vector<const esp_elfsym*> entries;
+
+public:
+
+    /**
+     * @param[in] tables symbol tables that end with ESP_ELFSYM_END
+     * @param[in] tableCount the amount of tables
+     */
+    SymbolIndex(const esp_elfsym* const* tables, size_t tableCount);
+
+    /** @param[in] tables symbol tables that end with ESP_ELFSYM_END */
+    explicit SymbolIndex(std::initializer_list<const esp_elfsym*> tables) : SymbolIndex(tables.begin(), tables.size()) {}
+
+    /** @return the symbol or nullptr when it wasn't found */
+    const esp_elfsym* find(const char* name) const;
+
+    /** @return the amount of indexed symbols */
+    size_t getSize() const { return entries.size(); }
+};
@@ -0,0 +1,41 @@
+#include <symbols/symbol_index.h>
+
+#include <algorithm>
+#include <cstring>
+
+static bool compareSymbolNames(const esp_elfsym* left, const esp_elfsym* right) {
+    return strcmp(left->name, right->name) < 0;
+}
+
+SymbolIndex::SymbolIndex(const esp_elfsym* const* tables, size_t tableCount) {
+    size_t count = 0;
+    for (size_t i = 0; i < tableCount; ++i) {
+        const auto* table = tables[i];
+        for (const auto* symbol = table; symbol->name != nullptr; symbol++) {
+            count++;
+        }
+    }
+
+    entries.reserve(count);
+    for (size_t i = 0; i < tableCount; ++i) {
+        const auto* table = tables[i];
+        for (const auto* symbol = table; symbol->name != nullptr; symbol++) {
+            entries.push_back(symbol);
+        }
+    }
+
+    // Stable sort keeps the table order for duplicate names, so lower_bound() finds the highest precedence symbol
+    std::stable_sort(entries.begin(), entries.end(), compareSymbolNames);
+}
+
+const esp_elfsym* SymbolIndex::find(const char* name) const {
+    auto iterator = std::lower_bound(entries.begin(), entries.end(), name, [](const esp_elfsym* symbol, const char* searchName) {
+        return strcmp(symbol->name, searchName) < 0;
+    });
+
+    if (iterator != entries.end() && strcmp((*iterator)->name, name) == 0) {
+        return *iterator;
+    } else {
+        return nullptr;
+    }
+}
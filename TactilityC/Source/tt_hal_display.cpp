@@ -2,6 +2,7 @@
 
 #include "Tactility/Check.h"
 #include "Tactility/hal/Device.h"
+#include "Tactility/hal/display/BufferedDisplayDriver.h"
 #include "Tactility/hal/display/DisplayDevice.h"
 #include "Tactility/hal/display/DisplayDriver.h"
 
@@ -26,7 +27,10 @@ static ColorFormat toColorFormat(tt::hal::display::ColorFormat format) {
 
 struct DriverWrapper {
     std::shared_ptr<tt::hal::display::DisplayDriver> driver;
+    /** Set when the driver is buffered: it is the same instance as driver */
+    std::shared_ptr<tt::hal::display::BufferedDisplayDriver> bufferedDriver;
     DriverWrapper(std::shared_ptr<tt::hal::display::DisplayDriver> driver) : driver(driver) {}
+    DriverWrapper(std::shared_ptr<tt::hal::display::BufferedDisplayDriver> bufferedDriver) : driver(bufferedDriver), bufferedDriver(bufferedDriver) {}
 };
 
 static std::shared_ptr<tt::hal::display::DisplayDevice> findValidDisplayDevice(tt::hal::Device::Id id) {
@@ -50,6 +54,12 @@ DisplayDriverHandle tt_hal_display_driver_alloc(DeviceId id) {
     return new DriverWrapper(display->getDisplayDriver());
 }
 
+DisplayDriverHandle tt_hal_display_driver_alloc_buffered(DeviceId id) {
+    auto display = findValidDisplayDevice(id);
+    assert(display->supportsDisplayDriver());
+    return new DriverWrapper(std::make_shared<tt::hal::display::BufferedDisplayDriver>(display->getDisplayDriver()));
+}
+
 void tt_hal_display_driver_free(DisplayDriverHandle handle) {
     auto wrapper = static_cast<DriverWrapper*>(handle);
     delete wrapper;
@@ -85,4 +95,13 @@ void tt_hal_display_driver_draw_bitmap(DisplayDriverHandle handle, int xStart, i
     wrapper->driver->drawBitmap(xStart, yStart, xEnd, yEnd, pixelData);
 }
 
+bool tt_hal_display_driver_flush(DisplayDriverHandle handle) {
+    auto wrapper = static_cast<DriverWrapper*>(handle);
+    if (wrapper->bufferedDriver != nullptr) {
+        return wrapper->bufferedDriver->flush();
+    } else {
+        return wrapper->driver->waitForPendingTransfers(0, portMAX_DELAY);
+    }
+}
+
 }
\ No newline at end of file
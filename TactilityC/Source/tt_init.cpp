@@ -29,6 +29,7 @@
 #include "symbols/cplusplus.h"
 #include "symbols/freertos.h"
 #include "symbols/gcc_soft_float.h"
+#include "symbols/symbol_index.h"
 
 #include <cstring>
 #include <ctype.h>
@@ -51,7 +52,6 @@
 #include <lwip/sockets.h>
 
 #include <lvgl.h>
-#include <vector>
 
 extern "C" {
 
@@ -210,7 +210,9 @@ const esp_elfsym main_symbols[] {
     ESP_ELFSYM_EXPORT(tt_hal_configuration_get_ui_scale),
     ESP_ELFSYM_EXPORT(tt_hal_device_find),
     ESP_ELFSYM_EXPORT(tt_hal_display_driver_alloc),
+    ESP_ELFSYM_EXPORT(tt_hal_display_driver_alloc_buffered),
     ESP_ELFSYM_EXPORT(tt_hal_display_driver_draw_bitmap),
+    ESP_ELFSYM_EXPORT(tt_hal_display_driver_flush),
     ESP_ELFSYM_EXPORT(tt_hal_display_driver_free),
     ESP_ELFSYM_EXPORT(tt_hal_display_driver_get_colorformat),
     ESP_ELFSYM_EXPORT(tt_hal_display_driver_get_pixel_height),
@@ -613,19 +615,9 @@ const esp_elfsym main_symbols[] {
     ESP_ELFSYM_END
 };
 
-uintptr_t resolve_symbol(const esp_elfsym* source, const char* symbolName) {
-    const esp_elfsym* symbol_iterator = source;
-    while (symbol_iterator->name != nullptr) {
-        if (strcmp(symbol_iterator->name, symbolName) == 0) {
-            return reinterpret_cast<uintptr_t>(symbol_iterator->sym);
-        }
-        symbol_iterator++;
-    }
-    return 0;
-}
-
 uintptr_t tt_symbol_resolver(const char* symbolName) {
-    static const std::vector all_symbols = {
+    // Built on first use (when the first app is loaded) so it doesn't cost memory otherwise
+    static const SymbolIndex symbol_index({
         main_symbols,
         gcc_soft_float_symbols,
         stl_symbols,
@@ -635,16 +627,10 @@ uintptr_t tt_symbol_resolver(const char* symbolName) {
         string_symbols,
         esp_event_symbols,
         esp_http_client_symbols,
-    };
-
-    for (const auto* symbols : all_symbols) {
-        const uintptr_t address = resolve_symbol(symbols, symbolName);
-        if (address != 0) {
-            return address;
-        }
-    }
+    });
 
-    return 0;
+    const auto* symbol = symbol_index.find(symbolName);
+    return (symbol != nullptr) ? reinterpret_cast<uintptr_t>(symbol->sym) : 0;
 }
 
 void tt_init_tactility_c() {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "LoggerAdapter.h"
+#include "LoggerBinary.h"
 #include "LoggerSettings.h"
 
 #ifdef ESP_PLATFORM
@@ -10,6 +11,7 @@
 #endif
 
 #include <format>
+#include <type_traits>
 
 namespace tt {
 
@@ -19,54 +21,128 @@ static LoggerAdapter defaultLoggerAdapter = espLoggerAdapter;
 static LoggerAdapter defaultLoggerAdapter = genericLoggerAdapter;
 #endif
 
-class Logger {
+/** Output a formatted message: either directly or via the log buffer (see startBufferedLogging()) */
+void writeLog(LogLevel level, const char* tag, const char* message);
+
+/** Output an encoded binary record: either directly or via the log buffer (see startBufferedLogging()) */
+void writeBinaryLog(const uint8_t* record, size_t length);
+
+/** @return true when log records are written in binary form instead of text */
+bool isBinaryLogging();
+
+/**
+ * Write binary records (see LoggerBinary.h) instead of formatted text.
+ * Use Buildscripts/log-decoder.py to decode the output.
+ */
+void setBinaryLogging(bool enabled);
+
+/**
+ * Start a low priority task that writes the log output to the console.
+ * Messages are put into a lock-free ring buffer, so logging doesn't wait for the console.
+ * When the buffer is full, new messages are dropped.
+ */
+void startBufferedLogging();
+
+/** Stop the buffered logging task after writing out all buffered messages */
+void stopBufferedLogging();
+
+/** @return the amount of messages that were dropped because the log buffer was full */
+uint32_t getDroppedLogCount();
+
+/**
+ * Logger with a compile-time maximum log level.
+ * Calls for levels above MaxLevel compile to nothing.
+ * Enabled messages are formatted into a fixed-size stack buffer (no heap allocations).
+ * @tparam MaxLevel the highest level that is logged
+ */
+template<LogLevel MaxLevel>
+class BasicLogger {
 
     const char* tag;
 
 public:
 
-    explicit Logger(const char* tag) : tag(tag) {}
+    /** @param[in] tag must be a string that lives for the lifetime of the application (e.g. a string literal) */
+    explicit constexpr BasicLogger(const char* tag) : tag(tag) {}
+
+    static constexpr bool isEnabled(LogLevel level) { return level <= MaxLevel; }
 
     template <typename... Args>
     void log(LogLevel level, std::format_string<Args...> format, Args&&... args) const {
-        std::string message = std::format(format, std::forward<Args>(args)...);
-        defaultLoggerAdapter(level, tag, message.c_str());
+        if (!isEnabled(level)) {
+            return;
+        }
+
+        if (isBinaryLogging()) {
+            uint8_t record[LOG_MESSAGE_MAX_LENGTH];
+            auto length = encodeBinaryLogRecord(record, sizeof(record), level, getLogTimestamp(), tag, format.get(), args...);
+            writeBinaryLog(record, length);
+        } else {
+            char message[LOG_MESSAGE_MAX_LENGTH];
+            auto result = std::format_to_n(message, sizeof(message) - 1, format, std::forward<Args>(args)...);
+            *result.out = '\0';
+            writeLog(level, tag, message);
+        }
     }
 
     template <typename... Args>
     void verbose(std::format_string<Args...> format, Args&&... args) const {
-        log(LogLevel::Verbose, format, std::forward<Args>(args)...);
+        if constexpr (isEnabled(LogLevel::Verbose)) {
+            log(LogLevel::Verbose, format, std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     void debug(std::format_string<Args...> format, Args&&... args) const {
-        log(LogLevel::Debug, format, std::forward<Args>(args)...);
+        if constexpr (isEnabled(LogLevel::Debug)) {
+            log(LogLevel::Debug, format, std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     void info(std::format_string<Args...> format, Args&&... args) const {
-        log(LogLevel::Info, format, std::forward<Args>(args)...);
+        if constexpr (isEnabled(LogLevel::Info)) {
+            log(LogLevel::Info, format, std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     void warn(std::format_string<Args...> format, Args&&... args) const {
-        log(LogLevel::Warning, format, std::forward<Args>(args)...);
+        if constexpr (isEnabled(LogLevel::Warning)) {
+            log(LogLevel::Warning, format, std::forward<Args>(args)...);
+        }
     }
 
     template <typename... Args>
     void error(std::format_string<Args...> format, Args&&... args) const {
-        log(LogLevel::Error, format, std::forward<Args>(args)...);
+        if constexpr (isEnabled(LogLevel::Error)) {
+            log(LogLevel::Error, format, std::forward<Args>(args)...);
+        }
     }
 
-    bool isLoggingVerbose() const { return LogLevel::Verbose <= LOG_LEVEL; }
+    bool isLoggingVerbose() const { return isEnabled(LogLevel::Verbose); }
 
-    bool isLoggingDebug() const { return LogLevel::Debug <= LOG_LEVEL; }
+    bool isLoggingDebug() const { return isEnabled(LogLevel::Debug); }
 
-    bool isLoggingInfo() const { return LogLevel::Info <= LOG_LEVEL; }
+    bool isLoggingInfo() const { return isEnabled(LogLevel::Info); }
 
-    bool isLoggingWarning() const { return LogLevel::Warning <= LOG_LEVEL; }
+    bool isLoggingWarning() const { return isEnabled(LogLevel::Warning); }
 
-    bool isLoggingError() const { return LogLevel::Error <= LOG_LEVEL; }
+    bool isLoggingError() const { return isEnabled(LogLevel::Error); }
 };
 
+/** Logger that uses the global LOG_LEVEL */
+using Logger = BasicLogger<LOG_LEVEL>;
+
 }
+
+/**
+ * Log without evaluating the arguments when the level is disabled at compile time for the specified logger.
+ * Example: tt_log(LOGGER, tt::LogLevel::Debug, "Value {}", expensiveCall());
+ */
+#define tt_log(logger, level, ...)                                                      \
+    do {                                                                                \
+        if constexpr (std::remove_cvref_t<decltype(logger)>::isEnabled(level)) {        \
+            (logger).log(level, __VA_ARGS__);                                           \
+        }                                                                               \
+    } while (0)
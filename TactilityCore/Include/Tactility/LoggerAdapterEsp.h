@@ -4,7 +4,6 @@
 #include "LoggerAdapterShared.h"
 
 #include <esp_log.h>
-#include <sstream>
 
 namespace tt {
 
@@ -24,12 +23,33 @@ inline esp_log_level_t toEspLogLevel(LogLevel level) {
     }
 }
 
+/** @return the log timestamp in milliseconds */
+inline uint32_t getLogTimestamp() {
+    return esp_log_timestamp();
+}
+
+/** Write a log line with a timestamp that was taken earlier (e.g. when the log was buffered) */
+inline void writeLogLine(LogLevel level, uint32_t timestamp, const char* tag, const char* message) {
+    esp_log_write(
+        toEspLogLevel(level),
+        tag,
+        "%s%lu %s%c%s [%s%s%s] %s%s%s\n",
+        LOG_COLOR_GREY,
+        static_cast<unsigned long>(timestamp),
+        toTagColour(level),
+        toPrefix(level),
+        LOG_COLOR_GREY,
+        LOG_COLOR_RESET,
+        tag,
+        LOG_COLOR_GREY,
+        toMessageColour(level),
+        message,
+        LOG_COLOR_RESET
+    );
+}
+
 static const LoggerAdapter espLoggerAdapter = [](LogLevel level, const char* tag, const char* message) {
-    constexpr auto COLOR_RESET = "\033[0m";
-    constexpr auto COLOR_GREY = "\033[37m";
-    std::stringstream buffer;
-    buffer << COLOR_GREY << esp_log_timestamp() << ' ' << toTagColour(level) << toPrefix(level) << COLOR_GREY << " [" << COLOR_RESET << tag << COLOR_GREY << "] " << toMessageColour(level) << message << COLOR_RESET << std::endl;
-    esp_log_write(toEspLogLevel(level), tag, "%s", buffer.str().c_str());
+    writeLogLine(level, getLogTimestamp(), tag, message);
 };
 
 }
@@ -4,13 +4,14 @@
 #include "LoggerAdapterShared.h"
 
 #include <cstdint>
+#include <cstdio>
 #include <mutex>
-#include <sstream>
 #include <sys/time.h>
 
 namespace tt {
 
-static uint64_t getLogTimestamp() {
+/** @return the log timestamp in milliseconds */
+inline uint32_t getLogTimestamp() {
     static uint64_t base = 0U;
     static std::once_flag init_flag;
     std::call_once(init_flag, []() {
@@ -21,15 +22,29 @@ static uint64_t getLogTimestamp() {
     timeval time {};
     gettimeofday(&time, nullptr);
     uint64_t now = ((uint64_t)time.tv_sec * 1000U) + (time.tv_usec / 1000U);
-    return now - base;
+    return static_cast<uint32_t>(now - base);
+}
+
+/** Write a log line with a timestamp that was taken earlier (e.g. when the log was buffered) */
+inline void writeLogLine(LogLevel level, uint32_t timestamp, const char* tag, const char* message) {
+    printf(
+        "%s%lu %s%c%s [%s%s%s] %s%s%s\n",
+        LOG_COLOR_GREY,
+        static_cast<unsigned long>(timestamp),
+        toTagColour(level),
+        toPrefix(level),
+        LOG_COLOR_GREY,
+        LOG_COLOR_RESET,
+        tag,
+        LOG_COLOR_GREY,
+        toMessageColour(level),
+        message,
+        LOG_COLOR_RESET
+    );
 }
 
 static const LoggerAdapter genericLoggerAdapter = [](LogLevel level, const char* tag, const char* message) {
-    constexpr auto COLOR_RESET = "\033[0m";
-    constexpr auto COLOR_GREY = "\033[37m";
-    std::stringstream buffer;
-    buffer << COLOR_GREY << getLogTimestamp() << ' ' << toTagColour(level) << toPrefix(level) << COLOR_GREY << " [" << COLOR_RESET << tag << COLOR_GREY << "] " << toMessageColour(level) << message << COLOR_RESET << std::endl;
-    printf(buffer.str().c_str());
+    writeLogLine(level, getLogTimestamp(), tag, message);
 };
 
-}
\ No newline at end of file
+}
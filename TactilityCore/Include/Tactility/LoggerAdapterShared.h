@@ -4,6 +4,9 @@
 
 namespace tt {
 
+constexpr auto LOG_COLOR_RESET = "\033[0m";
+constexpr auto LOG_COLOR_GREY = "\033[37m";
+
 inline const char* toTagColour(LogLevel level) {
     using enum LogLevel;
     switch (level) {
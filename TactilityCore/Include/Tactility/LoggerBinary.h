@@ -0,0 +1,155 @@
+/**
+ * Binary log records replace the formatted text by a hash of the tag, a hash of the format string and the raw arguments.
+ * This is much cheaper than formatting on the device. Buildscripts/log-decoder.py turns the records back into text.
+ *
+ * Record layout (little endian):
+ *   u8 sync0, u8 sync1, u16 payload length
+ *   payload: u8 level, u32 timestamp (ms), u32 tag hash, u32 format hash, u8 argument count, arguments...
+ *
+ * Each argument starts with a type byte:
+ *   'i' = i64, 'u' = u64, 'f' = f64, 'b' = u8, 's' = u16 length + characters
+ */
+#pragma once
+
+#include "LoggerCommon.h"
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string_view>
+#include <type_traits>
+
+namespace tt {
+
+constexpr uint8_t BINARY_LOG_SYNC_0 = 0xA5;
+constexpr uint8_t BINARY_LOG_SYNC_1 = 0x5A;
+constexpr size_t BINARY_LOG_HEADER_SIZE = 4;
+
+/** FNV-1a hash that is used for tag and format identifiers */
+constexpr uint32_t getLogHash(std::string_view text) {
+    uint32_t hash = 2166136261U;
+    for (char character : text) {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+/** Writes a binary log record into a fixed buffer. Arguments that don't fit are left out. */
+class BinaryLogWriter final {
+
+    uint8_t* buffer;
+    size_t capacity;
+    size_t length = 0;
+    size_t argumentCountOffset = 0;
+    uint8_t argumentCount = 0;
+
+    bool hasSpace(size_t size) const { return length + size <= capacity; }
+
+    void writeUnchecked(const void* data, size_t size) {
+        memcpy(buffer + length, data, size);
+        length += size;
+    }
+
+    template<typename T>
+    void writeUnchecked(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        // All supported targets are little endian
+        writeUnchecked(&value, sizeof(T));
+    }
+
+    void writeString(std::string_view text) {
+        auto text_length = static_cast<uint16_t>(std::min<size_t>(text.size(), UINT16_MAX));
+        if (!hasSpace(1 + sizeof(uint16_t))) {
+            return;
+        }
+        // Truncate strings that don't fit entirely
+        text_length = static_cast<uint16_t>(std::min<size_t>(text_length, capacity - length - 1 - sizeof(uint16_t)));
+        writeUnchecked<uint8_t>('s');
+        writeUnchecked(text_length);
+        writeUnchecked(text.data(), text_length);
+        argumentCount++;
+    }
+
+    template<typename T>
+    void writeTyped(uint8_t type, T value) {
+        if (hasSpace(1 + sizeof(T))) {
+            writeUnchecked(type);
+            writeUnchecked(value);
+            argumentCount++;
+        }
+    }
+
+public:
+
+    BinaryLogWriter(uint8_t* buffer, size_t capacity) : buffer(buffer), capacity(capacity) {}
+
+    /** @return false when the buffer is too small for the header */
+    bool begin(LogLevel level, uint32_t timestamp, const char* tag, std::string_view format) {
+        constexpr size_t payload_header_size = 1 + 4 + 4 + 4 + 1;
+        if (capacity < BINARY_LOG_HEADER_SIZE + payload_header_size) {
+            return false;
+        }
+        writeUnchecked(BINARY_LOG_SYNC_0);
+        writeUnchecked(BINARY_LOG_SYNC_1);
+        writeUnchecked<uint16_t>(0); // Length is written in end()
+        writeUnchecked(static_cast<uint8_t>(level));
+        writeUnchecked(timestamp);
+        writeUnchecked(getLogHash(tag));
+        writeUnchecked(getLogHash(format));
+        argumentCountOffset = length;
+        writeUnchecked<uint8_t>(0); // Argument count is written in end()
+        return true;
+    }
+
+    template<typename T>
+    void writeArgument(const T& argument) {
+        using Type = std::remove_cvref_t<T>;
+        if constexpr (std::same_as<Type, bool>) {
+            writeTyped<uint8_t>('b', argument ? 1U : 0U);
+        } else if constexpr (std::same_as<Type, char>) {
+            writeString(std::string_view(&argument, 1));
+        } else if constexpr (std::signed_integral<Type>) {
+            writeTyped<int64_t>('i', argument);
+        } else if constexpr (std::unsigned_integral<Type>) {
+            writeTyped<uint64_t>('u', argument);
+        } else if constexpr (std::floating_point<Type>) {
+            writeTyped<double>('f', argument);
+        } else if constexpr (std::is_enum_v<Type>) {
+            writeTyped<int64_t>('i', static_cast<int64_t>(argument));
+        } else if constexpr (std::is_convertible_v<const Type&, std::string_view>) {
+            writeString(std::string_view(argument));
+        } else {
+            // Fall back to formatting the argument on the device
+            char text[64];
+            auto result = std::format_to_n(text, sizeof(text), "{}", argument);
+            writeString(std::string_view(text, result.out - text));
+        }
+    }
+
+    /** @return the total record length */
+    size_t end() {
+        auto payload_length = static_cast<uint16_t>(length - BINARY_LOG_HEADER_SIZE);
+        memcpy(buffer + 2, &payload_length, sizeof(payload_length));
+        buffer[argumentCountOffset] = argumentCount;
+        return length;
+    }
+};
+
+/**
+ * Encode a binary log record
+ * @return the record length or 0 if the buffer is too small
+ */
+template<typename... Args>
+size_t encodeBinaryLogRecord(uint8_t* buffer, size_t capacity, LogLevel level, uint32_t timestamp, const char* tag, std::string_view format, const Args&... args) {
+    BinaryLogWriter writer(buffer, capacity);
+    if (!writer.begin(level, timestamp, tag, format)) {
+        return 0;
+    }
+    (writer.writeArgument(args), ...);
+    return writer.end();
+}
+
+}
@@ -2,8 +2,19 @@
 
 #include "LoggerCommon.h"
 
+#include <cstddef>
+
 namespace tt {
 
 constexpr auto LOG_LEVEL = LogLevel::Info;
 
-}
\ No newline at end of file
+/** The maximum length of a formatted log message: longer messages are truncated */
+constexpr size_t LOG_MESSAGE_MAX_LENGTH = 256;
+
+/** The amount of records that fit in the ring buffer when buffered logging is started */
+constexpr size_t LOG_BUFFER_CAPACITY = 32;
+
+/** The maximum length of a log message in the ring buffer: longer messages are truncated */
+constexpr size_t LOG_BUFFER_MESSAGE_LENGTH = 120;
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <mbedtls/sha256.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tt::crypt {
+
+/** Incremental SHA-256 hashing, so data can be hashed while it is being received */
+class Sha256 final {
+
+    mbedtls_sha256_context context;
+
+public:
+
+    Sha256();
+
+    ~Sha256();
+
+    Sha256(const Sha256&) = delete;
+    Sha256& operator=(const Sha256&) = delete;
+
+    /** Add data to the hash */
+    void update(const void* data, size_t length);
+
+    /**
+     * Finish the hash. Call reset() before hashing new data.
+     * @return the digest as a lowercase hexadecimal string
+     */
+    std::string finishHex();
+
+    /** Start a new hash */
+    void reset();
+};
+
+} // namespace
@@ -0,0 +1,160 @@
+#include <Tactility/Logger.h>
+
+#include <Tactility/BoundedDispatcher.h>
+#include <Tactility/Thread.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace tt {
+
+struct LogRecord {
+    /** nullptr for binary records */
+    const char* tag;
+    uint32_t timestamp;
+    LogLevel level;
+    uint16_t length;
+    char data[LOG_BUFFER_MESSAGE_LENGTH];
+};
+
+class LogBuffer final {
+
+    std::atomic<bool> interrupted = true;
+    uint32_t reportedDropCount = 0;
+
+    static void writeRecord(const LogRecord& record) {
+        if (record.tag != nullptr) {
+            writeLogLine(record.level, record.timestamp, record.tag, record.data);
+        } else {
+            fwrite(record.data, 1, record.length, stdout);
+            fflush(stdout);
+        }
+    }
+
+    int32_t threadMain() {
+        while (!interrupted) {
+            dispatcher.consume(100 / portTICK_PERIOD_MS);
+
+            auto dropped = dispatcher.getRejectedCount();
+            if (dropped != reportedDropCount) {
+                char message[64];
+                snprintf(message, sizeof(message), "Log buffer full: dropped %lu message(s)", static_cast<unsigned long>(dropped - reportedDropCount));
+                writeLogLine(LogLevel::Warning, getLogTimestamp(), "Logger", message);
+                reportedDropCount = dropped;
+            }
+        }
+
+        // Write out what's left
+        dispatcher.consume(0);
+        return 0;
+    }
+
+public:
+
+    BoundedDispatcher<LOG_BUFFER_CAPACITY, sizeof(LogRecord)> dispatcher;
+
+    Thread thread = Thread("log_buffer", 4096, [this] { return threadMain(); });
+
+    LogBuffer() {
+        thread.setPriority(Thread::Priority::Lower);
+    }
+
+    bool push(const LogRecord& record) {
+        return dispatcher.dispatch([record] { writeRecord(record); }, 0);
+    }
+
+    void start() {
+        interrupted = false;
+        thread.start();
+    }
+
+    void stop() {
+        interrupted = true;
+        thread.join();
+    }
+};
+
+/** Set while buffered logging is active */
+static std::atomic<LogBuffer*> activeLogBuffer = nullptr;
+static std::atomic<bool> binaryLogging = false;
+
+/** Never destroyed, because a logging task might still hold a pointer to it */
+static LogBuffer& getLogBuffer() {
+    static auto* log_buffer = new LogBuffer();
+    return *log_buffer;
+}
+
+static void writeBinaryRecordDirect(const uint8_t* record, size_t length) {
+    fwrite(record, 1, length, stdout);
+    fflush(stdout);
+}
+
+void writeLog(LogLevel level, const char* tag, const char* message) {
+    auto* log_buffer = activeLogBuffer.load();
+    if (log_buffer == nullptr) {
+        defaultLoggerAdapter(level, tag, message);
+        return;
+    }
+
+    LogRecord record = {
+        .tag = tag,
+        .timestamp = getLogTimestamp(),
+        .level = level,
+        .length = 0,
+        .data = {}
+    };
+    auto length = std::min(strlen(message), sizeof(record.data) - 1);
+    memcpy(record.data, message, length);
+    record.data[length] = '\0';
+    record.length = static_cast<uint16_t>(length);
+    log_buffer->push(record);
+}
+
+void writeBinaryLog(const uint8_t* record, size_t length) {
+    auto* log_buffer = activeLogBuffer.load();
+    // Binary records can't be truncated, so big records are written directly
+    if (log_buffer == nullptr || length > LOG_BUFFER_MESSAGE_LENGTH) {
+        writeBinaryRecordDirect(record, length);
+        return;
+    }
+
+    LogRecord buffered_record = {
+        .tag = nullptr,
+        .timestamp = 0,
+        .level = LogLevel::Info,
+        .length = static_cast<uint16_t>(length),
+        .data = {}
+    };
+    memcpy(buffered_record.data, record, length);
+    log_buffer->push(buffered_record);
+}
+
+bool isBinaryLogging() {
+    return binaryLogging.load(std::memory_order_relaxed);
+}
+
+void setBinaryLogging(bool enabled) {
+    binaryLogging = enabled;
+}
+
+void startBufferedLogging() {
+    auto& log_buffer = getLogBuffer();
+    if (activeLogBuffer.load() == nullptr) {
+        log_buffer.start();
+        activeLogBuffer = &log_buffer;
+    }
+}
+
+void stopBufferedLogging() {
+    auto* log_buffer = activeLogBuffer.exchange(nullptr);
+    if (log_buffer != nullptr) {
+        log_buffer->stop();
+    }
+}
+
+uint32_t getDroppedLogCount() {
+    return getLogBuffer().dispatcher.getRejectedCount();
+}
+
+}
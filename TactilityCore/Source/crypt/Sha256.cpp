@@ -0,0 +1,38 @@
+#include "Tactility/crypt/Sha256.h"
+
+namespace tt::crypt {
+
+Sha256::Sha256() {
+    mbedtls_sha256_init(&context);
+    mbedtls_sha256_starts(&context, 0);
+}
+
+Sha256::~Sha256() {
+    mbedtls_sha256_free(&context);
+}
+
+void Sha256::update(const void* data, size_t length) {
+    mbedtls_sha256_update(&context, static_cast<const unsigned char*>(data), length);
+}
+
+std::string Sha256::finishHex() {
+    unsigned char digest[32];
+    mbedtls_sha256_finish(&context, digest);
+
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    std::string result;
+    result.reserve(sizeof(digest) * 2);
+    for (auto byte : digest) {
+        result += HEX_DIGITS[byte >> 4];
+        result += HEX_DIGITS[byte & 0x0F];
+    }
+    return result;
+}
+
+void Sha256::reset() {
+    mbedtls_sha256_free(&context);
+    mbedtls_sha256_init(&context);
+    mbedtls_sha256_starts(&context, 0);
+}
+
+} // namespace
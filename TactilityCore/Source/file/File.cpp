@@ -316,6 +316,10 @@ bool deleteRecursively(const std::string& path) {
         }
 
         for (const auto& entry : entries) {
+            // Only POSIX file systems (e.g. the simulator) list these
+            if (strcmp(entry.d_name, ".") == 0 || strcmp(entry.d_name, "..") == 0) {
+                continue;
+            }
             auto child_path = path + "/" + entry.d_name;
             if (!deleteRecursively(child_path)) {
                 return false;
@@ -0,0 +1,248 @@
+/**
+ * BoundedDispatcher is a thread-safe code execution queue with a fixed capacity.
+ */
+#pragma once
+
+#include "EventGroup.h"
+#include "InlineFunction.h"
+#include "kernel/Kernel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace tt {
+
+/**
+ * An alternative to Dispatcher that never allocates after construction.
+ *
+ * Functions are stored inline in a pre-allocated ring buffer that supports
+ * multiple producers and a single consumer without a mutex.
+ * This makes dispatch() safe to call from ISR context.
+ *
+ * When the ring buffer is full, the configured Backpressure strategy decides what happens.
+ *
+ * @tparam Capacity the maximum amount of queued functions (must be a power of 2)
+ * @tparam FunctionSize the maximum size in bytes of a dispatched callable (including its captures)
+ */
+template<size_t Capacity = 32, size_t FunctionSize = 32>
+class BoundedDispatcher final {
+
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+    static constexpr EventBits_t WAIT_FLAG = 1U;
+    static constexpr EventBits_t SPACE_FLAG = 2U;
+
+public:
+
+    typedef InlineFunction<FunctionSize> Function;
+
+    /** What dispatch() does when the queue is full */
+    enum class Backpressure {
+        /** Fail the dispatch */
+        Reject,
+        /** Wait for the consumer to make space until the timeout passes (behaves like Reject in ISR context) */
+        Block,
+        /** Discard the oldest queued function to make space */
+        DropOldest
+    };
+
+private:
+
+    /**
+     * Each cell has a sequence number that tells producers and the consumer whether the cell is writable or readable.
+     * This is the bounded queue design by Dmitry Vyukov. Dequeueing is done with a CAS too,
+     * so producers can safely discard the oldest item for Backpressure::DropOldest.
+     */
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Function function;
+    };
+
+    static constexpr size_t MASK = Capacity - 1;
+
+    Cell cells[Capacity];
+    alignas(32) std::atomic<size_t> enqueuePosition = 0;
+    alignas(32) std::atomic<size_t> dequeuePosition = 0;
+    std::atomic<uint32_t> blockedProducers = 0;
+    std::atomic<uint32_t> rejectedCount = 0;
+    std::atomic<uint32_t> droppedCount = 0;
+    std::atomic<bool> shutdown = false;
+    EventGroup eventFlag;
+    Backpressure backpressure;
+
+    template<typename Callable>
+    bool tryPush(Callable&& callable) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & MASK];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.function.emplace(std::forward<Callable>(callable));
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // Full
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(Function& outFunction) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & MASK];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    outFunction = std::move(cell.function);
+                    cell.sequence.store(position + Capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // Empty (or a producer has not finished writing yet)
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void signalSpaceAvailable() {
+        if (blockedProducers.load() > 0U) {
+            eventFlag.set(SPACE_FLAG);
+        }
+    }
+
+    template<typename Callable>
+    bool pushOrBlock(Callable&& callable, TickType_t timeout) {
+        if (xPortInIsrContext() == pdTRUE || timeout == 0U) {
+            return false;
+        }
+
+        const TickType_t start_ticks = kernel::getTicks();
+        blockedProducers++;
+        bool pushed;
+        do {
+            // Retry before waiting: the consumer might have made space before blockedProducers was incremented
+            pushed = tryPush(std::forward<Callable>(callable));
+            if (pushed || shutdown) {
+                break;
+            }
+
+            const TickType_t passed = kernel::getTicks() - start_ticks;
+            if (timeout != kernel::MAX_TICKS && passed >= timeout) {
+                break;
+            }
+
+            const TickType_t remaining = (timeout == kernel::MAX_TICKS) ? kernel::MAX_TICKS : (timeout - passed);
+            eventFlag.wait(SPACE_FLAG, false, true, remaining);
+        } while (true);
+        blockedProducers--;
+
+        return pushed;
+    }
+
+public:
+
+    explicit BoundedDispatcher(Backpressure backpressure = Backpressure::Reject) : backpressure(backpressure) {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~BoundedDispatcher() {
+        shutdown = true;
+    }
+
+    BoundedDispatcher(const BoundedDispatcher&) = delete;
+    BoundedDispatcher& operator=(const BoundedDispatcher&) = delete;
+
+    /**
+     * Queue a function to be consumed elsewhere.
+     * Can be called from ISR context.
+     * @param[in] callable the function to execute elsewhere: it must fit inside FunctionSize
+     * @param[in] timeout the maximum wait time for free space (only applies to Backpressure::Block, must be 0 in ISR context)
+     * @return true if the function was queued
+     */
+    template<typename Callable>
+    bool dispatch(Callable&& callable, TickType_t timeout = kernel::MAX_TICKS) {
+        if (shutdown) {
+            return false;
+        }
+
+        bool pushed = tryPush(std::forward<Callable>(callable));
+        if (!pushed) {
+            switch (backpressure) {
+                case Backpressure::Reject:
+                    break;
+                case Backpressure::Block:
+                    pushed = pushOrBlock(std::forward<Callable>(callable), timeout);
+                    break;
+                case Backpressure::DropOldest:
+                    // Other producers might fill the freed cell first, so we try a limited amount of times
+                    for (size_t attempt = 0; attempt < Capacity && !pushed; ++attempt) {
+                        Function oldest;
+                        if (tryPop(oldest)) {
+                            droppedCount++;
+                        }
+                        pushed = tryPush(std::forward<Callable>(callable));
+                    }
+                    break;
+            }
+        }
+
+        if (!pushed) {
+            rejectedCount++;
+            return false;
+        }
+
+        eventFlag.set(WAIT_FLAG);
+        return true;
+    }
+
+    /**
+     * Consume 1 or more dispatched function (if any) until the queue is empty.
+     * Only 1 task should call this method.
+     * @warning The timeout is only the wait time before consuming the message! It is not a limit to the total execution time when calling this method.
+     * @param[in] timeout the ticks to wait for a message
+     * @return the amount of messages that were consumed
+     */
+    uint32_t consume(TickType_t timeout = kernel::MAX_TICKS) {
+        if (!eventFlag.wait(WAIT_FLAG, false, true, timeout)) {
+            return 0;
+        }
+
+        uint32_t consumed = 0;
+        Function function;
+        while (!shutdown && tryPop(function)) {
+            signalSpaceAvailable();
+            function();
+            function.reset();
+            consumed++;
+        }
+
+        return consumed;
+    }
+
+    /** @return the approximate amount of queued functions */
+    size_t getCount() const {
+        auto enqueued = enqueuePosition.load(std::memory_order_relaxed);
+        auto dequeued = dequeuePosition.load(std::memory_order_relaxed);
+        return (enqueued > dequeued) ? (enqueued - dequeued) : 0U;
+    }
+
+    /** @return the amount of functions that were discarded by Backpressure::DropOldest */
+    uint32_t getDroppedCount() const { return droppedCount; }
+
+    /** @return the amount of dispatch() calls that failed because the queue was full */
+    uint32_t getRejectedCount() const { return rejectedCount; }
+
+    static constexpr size_t getCapacity() { return Capacity; }
+};
+
+} // namespace
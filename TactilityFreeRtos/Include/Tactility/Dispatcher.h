@@ -13,7 +13,7 @@
 
 #include <functional>
 #include <memory>
-#include <queue>
+#include <deque>
 
 namespace tt {
 
@@ -27,18 +27,61 @@ class Dispatcher final {
     static constexpr auto TAG = "Dispatcher";
     static constexpr EventBits_t BACKPRESSURE_WARNING_COUNT = 100U;
     static constexpr EventBits_t WAIT_FLAG = 1U;
+    static constexpr int64_t STATISTICS_WINDOW_MICROS = 1000000;
 
 public:
 
     typedef std::function<void()> Function;
 
+    struct Statistics {
+        /** The highest amount of queued functions since the last reset */
+        size_t queueHighWaterMark;
+        /** The amount of consumed functions since the last reset */
+        uint32_t consumedCount;
+        /** The consumption rate during the last completed measurement window of 1 second */
+        uint32_t itemsPerSecond;
+        /** The highest time between dispatching a function and the start of its execution */
+        int64_t maxLatencyMicros;
+    };
+
 private:
 
+    struct Entry {
+        Function function;
+        int64_t dispatchTime;
+    };
+
     Mutex mutex;
-    std::queue<Function> queue = {};
+    std::deque<Entry> queue = {};
+    /** Functions that were taken from the queue, but weren't executed yet because the time budget ran out. Only accessed by the consumer. */
+    std::deque<Entry> batch = {};
     EventGroup eventFlag;
     bool shutdown = false;
 
+    // Guarded by mutex
+    Statistics statistics = {};
+    int64_t windowStartTime = 0;
+    uint32_t windowConsumedCount = 0;
+
+    void updateStatistics(uint32_t consumed, int64_t maxLatency) {
+        mutex.lock();
+        statistics.consumedCount += consumed;
+        if (maxLatency > statistics.maxLatencyMicros) {
+            statistics.maxLatencyMicros = maxLatency;
+        }
+        windowConsumedCount += consumed;
+        auto now = kernel::getMicrosSinceBoot();
+        auto window_duration = now - windowStartTime;
+        if (window_duration >= STATISTICS_WINDOW_MICROS) {
+            if (windowStartTime != 0) {
+                statistics.itemsPerSecond = static_cast<uint32_t>(static_cast<int64_t>(windowConsumedCount) * 1000000 / window_duration);
+            }
+            windowStartTime = now;
+            windowConsumedCount = 0;
+        }
+        mutex.unlock();
+    }
+
 public:
 
     explicit Dispatcher() = default;
@@ -57,6 +100,8 @@ public:
      * @return true if dispatching was successful (timeout not reached)
      */
     bool dispatch(Function function, TickType_t timeout = kernel::MAX_TICKS) {
+        auto dispatch_time = kernel::getMicrosSinceBoot();
+
         // Mutate
         if (!mutex.lock(timeout)) {
 #ifdef ESP_PLATFORM
@@ -66,10 +111,17 @@ public:
         }
 
         if (shutdown) {
+            mutex.unlock();
             return false;
         }
 
-        queue.push(std::move(function));
+        queue.push_back({
+            .function = std::move(function),
+            .dispatchTime = dispatch_time
+        });
+        if (queue.size() > statistics.queueHighWaterMark) {
+            statistics.queueHighWaterMark = queue.size();
+        }
         if (queue.size() == BACKPRESSURE_WARNING_COUNT) {
 #ifdef ESP_PLATFORM
             ESP_LOGW(TAG, "Backpressure: You're not consuming fast enough (100 queued)");
@@ -85,14 +137,18 @@ public:
     }
 
     /**
-     * Consume 1 or more dispatched function (if any) until the queue is empty.
-     * @warning The timeout is only the wait time before consuming the message! It is not a limit to the total execution time when calling this method.
+     * Consume dispatched functions (if any) until the queue is empty or until the time budget is used up.
+     * All pending functions are taken from the queue with a single lock acquisition and are then executed without holding the lock.
+     * When the budget is used up, the remaining functions are kept for the next call and the calling task yields.
+     * @warning The timeout is only the wait time before consuming the message! Use the budget to limit the total execution time.
+     * @warning Only 1 task should consume from a Dispatcher.
      * @param[in] timeout the ticks to wait for a message
+     * @param[in] budget the ticks after which no new functions are started (a running function is never interrupted)
      * @return the amount of messages that were consumed
      */
-    uint32_t consume(TickType_t timeout = kernel::MAX_TICKS) {
-        // Wait for signal
-        if (!eventFlag.wait(WAIT_FLAG, false, true, timeout)) {
+    uint32_t consume(TickType_t timeout = kernel::MAX_TICKS, TickType_t budget = kernel::MAX_TICKS) {
+        // Wait for signal, unless there is work left from the last call
+        if (batch.empty() && !eventFlag.wait(WAIT_FLAG, false, true, timeout)) {
             return 0;
         }
 
@@ -100,33 +156,67 @@ public:
             return 0;
         }
 
-        // Mutate
-        bool processing = true;
+        const auto start_time = kernel::getMicrosSinceBoot();
+        const auto budget_micros = (budget == kernel::MAX_TICKS)
+            ? INT64_MAX
+            : static_cast<int64_t>(budget) * portTICK_PERIOD_MS * 1000;
         uint32_t consumed = 0;
+        int64_t max_latency = 0;
+        bool budget_used = false;
+
         do {
-            if (mutex.lock(10)) {
-                if (!queue.empty()) {
-                    auto function = queue.front();
-                    queue.pop();
-                    consumed++;
-                    processing = !queue.empty();
-                    // Don't keep lock as callback might be slow
-                    mutex.unlock();
-                    function();
-                } else {
-                    processing = false;
-                    mutex.unlock();
+            if (batch.empty()) {
+                // Don't keep lock as callbacks might be slow
+                mutex.lock();
+                batch.swap(queue);
+                mutex.unlock();
+                if (batch.empty()) {
+                    break;
                 }
-            } else {
-#ifdef ESP_PLATFORM
-                ESP_LOGW(TAG, "Mutex acquisition timeout");
-#endif
             }
 
-        } while (processing && !shutdown);
+            while (!batch.empty() && !shutdown) {
+                auto entry = std::move(batch.front());
+                batch.pop_front();
+                auto now = kernel::getMicrosSinceBoot();
+                if (now - entry.dispatchTime > max_latency) {
+                    max_latency = now - entry.dispatchTime;
+                }
+                entry.function();
+                consumed++;
+                if (kernel::getMicrosSinceBoot() - start_time >= budget_micros) {
+                    budget_used = true;
+                    break;
+                }
+            }
+        } while (!budget_used && !shutdown);
+
+        updateStatistics(consumed, max_latency);
+
+        if (budget_used) {
+            // Let other tasks of the same priority run before continuing with the remaining work
+            kernel::delayTicks(0);
+        }
 
         return consumed;
     }
+
+    /** @return a copy of the current statistics */
+    Statistics getStatistics() const {
+        mutex.lock();
+        auto result = statistics;
+        mutex.unlock();
+        return result;
+    }
+
+    /** Reset all statistics to their initial values */
+    void resetStatistics() {
+        mutex.lock();
+        statistics = {};
+        windowStartTime = 0;
+        windowConsumedCount = 0;
+        mutex.unlock();
+    }
 };
 
 } // namespace
@@ -10,6 +10,7 @@ class DispatcherThread final {
 
     Dispatcher dispatcher;
     std::unique_ptr<Thread> thread;
+    TickType_t consumeBudget;
     bool interruptThread = true;
 
     int32_t threadMain() {
@@ -18,7 +19,7 @@ class DispatcherThread final {
              * If this value is too high (e.g. 1 second) then the dispatcher destroys too slowly when the simulator exits.
              * This causes the problems with other services doing an update (e.g. Statusbar) and calling into destroyed mutex in the global scope.
              */
-            dispatcher.consume(100 / portTICK_PERIOD_MS);
+            dispatcher.consume(100 / portTICK_PERIOD_MS, consumeBudget);
         } while (!interruptThread);
 
         return 0;
@@ -26,7 +27,12 @@ class DispatcherThread final {
 
 public:
 
-    explicit DispatcherThread(const std::string& threadName, size_t threadStackSize = 4096) {
+    /**
+     * @param[in] threadName
+     * @param[in] threadStackSize
+     * @param[in] consumeBudget the maximum time to spend consuming before yielding to other tasks (see Dispatcher::consume())
+     */
+    explicit DispatcherThread(const std::string& threadName, size_t threadStackSize = 4096, TickType_t consumeBudget = kernel::millisToTicks(50)) : consumeBudget(consumeBudget) {
         thread = std::make_unique<Thread>(
             threadName,
             threadStackSize,
@@ -61,6 +67,9 @@ public:
         thread->join();
     }
 
+    /** @return the statistics of the underlying Dispatcher */
+    Dispatcher::Statistics getStatistics() const { return dispatcher.getStatistics(); }
+
     /** @return true of the thread is started */
     bool isStarted() const { return thread != nullptr && !interruptThread; }
 };
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tt {
+
+/**
+ * A move-only replacement for std::function<void()> that stores its callable inline.
+ * It never allocates: a callable that doesn't fit in the buffer fails to compile.
+ * This makes it usable from ISR context and in pre-allocated containers.
+ * @tparam Size the maximum size in bytes of the stored callable
+ */
+template<size_t Size>
+class InlineFunction final {
+
+    struct Operations {
+        void (*invoke)(void* storage);
+        void (*move)(void* from, void* to);
+        void (*destroy)(void* storage);
+    };
+
+    template<typename Callable>
+    static constexpr Operations operationsFor = {
+        .invoke = [](void* storage) {
+            (*static_cast<Callable*>(storage))();
+        },
+        .move = [](void* from, void* to) {
+            new (to) Callable(std::move(*static_cast<Callable*>(from)));
+            static_cast<Callable*>(from)->~Callable();
+        },
+        .destroy = [](void* storage) {
+            static_cast<Callable*>(storage)->~Callable();
+        }
+    };
+
+    alignas(std::max_align_t) unsigned char storage[Size];
+    const Operations* operations = nullptr;
+
+public:
+
+    static constexpr size_t CAPACITY = Size;
+
+    InlineFunction() = default;
+
+    template<typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, InlineFunction>>>
+    InlineFunction(Callable&& callable) { // NOLINT: implicit conversion is intended, like std::function
+        emplace(std::forward<Callable>(callable));
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept {
+        if (other.operations != nullptr) {
+            other.operations->move(other.storage, storage);
+            operations = other.operations;
+            other.operations = nullptr;
+        }
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.operations != nullptr) {
+                other.operations->move(other.storage, storage);
+                operations = other.operations;
+                other.operations = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() { reset(); }
+
+    /** Replace the current callable (if any) by constructing the new one in place. */
+    template<typename Callable>
+    void emplace(Callable&& callable) {
+        using StoredType = std::decay_t<Callable>;
+        static_assert(sizeof(StoredType) <= Size, "Callable does not fit in InlineFunction: increase the size or capture less");
+        static_assert(alignof(StoredType) <= alignof(std::max_align_t), "Callable alignment is not supported");
+        static_assert(std::is_nothrow_move_constructible_v<StoredType>, "Callable must be nothrow move constructible");
+        static_assert(std::is_invocable_v<StoredType&>, "Callable must be invocable without arguments");
+        reset();
+        new (storage) StoredType(std::forward<Callable>(callable));
+        operations = &operationsFor<StoredType>;
+    }
+
+    /** Destroy the stored callable (if any) */
+    void reset() {
+        if (operations != nullptr) {
+            operations->destroy(storage);
+            operations = nullptr;
+        }
+    }
+
+    /** @warning Calling an empty InlineFunction is undefined behaviour */
+    void operator()() { operations->invoke(storage); }
+
+    explicit operator bool() const { return operations != nullptr; }
+};
+
+} // namespace
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "DispatcherThread.h"
 #include "Mutex.h"
+#include "RecursiveMutex.h"
 #include "kernel/Kernel.h"
 
+#include <atomic>
 #include <functional>
-#include <list>
+#include <memory>
+#include <vector>
 
 #ifdef ESP_PLATFORM
 #include <esp_log.h>
@@ -14,60 +18,241 @@
 
 namespace tt {
 
-/** Publish and subscribe to messages in a thread-safe manner. */
+/**
+ * Publish and subscribe to messages in a thread-safe manner.
+ *
+ * The subscriptions are stored in an immutable snapshot (RCU-style):
+ * publish() reads the current snapshot without locking, while subscribe() and unsubscribe()
+ * swap in a new snapshot. This means that a slow subscriber doesn't block other publishers,
+ * and that subscribers can unsubscribe from within their callback.
+ *
+ * unsubscribe() waits for the publish() calls that are in progress on other tasks,
+ * so a callback is never called after unsubscribe() returns.
+ */
 template<typename DataType>
 class PubSub final {
 
+public:
+
+    typedef std::function<void(const DataType&)> Callback;
+    typedef void* SubscriptionHandle;
+
+private:
+
+    /** State for subscriptions that receive their messages on a DispatcherThread */
+    struct AsyncTarget {
+        Callback callback;
+        /** Held while the callback runs, so unsubscribe() can wait for it */
+        RecursiveMutex mutex;
+        bool active = true;
+    };
+
     struct Subscription {
         uint64_t id;
-        std::function<void(DataType)> callback;
+        Callback callback;
+        std::shared_ptr<AsyncTarget> asyncTarget;
     };
 
-    typedef std::list<Subscription> Subscriptions;
-    uint64_t lastId = 0;
-    Subscriptions items;
+    typedef std::vector<Subscription> Subscriptions;
+
+    /** A publish() that is in progress on the current task */
+    struct PublishFrame {
+        const PubSub* pubSub;
+        const Subscriptions* snapshot;
+        uint32_t readerIndex;
+        PublishFrame* previous;
+    };
+
+    /** The publish() calls of the current task, innermost first */
+    static inline thread_local PublishFrame* publishFrames = nullptr;
+
+    /** The amount of retired snapshots after which a publish() waits to reclaim them */
+    static constexpr size_t MAX_RETIRED_SNAPSHOTS = 8;
+
+    std::atomic<const Subscriptions*> snapshot = new Subscriptions();
+    /**
+     * The readers are counted in 2 groups: a grace period moves new readers to the other group
+     * and then waits for the old group to finish.
+     */
+    std::atomic<uint32_t> readerCounts[2] = { 0, 0 };
+    std::atomic<uint32_t> readerEpoch = 0;
+    std::atomic<size_t> retiredCount = 0;
+
+    // Guarded by mutex
     Mutex mutex;
+    uint64_t lastId = 0;
+    std::vector<const Subscriptions*> retired;
 
-public:
+    /** Serializes grace periods */
+    Mutex graceMutex;
 
-    typedef void* SubscriptionHandle;
+    bool isPublishingOnCurrentTask() const {
+        for (auto* frame = publishFrames; frame != nullptr; frame = frame->previous) {
+            if (frame->pubSub == this) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isSnapshotUsedByCurrentTask(const Subscriptions* item) const {
+        for (auto* frame = publishFrames; frame != nullptr; frame = frame->previous) {
+            if (frame->pubSub == this && frame->snapshot == item) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Free the retired snapshots if only the current task is reading, without blocking.
+     * Must be called with the mutex locked.
+     */
+    void tryReclaimRetiredLocked() {
+        uint32_t own_readers[2] = { 0, 0 };
+        for (auto* frame = publishFrames; frame != nullptr; frame = frame->previous) {
+            if (frame->pubSub == this) {
+                own_readers[frame->readerIndex]++;
+            }
+        }
+
+        // Readers that start after this check use the current snapshot
+        if (readerCounts[0] != own_readers[0] || readerCounts[1] != own_readers[1]) {
+            return;
+        }
+
+        std::erase_if(retired, [this](auto* item) {
+            if (isSnapshotUsedByCurrentTask(item)) {
+                return false;
+            } else {
+                delete item;
+                return true;
+            }
+        });
+        retiredCount = retired.size();
+    }
+
+    /**
+     * Wait until no publish() uses a retired snapshot and free them.
+     * Must not be called from within a publish() of this instance on the current task.
+     */
+    void synchronize() {
+        graceMutex.lock();
+
+        mutex.lock();
+        auto reclaimed = std::move(retired);
+        retired.clear();
+        retiredCount = 0;
+        // Readers that start from here on use the current snapshot and are counted in the other group
+        const auto reader_index = readerEpoch++ & 1U;
+        mutex.unlock();
+
+        while (readerCounts[reader_index] != 0U) {
+            kernel::delayTicks(1);
+        }
+
+        graceMutex.unlock();
+
+        for (auto* item : reclaimed) {
+            delete item;
+        }
+    }
+
+    /**
+     * Publish a new snapshot and retire the old one.
+     * The mutex must be locked and is unlocked by this function.
+     */
+    void replaceSnapshotAndUnlock(const Subscriptions* newSnapshot) {
+        auto* old_snapshot = snapshot.exchange(newSnapshot);
+        retired.push_back(old_snapshot);
+        retiredCount = retired.size();
+        tryReclaimRetiredLocked();
+        mutex.unlock();
+    }
+
+    SubscriptionHandle addSubscription(Callback callback, std::shared_ptr<AsyncTarget> asyncTarget) {
+        mutex.lock();
+
+        auto id = ++lastId;
+        auto* new_snapshot = new Subscriptions(*snapshot.load());
+        new_snapshot->push_back({
+            .id = id,
+            .callback = std::move(callback),
+            .asyncTarget = std::move(asyncTarget)
+        });
+        replaceSnapshotAndUnlock(new_snapshot);
+
+        return reinterpret_cast<SubscriptionHandle>(id);
+    }
+
+public:
 
     PubSub() = default;
 
     ~PubSub() {
-        if (!items.empty()) {
+        auto* current = snapshot.load();
+        if (!current->empty()) {
 #ifdef ESP_PLATFORM
-            ESP_LOGW("PubSub", "Destroying with %d active subscriptions", items.size());
+            ESP_LOGW("PubSub", "Destroying with %d active subscriptions", current->size());
 #endif
         }
 
         // Wait for Mutex usage
         if (mutex.lock(kernel::MAX_TICKS)) {
             // TODO: Fix the case where the mutex might be immediately locked after this point and then crashes when deleted
+            for (auto* item : retired) {
+                delete item;
+            }
+            retired.clear();
             mutex.unlock();
         }
+
+        delete current;
     }
 
+    PubSub(const PubSub&) = delete;
+    PubSub& operator=(const PubSub&) = delete;
+
     /**
      * Start receiving messages at the specified handle (Re-entrable)
+     * The callback is called on the publishing task.
      * @param[in] callback
      * @return subscription instance
      */
-    SubscriptionHandle subscribe(std::function<void(DataType)> callback) {
-        mutex.lock();
-
-        items.push_back({
-            .id = (++lastId),
-            .callback = std::move(callback)
-        });
-
-        mutex.unlock();
+    SubscriptionHandle subscribe(Callback callback) {
+        return addSubscription(std::move(callback), nullptr);
+    }
 
-        return reinterpret_cast<SubscriptionHandle>(lastId);
+    /**
+     * Start receiving messages on the specified DispatcherThread (Re-entrable)
+     * Each published message is copied and dispatched, so a slow subscriber never blocks the publisher.
+     * @warning The DispatcherThread must outlive the subscription
+     * @param[in] callback
+     * @param[in] dispatcherThread the thread that the callback is called on
+     * @return subscription instance
+     */
+    SubscriptionHandle subscribe(Callback callback, DispatcherThread& dispatcherThread) {
+        auto async_target = std::make_shared<AsyncTarget>();
+        async_target->callback = std::move(callback);
+        auto forwarder = [async_target, &dispatcherThread](const DataType& data) {
+            dispatcherThread.dispatch([async_target, data] {
+                auto lock = async_target->mutex.asScopedLock();
+                lock.lock();
+                // Don't deliver messages that were queued before the subscription was removed
+                if (async_target->active) {
+                    async_target->callback(data);
+                }
+            });
+        };
+        return addSubscription(forwarder, async_target);
     }
 
     /**
      * Stop receiving messages at the specified handle (Re-entrable)
+     * When this returns, the callback isn't running and won't be called anymore,
+     * so the callback can safely refer to an object that is destroyed afterwards.
+     * Can be called from within the subscription's own callback: the publish() that
+     * called it is then not awaited.
      * @param[in] subscription
      */
     void unsubscribe(SubscriptionHandle subscription) {
@@ -75,35 +260,88 @@ public:
 
         mutex.lock();
 
+        std::shared_ptr<AsyncTarget> async_target;
         bool result = false;
         auto id = reinterpret_cast<uint64_t>(subscription);
-        for (auto it = items.begin(); it != items.end(); ++it) {
-            if (it->id == id) {
-                items.erase(it);
+        auto* current = snapshot.load();
+        auto* new_snapshot = new Subscriptions();
+        new_snapshot->reserve(current->size());
+        for (auto& item : *current) {
+            if (item.id == id) {
+                async_target = item.asyncTarget;
                 result = true;
-                break;
+            } else {
+                new_snapshot->push_back(item);
             }
         }
 
-        mutex.unlock();
+        if (result) {
+            replaceSnapshotAndUnlock(new_snapshot);
+        } else {
+            delete new_snapshot;
+            mutex.unlock();
+        }
+
         assert(result);
+
+        // Waiting for our own publish() would never end
+        if (result && !isPublishingOnCurrentTask()) {
+            synchronize();
+        }
+
+        if (async_target != nullptr) {
+            // Waits for a callback that is running on the DispatcherThread
+            auto lock = async_target->mutex.asScopedLock();
+            lock.lock();
+            async_target->active = false;
+        }
     }
 
     /**
      * Publish something to all subscribers (Re-entrable)
+     * This does not lock: the callbacks are called from the subscriptions snapshot that was active when publishing started.
      * @param[in] data the data to publish
      */
-    void publish(DataType data) {
-        mutex.lock();
+    void publish(const DataType& data) {
+        // Register as reader in the current group. When a grace period moved to the other group meanwhile, try again.
+        uint32_t reader_index;
+        while (true) {
+            const auto epoch = readerEpoch.load();
+            reader_index = epoch & 1U;
+            readerCounts[reader_index]++;
+            if (readerEpoch.load() == epoch) {
+                break;
+            }
+            readerCounts[reader_index]--;
+        }
+
+        PublishFrame frame = {
+            .pubSub = this,
+            .snapshot = snapshot.load(),
+            .readerIndex = reader_index,
+            .previous = publishFrames
+        };
+        publishFrames = &frame;
 
         // Iterate over subscribers
-        for (auto& it : items) {
+        for (auto& it : *frame.snapshot) {
             it.callback(data);
         }
 
-        mutex.unlock();
+        publishFrames = frame.previous;
+        readerCounts[reader_index]--;
+
+        if (retiredCount != 0U) {
+            if (retiredCount > MAX_RETIRED_SNAPSHOTS && !isPublishingOnCurrentTask()) {
+                // Subscriptions keep changing from within callbacks: wait, so the snapshots don't pile up
+                synchronize();
+            } else if (mutex.lock(0)) {
+                // Don't block the publisher: if a subscription change is in progress, it will reclaim instead
+                tryReclaimRetiredLocked();
+                mutex.unlock();
+            }
+        }
     }
 };
 
-
 } // namespace
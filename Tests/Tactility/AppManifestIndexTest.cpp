@@ -0,0 +1,122 @@
+#include "doctest.h"
+
+#include <Tactility/app/AppManifestIndex.h>
+#include <Tactility/file/File.h>
+
+#include <cstdio>
+#include <format>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace tt;
+
+constexpr auto TEST_APPS_PATH = "test_apps";
+
+static app::AppManifestIndexEntry createEntry(const std::string& appId) {
+    app::AppManifestIndexEntry entry;
+    entry.directoryName = appId;
+    entry.manifestModifiedTime = 1700000000;
+    entry.manifestSize = 123;
+    entry.manifest.targetSdk = "0.6.0";
+    entry.manifest.targetPlatforms = "esp32,esp32s3";
+    entry.manifest.appId = appId;
+    entry.manifest.appName = "Test App";
+    entry.manifest.appVersionName = "1.2.3";
+    entry.manifest.appVersionCode = 123;
+    entry.manifest.appFlags = app::AppManifest::Flags::Hidden;
+    return entry;
+}
+
+static void writeManifest(const std::string& appId, const std::string& appName) {
+    const auto app_path = std::format("{}/{}", TEST_APPS_PATH, appId);
+    mkdir(app_path.c_str(), 0777);
+    const auto content = std::format(
+        "[manifest]\nversion=0.1\n"
+        "[target]\nsdk=0.6.0\nplatforms=esp32\n"
+        "[app]\nid={}\nname={}\nversionName=1.0.0\nversionCode=1\n",
+        appId,
+        appName
+    );
+    CHECK_EQ(file::writeString(app_path + "/manifest.properties", content), true);
+}
+
+static void removeApp(const std::string& appId) {
+    const auto app_path = std::format("{}/{}", TEST_APPS_PATH, appId);
+    remove((app_path + "/manifest.properties").c_str());
+    rmdir(app_path.c_str());
+}
+
+static void removeApps() {
+    removeApp("one.app");
+    removeApp("two.app");
+    remove(std::format("{}/{}", TEST_APPS_PATH, app::APP_MANIFEST_INDEX_FILE_NAME).c_str());
+    rmdir(TEST_APPS_PATH);
+}
+
+TEST_CASE("App manifest index should decode what it encodes") {
+    std::vector<app::AppManifestIndexEntry> entries = { createEntry("one.app"), createEntry("two.app") };
+    auto data = app::encodeAppManifestIndex(entries);
+
+    std::vector<app::AppManifestIndexEntry> decoded;
+    CHECK_EQ(app::decodeAppManifestIndex(data.data(), data.size(), decoded), true);
+    REQUIRE_EQ(decoded.size(), 2);
+    CHECK_EQ(decoded[1].directoryName, "two.app");
+    CHECK_EQ(decoded[1].manifestModifiedTime, 1700000000);
+    CHECK_EQ(decoded[1].manifestSize, 123);
+    CHECK_EQ(decoded[1].manifest.targetSdk, "0.6.0");
+    CHECK_EQ(decoded[1].manifest.targetPlatforms, "esp32,esp32s3");
+    CHECK_EQ(decoded[1].manifest.appId, "two.app");
+    CHECK_EQ(decoded[1].manifest.appName, "Test App");
+    CHECK_EQ(decoded[1].manifest.appVersionName, "1.2.3");
+    CHECK_EQ(decoded[1].manifest.appVersionCode, 123);
+    CHECK_EQ(decoded[1].manifest.appFlags, app::AppManifest::Flags::Hidden);
+}
+
+TEST_CASE("App manifest index should reject damaged data") {
+    std::vector<app::AppManifestIndexEntry> entries = { createEntry("one.app") };
+    auto data = app::encodeAppManifestIndex(entries);
+    std::vector<app::AppManifestIndexEntry> decoded;
+
+    // Truncated
+    CHECK_EQ(app::decodeAppManifestIndex(data.data(), data.size() - 6, decoded), false);
+
+    // Modified
+    data[12] ^= 0xFF;
+    CHECK_EQ(app::decodeAppManifestIndex(data.data(), data.size(), decoded), false);
+    CHECK_EQ(decoded.empty(), true);
+}
+
+TEST_CASE("findInstalledAppManifests() should create and use the index") {
+    removeApps();
+    mkdir(TEST_APPS_PATH, 0777);
+    writeManifest("one.app", "One");
+    writeManifest("two.app", "Two");
+
+    const auto index_path = std::format("{}/{}", TEST_APPS_PATH, app::APP_MANIFEST_INDEX_FILE_NAME);
+    auto manifests = app::findInstalledAppManifests(TEST_APPS_PATH);
+    CHECK_EQ(manifests.size(), 2);
+    CHECK_EQ(access(index_path.c_str(), F_OK), 0);
+    for (const auto& manifest : manifests) {
+        CHECK_EQ(manifest.appCategory, app::Category::User);
+        CHECK_EQ(manifest.appLocation.getPath(), std::format("{}/{}", TEST_APPS_PATH, manifest.appId));
+    }
+
+    // Changed manifests are parsed again, removed apps disappear
+    writeManifest("one.app", "One Changed");
+    removeApp("two.app");
+    manifests = app::findInstalledAppManifests(TEST_APPS_PATH);
+    REQUIRE_EQ(manifests.size(), 1);
+    CHECK_EQ(manifests[0].appName, "One Changed");
+
+    // Index updates by install and uninstall
+    auto updated = manifests[0];
+    updated.appName = "One Updated";
+    CHECK_EQ(app::updateAppManifestIndex(TEST_APPS_PATH, "one.app", updated), true);
+    manifests = app::findInstalledAppManifests(TEST_APPS_PATH);
+    REQUIRE_EQ(manifests.size(), 1);
+    CHECK_EQ(manifests[0].appName, "One Updated");
+
+    CHECK_EQ(app::removeFromAppManifestIndex(TEST_APPS_PATH, "one.app"), true);
+
+    removeApps();
+}
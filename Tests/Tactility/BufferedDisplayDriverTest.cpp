@@ -0,0 +1,160 @@
+#include "doctest.h"
+#include <Tactility/hal/display/BufferedDisplayDriver.h>
+
+#include <atomic>
+#include <deque>
+
+using namespace tt::hal::display;
+
+class FakeDisplayDriver final : public DisplayDriver {
+
+    std::shared_ptr<tt::Lock> lock = std::make_shared<tt::Mutex>();
+
+public:
+
+    static constexpr uint16_t WIDTH = 32;
+    static constexpr uint16_t HEIGHT = 16;
+
+    std::vector<Region> transfers;
+    uint16_t pixels[WIDTH * HEIGHT] = {};
+
+    /** When set, transfers are queued like DMA transfers: their pixel data is only read when they finish */
+    bool queueTransfers = false;
+    std::deque<std::pair<Region, const void*>> pendingTransfers;
+
+    ColorFormat getColorFormat() const override { return ColorFormat::RGB565; }
+    uint16_t getPixelWidth() const override { return WIDTH; }
+    uint16_t getPixelHeight() const override { return HEIGHT; }
+    std::shared_ptr<tt::Lock> getLock() const override { return lock; }
+
+    void copyPixels(const Region& region, const void* pixelData) {
+        const auto* source = static_cast<const uint16_t*>(pixelData);
+        for (int y = region.yStart; y < region.yEnd; ++y) {
+            for (int x = region.xStart; x < region.xEnd; ++x) {
+                pixels[y * WIDTH + x] = *source++;
+            }
+        }
+    }
+
+    bool drawBitmap(int xStart, int yStart, int xEnd, int yEnd, const void* pixelData) override {
+        const Region region = { xStart, yStart, xEnd, yEnd };
+        transfers.push_back(region);
+        if (queueTransfers) {
+            pendingTransfers.emplace_back(region, pixelData);
+        } else {
+            copyPixels(region, pixelData);
+        }
+        return true;
+    }
+
+    bool waitForPendingTransfers(size_t maxPendingTransfers, TickType_t timeout) override {
+        while (pendingTransfers.size() > maxPendingTransfers) {
+            copyPixels(pendingTransfers.front().first, pendingTransfers.front().second);
+            pendingTransfers.pop_front();
+        }
+        return true;
+    }
+};
+
+TEST_CASE("DirtyRegions merges adjacent and overlapping regions") {
+    DirtyRegions regions(16);
+    regions.add({ 0, 0, 8, 4 });
+    regions.add({ 8, 0, 16, 4 });
+    regions.add({ 4, 2, 12, 6 });
+    REQUIRE_EQ(regions.getCount(), 1);
+    CHECK_EQ(regions.take()[0], Region { 0, 0, 16, 6 });
+    CHECK(regions.isEmpty());
+}
+
+TEST_CASE("DirtyRegions keeps distant regions apart and returns them in scanline order") {
+    DirtyRegions regions(16);
+    regions.add({ 100, 100, 110, 110 });
+    regions.add({ 0, 0, 10, 10 });
+    regions.add({ 200, 0, 210, 10 });
+    regions.add({ 0, 0, 0, 10 }); // Empty
+
+    auto result = regions.take();
+    REQUIRE_EQ(result.size(), 3);
+    CHECK_EQ(result[0], Region { 0, 0, 10, 10 });
+    CHECK_EQ(result[1], Region { 200, 0, 210, 10 });
+    CHECK_EQ(result[2], Region { 100, 100, 110, 110 });
+}
+
+TEST_CASE("DirtyRegions merges the cheapest regions when there are too many") {
+    DirtyRegions regions(0, 2);
+    regions.add({ 0, 0, 1, 1 });
+    regions.add({ 100, 100, 101, 101 });
+    regions.add({ 3, 0, 4, 1 });
+
+    auto result = regions.take();
+    REQUIRE_EQ(result.size(), 2);
+    CHECK_EQ(result[0], Region { 0, 0, 4, 1 });
+}
+
+TEST_CASE("BufferedDisplayDriver merges small draws into a single transfer") {
+    auto fake = std::make_shared<FakeDisplayDriver>();
+    BufferedDisplayDriver driver(fake);
+
+    std::atomic<int> completed = 0;
+    for (int x = 0; x < 4; ++x) {
+        uint16_t tile[4 * 4];
+        std::fill(std::begin(tile), std::end(tile), static_cast<uint16_t>(x + 1));
+        CHECK(driver.drawBitmapAsync(x * 4, 0, x * 4 + 4, 4, tile, [&completed](bool success) {
+            CHECK(success);
+            completed++;
+        }));
+    }
+
+    // The flush thread might have sent the first tile before the others were drawn
+    CHECK(driver.flush());
+    CHECK_EQ(completed, 4);
+    CHECK_LE(fake->transfers.size(), 2);
+    CHECK_EQ(fake->pixels[0], 1);
+    CHECK_EQ(fake->pixels[3 * FakeDisplayDriver::WIDTH + 15], 4);
+    CHECK_EQ(fake->pixels[4 * FakeDisplayDriver::WIDTH], 0);
+}
+
+TEST_CASE("BufferedDisplayDriver sends large regions in bands") {
+    auto fake = std::make_shared<FakeDisplayDriver>();
+    // A band is at least a row: 32 pixels of 2 bytes
+    BufferedDisplayDriver driver(fake, { .transferBufferSize = 1 });
+
+    std::vector<uint16_t> screen(FakeDisplayDriver::WIDTH * FakeDisplayDriver::HEIGHT, 0xABCD);
+    CHECK(driver.drawBitmap(0, 0, FakeDisplayDriver::WIDTH, FakeDisplayDriver::HEIGHT, screen.data()));
+    CHECK(driver.flush());
+
+    CHECK_EQ(fake->transfers.size(), FakeDisplayDriver::HEIGHT);
+    CHECK_EQ(fake->transfers.back(), Region { 0, 15, 32, 16 });
+    CHECK_EQ(fake->pixels[FakeDisplayDriver::WIDTH * FakeDisplayDriver::HEIGHT - 1], 0xABCD);
+}
+
+TEST_CASE("BufferedDisplayDriver doesn't change a transfer buffer that is still being sent") {
+    auto fake = std::make_shared<FakeDisplayDriver>();
+    fake->queueTransfers = true;
+    BufferedDisplayDriver driver(fake, { .transferBufferSize = 1 });
+
+    std::vector<uint16_t> screen(FakeDisplayDriver::WIDTH * FakeDisplayDriver::HEIGHT);
+    for (size_t i = 0; i < screen.size(); ++i) {
+        screen[i] = static_cast<uint16_t>(i / FakeDisplayDriver::WIDTH + 1);
+    }
+    bool sent_before_callback = false;
+    CHECK(driver.drawBitmapAsync(0, 0, FakeDisplayDriver::WIDTH, FakeDisplayDriver::HEIGHT, screen.data(), [&](bool success) {
+        sent_before_callback = success && fake->pendingTransfers.empty();
+    }));
+    CHECK(driver.flush());
+
+    CHECK(sent_before_callback);
+    CHECK_EQ(fake->transfers.size(), FakeDisplayDriver::HEIGHT);
+    for (size_t i = 0; i < screen.size(); ++i) {
+        REQUIRE_EQ(fake->pixels[i], screen[i]);
+    }
+}
+
+TEST_CASE("BufferedDisplayDriver rejects areas outside the screen") {
+    auto fake = std::make_shared<FakeDisplayDriver>();
+    BufferedDisplayDriver driver(fake);
+    uint16_t pixel = 0;
+    CHECK_FALSE(driver.drawBitmap(-1, 0, 1, 1, &pixel));
+    CHECK_FALSE(driver.drawBitmap(0, 0, FakeDisplayDriver::WIDTH + 1, 1, &pixel));
+    CHECK_FALSE(driver.drawBitmap(2, 0, 2, 1, &pixel));
+}
@@ -0,0 +1,333 @@
+#include "doctest.h"
+#include <Tactility/service/download/Downloader.h>
+#include <Tactility/Thread.h>
+#include <Tactility/file/File.h>
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace tt;
+using namespace tt::service::download;
+
+/** Serves a file from memory like an HTTP server that supports Range requests */
+class FakeServer {
+
+public:
+
+    std::string content;
+    /** When not 0, connections are dropped after sending this amount of bytes */
+    size_t dropAfterSize = 0;
+    bool supportsRange = true;
+    std::vector<uint64_t> rangeStarts;
+
+    class Stream final : public network::HttpStream {
+
+        FakeServer& server;
+        size_t offset = 0;
+        size_t sentSize = 0;
+        int statusCode = 0;
+
+    public:
+
+        explicit Stream(FakeServer& server) : server(server) {}
+
+        bool open(const std::string& url, const std::string& certificatePath, uint64_t rangeStart) override {
+            server.rangeStarts.push_back(rangeStart);
+            if (rangeStart > server.content.size()) {
+                statusCode = 416;
+            } else if (rangeStart > 0 && server.supportsRange) {
+                statusCode = 206;
+                offset = rangeStart;
+            } else {
+                statusCode = 200;
+            }
+            return true;
+        }
+
+        int getStatusCode() const override { return statusCode; }
+
+        int64_t getContentLength() const override { return static_cast<int64_t>(server.content.size() - offset); }
+
+        int read(uint8_t* data, size_t size) override {
+            if (server.dropAfterSize != 0 && sentSize >= server.dropAfterSize) {
+                return -1;
+            }
+            if (server.dropAfterSize != 0) {
+                size = std::min(size, server.dropAfterSize - sentSize);
+            }
+            size = std::min(size, server.content.size() - offset);
+            memcpy(data, server.content.data() + offset, size);
+            offset += size;
+            sentSize += size;
+            return static_cast<int>(size);
+        }
+    };
+
+    Downloader::CreateStream createStream() {
+        return [this] { return std::make_unique<Stream>(*this); };
+    }
+};
+
+/** Serves a file from memory over a loopback socket, to test the platform's HttpStream */
+class LoopbackHttpServer {
+
+    int listenSocket = -1;
+    uint16_t port = 0;
+    std::unique_ptr<tt::Thread> thread;
+
+    static ssize_t receive(int socketHandle, char* data, size_t size) {
+        ssize_t result;
+        do {
+            result = recv(socketHandle, data, size, 0);
+        } while (result < 0 && errno == EINTR);
+        return result;
+    }
+
+    static void sendAll(int socketHandle, const std::string& data) {
+        size_t offset = 0;
+        while (offset < data.size()) {
+            const auto sent = send(socketHandle, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            } else if (sent <= 0) {
+                return;
+            }
+            offset += sent;
+        }
+    }
+
+    void serve(int socketHandle) {
+        std::string request;
+        char buffer[256];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            const auto received = receive(socketHandle, buffer, sizeof(buffer));
+            if (received <= 0) {
+                return;
+            }
+            request.append(buffer, received);
+        }
+        requests.push_back(request);
+
+        uint64_t range_start = 0;
+        const auto range_index = request.find("Range: bytes=");
+        if (range_index != std::string::npos) {
+            range_start = strtoull(request.c_str() + range_index + 13, nullptr, 10);
+        }
+
+        const auto body = content.substr(range_start);
+        // Lowercase header names and body data in the same packet as the headers
+        auto response = std::format(
+            "HTTP/1.0 {}\r\ncontent-length: {}\r\n\r\n",
+            range_start > 0 ? "206 Partial Content" : "200 OK",
+            body.size()
+        );
+        const auto drop_size = requests.size() == 1 && dropAfterSize != 0 ? dropAfterSize : body.size();
+        response.append(body, 0, drop_size);
+        sendAll(socketHandle, response);
+    }
+
+public:
+
+    std::string content;
+    /** When not 0, the first connection is closed after sending this amount of bytes */
+    size_t dropAfterSize = 0;
+    std::vector<std::string> requests;
+
+    /** @param[in] connectionCount the amount of connections to serve */
+    bool start(size_t connectionCount) {
+        listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t address_size = sizeof(address);
+        if (listenSocket < 0 ||
+            bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listenSocket, 1) != 0 ||
+            getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &address_size) != 0
+        ) {
+            return false;
+        }
+        port = ntohs(address.sin_port);
+
+        thread = std::make_unique<tt::Thread>("http_server", 8192, [this, connectionCount] {
+            for (size_t i = 0; i < connectionCount; ++i) {
+                int client_socket;
+                do {
+                    client_socket = accept(listenSocket, nullptr, nullptr);
+                } while (client_socket < 0 && errno == EINTR);
+                if (client_socket < 0) {
+                    break;
+                }
+                serve(client_socket);
+                close(client_socket);
+            }
+            return 0;
+        });
+        thread->start();
+        return true;
+    }
+
+    /** Wait until the connections are served */
+    void join() {
+        if (thread != nullptr) {
+            thread->join();
+            thread = nullptr;
+        }
+    }
+
+    ~LoopbackHttpServer() {
+        join();
+        if (listenSocket >= 0) {
+            close(listenSocket);
+        }
+    }
+
+    std::string getUrl(const std::string& path) const { return std::format("http://127.0.0.1:{}{}", port, path); }
+};
+
+static std::string createContent(size_t size) {
+    std::string content(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+        content[i] = static_cast<char>(i * 7 + i / 251);
+    }
+    return content;
+}
+
+static std::string readFile(const std::string& path) {
+    size_t size;
+    auto data = file::readBinary(path, size);
+    return data != nullptr ? std::string(reinterpret_cast<const char*>(data.get()), size) : "";
+}
+
+static std::string hashOf(const std::string& data) {
+    crypt::Sha256 hash;
+    hash.update(data.data(), data.size());
+    return hash.finishHex();
+}
+
+static const Downloader::Configuration CONFIGURATION = { .bufferSize = 1000, .retryCount = 2, .retryDelayMs = 0, .progressIntervalMs = 0 };
+
+TEST_CASE("Downloader continues from the received data after a connection failure") {
+    const std::string path = "downloader_test.bin";
+    std::remove(path.c_str());
+    std::remove((path + ".part").c_str());
+
+    FakeServer server;
+    server.content = createContent(10000);
+    server.dropAfterSize = 4500;
+
+    Downloader downloader(CONFIGURATION, server.createStream());
+    uint64_t last_progress = 0;
+    const bool success = downloader.run(
+        { .url = "http://localhost/file.bin", .filePath = path, .sha256 = hashOf(server.content) },
+        [&last_progress](uint64_t bytesReceived, uint64_t totalBytes) {
+            CHECK_GE(bytesReceived, last_progress);
+            CHECK_EQ(totalBytes, 10000);
+            last_progress = bytesReceived;
+        }
+    );
+
+    REQUIRE(success);
+    CHECK_EQ(last_progress, 10000);
+    REQUIRE_EQ(server.rangeStarts.size(), 3);
+    CHECK_EQ(server.rangeStarts[1], 4500);
+    CHECK_EQ(server.rangeStarts[2], 9000);
+    CHECK_EQ(readFile(path), server.content);
+    CHECK_FALSE(file::isFile(path + ".part"));
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Downloader resumes a partial file from an earlier download") {
+    const std::string path = "downloader_resume_test.bin";
+    std::remove(path.c_str());
+
+    FakeServer server;
+    server.content = createContent(5000);
+    auto* part_file = fopen((path + ".part").c_str(), "wb");
+    REQUIRE_NE(part_file, nullptr);
+    fwrite(server.content.data(), 1, 3000, part_file);
+    fclose(part_file);
+
+    SUBCASE("server supports Range requests") {
+        Downloader downloader(CONFIGURATION, server.createStream());
+        REQUIRE(downloader.run({ .url = "http://localhost/file.bin", .filePath = path, .sha256 = hashOf(server.content) }));
+        REQUIRE_EQ(server.rangeStarts.size(), 1);
+        CHECK_EQ(server.rangeStarts[0], 3000);
+        CHECK_EQ(readFile(path), server.content);
+    }
+
+    SUBCASE("server ignores Range requests") {
+        server.supportsRange = false;
+        Downloader downloader(CONFIGURATION, server.createStream());
+        REQUIRE(downloader.run({ .url = "http://localhost/file.bin", .filePath = path, .sha256 = hashOf(server.content) }));
+        CHECK_EQ(readFile(path), server.content);
+    }
+
+    SUBCASE("resume disabled") {
+        Downloader downloader(CONFIGURATION, server.createStream());
+        REQUIRE(downloader.run({ .url = "http://localhost/file.bin", .filePath = path, .resume = false }));
+        REQUIRE_EQ(server.rangeStarts.size(), 1);
+        CHECK_EQ(server.rangeStarts[0], 0);
+        CHECK_EQ(readFile(path), server.content);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Downloader rejects files with a different hash") {
+    const std::string path = "downloader_hash_test.bin";
+    FakeServer server;
+    server.content = createContent(2000);
+
+    Downloader downloader(CONFIGURATION, server.createStream());
+    CHECK_FALSE(downloader.run({ .url = "http://localhost/file.bin", .filePath = path, .sha256 = hashOf("other") }));
+    CHECK_EQ(std::string(downloader.getErrorMessage()), "File hash mismatch");
+    CHECK_FALSE(file::isFile(path));
+    CHECK_FALSE(file::isFile(path + ".part"));
+}
+
+TEST_CASE("Downloader resumes with the platform HttpStream from a local HTTP server") {
+    const std::string path = "downloader_loopback_test.bin";
+    std::remove(path.c_str());
+    std::remove((path + ".part").c_str());
+
+    LoopbackHttpServer server;
+    server.content = createContent(20000);
+    server.dropAfterSize = 8000;
+    REQUIRE(server.start(2));
+
+    Downloader downloader(CONFIGURATION, network::createHttpStream);
+    const bool success = downloader.run({ .url = server.getUrl("/files/file.bin"), .filePath = path, .sha256 = hashOf(server.content) });
+
+    server.join();
+
+    REQUIRE(success);
+    CHECK_EQ(readFile(path), server.content);
+    REQUIRE_EQ(server.requests.size(), 2);
+    CHECK(server.requests[0].starts_with("GET /files/file.bin HTTP/1.0\r\n"));
+    CHECK_NE(server.requests[0].find(std::format("Host: {}\r\n", server.getUrl("").substr(7))), std::string::npos);
+    CHECK_EQ(server.requests[0].find("Range:"), std::string::npos);
+    CHECK_NE(server.requests[1].find("Range: bytes=8000-\r\n"), std::string::npos);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("BandwidthLimiter schedules reservations back-to-back") {
+    network::BandwidthLimiter limiter(1000);
+    CHECK_EQ(limiter.reserve(500, 0), 0);
+    // The previous 500 bytes take 500 ms
+    CHECK_EQ(limiter.reserve(500, 100000), 400000);
+    CHECK_EQ(limiter.reserve(100, 200000), 800000);
+    // Idle time isn't saved up
+    CHECK_EQ(limiter.reserve(100, 5000000), 0);
+    CHECK_EQ(limiter.reserve(100, 5000000), 100000);
+
+    limiter.setLimit(0);
+    CHECK_EQ(limiter.reserve(1000000, 0), 0);
+}
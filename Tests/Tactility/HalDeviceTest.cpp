@@ -1,5 +1,6 @@
 #include "doctest.h"
 #include <Tactility/hal/Device.h>
+#include <Tactility/kernel/Kernel.h>
 
 #include <utility>
 
@@ -96,3 +97,97 @@ TEST_CASE("find device by type") {
     CHECK_NE(found_device, nullptr);
     CHECK_EQ(found_device->getId(), device->getId());
 }
+
+TEST_CASE("device list only contains devices of the requested type") {
+    auto display = std::make_shared<TestDevice>(hal::Device::Type::Display, "DisplayMock", "");
+    auto power = std::make_shared<TestDevice>(hal::Device::Type::Power, "PowerMock", "");
+    DeviceAutoRegistration display_registration(display);
+    DeviceAutoRegistration power_registration(power);
+
+    auto displays = hal::getDeviceList(hal::Device::Type::Display);
+    CHECK_EQ(displays.size(), 1);
+    CHECK_EQ(displays[0]->getId(), display->getId());
+    CHECK(hal::hasDevice(hal::Device::Type::Power));
+    CHECK_FALSE(hal::hasDevice(hal::Device::Type::Gps));
+}
+
+TEST_CASE("device list stays valid when a device is deregistered") {
+    auto device = std::make_shared<TestDevice>(hal::Device::Type::Display, "DisplayMock", "");
+    hal::registerDevice(device);
+
+    {
+        auto displays = hal::getDeviceList(hal::Device::Type::Display);
+        hal::deregisterDevice(device);
+        CHECK_EQ(displays.size(), 1);
+        CHECK_EQ(displays[0]->getId(), device->getId());
+        CHECK_EQ(hal::findFirstDevice<TestDevice>(hal::Device::Type::Display), nullptr);
+    }
+
+    // The old snapshot is freed when it's not used anymore
+    CHECK_EQ(device.use_count(), 1);
+}
+
+TEST_CASE("device pubsub publishes registration changes") {
+    auto device = std::make_shared<TestDevice>();
+    std::vector<hal::DeviceEvent::Action> actions;
+    auto pubsub = hal::getDevicePubsub();
+    auto subscription = pubsub->subscribe([&actions, &device](const hal::DeviceEvent& event) {
+        if (event.device == device) {
+            actions.push_back(event.action);
+        }
+    });
+
+    hal::registerDevice(device);
+    hal::deregisterDevice(device);
+    pubsub->unsubscribe(subscription);
+
+    CHECK_EQ(actions.size(), 2);
+    CHECK_EQ(actions[0], hal::DeviceEvent::Action::Registered);
+    CHECK_EQ(actions[1], hal::DeviceEvent::Action::Deregistered);
+}
+
+// region Benchmark
+
+// Not part of the unit test run: enable it with "TactilityTests --no-skip"
+
+constexpr int BENCHMARK_ITERATIONS = 10000;
+
+/** The lookup that findFirstDevice() did before: filter all devices into a new vector */
+static std::shared_ptr<hal::Device> findFirstLikeBefore(hal::Device::Type type) {
+    auto devices = hal::findDevices([type](const auto& device) {
+        return device->getType() == type;
+    });
+    return devices.empty() ? nullptr : devices[0];
+}
+
+static std::shared_ptr<hal::Device> findFirstLikeNow(hal::Device::Type type) {
+    return hal::findFirstDevice<hal::Device>(type);
+}
+
+template<typename Function>
+static int64_t measureNanosPerCall(Function function) {
+    size_t found = 0;
+    auto start_time = kernel::getMicrosSinceBoot();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        found += (function(hal::Device::Type::Display) != nullptr) ? 1 : 0;
+    }
+    auto duration = kernel::getMicrosSinceBoot() - start_time;
+    CHECK_EQ(found, BENCHMARK_ITERATIONS);
+    return duration * 1000 / BENCHMARK_ITERATIONS;
+}
+
+TEST_CASE("benchmark finding the first device of a type" * doctest::skip()) {
+    // A registry that is similar to a real device: a few devices of various types
+    std::vector<std::unique_ptr<DeviceAutoRegistration>> registrations;
+    for (auto type : { hal::Device::Type::I2c, hal::Device::Type::I2c, hal::Device::Type::Power, hal::Device::Type::SdCard, hal::Device::Type::Touch, hal::Device::Type::Keyboard, hal::Device::Type::Display }) {
+        registrations.push_back(std::make_unique<DeviceAutoRegistration>(std::make_shared<TestDevice>(type, "Mock", "")));
+    }
+
+    auto before = measureNanosPerCall(findFirstLikeBefore);
+    auto now = measureNanosPerCall(findFirstLikeNow);
+
+    MESSAGE("Before (filtered copy): ", before, " ns/call");
+    MESSAGE("Now (type bucket view): ", now, " ns/call");
+}
+
+// endregion Benchmark
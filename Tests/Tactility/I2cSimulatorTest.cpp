@@ -0,0 +1,164 @@
+#include "../TactilityCore/TestFile.h"
+#include "doctest.h"
+
+#include <Tactility/hal/i2c/I2c.h>
+#include <Tactility/hal/i2c/I2cSimulator.h>
+#include <Tactility/hal/i2c/I2cTransaction.h>
+
+using namespace tt::hal::i2c;
+
+constexpr auto TEST_PORT = I2C_NUM_1;
+constexpr uint8_t TEST_ADDRESS = 0x42;
+
+class SimulatedDeviceAttachment {
+
+    std::shared_ptr<simulator::SimulatedDevice> device;
+
+public:
+
+    explicit SimulatedDeviceAttachment(std::shared_ptr<simulator::SimulatedDevice> device) : device(std::move(device)) {
+        simulator::attachDevice(TEST_PORT, TEST_ADDRESS, this->device);
+        simulator::resetCounters(TEST_PORT);
+    }
+
+    ~SimulatedDeviceAttachment() {
+        simulator::detachDevice(TEST_PORT, TEST_ADDRESS);
+    }
+};
+
+TEST_CASE("simulated register map device can be read and written") {
+    auto device = std::make_shared<simulator::RegisterMapDevice>();
+    SimulatedDeviceAttachment attachment(device);
+    device->setRegister16(0x10, 0x1234);
+
+    uint8_t data[2] = { 0 };
+    CHECK(masterReadRegister(TEST_PORT, TEST_ADDRESS, 0x10, data, 2));
+    CHECK_EQ(data[0], 0x34);
+    CHECK_EQ(data[1], 0x12);
+
+    uint8_t value = 0xAB;
+    CHECK(masterWriteRegister(TEST_PORT, TEST_ADDRESS, 0x20, &value, 1));
+    CHECK_EQ(device->getRegister(0x20), 0xAB);
+
+    CHECK(Transaction().updateRegister8(TEST_ADDRESS, 0x20, 0x04, 0x01).execute(TEST_PORT));
+    CHECK_EQ(device->getRegister(0x20), 0xAE);
+}
+
+TEST_CASE("simulated bus doesn't acknowledge missing devices") {
+    simulator::resetCounters(TEST_PORT);
+    const auto failure_count = getStatistics(TEST_PORT).failureCount;
+    CHECK_FALSE(masterHasDeviceAtAddress(TEST_PORT, 0x11));
+    CHECK_EQ(simulator::getCounters(TEST_PORT).nackCount, 1);
+    // Probing for a missing device isn't a failure
+    CHECK_EQ(getStatistics(TEST_PORT).failureCount, failure_count);
+}
+
+/** Doesn't acknowledge writes to register 0x02 */
+class RejectingDevice final : public simulator::SimulatedDevice {
+
+public:
+
+    std::vector<uint8_t> writtenRegisters;
+
+    bool onWrite(const uint8_t* data, size_t dataSize) override {
+        if (data[0] == 0x02) {
+            return false;
+        }
+        writtenRegisters.push_back(data[0]);
+        return true;
+    }
+
+    bool onRead(uint8_t* data, size_t dataSize) override { return false; }
+};
+
+TEST_CASE("register array writes continue after a failed write") {
+    auto device = std::make_shared<RejectingDevice>();
+    SimulatedDeviceAttachment attachment(device);
+
+    const uint8_t data[] = { 0x01, 0xAA, 0x02, 0xBB, 0x03, 0xCC };
+    const auto failure_count = getStatistics(TEST_PORT).failureCount;
+    CHECK_FALSE(masterWriteRegisterArray(TEST_PORT, TEST_ADDRESS, data, sizeof(data)));
+    CHECK_EQ(device->writtenRegisters, std::vector<uint8_t> { 0x01, 0x03 });
+    CHECK_EQ(getStatistics(TEST_PORT).failureCount, failure_count + 1);
+}
+
+TEST_CASE("simulated bus counts bytes on the wire") {
+    auto device = std::make_shared<simulator::RegisterMapDevice>();
+    SimulatedDeviceAttachment attachment(device);
+    simulator::setTiming(TEST_PORT, {
+        .clockHz = 100000,
+        .transferLatencyMicros = 0,
+        .delay = false
+    });
+
+    uint8_t data[2];
+    CHECK(masterReadRegister(TEST_PORT, TEST_ADDRESS, 0x00, data, 2));
+    auto counters = simulator::getCounters(TEST_PORT);
+    CHECK_EQ(counters.transferCount, 1);
+    // Address + register, address + 2 data bytes
+    CHECK_EQ(counters.byteCount, 5);
+    // 45 bits and 4 start/stop conditions at 10 us per bit
+    CHECK_EQ(counters.busMicros, 490);
+
+    // Without a clock, only the latency counts
+    simulator::setTiming(TEST_PORT, {
+        .clockHz = 0,
+        .transferLatencyMicros = 50,
+        .delay = false
+    });
+    CHECK(masterReadRegister(TEST_PORT, TEST_ADDRESS, 0x00, data, 2));
+    CHECK_EQ(simulator::getCounters(TEST_PORT).busMicros, 540);
+
+    simulator::setTiming(TEST_PORT, {
+        .clockHz = 400000,
+        .transferLatencyMicros = 0,
+        .delay = false
+    });
+}
+
+TEST_CASE("simulated device handlers can model behaviour") {
+    auto device = std::make_shared<simulator::RegisterMapDevice>();
+    SimulatedDeviceAttachment attachment(device);
+    int fifo_reads = 0;
+    device->setReadHandler([&fifo_reads](auto& device, uint8_t reg) {
+        if (reg == 0x04) {
+            device.setRegister(0x04, ++fifo_reads);
+        }
+    });
+
+    uint8_t value;
+    CHECK(masterReadRegister(TEST_PORT, TEST_ADDRESS, 0x04, &value, 1));
+    CHECK_EQ(value, 1);
+    CHECK(masterReadRegister(TEST_PORT, TEST_ADDRESS, 0x04, &value, 1));
+    CHECK_EQ(value, 2);
+}
+
+TEST_CASE("simulated bus traces can be saved, loaded and replayed") {
+    std::vector<simulator::TraceEntry> trace;
+    {
+        auto device = std::make_shared<simulator::RegisterMapDevice>();
+        SimulatedDeviceAttachment attachment(device);
+        device->setRegister(0x08, 0x3C);
+
+        simulator::startTrace(TEST_PORT);
+        uint8_t value;
+        CHECK(masterReadRegister(TEST_PORT, TEST_ADDRESS, 0x08, &value, 1));
+        CHECK(Transaction().writeRegister8(TEST_ADDRESS, 0x09, 0x01).execute(TEST_PORT));
+        trace = simulator::stopTrace(TEST_PORT);
+    }
+    CHECK_EQ(trace.size(), 3);
+
+    TestFile file("test.i2ctrace");
+    CHECK(simulator::saveTrace(file.getPath(), trace));
+    std::vector<simulator::TraceEntry> loaded_trace;
+    CHECK(simulator::loadTrace(file.getPath(), loaded_trace));
+    CHECK_EQ(loaded_trace, trace);
+
+    auto replay_device = std::make_shared<simulator::TraceReplayDevice>(simulator::filterTrace(loaded_trace, TEST_ADDRESS));
+    SimulatedDeviceAttachment attachment(replay_device);
+    uint8_t value = 0;
+    CHECK(masterReadRegister(TEST_PORT, TEST_ADDRESS, 0x08, &value, 1));
+    CHECK_EQ(value, 0x3C);
+    CHECK(Transaction().writeRegister8(TEST_ADDRESS, 0x09, 0x01).execute(TEST_PORT));
+    CHECK(replay_device->isFinished());
+}
@@ -0,0 +1,52 @@
+#include "doctest.h"
+#include <Tactility/hal/i2c/I2cTransaction.h>
+
+using namespace tt::hal::i2c;
+
+TEST_CASE("Transaction copies register writes") {
+    Transaction transaction;
+    {
+        uint8_t value = 0x42;
+        transaction.writeRegister8(0x34, 0x10, value);
+        value = 0;
+    }
+
+    auto& operations = transaction.getOperations();
+    CHECK_EQ(operations.size(), 1);
+    CHECK_EQ(operations[0].address, 0x34);
+    CHECK_EQ(operations[0].prefixSize, 2);
+    CHECK_EQ(operations[0].prefix[0], 0x10);
+    CHECK_EQ(operations[0].prefix[1], 0x42);
+    CHECK_EQ(operations[0].writeDataSize, 0);
+    CHECK_EQ(operations[0].readDataSize, 0);
+}
+
+TEST_CASE("Transaction keeps operations in order") {
+    uint8_t write_data[3] = { 1, 2, 3 };
+    uint8_t read_data[2];
+    Transaction transaction;
+    transaction
+        .writeRegister(0x20, 0x01, write_data, sizeof(write_data))
+        .readRegister(0x20, 0x02, read_data, sizeof(read_data))
+        .updateRegister8(0x21, 0x03, 0x80, 0x01);
+
+    auto& operations = transaction.getOperations();
+    CHECK_EQ(operations.size(), 3);
+
+    CHECK_EQ(operations[0].type, Transaction::Operation::Type::Transfer);
+    CHECK_EQ(operations[0].prefix[0], 0x01);
+    CHECK_EQ(operations[0].writeData, write_data);
+    CHECK_EQ(operations[0].writeDataSize, 3);
+
+    CHECK_EQ(operations[1].prefix[0], 0x02);
+    CHECK_EQ(operations[1].readData, read_data);
+    CHECK_EQ(operations[1].readDataSize, 2);
+
+    CHECK_EQ(operations[2].type, Transaction::Operation::Type::UpdateRegister8);
+    CHECK_EQ(operations[2].address, 0x21);
+    CHECK_EQ(operations[2].setMask, 0x80);
+    CHECK_EQ(operations[2].clearMask, 0x01);
+
+    transaction.clear();
+    CHECK(transaction.getOperations().empty());
+}
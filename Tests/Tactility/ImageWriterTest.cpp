@@ -0,0 +1,186 @@
+#include "doctest.h"
+#include <Tactility/file/ImageWriter.h>
+
+#include <cstring>
+#include <string>
+
+using namespace tt::file;
+
+static uint32_t readUint32(const uint8_t* data) {
+    return (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+}
+
+static uint32_t calculateCrc(const uint8_t* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+/** A minimal QOI decoder for RGB images */
+static bool decodeQoi(const std::vector<uint8_t>& data, std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height) {
+    if (data.size() < 22 || memcmp(data.data(), "qoif", 4) != 0) {
+        return false;
+    }
+    width = readUint32(data.data() + 4);
+    height = readUint32(data.data() + 8);
+    struct { uint8_t r, g, b, a; } index[64] = {}, pixel = { 0, 0, 0, 255 };
+    size_t position = 14;
+    int run = 0;
+    for (size_t i = 0; i < width * height; ++i) {
+        if (run > 0) {
+            run--;
+        } else {
+            const uint8_t op = data[position++];
+            if (op == 0xFE) {
+                pixel.r = data[position++];
+                pixel.g = data[position++];
+                pixel.b = data[position++];
+            } else if ((op & 0xC0) == 0x00) {
+                pixel = index[op];
+            } else if ((op & 0xC0) == 0x40) {
+                pixel.r += ((op >> 4) & 3) - 2;
+                pixel.g += ((op >> 2) & 3) - 2;
+                pixel.b += (op & 3) - 2;
+            } else if ((op & 0xC0) == 0x80) {
+                const int dg = (op & 0x3F) - 32;
+                const uint8_t second = data[position++];
+                pixel.r += dg + ((second >> 4) & 0x0F) - 8;
+                pixel.g += dg;
+                pixel.b += dg + (second & 0x0F) - 8;
+            } else {
+                run = op & 0x3F;
+            }
+            index[(pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64] = pixel;
+        }
+        pixels.push_back(pixel.r);
+        pixels.push_back(pixel.g);
+        pixels.push_back(pixel.b);
+    }
+    static constexpr uint8_t end_marker[] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    return position + 8 == data.size() && memcmp(data.data() + position, end_marker, 8) == 0;
+}
+
+/** A screen-like test image: a flat background with a gradient bar */
+static std::vector<uint8_t> createImage(uint16_t width, uint16_t height) {
+    std::vector<uint8_t> pixels;
+    for (uint16_t y = 0; y < height; ++y) {
+        for (uint16_t x = 0; x < width; ++x) {
+            const bool is_bar = y >= height / 4 && y < height / 2;
+            pixels.push_back(is_bar ? x * 7 : 0x20);
+            pixels.push_back(is_bar ? y * 3 : 0x30);
+            pixels.push_back(is_bar ? (x ^ y) : 0x40);
+        }
+    }
+    return pixels;
+}
+
+static void encode(ImageWriter& writer, const std::vector<uint8_t>& pixels, uint16_t width, uint16_t height) {
+    REQUIRE(writer.begin(width, height));
+    for (uint16_t y = 0; y < height; ++y) {
+        REQUIRE(writer.writeRow(pixels.data() + static_cast<size_t>(y) * width * 3));
+    }
+    REQUIRE(writer.finish());
+}
+
+TEST_CASE("convertBgr888ToRgb888 swaps red and blue, also in place") {
+    std::vector<uint8_t> source;
+    for (int i = 0; i < 7 * 3; ++i) {
+        source.push_back(i);
+    }
+
+    std::vector<uint8_t> destination(source.size());
+    convertBgr888ToRgb888(source.data(), destination.data(), 7);
+    for (int pixel = 0; pixel < 7; ++pixel) {
+        CHECK_EQ(destination[pixel * 3], source[pixel * 3 + 2]);
+        CHECK_EQ(destination[pixel * 3 + 1], source[pixel * 3 + 1]);
+        CHECK_EQ(destination[pixel * 3 + 2], source[pixel * 3]);
+    }
+
+    convertBgr888ToRgb888(source.data(), source.data(), 7);
+    CHECK_EQ(source, destination);
+}
+
+TEST_CASE("QoiWriter output decodes to the original pixels") {
+    const uint16_t width = 70;
+    const uint16_t height = 20;
+    const auto pixels = createImage(width, height);
+
+    std::vector<uint8_t> output;
+    size_t largest_block = 0;
+    QoiWriter writer([&](const uint8_t* data, size_t size) {
+        output.insert(output.end(), data, data + size);
+        largest_block = std::max(largest_block, size);
+        return true;
+    }, 256);
+    encode(writer, pixels, width, height);
+
+    std::vector<uint8_t> decoded;
+    uint32_t decoded_width, decoded_height;
+    REQUIRE(decodeQoi(output, decoded, decoded_width, decoded_height));
+    CHECK_EQ(decoded_width, width);
+    CHECK_EQ(decoded_height, height);
+    CHECK_EQ(decoded, pixels);
+    CHECK_LE(largest_block, 256);
+    CHECK_LT(output.size(), pixels.size() / 2);
+}
+
+TEST_CASE("PngWriter writes valid chunks of bounded size") {
+    const uint16_t width = 100;
+    const uint16_t height = 40;
+    const auto pixels = createImage(width, height);
+
+    std::vector<uint8_t> output;
+    PngWriter writer([&output](const uint8_t* data, size_t size) {
+        output.insert(output.end(), data, data + size);
+        return true;
+    }, 512);
+    encode(writer, pixels, width, height);
+
+    REQUIRE_GT(output.size(), 8);
+    CHECK_EQ(memcmp(output.data(), "\x89PNG\r\n\x1A\n", 8), 0);
+
+    std::vector<std::string> chunk_types;
+    size_t position = 8;
+    while (position + 12 <= output.size()) {
+        const uint32_t length = readUint32(output.data() + position);
+        REQUIRE_LE(position + 12 + length, output.size());
+        const uint8_t* type = output.data() + position + 4;
+        CHECK_EQ(readUint32(type + 4 + length), calculateCrc(type, 4 + length));
+        chunk_types.emplace_back(reinterpret_cast<const char*>(type), 4);
+        if (chunk_types.back() == "IHDR") {
+            CHECK_EQ(readUint32(type + 4), width);
+            CHECK_EQ(readUint32(type + 8), height);
+        } else if (chunk_types.back() == "IDAT") {
+            CHECK_LE(length, 512);
+        }
+        position += 12 + length;
+    }
+
+    CHECK_EQ(position, output.size());
+    REQUIRE_GE(chunk_types.size(), 3);
+    CHECK_EQ(chunk_types.front(), "IHDR");
+    CHECK_EQ(chunk_types.back(), "IEND");
+    // The flat background compresses to less than half the raw size
+    CHECK_LT(output.size(), pixels.size() / 2);
+}
+
+TEST_CASE("ImageWriter fails on missing rows and output errors") {
+    uint8_t row[3 * 4] = {};
+
+    PngWriter incomplete_writer([](const uint8_t*, size_t) { return true; });
+    REQUIRE(incomplete_writer.begin(4, 2));
+    CHECK(incomplete_writer.writeRow(row));
+    CHECK_FALSE(incomplete_writer.finish());
+
+    QoiWriter failing_writer([](const uint8_t*, size_t) { return false; }, 16);
+    CHECK(failing_writer.begin(4, 2));
+    CHECK(failing_writer.writeRow(row));
+    CHECK(failing_writer.writeRow(row));
+    CHECK_FALSE(failing_writer.writeRow(row));
+    CHECK_FALSE(failing_writer.finish());
+}
@@ -0,0 +1,251 @@
+#include "doctest.h"
+#include <Tactility/network/MultipartParser.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <sstream>
+
+using namespace tt;
+using namespace tt::network;
+
+static const std::string BOUNDARY = "----TactilityBoundary7MA4YWxkTrZu0gW";
+
+static std::string createFileBody(const std::string& fileContent) {
+    std::string body;
+    body += "--" + BOUNDARY + "\r\n";
+    body += "Content-Disposition: form-data; name=\"elf\"; filename=\"app.elf\"\r\n\r\n";
+    body += fileContent;
+    body += "\r\n--" + BOUNDARY + "--\r\n";
+    return body;
+}
+
+static std::string createBody(const std::string& fileContent) {
+    std::string body;
+    body += "--" + BOUNDARY + "\r\n";
+    body += "Content-Disposition: form-data; name=\"comment\"\r\n\r\n";
+    body += "hello\r\n";
+    body += "--" + BOUNDARY + "\r\n";
+    body += "Content-Disposition: form-data; name=\"elf\"; filename=\"app; v1.elf\"\r\n";
+    body += "Content-Type: application/octet-stream\r\n\r\n";
+    body += fileContent;
+    body += "\r\n--" + BOUNDARY + "--\r\n";
+    return body;
+}
+
+/** Collects the parts in memory */
+class MemoryPartSink final : public PartSink {
+
+    std::string& output;
+
+public:
+
+    explicit MemoryPartSink(std::string& output) : output(output) {}
+
+    bool write(const uint8_t* data, size_t size) override {
+        output.append(reinterpret_cast<const char*>(data), size);
+        return true;
+    }
+};
+
+static bool parseInChunks(const std::string& body, size_t chunkSize, std::vector<MultipartParser::Part>& parts, std::deque<std::string>& contents) {
+    MultipartParser parser(BOUNDARY, [&parts, &contents](const MultipartParser::Part& part) {
+        parts.push_back(part);
+        contents.emplace_back();
+        return std::make_unique<MemoryPartSink>(contents.back());
+    });
+
+    for (size_t offset = 0; offset < body.size(); offset += chunkSize) {
+        const auto size = std::min(chunkSize, body.size() - offset);
+        if (!parser.parse(reinterpret_cast<const uint8_t*>(body.data() + offset), size)) {
+            return false;
+        }
+    }
+    return parser.isFinished();
+}
+
+TEST_CASE("MultipartParser parses parts regardless of how the body is split") {
+    // The content contains partial delimiters and line breaks that must not end the part
+    const std::string content = "line 1\r\nline 2\r\n--" + BOUNDARY.substr(0, 10) + "\r\r\n-\r\n--\r";
+    const auto body = createBody(content);
+
+    for (size_t chunk_size = 1; chunk_size <= body.size(); ++chunk_size) {
+        std::vector<MultipartParser::Part> parts;
+        std::deque<std::string> contents;
+        REQUIRE(parseInChunks(body, chunk_size, parts, contents));
+        REQUIRE_EQ(parts.size(), 2);
+        CHECK_EQ(parts[0].name, "comment");
+        CHECK(parts[0].filename.empty());
+        CHECK_EQ(contents[0], "hello");
+        CHECK_EQ(parts[1].name, "elf");
+        CHECK_EQ(parts[1].filename, "app; v1.elf");
+        CHECK_EQ(parts[1].contentType, "application/octet-stream");
+        CHECK_EQ(contents[1], content);
+    }
+}
+
+TEST_CASE("MultipartParser rejects invalid bodies") {
+    std::vector<MultipartParser::Part> parts;
+    std::deque<std::string> contents;
+
+    // Missing closing delimiter
+    auto body = createBody("data");
+    CHECK_FALSE(parseInChunks(body.substr(0, body.size() - 4), 64, parts, contents));
+
+    // Missing name
+    body = "--" + BOUNDARY + "\r\nContent-Disposition: form-data\r\n\r\ndata\r\n--" + BOUNDARY + "--\r\n";
+    CHECK_FALSE(parseInChunks(body, 64, parts, contents));
+
+    // Garbage after the delimiter
+    body = "--" + BOUNDARY + "xx";
+    CHECK_FALSE(parseInChunks(body, 64, parts, contents));
+}
+
+TEST_CASE("FilePartSink writes the file and removes incomplete files") {
+    const std::string path = "multipart_test.bin";
+    std::remove(path.c_str());
+
+    MultipartParser parser(BOUNDARY, [&path](const MultipartParser::Part& part) -> std::unique_ptr<PartSink> {
+        if (part.name != "elf") {
+            return nullptr;
+        }
+        return std::make_unique<FilePartSink>(path);
+    });
+    auto body = createBody("file content");
+    REQUIRE(parser.parse(reinterpret_cast<const uint8_t*>(body.data()), body.size()));
+    REQUIRE(parser.isFinished());
+
+    auto* file = fopen(path.c_str(), "rb");
+    REQUIRE_NE(file, nullptr);
+    char buffer[32] = {};
+    CHECK_EQ(fread(buffer, 1, sizeof(buffer), file), 12);
+    CHECK_EQ(std::string(buffer), "file content");
+    fclose(file);
+    std::remove(path.c_str());
+
+    {
+        MultipartParser incomplete_parser(BOUNDARY, [&path](const MultipartParser::Part&) {
+            return std::make_unique<FilePartSink>(path);
+        });
+        CHECK(incomplete_parser.parse(reinterpret_cast<const uint8_t*>(body.data()), body.size() - 20));
+        CHECK_FALSE(incomplete_parser.isFinished());
+    }
+    file = fopen(path.c_str(), "rb");
+    CHECK_EQ(file, nullptr);
+}
+
+TEST_CASE("parseContentDispositionValue handles quoted values") {
+    auto result = parseContentDispositionValue("form-data; name=\"elf\"; filename=\"a \\\"b\\\";c.elf\"");
+    CHECK_EQ(result["type"], "form-data");
+    CHECK_EQ(result["name"], "elf");
+    CHECK_EQ(result["filename"], "a \"b\";c.elf");
+}
+
+// region Benchmark
+
+// Receives a 4 MB body, so it is skipped in unit test runs: use "TactilityTests --no-skip" to run it
+
+/**
+ * Simulates receiving an upload from a socket, in TCP segments of 1436 bytes.
+ * The old implementation read the part headers 1 byte at a time, and received the file in 512 byte chunks.
+ * On a device, every receive call has a large overhead, so the amount of calls is reported too.
+ */
+class FakeUpload {
+
+    const std::string& body;
+    size_t offset = 0;
+
+public:
+
+    size_t receiveCount = 0;
+
+    static constexpr size_t SEGMENT_SIZE = 1436;
+
+    explicit FakeUpload(const std::string& body) : body(body) {}
+
+    int receive(char* buffer, size_t size) {
+        const auto segment_left = SEGMENT_SIZE - (offset % SEGMENT_SIZE);
+        const auto read_size = std::min({ size, segment_left, body.size() - offset });
+        memcpy(buffer, body.data() + offset, read_size);
+        offset += read_size;
+        receiveCount++;
+        return static_cast<int>(read_size);
+    }
+};
+
+static std::string receiveTextUntilLikeBefore(FakeUpload& upload, const std::string& terminator) {
+    std::stringstream result;
+    while (!result.str().ends_with(terminator)) {
+        char buffer;
+        if (upload.receive(&buffer, 1) <= 0) {
+            return "";
+        }
+        result << buffer;
+    }
+    return result.str();
+}
+
+static size_t receiveLikeBefore(const std::string& body, size_t fileSize, size_t& receiveCount) {
+    FakeUpload upload(body);
+    receiveTextUntilLikeBefore(upload, "\r\n\r\n");
+    char buffer[512];
+    size_t received = 0;
+    while (received < fileSize) {
+        received += upload.receive(buffer, std::min<size_t>(sizeof(buffer), fileSize - received));
+    }
+    receiveCount = upload.receiveCount;
+    return received;
+}
+
+static size_t receiveNow(const std::string& body, size_t& receiveCount) {
+    FakeUpload upload(body);
+    size_t received = 0;
+    MultipartParser parser(BOUNDARY, [&received](const MultipartParser::Part&) {
+        class CountingSink final : public PartSink {
+            size_t& received;
+        public:
+            explicit CountingSink(size_t& received) : received(received) {}
+            bool write(const uint8_t*, size_t size) override {
+                received += size;
+                return true;
+            }
+        };
+        return std::make_unique<CountingSink>(received);
+    });
+
+    auto buffer = std::make_unique<char[]>(4096);
+    int size;
+    while ((size = upload.receive(buffer.get(), 4096)) > 0) {
+        parser.parse(reinterpret_cast<const uint8_t*>(buffer.get()), size);
+    }
+    CHECK(parser.isFinished());
+    receiveCount = upload.receiveCount;
+    return received;
+}
+
+TEST_CASE("benchmark upload receiving" * doctest::skip()) {
+    const size_t file_size = 4 * 1024 * 1024;
+    std::string content(file_size, 'x');
+    for (size_t i = 0; i < file_size; i += 97) {
+        content[i] = '\r';
+    }
+    const auto body = createFileBody(content);
+
+    size_t receive_count_before;
+    auto start_time = kernel::getMicrosSinceBoot();
+    CHECK_EQ(receiveLikeBefore(body, file_size, receive_count_before), file_size);
+    const auto duration_before = std::max<int64_t>(kernel::getMicrosSinceBoot() - start_time, 1);
+
+    size_t receive_count_now;
+    start_time = kernel::getMicrosSinceBoot();
+    CHECK_EQ(receiveNow(body, receive_count_now), file_size);
+    const auto duration_now = std::max<int64_t>(kernel::getMicrosSinceBoot() - start_time, 1);
+    CHECK_LT(receive_count_now, receive_count_before);
+
+    MESSAGE("Upload before (512 byte chunks): ", file_size / duration_before, " MB/s, ", receive_count_before, " receive calls");
+    MESSAGE("Upload now (multipart parser): ", file_size / duration_now, " MB/s, ", receive_count_now, " receive calls");
+}
+
+// endregion Benchmark
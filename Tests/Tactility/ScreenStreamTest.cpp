@@ -0,0 +1,152 @@
+#include "doctest.h"
+#include <Tactility/service/development/ScreenStream.h>
+
+#include <string>
+
+using namespace tt::service::development;
+
+/** Reads a stream like a client would */
+class StreamReader {
+
+    const std::vector<uint8_t>& data;
+    size_t position = 0;
+
+public:
+
+    explicit StreamReader(const std::vector<uint8_t>& data) : data(data) {}
+
+    bool isAtEnd() const { return position == data.size(); }
+
+    uint8_t readUint8() { return data.at(position++); }
+
+    uint16_t readUint16() {
+        const uint16_t high = readUint8();
+        return (high << 8) | readUint8();
+    }
+
+    uint32_t readUint32() {
+        const uint32_t high = readUint16();
+        return (high << 16) | readUint16();
+    }
+
+    std::string readTag() {
+        std::string tag;
+        for (int i = 0; i < 4; ++i) {
+            tag += static_cast<char>(readUint8());
+        }
+        return tag;
+    }
+
+    /** Decode a QOI image that only uses the RGB and run operations (enough for flat test images) */
+    std::vector<uint8_t> readQoi(uint32_t& width, uint32_t& height) {
+        REQUIRE_EQ(readTag(), "qoif");
+        width = readUint32();
+        height = readUint32();
+        readUint16(); // Channels and colour space
+        std::vector<uint8_t> pixels;
+        uint8_t pixel[3] = { 0, 0, 0 };
+        while (pixels.size() < width * height * 3) {
+            const uint8_t op = readUint8();
+            int repeat = 1;
+            if (op == 0xFE) {
+                pixel[0] = readUint8();
+                pixel[1] = readUint8();
+                pixel[2] = readUint8();
+            } else {
+                REQUIRE_EQ(op & 0xC0, 0xC0);
+                repeat = (op & 0x3F) + 1;
+            }
+            for (int i = 0; i < repeat; ++i) {
+                pixels.insert(pixels.end(), pixel, pixel + 3);
+            }
+        }
+        for (int i = 0; i < 7; ++i) {
+            REQUIRE_EQ(readUint8(), 0);
+        }
+        REQUIRE_EQ(readUint8(), 1);
+        return pixels;
+    }
+};
+
+TEST_CASE("ScreenStreamEncoder writes frames with regions") {
+    std::vector<uint8_t> output;
+    ScreenStreamEncoder encoder([&output](const uint8_t* data, size_t size) {
+        output.insert(output.end(), data, data + size);
+        return true;
+    });
+
+    CHECK(encoder.writeHeader(320, 240));
+    CHECK(encoder.beginFrame(2));
+    const uint8_t color[] = { 200, 10, 90, 200, 10, 90, 200, 10, 90, 200, 10, 90 };
+    CHECK(encoder.beginRegion({ .xStart = 10, .yStart = 20, .xEnd = 14, .yEnd = 22 }));
+    CHECK(encoder.writeRow(color));
+    CHECK(encoder.writeRow(color));
+    CHECK(encoder.finishRegion());
+    CHECK(encoder.beginRegion({ .xStart = 0, .yStart = 0, .xEnd = 4, .yEnd = 1 }));
+    CHECK(encoder.writeRow(color));
+    CHECK(encoder.finishRegion());
+    // Keep-alive
+    CHECK(encoder.beginFrame(0));
+    CHECK_EQ(encoder.getFrameCount(), 2);
+
+    StreamReader reader(output);
+    CHECK_EQ(reader.readTag(), "TTSS");
+    CHECK_EQ(reader.readUint8(), ScreenStreamEncoder::VERSION);
+    CHECK_EQ(reader.readUint16(), 320);
+    CHECK_EQ(reader.readUint16(), 240);
+
+    CHECK_EQ(reader.readTag(), "FRAM");
+    CHECK_EQ(reader.readUint32(), 0);
+    REQUIRE_EQ(reader.readUint16(), 2);
+
+    CHECK_EQ(reader.readUint16(), 10);
+    CHECK_EQ(reader.readUint16(), 20);
+    CHECK_EQ(reader.readUint16(), 4);
+    CHECK_EQ(reader.readUint16(), 2);
+    uint32_t width, height;
+    auto pixels = reader.readQoi(width, height);
+    CHECK_EQ(width, 4);
+    CHECK_EQ(height, 2);
+    CHECK_EQ(pixels[21], 200);
+    CHECK_EQ(pixels[22], 10);
+    CHECK_EQ(pixels[23], 90);
+
+    CHECK_EQ(reader.readUint16(), 0);
+    CHECK_EQ(reader.readUint16(), 0);
+    CHECK_EQ(reader.readUint16(), 4);
+    CHECK_EQ(reader.readUint16(), 1);
+    pixels = reader.readQoi(width, height);
+    CHECK_EQ(pixels.size(), 12);
+
+    CHECK_EQ(reader.readTag(), "FRAM");
+    CHECK_EQ(reader.readUint32(), 1);
+    CHECK_EQ(reader.readUint16(), 0);
+    CHECK(reader.isAtEnd());
+}
+
+TEST_CASE("FrameRateController adapts the frame interval to the send time") {
+    FrameRateController controller({ .minimumIntervalMs = 50, .maximumIntervalMs = 1000 });
+    CHECK_EQ(controller.getFrameIntervalMs(), 50);
+    CHECK_EQ(controller.getThroughput(), 0);
+
+    // A fast link stays at the maximum frame rate
+    controller.onFrameSent(10000, 10);
+    CHECK_EQ(controller.getFrameIntervalMs(), 50);
+    CHECK_EQ(controller.getThroughput(), 1000000);
+
+    // A slow link gradually lowers the frame rate
+    uint32_t previous_interval = controller.getFrameIntervalMs();
+    for (int i = 0; i < 20; ++i) {
+        controller.onFrameSent(10000, 300);
+        CHECK_GE(controller.getFrameIntervalMs(), previous_interval);
+        previous_interval = controller.getFrameIntervalMs();
+    }
+    CHECK_GT(previous_interval, 500);
+    CHECK_LE(previous_interval, 600);
+
+    // Very slow frames are limited by the maximum interval
+    for (int i = 0; i < 20; ++i) {
+        controller.onFrameSent(10000, 5000);
+    }
+    CHECK_EQ(controller.getFrameIntervalMs(), 1000);
+}
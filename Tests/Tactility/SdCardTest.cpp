@@ -0,0 +1,158 @@
+#include "../TactilityCore/TestFile.h"
+#include "doctest.h"
+
+#include <Tactility/file/FileLock.h>
+#include <Tactility/file/PropertiesFile.h>
+#include <Tactility/hal/sdcard/SdCardDevice.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Mutex.h>
+
+using namespace tt;
+using namespace tt::hal::sdcard;
+
+class TestSdCard final : public SdCardDevice {
+
+    std::string mountPath;
+    std::shared_ptr<Lock> lock = std::make_shared<Mutex>();
+
+public:
+
+    TestSdCard() : SdCardDevice(MountBehaviour::Anytime) {}
+
+    std::string getName() const override { return "TestSdCard"; }
+    std::string getDescription() const override { return "Test SD card"; }
+
+    bool mount(const std::string& newMountPath) override {
+        mountPath = newMountPath;
+        return true;
+    }
+
+    bool unmount() override {
+        mountPath = "";
+        return true;
+    }
+
+    State getState(TickType_t timeout) const override {
+        return mountPath.empty() ? State::Unmounted : State::Mounted;
+    }
+
+    std::string getMountPath() const override { return mountPath; }
+
+    std::shared_ptr<Lock> getLock() const override { return lock; }
+};
+
+class SdCardRegistration {
+
+    std::shared_ptr<TestSdCard> sdcard = std::make_shared<TestSdCard>();
+
+public:
+
+    explicit SdCardRegistration(const std::string& mountPath) {
+        hal::registerDevice(sdcard);
+        sdcard->mount(mountPath);
+        updateMountTable();
+    }
+
+    ~SdCardRegistration() {
+        sdcard->unmount();
+        hal::deregisterDevice(sdcard);
+        updateMountTable();
+    }
+
+    std::shared_ptr<TestSdCard> get() const { return sdcard; }
+};
+
+TEST_CASE("findSdCardLock() returns the lock of the SD card that the path is on") {
+    SdCardRegistration sdcard("/sdcard");
+
+    CHECK_EQ(findSdCardLock("/sdcard"), sdcard.get()->getLock());
+    CHECK_EQ(findSdCardLock("/sdcard/settings/test.properties"), sdcard.get()->getLock());
+    CHECK_EQ(findSdCardLock("/data/settings/test.properties"), nullptr);
+    CHECK_EQ(findSdCardLock("/sdcard1/test.properties"), nullptr);
+}
+
+TEST_CASE("findSdCardLock() returns the lock of the most specific mount path") {
+    SdCardRegistration first("/sdcard");
+    SdCardRegistration second("/sdcard/nested");
+
+    CHECK_EQ(findSdCardLock("/sdcard/file"), first.get()->getLock());
+    CHECK_EQ(findSdCardLock("/sdcard/nested/file"), second.get()->getLock());
+    CHECK_EQ(findSdCardLock("/sdcard/nested2/file"), first.get()->getLock());
+}
+
+TEST_CASE("findSdCardLock() returns nullptr after unmounting and updating the mount table") {
+    SdCardRegistration sdcard("/sdcard");
+    sdcard.get()->unmount();
+
+    // Not updated yet
+    CHECK_EQ(findSdCardLock("/sdcard/file"), sdcard.get()->getLock());
+
+    updateMountTable();
+    CHECK_EQ(findSdCardLock("/sdcard/file"), nullptr);
+
+    sdcard.get()->mount("/sdcard");
+    updateMountTable();
+    CHECK_EQ(findSdCardLock("/sdcard/file"), sdcard.get()->getLock());
+}
+
+// region Benchmark
+
+// Skipped by default, so unit test runs stay fast: use "TactilityTests --no-skip" to run it
+
+constexpr int BENCHMARK_ITERATIONS = 1000;
+
+/** The lookup that findSdCardLock() did before: a device registry scan with a mount state check */
+static std::shared_ptr<Lock> findLockLikeBefore(const std::string& path) {
+    for (const auto& sdcard : hal::findDevices<SdCardDevice>(hal::Device::Type::SdCard)) {
+        if (sdcard->isMounted() && path.starts_with(sdcard->getMountPath())) {
+            return sdcard->getLock();
+        }
+    }
+    return nullptr;
+}
+
+static int64_t measureSettingsLoadsPerSecond(const char* path) {
+    std::map<std::string, std::string> properties;
+    auto start_time = kernel::getMicrosSinceBoot();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        properties.clear();
+        file::loadPropertiesFile(path, properties);
+    }
+    auto duration = kernel::getMicrosSinceBoot() - start_time;
+    CHECK_EQ(properties.size(), 3);
+    return BENCHMARK_ITERATIONS * 1000000LL / std::max<int64_t>(duration, 1);
+}
+
+static int64_t measureNanosPerLookup(std::shared_ptr<Lock> (*function)(const std::string&)) {
+    const std::string path = "/sdcard/settings/test.properties";
+    size_t found = 0;
+    auto start_time = kernel::getMicrosSinceBoot();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        found += (function(path) != nullptr) ? 1 : 0;
+    }
+    auto duration = kernel::getMicrosSinceBoot() - start_time;
+    CHECK_EQ(found, BENCHMARK_ITERATIONS);
+    return duration * 1000 / BENCHMARK_ITERATIONS;
+}
+
+TEST_CASE("benchmark file lock lookup and settings loading" * doctest::skip()) {
+    SdCardRegistration sdcard("/sdcard");
+    TestFile file("benchmark.properties");
+    file.writeData("brightness=200\ntimeZone=Europe/Amsterdam\ntheme=dark\n");
+
+    auto lookup_before = measureNanosPerLookup(findLockLikeBefore);
+    auto lookup_now = measureNanosPerLookup(findSdCardLock);
+
+    file::setFindLockFunction(findLockLikeBefore);
+    auto loads_before = measureSettingsLoadsPerSecond(file.getPath());
+    file::setFindLockFunction(file::findLock);
+    auto loads_now = measureSettingsLoadsPerSecond(file.getPath());
+    file::setFindLockFunction(nullptr);
+
+    MESSAGE("Lock lookup before (registry scan): ", lookup_before, " ns/call");
+    MESSAGE("Lock lookup now (mount table): ", lookup_now, " ns/call");
+    MESSAGE("Settings loads before: ", loads_before, "/s");
+    MESSAGE("Settings loads now: ", loads_now, "/s");
+}
+
+// endregion Benchmark
@@ -0,0 +1,73 @@
+#include "doctest.h"
+#include <Tactility/hal/spi/SpiBusArbiter.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/RecursiveMutex.h>
+#include <Tactility/Thread.h>
+
+#include <atomic>
+
+using namespace tt;
+using namespace tt::hal::spi;
+
+static SpiBusClientStatistics findStatistics(const SpiBusArbiter& arbiter, const std::string& name) {
+    for (const auto& statistics : arbiter.getStatistics()) {
+        if (statistics.name == name) {
+            return statistics;
+        }
+    }
+    return {};
+}
+
+TEST_CASE("SpiBusArbiter client counts locks") {
+    auto arbiter = SpiBusArbiter(std::make_shared<RecursiveMutex>());
+    auto client = arbiter.createClient("Display", SpiBusArbiter::Priority::Normal, 10);
+
+    CHECK(client->lock(0));
+    client->unlock();
+    CHECK(client->lock(0));
+    client->unlock();
+
+    auto statistics = findStatistics(arbiter, "Display");
+    CHECK_EQ(statistics.lockCount, 2);
+    uint32_t hold_count = 0;
+    for (auto count : statistics.holdHistogram) {
+        hold_count += count;
+    }
+    CHECK_EQ(hold_count, 2);
+}
+
+TEST_CASE("SpiBusArbiter client can be locked recursively") {
+    auto bus_lock = std::make_shared<RecursiveMutex>();
+    auto arbiter = SpiBusArbiter(bus_lock);
+    auto client = arbiter.createClient("Storage", SpiBusArbiter::Priority::Low, 10);
+
+    CHECK(client->lock(0));
+    CHECK(client->lock(0));
+    client->unlock();
+    client->unlock();
+
+    CHECK_EQ(findStatistics(arbiter, "Storage").lockCount, 1);
+
+    // The bus must be released by now
+    std::atomic<bool> locked_by_other_thread = false;
+    auto thread = Thread("test", 4096, [&bus_lock, &locked_by_other_thread] {
+        if (bus_lock->lock(0)) {
+            locked_by_other_thread = true;
+            bus_lock->unlock();
+        }
+        return 0;
+    });
+    thread.start();
+    thread.join();
+    CHECK(locked_by_other_thread);
+}
+
+TEST_CASE("SpiBusArbiter statistics only include existing clients") {
+    auto arbiter = SpiBusArbiter(std::make_shared<RecursiveMutex>());
+    auto client = arbiter.createClient("First", SpiBusArbiter::Priority::Normal, 10);
+    arbiter.createClient("Second", SpiBusArbiter::Priority::Normal, 10);
+
+    auto statistics = arbiter.getStatistics();
+    CHECK_EQ(statistics.size(), 1);
+    CHECK_EQ(statistics[0].name, "First");
+}
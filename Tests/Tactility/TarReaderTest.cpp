@@ -0,0 +1,172 @@
+#include "doctest.h"
+#include <Tactility/file/TarReader.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace tt::file;
+
+// region Archive creation
+
+static void putOctal(std::vector<uint8_t>& header, size_t offset, size_t size, uint64_t value) {
+    char text[16];
+    snprintf(text, sizeof(text), "%0*llo", static_cast<int>(size - 1), static_cast<unsigned long long>(value));
+    memcpy(header.data() + offset, text, size - 1);
+}
+
+static void addRecord(std::vector<uint8_t>& archive, const std::string& name, char typeFlag, const std::string& data, const std::string& prefix = "") {
+    std::vector<uint8_t> header(512, 0);
+    memcpy(header.data(), name.data(), std::min<size_t>(name.size(), 100));
+    putOctal(header, 100, 8, 0644);
+    putOctal(header, 108, 8, 0);
+    putOctal(header, 116, 8, 0);
+    putOctal(header, 124, 12, data.size());
+    putOctal(header, 136, 12, 0);
+    header[156] = typeFlag;
+    memcpy(header.data() + 257, "ustar\0" "00", 8);
+    memcpy(header.data() + 345, prefix.data(), prefix.size());
+
+    memset(header.data() + 148, ' ', 8);
+    uint32_t checksum = 0;
+    for (auto value : header) {
+        checksum += value;
+    }
+    putOctal(header, 148, 7, checksum);
+
+    archive.insert(archive.end(), header.begin(), header.end());
+    archive.insert(archive.end(), data.begin(), data.end());
+    archive.resize((archive.size() + 511) / 512 * 512, 0);
+}
+
+static void addEnd(std::vector<uint8_t>& archive) {
+    archive.resize(archive.size() + 1024, 0);
+}
+
+// endregion
+
+/** Records the entries in memory */
+class MemoryHandler final : public TarReader::Handler {
+
+public:
+
+    std::vector<TarReader::Entry> entries;
+    std::vector<std::string> contents;
+
+    bool onEntry(const TarReader::Entry& entry) override {
+        entries.push_back(entry);
+        contents.emplace_back();
+        return true;
+    }
+
+    bool onData(const uint8_t* data, size_t size) override {
+        contents.back().append(reinterpret_cast<const char*>(data), size);
+        return true;
+    }
+};
+
+TEST_CASE("TarReader reads entries regardless of how the archive is split") {
+    const std::string long_name = std::string(120, 'a') + ".txt";
+    const std::string large_content(1500, 'x');
+
+    std::vector<uint8_t> archive;
+    addRecord(archive, "./", '5', "");
+    addRecord(archive, "./manifest.properties", '0', "[manifest]\nversion=0.1\n");
+    addRecord(archive, "assets/", '5', "");
+    addRecord(archive, "image.png", '0', large_content, "assets");
+    addRecord(archive, "././@LongLink", 'L', long_name + '\0');
+    addRecord(archive, "truncated", '0', "long");
+    addRecord(archive, "PaxHeader", 'x', "23 path=assets/pax.txt\n");
+    addRecord(archive, "ignored", '0', "");
+    addRecord(archive, "link", '2', "");
+    addEnd(archive);
+    // Tar files are padded to a record size
+    archive.resize(archive.size() + 2048, 0);
+
+    for (size_t chunk_size : { 1, 7, 512, 513, 4096, 100000 }) {
+        MemoryHandler handler;
+        TarReader reader(handler);
+        for (size_t offset = 0; offset < archive.size(); offset += chunk_size) {
+            const auto size = std::min(chunk_size, archive.size() - offset);
+            REQUIRE(reader.write(archive.data() + offset, size));
+        }
+        REQUIRE(reader.isFinished());
+        REQUIRE_EQ(handler.entries.size(), 7);
+        CHECK_EQ(reader.getEntryCount(), 7);
+
+        CHECK(handler.entries[0].path.empty());
+        CHECK_EQ(handler.entries[0].type, TarReader::EntryType::Directory);
+        CHECK_EQ(handler.entries[1].path, "manifest.properties");
+        CHECK_EQ(handler.entries[1].mode, 0644);
+        CHECK_EQ(handler.contents[1], "[manifest]\nversion=0.1\n");
+        CHECK_EQ(handler.entries[2].path, "assets");
+        CHECK_EQ(handler.entries[3].path, "assets/image.png");
+        CHECK_EQ(handler.entries[3].size, large_content.size());
+        CHECK_EQ(handler.contents[3], large_content);
+        CHECK_EQ(handler.entries[4].path, long_name);
+        CHECK_EQ(handler.contents[4], "long");
+        CHECK_EQ(handler.entries[5].path, "assets/pax.txt");
+        CHECK_EQ(handler.entries[6].type, TarReader::EntryType::Other);
+    }
+}
+
+TEST_CASE("TarReader rejects invalid archives") {
+    std::vector<uint8_t> archive;
+    addRecord(archive, "file.txt", '0', "data");
+    addEnd(archive);
+
+    SUBCASE("corrupt header") {
+        archive[0] = 'F';
+        MemoryHandler handler;
+        TarReader reader(handler);
+        CHECK_FALSE(reader.write(archive.data(), archive.size()));
+        CHECK(handler.entries.empty());
+    }
+
+    SUBCASE("truncated archive") {
+        MemoryHandler handler;
+        TarReader reader(handler);
+        CHECK(reader.write(archive.data(), 700));
+        CHECK_FALSE(reader.isFinished());
+    }
+}
+
+TEST_CASE("TarExtractor extracts files and rejects paths outside of the destination") {
+    CHECK(isSafeRelativePath("manifest.properties"));
+    CHECK(isSafeRelativePath("assets/..image.png"));
+    CHECK_FALSE(isSafeRelativePath(""));
+    CHECK_FALSE(isSafeRelativePath("/etc/passwd"));
+    CHECK_FALSE(isSafeRelativePath("../app.elf"));
+    CHECK_FALSE(isSafeRelativePath("assets/../../app.elf"));
+    CHECK_FALSE(isSafeRelativePath("assets\\..\\..\\app.elf"));
+
+    const std::string destination = "tar_extractor_test";
+    REQUIRE((!isDirectory(destination) || deleteRecursively(destination)));
+    REQUIRE(findOrCreateDirectory(destination, 0777));
+
+    std::vector<uint8_t> archive;
+    addRecord(archive, "assets/data/file.txt", '0', "file content");
+    addEnd(archive);
+    {
+        TarExtractor extractor(destination);
+        TarReader reader(extractor);
+        CHECK(reader.write(archive.data(), archive.size()));
+        CHECK(reader.isFinished());
+    }
+
+    auto content = readString(destination + "/assets/data/file.txt");
+    REQUIRE_NE(content, nullptr);
+    CHECK_EQ(std::string(reinterpret_cast<const char*>(content.get())), "file content");
+
+    archive.clear();
+    addRecord(archive, "../escaped.txt", '0', "data");
+    addEnd(archive);
+    {
+        TarExtractor extractor(destination);
+        TarReader reader(extractor);
+        CHECK_FALSE(reader.write(archive.data(), archive.size()));
+    }
+    CHECK_FALSE(isFile("escaped.txt"));
+
+    CHECK(deleteRecursively(destination));
+}
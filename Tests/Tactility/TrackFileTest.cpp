@@ -0,0 +1,179 @@
+#include "doctest.h"
+#include <Tactility/service/trackrecorder/TrackExport.h>
+#include <Tactility/service/trackrecorder/TrackFile.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace tt::service::trackrecorder;
+using tt::hal::gps::GpsFix;
+
+static TrackPoint createPoint(int index) {
+    return {
+        .time = 1752496496000 + index * 200,
+        .latitude = 525000000 + index * 13,
+        .longitude = -1234567890 - index * 7,
+        .altitude = 12345 + index,
+        .groundSpeed = 5144,
+        .heading = 9000000 - index * 10,
+        .horizontalAccuracy = 1500,
+        .satelliteCount = 11
+    };
+}
+
+static std::string readText(const std::string& path) {
+    std::ifstream stream(path);
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    return buffer.str();
+}
+
+static std::vector<TrackPoint> readAll(const std::string& path, bool& corrupted) {
+    TrackReader reader(path);
+    std::vector<TrackPoint> points;
+    if (reader.open()) {
+        TrackPoint point;
+        while (reader.next(point)) {
+            points.push_back(point);
+        }
+    }
+    corrupted = reader.isCorrupted();
+    return points;
+}
+
+/** Write chunks of the specified sizes, with consecutive points */
+static void writeTrack(const std::string& path, std::initializer_list<int> chunkSizes) {
+    std::remove(path.c_str());
+    int index = 0;
+    for (auto size : chunkSizes) {
+        TrackChunkEncoder encoder;
+        for (int i = 0; i < size; ++i) {
+            CHECK(encoder.add(createPoint(index++)));
+        }
+        std::vector<std::vector<uint8_t>> chunks = { encoder.finish() };
+        CHECK(appendChunks(path, chunks));
+    }
+}
+
+static long getFileSize(const std::string& path) {
+    auto* file = fopen(path.c_str(), "rb");
+    fseek(file, 0, SEEK_END);
+    auto size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+TEST_CASE("toTrackPoint converts the date and time to unix time") {
+    GpsFix fix = {};
+    fix.type = GpsFix::Type::Fix3d;
+    fix.valid = true;
+    fix.validDate = true;
+    fix.validTime = true;
+    fix.year = 2025;
+    fix.month = 7;
+    fix.day = 14;
+    fix.hour = 12;
+    fix.minute = 34;
+    fix.second = 56;
+    fix.nanoseconds = 250000000;
+    fix.latitude = 525000000;
+
+    TrackPoint point;
+    CHECK(toTrackPoint(fix, point));
+    CHECK_EQ(point.time, 1752496496250);
+    CHECK_EQ(point.latitude, 525000000);
+
+    fix.validDate = false;
+    CHECK_FALSE(toTrackPoint(fix, point));
+}
+
+TEST_CASE("toFix converts RMC sentences") {
+    minmea_sentence_rmc rmc;
+    REQUIRE(minmea_parse_rmc(&rmc, "$GPRMC,123456.25,A,5230.000,N,12327.40734,W,10.0,90.0,140725,,*20"));
+
+    GpsFix fix;
+    tt::hal::gps::toFix(rmc, fix);
+    CHECK(fix.valid);
+    CHECK_EQ(fix.year, 2025);
+    CHECK_EQ(fix.day, 14);
+    CHECK_EQ(fix.nanoseconds, 250000000);
+    CHECK_EQ(fix.latitude, 525000000);
+    CHECK_EQ(fix.longitude, -1234567890);
+    CHECK_EQ(fix.groundSpeed, 5144);
+    CHECK_EQ(fix.heading, 9000000);
+}
+
+TEST_CASE("TrackChunkEncoder points can be read back") {
+    const std::string path = "track_roundtrip.trk";
+    writeTrack(path, { 100, 50 });
+
+    bool corrupted;
+    auto points = readAll(path, corrupted);
+    CHECK_FALSE(corrupted);
+    REQUIRE_EQ(points.size(), 150);
+    for (int i = 0; i < 150; ++i) {
+        CHECK_EQ(points[i].time, createPoint(i).time);
+        CHECK_EQ(points[i].longitude, createPoint(i).longitude);
+        CHECK_EQ(points[i].heading, createPoint(i).heading);
+    }
+
+    // Deltas make points a lot smaller than the in-memory representation
+    CHECK_LT(getFileSize(path), 150 * 16);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("TrackReader keeps the complete chunks of a truncated file") {
+    const std::string path = "track_truncated.trk";
+    writeTrack(path, { 20, 20 });
+    const auto size = getFileSize(path);
+    std::ifstream input(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << data.substr(0, size - 5);
+
+    bool corrupted;
+    auto points = readAll(path, corrupted);
+    CHECK(corrupted);
+    CHECK_EQ(points.size(), 20);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("TrackReader skips a damaged chunk") {
+    const std::string path = "track_damaged.trk";
+    writeTrack(path, { 10, 10, 10 });
+    auto* file = fopen(path.c_str(), "r+b");
+    // Damage the payload of the first chunk
+    fseek(file, sizeof(TrackFileHeader) + sizeof(TrackChunkHeader) + 3, SEEK_SET);
+    fputc(0xFF, file);
+    fclose(file);
+
+    bool corrupted;
+    auto points = readAll(path, corrupted);
+    CHECK(corrupted);
+    REQUIRE_EQ(points.size(), 20);
+    CHECK_EQ(points[0].time, createPoint(10).time);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("exportTrack writes CSV and GPX") {
+    const std::string path = "track_export.trk";
+    writeTrack(path, { 2 });
+
+    CHECK(exportTrack(path, "track_export.csv", ExportFormat::Csv));
+    CHECK_EQ(
+        readText("track_export.csv"),
+        "time,latitude,longitude,altitude,speed,heading,horizontal_accuracy,satellites\n"
+        "2025-07-14T12:34:56.000Z,52.5000000,-123.4567890,12.345,5.144,90.00000,1.500,11\n"
+        "2025-07-14T12:34:56.200Z,52.5000013,-123.4567897,12.346,5.144,89.99990,1.500,11\n"
+    );
+
+    CHECK(exportTrack(path, "track_export.gpx", ExportFormat::Gpx));
+    auto gpx = readText("track_export.gpx");
+    CHECK_NE(gpx.find("<trkpt lat=\"52.5000000\" lon=\"-123.4567890\"><ele>12.345</ele><time>2025-07-14T12:34:56.000Z</time><sat>11</sat></trkpt>"), std::string::npos);
+    CHECK_NE(gpx.find("</gpx>"), std::string::npos);
+
+    std::remove(path.c_str());
+    std::remove("track_export.csv");
+    std::remove("track_export.gpx");
+}
@@ -0,0 +1,197 @@
+#include "doctest.h"
+#include <Tactility/hal/uart/Uart.h>
+
+#include <cstring>
+#include <deque>
+
+using namespace tt::hal::uart;
+
+/** A UART that receives the data from a queue of chunks, like bursts on a real port */
+class FakeUart final : public Uart {
+
+public:
+
+    std::deque<std::vector<uint8_t>> chunks;
+    uint32_t readCount = 0;
+
+    void receive(const std::string& data) { chunks.emplace_back(data.begin(), data.end()); }
+    void receive(std::vector<uint8_t> data) { chunks.push_back(std::move(data)); }
+
+    bool start() override { return true; }
+    bool isStarted() const override { return true; }
+    bool stop() override { return true; }
+
+    size_t readBytes(std::byte* buffer, size_t bufferSize, TickType_t timeout) override {
+        readCount++;
+        size_t read_size = 0;
+        while (read_size < bufferSize && !chunks.empty()) {
+            auto& chunk = chunks.front();
+            const auto copy_size = std::min(chunk.size(), bufferSize - read_size);
+            memcpy(buffer + read_size, chunk.data(), copy_size);
+            chunk.erase(chunk.begin(), chunk.begin() + copy_size);
+            read_size += copy_size;
+            if (chunk.empty()) {
+                chunks.pop_front();
+            }
+        }
+        return read_size;
+    }
+
+    bool readByte(std::byte* output, TickType_t timeout) override { return readBytes(output, 1, timeout) == 1; }
+    size_t writeBytes(const std::byte* buffer, size_t bufferSize, TickType_t timeout) override { return bufferSize; }
+
+    size_t available(TickType_t timeout) override {
+        size_t size = 0;
+        for (const auto& chunk : chunks) {
+            size += chunk.size();
+        }
+        return size;
+    }
+
+    bool setBaudRate(uint32_t baudRate, TickType_t timeout) override { return true; }
+    uint32_t getBaudRate() override { return 115200; }
+    void flushDriverInput() override { chunks.clear(); }
+};
+
+static std::string toString(std::span<const uint8_t> data) {
+    return { reinterpret_cast<const char*>(data.data()), data.size() };
+}
+
+static std::vector<uint8_t> createUbxFrame(uint8_t messageClass, uint8_t messageId, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> frame = { 0xB5, 0x62, messageClass, messageId, static_cast<uint8_t>(payload.size()), static_cast<uint8_t>(payload.size() >> 8) };
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    uint8_t checksum_a = 0;
+    uint8_t checksum_b = 0;
+    for (size_t i = 2; i < frame.size(); ++i) {
+        checksum_a += frame[i];
+        checksum_b += checksum_a;
+    }
+    frame.push_back(checksum_a);
+    frame.push_back(checksum_b);
+    return frame;
+}
+
+TEST_CASE("findDelimitedFrame includes the delimiter") {
+    const std::string data = "abc\ndef";
+    auto match = findDelimitedFrame({ reinterpret_cast<const uint8_t*>(data.data()), data.size() }, '\n');
+    CHECK_EQ(match.skipSize, 0);
+    CHECK_EQ(match.frameSize, 4);
+
+    match = findDelimitedFrame({ reinterpret_cast<const uint8_t*>(data.data()) + 4, 3 }, '\n');
+    CHECK_EQ(match.frameSize, 0);
+}
+
+TEST_CASE("findLengthPrefixedFrame waits for the complete payload") {
+    const std::vector<uint8_t> data = { 0xAA, 0x03, 0x00, 1, 2, 3, 0xFF };
+    CHECK_EQ(findLengthPrefixedFrame(std::span(data).first(2), 1, 2, 4).frameSize, 0);
+    CHECK_EQ(findLengthPrefixedFrame(std::span(data).first(6), 1, 2, 4).frameSize, 0);
+    CHECK_EQ(findLengthPrefixedFrame(data, 1, 2, 4).frameSize, 7);
+    CHECK_EQ(findLengthPrefixedFrame(data, 1, 1, 4).frameSize, 7);
+}
+
+TEST_CASE("findUbxFrame skips noise and invalid frames") {
+    auto frame = createUbxFrame(0x01, 0x07, { 1, 2, 3, 4 });
+    auto corrupted = frame;
+    corrupted[7] ^= 0xFF;
+
+    std::vector<uint8_t> data = { 0x00, 0xB5, 0x00 };
+    data.insert(data.end(), corrupted.begin(), corrupted.end());
+    const auto frame_offset = data.size();
+    data.insert(data.end(), frame.begin(), frame.end());
+
+    auto match = findUbxFrame(data);
+    CHECK_EQ(match.skipSize, frame_offset);
+    CHECK_EQ(match.frameSize, frame.size());
+
+    // Incomplete frame
+    match = findUbxFrame(std::span(frame).first(frame.size() - 1));
+    CHECK_EQ(match.skipSize, 0);
+    CHECK_EQ(match.frameSize, 0);
+}
+
+TEST_CASE("ReceiveBuffer moves data to the start when space runs out") {
+    ReceiveBuffer buffer(8);
+    auto space = buffer.getWritableSpace();
+    CHECK_EQ(space.size(), 8);
+    memcpy(space.data(), "abcdefg", 7);
+    buffer.commit(7);
+    buffer.consume(5);
+    CHECK_EQ(toString(buffer.getData()), "fg");
+
+    space = buffer.getWritableSpace();
+    CHECK_EQ(space.size(), 6);
+    CHECK_EQ(toString(buffer.getData()), "fg");
+    buffer.consume(2);
+    CHECK_EQ(buffer.size(), 0);
+}
+
+TEST_CASE("readLine returns lines from bulk reads") {
+    FakeUart uart;
+    uart.receive("$GPGGA,1*00\r\n$GPRMC,");
+    uart.receive("2*00\r\n$GP");
+
+    CHECK_EQ(toString(uart.readLine('\n', 0)), "$GPGGA,1*00\r\n");
+    CHECK_EQ(toString(uart.readLine('\n', 0)), "$GPRMC,2*00\r\n");
+    CHECK(uart.readLine('\n', 0).empty());
+
+    // Everything was read in blocks instead of byte by byte
+    CHECK_LE(uart.readCount, 3);
+    auto statistics = uart.getReceiveStatistics();
+    CHECK_EQ(statistics.byteCount, 29);
+    CHECK_EQ(statistics.frameCount, 2);
+    CHECK_EQ(statistics.overrunCount, 0);
+
+    // The partial line is kept until it's complete
+    uart.receive("GSV\n");
+    CHECK_EQ(toString(uart.readLine('\n', 0)), "$GPGSV\n");
+}
+
+TEST_CASE("flushInput discards the data in the receive buffer") {
+    FakeUart uart;
+    uart.receive("old\npartial");
+    CHECK_EQ(toString(uart.readLine('\n', 0)), "old\n");
+
+    uart.flushInput();
+    uart.receive("new\n");
+    CHECK_EQ(toString(uart.readLine('\n', 0)), "new\n");
+}
+
+TEST_CASE("readUntil copies a line into the buffer") {
+    FakeUart uart;
+    uart.receive("hello\nworld\n");
+
+    char buffer[8];
+    CHECK_EQ(uart.readUntil(reinterpret_cast<std::byte*>(buffer), sizeof(buffer), '\n', 0), 6);
+    CHECK_EQ(std::string(buffer), "hello\n");
+
+    // Truncated lines keep room for the null terminator
+    char small_buffer[4];
+    CHECK_EQ(uart.readUntil(reinterpret_cast<std::byte*>(small_buffer), sizeof(small_buffer), '\n', 0), 3);
+    CHECK_EQ(std::string(small_buffer), "wor");
+}
+
+TEST_CASE("readFrame counts overruns when the buffer fills up without a frame") {
+    FakeUart uart;
+    uart.setReceiveBufferSize(16);
+    uart.receive(std::string(20, 'x') + "\nok\n");
+
+    // The rest of the dropped line can't be recognized as a fragment
+    CHECK_EQ(toString(uart.readLine('\n', 0)), "xxxx\n");
+    CHECK_EQ(toString(uart.readLine('\n', 0)), "ok\n");
+    auto statistics = uart.getReceiveStatistics();
+    CHECK_EQ(statistics.overrunCount, 1);
+    CHECK_EQ(statistics.droppedByteCount, 16);
+}
+
+TEST_CASE("readUbxFrame returns complete frames") {
+    FakeUart uart;
+    auto frame = createUbxFrame(0x01, 0x07, std::vector<uint8_t>(92, 0x11));
+    uart.receive(std::vector<uint8_t> { 0x24, 0x47 });
+    uart.receive(std::vector(frame.begin(), frame.begin() + 50));
+    uart.receive(std::vector(frame.begin() + 50, frame.end()));
+
+    auto result = uart.readUbxFrame(0);
+    CHECK_EQ(result.size(), 100);
+    CHECK(std::equal(result.begin(), result.end(), frame.begin()));
+    CHECK_EQ(uart.getReceiveStatistics().droppedByteCount, 2);
+}
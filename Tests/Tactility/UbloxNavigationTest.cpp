@@ -0,0 +1,124 @@
+#include "doctest.h"
+#include <Tactility/hal/gps/UbloxNavigation.h>
+
+#include <vector>
+
+using namespace tt::hal::gps;
+
+static std::vector<uint8_t> createFrame(uint8_t messageClass, uint8_t messageId, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> frame = { 0xB5, 0x62, messageClass, messageId, static_cast<uint8_t>(payload.size()), static_cast<uint8_t>(payload.size() >> 8) };
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    frame.push_back(0x00);
+    frame.push_back(0x00);
+    return frame;
+}
+
+static void writeU2(std::vector<uint8_t>& data, size_t offset, uint16_t value) {
+    data[offset] = value & 0xFF;
+    data[offset + 1] = value >> 8;
+}
+
+static void writeU4(std::vector<uint8_t>& data, size_t offset, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        data[offset + i] = (value >> (i * 8)) & 0xFF;
+    }
+}
+
+static std::vector<uint8_t> createNavPvtPayload() {
+    std::vector<uint8_t> payload(92, 0);
+    writeU2(payload, 4, 2025);
+    payload[6] = 7; // Month
+    payload[7] = 14; // Day
+    payload[8] = 12; // Hour
+    payload[9] = 34; // Minute
+    payload[10] = 56; // Second
+    payload[11] = 0x07; // Valid date, time and fully resolved
+    writeU4(payload, 16, 250000000); // Nanoseconds
+    payload[20] = 3; // 3D fix
+    payload[21] = 0x01; // GNSS fix OK
+    payload[23] = 11; // Satellites
+    writeU4(payload, 24, static_cast<uint32_t>(-1234567890)); // Longitude: -123.456789
+    writeU4(payload, 28, 525000000); // Latitude: 52.5
+    writeU4(payload, 36, 12345); // Altitude
+    writeU4(payload, 40, 1500); // Horizontal accuracy
+    writeU4(payload, 60, 5144); // Ground speed: 10 knots
+    writeU4(payload, 64, 9000000); // Heading: 90 degrees
+    writeU2(payload, 76, 156); // PDOP
+    return payload;
+}
+
+TEST_CASE("parseNavPvt reads the fix") {
+    auto frame = createFrame(ublox::UBX_CLASS_NAV, ublox::UBX_ID_NAV_PVT, createNavPvtPayload());
+
+    GpsFix fix;
+    CHECK(ublox::parseNavPvt(frame, fix));
+    CHECK_EQ(fix.type, GpsFix::Type::Fix3d);
+    CHECK(fix.valid);
+    CHECK(fix.validDate);
+    CHECK(fix.validTime);
+    CHECK_EQ(fix.year, 2025);
+    CHECK_EQ(fix.month, 7);
+    CHECK_EQ(fix.second, 56);
+    CHECK_EQ(fix.nanoseconds, 250000000);
+    CHECK_EQ(fix.satelliteCount, 11);
+    CHECK_EQ(fix.latitude, 525000000);
+    CHECK_EQ(fix.longitude, -1234567890);
+    CHECK_EQ(fix.altitude, 12345);
+    CHECK_EQ(fix.horizontalAccuracy, 1500);
+    CHECK_EQ(fix.groundSpeed, 5144);
+    CHECK_EQ(fix.positionDop, 156);
+}
+
+TEST_CASE("parseNavPvt rejects other and truncated messages") {
+    GpsFix fix;
+    auto sat_frame = createFrame(ublox::UBX_CLASS_NAV, ublox::UBX_ID_NAV_SAT, createNavPvtPayload());
+    CHECK_FALSE(ublox::parseNavPvt(sat_frame, fix));
+
+    auto short_frame = createFrame(ublox::UBX_CLASS_NAV, ublox::UBX_ID_NAV_PVT, std::vector<uint8_t>(40, 0));
+    CHECK_FALSE(ublox::parseNavPvt(short_frame, fix));
+}
+
+TEST_CASE("parseNavSat reads all satellites") {
+    std::vector<uint8_t> payload(8 + 2 * 12, 0);
+    payload[5] = 2;
+    // First satellite
+    payload[9] = 5; // Satellite id
+    payload[10] = 42; // Carrier-to-noise ratio
+    payload[11] = static_cast<uint8_t>(-3); // Elevation
+    writeU2(payload, 12, 270); // Azimuth
+    // Second satellite
+    payload[21] = 17;
+    payload[22] = 30;
+    payload[23] = 65;
+    writeU2(payload, 24, 10);
+
+    std::vector<minmea_sat_info> satellites;
+    auto frame = createFrame(ublox::UBX_CLASS_NAV, ublox::UBX_ID_NAV_SAT, payload);
+    CHECK(ublox::parseNavSat(frame, [&satellites](const auto& info) {
+        satellites.push_back(info);
+    }));
+
+    CHECK_EQ(satellites.size(), 2);
+    CHECK_EQ(satellites[0].nr, 5);
+    CHECK_EQ(satellites[0].snr, 42);
+    CHECK_EQ(satellites[0].elevation, -3);
+    CHECK_EQ(satellites[0].azimuth, 270);
+    CHECK_EQ(satellites[1].nr, 17);
+    CHECK_EQ(satellites[1].elevation, 65);
+}
+
+TEST_CASE("toRmc converts to NMEA units") {
+    auto frame = createFrame(ublox::UBX_CLASS_NAV, ublox::UBX_ID_NAV_PVT, createNavPvtPayload());
+    GpsFix fix;
+    CHECK(ublox::parseNavPvt(frame, fix));
+
+    minmea_sentence_rmc rmc;
+    ublox::toRmc(fix, rmc);
+    CHECK(rmc.valid);
+    CHECK_EQ(minmea_tocoord(&rmc.latitude), doctest::Approx(52.5));
+    CHECK_EQ(minmea_tocoord(&rmc.longitude), doctest::Approx(-123.456789).epsilon(1e-7));
+    CHECK_EQ(minmea_tofloat(&rmc.speed), doctest::Approx(10.0).epsilon(0.01));
+    CHECK_EQ(minmea_tofloat(&rmc.course), doctest::Approx(90.0));
+    CHECK_EQ(rmc.date.year, 25);
+    CHECK_EQ(rmc.time.microseconds, 250000);
+}
@@ -0,0 +1,174 @@
+#include "doctest.h"
+#include <symbols/symbol_index.h>
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int symbolA = 1;
+static int symbolB = 2;
+static int symbolC = 3;
+
+static const esp_elfsym firstTable[] = {
+    { "b", &symbolB },
+    { "a", &symbolA },
+    ESP_ELFSYM_END
+};
+
+static const esp_elfsym secondTable[] = {
+    { "c", &symbolC },
+    { "a", &symbolC }, // duplicate: firstTable takes precedence
+    ESP_ELFSYM_END
+};
+
+TEST_CASE("SymbolIndex finds symbols from all tables") {
+    SymbolIndex index({ firstTable, secondTable });
+
+    CHECK_EQ(index.getSize(), 4);
+    REQUIRE_NE(index.find("b"), nullptr);
+    CHECK_EQ(index.find("b")->sym, &symbolB);
+    REQUIRE_NE(index.find("c"), nullptr);
+    CHECK_EQ(index.find("c")->sym, &symbolC);
+}
+
+TEST_CASE("SymbolIndex returns nullptr for unknown symbols") {
+    SymbolIndex index({ firstTable, secondTable });
+
+    CHECK_EQ(index.find("d"), nullptr);
+    CHECK_EQ(index.find(""), nullptr);
+}
+
+TEST_CASE("SymbolIndex gives precedence to the first table for duplicate names") {
+    SymbolIndex index({ firstTable, secondTable });
+
+    REQUIRE_NE(index.find("a"), nullptr);
+    CHECK_EQ(index.find("a")->sym, &symbolA);
+}
+
+/**
+ * Symbol tables with the names that TactilityC actually exports.
+ * The names are read from the sources so the tests stay representative.
+ */
+class ExportedSymbolTables {
+
+    std::deque<std::string> names;
+    std::vector<std::vector<esp_elfsym>> tables;
+
+    void addTable(const std::string& relativePath) {
+        std::ifstream file(std::string(TACTILITY_SOURCE_DIR) + "/" + relativePath);
+        REQUIRE(file.is_open());
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        auto source = buffer.str();
+
+        std::vector<esp_elfsym> table;
+        static const std::regex pattern(R"(ESP_ELFSYM_EXPORT\((\w+)\)|\{\s*\"(\w+)\",)");
+        for (auto it = std::sregex_iterator(source.begin(), source.end(), pattern); it != std::sregex_iterator(); ++it) {
+            const auto& match = *it;
+            names.push_back(match[1].matched ? match[1].str() : match[2].str());
+            table.push_back({ names.back().c_str(), &names.back() });
+        }
+        table.push_back(ESP_ELFSYM_END);
+        tables.push_back(std::move(table));
+    }
+
+public:
+
+    ExportedSymbolTables() {
+        // Same order as tt_symbol_resolver()
+        addTable("TactilityC/Source/tt_init.cpp");
+        addTable("TactilityC/Source/symbols/gcc_soft_float.cpp");
+        addTable("TactilityC/Source/symbols/stl.cpp");
+        addTable("TactilityC/Source/symbols/cplusplus.cpp");
+        addTable("TactilityC/Source/symbols/pthread.cpp");
+        addTable("TactilityC/Source/symbols/freertos.cpp");
+        addTable("TactilityC/Source/symbols/string.cpp");
+        addTable("TactilityC/Source/symbols/esp_event.cpp");
+        addTable("TactilityC/Source/symbols/esp_http_client.cpp");
+    }
+
+    std::vector<const esp_elfsym*> getTables() const {
+        std::vector<const esp_elfsym*> result;
+        for (const auto& table : tables) {
+            result.push_back(table.data());
+        }
+        return result;
+    }
+
+    const std::deque<std::string>& getNames() const { return names; }
+};
+
+/** The implementation that tt_symbol_resolver() used before SymbolIndex */
+static const esp_elfsym* findLinear(const std::vector<const esp_elfsym*>& tables, const char* name) {
+    for (const auto* table : tables) {
+        for (const auto* symbol = table; symbol->name != nullptr; symbol++) {
+            if (strcmp(symbol->name, name) == 0) {
+                return symbol;
+            }
+        }
+    }
+    return nullptr;
+}
+
+TEST_CASE("SymbolIndex resolves the exported symbols like a linear search") {
+    ExportedSymbolTables exported;
+    auto tables = exported.getTables();
+    const auto& names = exported.getNames();
+    REQUIRE_GT(names.size(), 100);
+
+    SymbolIndex index(tables.data(), tables.size());
+    for (const auto& name : names) {
+        // Results must be identical to the linear search, including duplicates
+        CHECK_EQ(index.find(name.c_str()), findLinear(tables, name.c_str()));
+    }
+}
+
+// region Benchmark
+
+template<typename Function>
+static int64_t measureMicros(Function function) {
+    auto start_time = std::chrono::steady_clock::now();
+    function();
+    auto duration = std::chrono::steady_clock::now() - start_time;
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+// Only reports timings, so it is skipped in unit test runs: run "TactilityCTests --no-skip" to include it
+TEST_CASE("benchmark resolving all exported symbols" * doctest::skip()) {
+    ExportedSymbolTables exported;
+    auto tables = exported.getTables();
+    const auto& names = exported.getNames();
+    REQUIRE_GT(names.size(), 100);
+
+    SymbolIndex* index = nullptr;
+    auto build_time = measureMicros([&] {
+        index = new SymbolIndex(tables.data(), tables.size());
+    });
+
+    size_t linear_found = 0;
+    auto linear_time = measureMicros([&] {
+        for (const auto& name : names) {
+            linear_found += (findLinear(tables, name.c_str()) != nullptr) ? 1 : 0;
+        }
+    });
+
+    size_t indexed_found = 0;
+    auto indexed_time = measureMicros([&] {
+        for (const auto& name : names) {
+            indexed_found += (index->find(name.c_str()) != nullptr) ? 1 : 0;
+        }
+    });
+
+    CHECK_EQ(linear_found, names.size());
+    CHECK_EQ(indexed_found, names.size());
+
+    MESSAGE("Resolving ", names.size(), " symbols: linear ", linear_time, " us, indexed ", indexed_time, " us (index built in ", build_time, " us)");
+    delete index;
+}
+
+// endregion Benchmark
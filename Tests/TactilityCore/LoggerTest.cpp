@@ -0,0 +1,144 @@
+#include "doctest.h"
+#include <Tactility/Logger.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using namespace tt;
+
+// region Binary records
+
+TEST_CASE("binary log record contains header and hashes") {
+    uint8_t buffer[64];
+    auto length = encodeBinaryLogRecord(buffer, sizeof(buffer), LogLevel::Info, 1234U, "Tag", "Value {}", 42);
+
+    // Header (4) + payload header (14) + signed argument (9)
+    CHECK_EQ(length, 27);
+    CHECK_EQ(buffer[0], BINARY_LOG_SYNC_0);
+    CHECK_EQ(buffer[1], BINARY_LOG_SYNC_1);
+
+    uint16_t payload_length;
+    memcpy(&payload_length, buffer + 2, sizeof(payload_length));
+    CHECK_EQ(payload_length, length - BINARY_LOG_HEADER_SIZE);
+    CHECK_EQ(buffer[4], static_cast<uint8_t>(LogLevel::Info));
+
+    uint32_t timestamp, tag_hash, format_hash;
+    memcpy(&timestamp, buffer + 5, sizeof(timestamp));
+    memcpy(&tag_hash, buffer + 9, sizeof(tag_hash));
+    memcpy(&format_hash, buffer + 13, sizeof(format_hash));
+    CHECK_EQ(timestamp, 1234U);
+    CHECK_EQ(tag_hash, getLogHash("Tag"));
+    CHECK_EQ(format_hash, getLogHash("Value {}"));
+
+    CHECK_EQ(buffer[17], 1); // Argument count
+    CHECK_EQ(buffer[18], 'i');
+    int64_t value;
+    memcpy(&value, buffer + 19, sizeof(value));
+    CHECK_EQ(value, 42);
+}
+
+TEST_CASE("binary log record stores strings with their length") {
+    uint8_t buffer[64];
+    std::string text = "abc";
+    auto length = encodeBinaryLogRecord(buffer, sizeof(buffer), LogLevel::Error, 0U, "Tag", "{}", text);
+
+    CHECK_EQ(length, 18 + 1 + 2 + 3);
+    CHECK_EQ(buffer[17], 1);
+    CHECK_EQ(buffer[18], 's');
+    CHECK_EQ(buffer[19], 3);
+    CHECK_EQ(buffer[20], 0);
+    CHECK_EQ(memcmp(buffer + 21, "abc", 3), 0);
+}
+
+TEST_CASE("binary log record leaves out arguments that don't fit") {
+    uint8_t buffer[24];
+    auto length = encodeBinaryLogRecord(buffer, sizeof(buffer), LogLevel::Info, 0U, "Tag", "{} {}", 1, 2);
+
+    CHECK_EQ(length, 18);
+    CHECK_EQ(buffer[17], 0);
+}
+
+TEST_CASE("binary log record fails when the buffer is too small for the header") {
+    uint8_t buffer[8];
+    CHECK_EQ(encodeBinaryLogRecord(buffer, sizeof(buffer), LogLevel::Info, 0U, "Tag", "Test"), 0);
+}
+
+// endregion Binary records
+
+// region Level filtering
+
+TEST_CASE("logger level filtering is resolved at compile time") {
+    static_assert(BasicLogger<LogLevel::Info>::isEnabled(LogLevel::Error));
+    static_assert(BasicLogger<LogLevel::Info>::isEnabled(LogLevel::Info));
+    static_assert(!BasicLogger<LogLevel::Info>::isEnabled(LogLevel::Debug));
+    static_assert(BasicLogger<LogLevel::Verbose>::isEnabled(LogLevel::Verbose));
+
+    constexpr auto logger = BasicLogger<LogLevel::Warning>("Test");
+    CHECK_EQ(logger.isLoggingWarning(), true);
+    CHECK_EQ(logger.isLoggingInfo(), false);
+}
+
+TEST_CASE("tt_log does not evaluate arguments for disabled levels") {
+    constexpr auto logger = BasicLogger<LogLevel::Error>("Test");
+    int evaluations = 0;
+    auto evaluate = [&evaluations] { return ++evaluations; };
+
+    tt_log(logger, LogLevel::Debug, "{}", evaluate());
+    CHECK_EQ(evaluations, 0);
+}
+
+// endregion Level filtering
+
+// region Benchmark
+
+// Benchmarks are skipped in unit test runs: run them with "TactilityCoreTests --no-skip"
+
+constexpr int BENCHMARK_ITERATIONS = 10000;
+
+/** The formatting that Logger did before: a heap-allocated message and a stringstream for the prefix */
+static size_t formatLikeBefore(LogLevel level, const char* tag, int value, const char* text) {
+    std::string message = std::format("Value {} for {}", value, text);
+    std::stringstream buffer;
+    buffer << LOG_COLOR_GREY << getLogTimestamp() << ' ' << toTagColour(level) << toPrefix(level) << LOG_COLOR_GREY << " [" << LOG_COLOR_RESET << tag << LOG_COLOR_GREY << "] " << toMessageColour(level) << message << LOG_COLOR_RESET << std::endl;
+    return buffer.str().size();
+}
+
+/** The formatting that Logger does now: a stack buffer for the message and the prefix */
+static size_t formatLikeNow(LogLevel level, const char* tag, int value, const char* text) {
+    char message[LOG_MESSAGE_MAX_LENGTH];
+    auto result = std::format_to_n(message, sizeof(message) - 1, "Value {} for {}", value, text);
+    *result.out = '\0';
+    char line[LOG_MESSAGE_MAX_LENGTH + 64];
+    return snprintf(line, sizeof(line), "%s%lu %s%c%s [%s%s%s] %s%s%s\n", LOG_COLOR_GREY, static_cast<unsigned long>(getLogTimestamp()), toTagColour(level), toPrefix(level), LOG_COLOR_GREY, LOG_COLOR_RESET, tag, LOG_COLOR_GREY, toMessageColour(level), message, LOG_COLOR_RESET);
+}
+
+static size_t encodeBinary(LogLevel level, const char* tag, int value, const char* text) {
+    uint8_t record[LOG_MESSAGE_MAX_LENGTH];
+    return encodeBinaryLogRecord(record, sizeof(record), level, getLogTimestamp(), tag, "Value {} for {}", value, text);
+}
+
+template<typename Function>
+static int64_t measureNanosPerCall(Function function) {
+    size_t total_length = 0;
+    auto start_time = kernel::getMicrosSinceBoot();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        total_length += function(LogLevel::Info, "Benchmark", i, "benchmark");
+    }
+    auto duration = kernel::getMicrosSinceBoot() - start_time;
+    CHECK_GT(total_length, 0);
+    return duration * 1000 / BENCHMARK_ITERATIONS;
+}
+
+TEST_CASE("benchmark log formatting" * doctest::skip()) {
+    auto before = measureNanosPerCall(formatLikeBefore);
+    auto now = measureNanosPerCall(formatLikeNow);
+    auto binary = measureNanosPerCall(encodeBinary);
+
+    MESSAGE("Before (std::format + stringstream): ", before, " ns/call");
+    MESSAGE("Now (format_to_n into stack buffer): ", now, " ns/call");
+    MESSAGE("Binary record: ", binary, " ns/call");
+}
+
+// endregion Benchmark
@@ -0,0 +1,17 @@
+#include "doctest.h"
+#include <Tactility/crypt/Sha256.h>
+
+#include <string>
+
+TEST_CASE("Sha256 hashes data that is passed in parts") {
+    tt::crypt::Sha256 hash;
+    CHECK_EQ(hash.finishHex(), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+    hash.reset();
+    const std::string data = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    for (size_t offset = 0; offset < data.size(); offset += 5) {
+        auto part = data.substr(offset, 5);
+        hash.update(part.data(), part.size());
+    }
+    CHECK_EQ(hash.finishHex(), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
@@ -0,0 +1,99 @@
+#include "doctest.h"
+#include <Tactility/BoundedDispatcher.h>
+#include <Tactility/Thread.h>
+
+#include <memory>
+
+using namespace tt;
+
+TEST_CASE("BoundedDispatcher should not call callback if consume isn't called") {
+    int counter = 0;
+    BoundedDispatcher dispatcher;
+    dispatcher.dispatch([&counter] { counter++; });
+    kernel::delayTicks(10);
+
+    CHECK_EQ(counter, 0);
+}
+
+TEST_CASE("BoundedDispatcher should call callbacks in order when consume is called") {
+    int value = 0;
+    BoundedDispatcher dispatcher;
+
+    CHECK_EQ(dispatcher.dispatch([&value] { value = value * 10 + 1; }), true);
+    CHECK_EQ(dispatcher.dispatch([&value] { value = value * 10 + 2; }), true);
+    CHECK_EQ(dispatcher.getCount(), 2);
+    CHECK_EQ(dispatcher.consume(100), 2);
+
+    CHECK_EQ(value, 12);
+    CHECK_EQ(dispatcher.getCount(), 0);
+}
+
+TEST_CASE("BoundedDispatcher should be able to dealloc when message is not consumed") {
+    auto context = std::make_shared<uint32_t>();
+    auto* dispatcher = new BoundedDispatcher();
+    dispatcher->dispatch([context] { /* NO-OP */ });
+    CHECK_EQ(context.use_count(), 2);
+    delete dispatcher;
+    CHECK_EQ(context.use_count(), 1);
+}
+
+TEST_CASE("BoundedDispatcher with Backpressure::Reject should reject when full") {
+    int counter = 0;
+    BoundedDispatcher<4> dispatcher(BoundedDispatcher<4>::Backpressure::Reject);
+
+    for (int i = 0; i < 4; ++i) {
+        CHECK_EQ(dispatcher.dispatch([&counter] { counter++; }), true);
+    }
+    CHECK_EQ(dispatcher.dispatch([&counter] { counter++; }), false);
+    CHECK_EQ(dispatcher.getRejectedCount(), 1);
+
+    CHECK_EQ(dispatcher.consume(100), 4);
+    CHECK_EQ(counter, 4);
+}
+
+TEST_CASE("BoundedDispatcher with Backpressure::DropOldest should discard the oldest function when full") {
+    int value = 0;
+    BoundedDispatcher<2> dispatcher(BoundedDispatcher<2>::Backpressure::DropOldest);
+
+    CHECK_EQ(dispatcher.dispatch([&value] { value = value * 10 + 1; }), true);
+    CHECK_EQ(dispatcher.dispatch([&value] { value = value * 10 + 2; }), true);
+    CHECK_EQ(dispatcher.dispatch([&value] { value = value * 10 + 3; }), true);
+    CHECK_EQ(dispatcher.getDroppedCount(), 1);
+
+    CHECK_EQ(dispatcher.consume(100), 2);
+    CHECK_EQ(value, 23);
+}
+
+TEST_CASE("BoundedDispatcher with Backpressure::Block should time out when nothing is consumed") {
+    BoundedDispatcher<2> dispatcher(BoundedDispatcher<2>::Backpressure::Block);
+
+    CHECK_EQ(dispatcher.dispatch([] {}), true);
+    CHECK_EQ(dispatcher.dispatch([] {}), true);
+    CHECK_EQ(dispatcher.dispatch([] {}, 5), false);
+    CHECK_EQ(dispatcher.getRejectedCount(), 1);
+}
+
+TEST_CASE("BoundedDispatcher with Backpressure::Block should wait for the consumer") {
+    BoundedDispatcher<2> dispatcher(BoundedDispatcher<2>::Backpressure::Block);
+    int counter = 0;
+    bool interrupted = false;
+
+    Thread consumer("consumer", 4096, [&dispatcher, &interrupted] {
+        while (!interrupted) {
+            dispatcher.consume(10);
+        }
+        return 0;
+    });
+    consumer.start();
+
+    for (int i = 0; i < 20; ++i) {
+        CHECK_EQ(dispatcher.dispatch([&counter] { counter++; }, 1000), true);
+    }
+
+    kernel::delayTicks(10);
+    interrupted = true;
+    consumer.join();
+
+    CHECK_EQ(counter, 20);
+    CHECK_EQ(dispatcher.getRejectedCount(), 0);
+}
@@ -0,0 +1,119 @@
+#include "doctest.h"
+#include <Tactility/BoundedDispatcher.h>
+#include <Tactility/Dispatcher.h>
+#include <Tactility/Thread.h>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace tt;
+
+/**
+ * Benchmarks that compare Dispatcher with BoundedDispatcher.
+ * The timing results are reported as messages. The benchmarks are skipped in unit test runs:
+ * run "TactilityFreeRtosTests --no-skip" to include them.
+ */
+
+constexpr uint32_t THROUGHPUT_ITERATIONS = 10000;
+constexpr uint32_t LATENCY_ITERATIONS = 200;
+
+template<typename DispatcherType>
+class ConsumerThread {
+
+    DispatcherType& dispatcher;
+    std::atomic<bool> interrupted = false;
+    Thread thread;
+
+public:
+
+    explicit ConsumerThread(DispatcherType& dispatcher) :
+        dispatcher(dispatcher),
+        thread("consumer", 4096, [this] {
+            while (!interrupted) {
+                this->dispatcher.consume(10);
+            }
+            return 0;
+        })
+    {
+        thread.start();
+    }
+
+    ~ConsumerThread() {
+        interrupted = true;
+        thread.join();
+    }
+};
+
+/** @return the amount of microseconds it took to dispatch and consume all items */
+template<typename DispatcherType>
+int64_t measureThroughput(DispatcherType& dispatcher) {
+    std::atomic<uint32_t> counter = 0;
+    ConsumerThread consumer(dispatcher);
+
+    auto start_time = kernel::getMicrosSinceBoot();
+    for (uint32_t i = 0; i < THROUGHPUT_ITERATIONS; ++i) {
+        while (!dispatcher.dispatch([&counter] { counter++; }, 1000)) {
+            kernel::delayTicks(0);
+        }
+    }
+    while (counter < THROUGHPUT_ITERATIONS) {
+        kernel::delayTicks(0);
+    }
+    auto duration = kernel::getMicrosSinceBoot() - start_time;
+
+    CHECK_EQ(counter.load(), THROUGHPUT_ITERATIONS);
+    return duration;
+}
+
+struct Latency {
+    int64_t average;
+    int64_t max;
+};
+
+/** @return the time between dispatching an item and its execution, in microseconds */
+template<typename DispatcherType>
+Latency measureLatency(DispatcherType& dispatcher) {
+    std::atomic<int64_t> executed_time = 0;
+    ConsumerThread consumer(dispatcher);
+
+    int64_t total = 0;
+    int64_t max = 0;
+    for (uint32_t i = 0; i < LATENCY_ITERATIONS; ++i) {
+        executed_time = 0;
+        auto dispatch_time = kernel::getMicrosSinceBoot();
+        CHECK(dispatcher.dispatch([&executed_time] { executed_time = kernel::getMicrosSinceBoot(); }, 1000));
+        while (executed_time == 0) {
+            kernel::delayTicks(0);
+        }
+        auto latency = executed_time - dispatch_time;
+        total += latency;
+        max = std::max(max, latency);
+    }
+
+    return {
+        .average = total / LATENCY_ITERATIONS,
+        .max = max
+    };
+}
+
+TEST_CASE("benchmark dispatcher throughput" * doctest::skip()) {
+    Dispatcher dispatcher;
+    auto dispatcher_duration = measureThroughput(dispatcher);
+
+    BoundedDispatcher<64> bounded_dispatcher(BoundedDispatcher<64>::Backpressure::Block);
+    auto bounded_duration = measureThroughput(bounded_dispatcher);
+
+    MESSAGE("Dispatcher: ", THROUGHPUT_ITERATIONS, " items in ", dispatcher_duration, " us");
+    MESSAGE("BoundedDispatcher: ", THROUGHPUT_ITERATIONS, " items in ", bounded_duration, " us");
+}
+
+TEST_CASE("benchmark dispatcher latency" * doctest::skip()) {
+    Dispatcher dispatcher;
+    auto dispatcher_latency = measureLatency(dispatcher);
+
+    BoundedDispatcher<64> bounded_dispatcher;
+    auto bounded_latency = measureLatency(bounded_dispatcher);
+
+    MESSAGE("Dispatcher latency: average ", dispatcher_latency.average, " us, max ", dispatcher_latency.max, " us");
+    MESSAGE("BoundedDispatcher latency: average ", bounded_latency.average, " us, max ", bounded_latency.max, " us");
+}
@@ -35,3 +35,52 @@ TEST_CASE("message should be passed on correctly") {
     dispatcher.dispatch([]() { /* NO-OP */ });
     dispatcher.consume(100);
 }
+
+TEST_CASE("dispatcher should consume multiple messages in order") {
+    int value = 0;
+    Dispatcher dispatcher;
+
+    dispatcher.dispatch([&value] { value = value * 10 + 1; });
+    dispatcher.dispatch([&value] { value = value * 10 + 2; });
+    dispatcher.dispatch([&value] { value = value * 10 + 3; });
+    CHECK_EQ(dispatcher.consume(100), 3);
+
+    CHECK_EQ(value, 123);
+}
+
+TEST_CASE("dispatcher should keep remaining messages when the consume budget is used up") {
+    int value = 0;
+    Dispatcher dispatcher;
+
+    dispatcher.dispatch([&value] {
+        value = value * 10 + 1;
+        kernel::delayTicks(5);
+    });
+    dispatcher.dispatch([&value] { value = value * 10 + 2; });
+    dispatcher.dispatch([&value] { value = value * 10 + 3; });
+
+    CHECK_EQ(dispatcher.consume(100, 1), 1);
+    CHECK_EQ(value, 1);
+
+    // Remaining messages are consumed without waiting for a new signal
+    CHECK_EQ(dispatcher.consume(0), 2);
+    CHECK_EQ(value, 123);
+}
+
+TEST_CASE("dispatcher should track statistics") {
+    Dispatcher dispatcher;
+
+    dispatcher.dispatch([] {});
+    dispatcher.dispatch([] {});
+    dispatcher.consume(100);
+
+    auto statistics = dispatcher.getStatistics();
+    CHECK_EQ(statistics.queueHighWaterMark, 2);
+    CHECK_EQ(statistics.consumedCount, 2);
+    CHECK_GE(statistics.maxLatencyMicros, 0);
+
+    dispatcher.resetStatistics();
+    statistics = dispatcher.getStatistics();
+    CHECK_EQ(statistics.queueHighWaterMark, 0);
+    CHECK_EQ(statistics.consumedCount, 0);
+}
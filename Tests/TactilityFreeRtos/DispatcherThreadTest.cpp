@@ -26,3 +26,16 @@ TEST_CASE("DispatcherThread should consume jobs") {
     CHECK_EQ(counter, 1);
     thread.stop();
 }
+
+TEST_CASE("DispatcherThread should report statistics") {
+    DispatcherThread thread("test");
+    thread.start();
+
+    thread.dispatch([] {});
+    thread.dispatch([] {});
+
+    tt::kernel::delayTicks(10);
+
+    CHECK_EQ(thread.getStatistics().consumedCount, 2);
+    thread.stop();
+}
@@ -1,6 +1,8 @@
 #include "doctest.h"
 #include <Tactility/PubSub.h>
 
+#include <atomic>
+
 using namespace tt;
 
 TEST_CASE("PubSub publishing with no subscriptions should not crash") {
@@ -34,3 +36,101 @@ TEST_CASE("PubSub unsubscribed subscription does not receive published data") {
 
     CHECK_EQ(value, 0);
 }
+
+TEST_CASE("PubSub subscription can unsubscribe from within its callback") {
+    PubSub<int> pubsub;
+    int counter = 0;
+    PubSub<int>::SubscriptionHandle subscription = nullptr;
+
+    subscription = pubsub.subscribe([&](auto) {
+        counter++;
+        pubsub.unsubscribe(subscription);
+    });
+    pubsub.publish(1);
+    pubsub.publish(2);
+
+    CHECK_EQ(counter, 1);
+}
+
+TEST_CASE("PubSub delivers to all subscribers") {
+    PubSub<int> pubsub;
+    int first = 0;
+    int second = 0;
+
+    auto first_subscription = pubsub.subscribe([&first](auto newValue) { first = newValue; });
+    auto second_subscription = pubsub.subscribe([&second](auto newValue) { second = newValue; });
+    pubsub.publish(1);
+    pubsub.unsubscribe(first_subscription);
+    pubsub.publish(2);
+    pubsub.unsubscribe(second_subscription);
+
+    CHECK_EQ(first, 1);
+    CHECK_EQ(second, 2);
+}
+
+TEST_CASE("PubSub async subscription receives published data on the DispatcherThread") {
+    PubSub<int> pubsub;
+    DispatcherThread dispatcherThread("pubsub");
+    dispatcherThread.start();
+    int value = 0;
+    Thread* receiving_thread = nullptr;
+
+    auto subscription = pubsub.subscribe([&](auto newValue) {
+        value = newValue;
+        receiving_thread = Thread::getCurrent();
+    }, dispatcherThread);
+    pubsub.publish(1);
+
+    kernel::delayTicks(10);
+    pubsub.unsubscribe(subscription);
+    dispatcherThread.stop();
+
+    CHECK_EQ(value, 1);
+    CHECK_NE(receiving_thread, nullptr);
+    CHECK_NE(receiving_thread, Thread::getCurrent());
+}
+
+TEST_CASE("PubSub unsubscribe waits for a callback that is running on another task") {
+    PubSub<int> pubsub;
+    std::atomic<bool> callback_started = false;
+    std::atomic<bool> callback_finished = false;
+
+    auto subscription = pubsub.subscribe([&](auto) {
+        callback_started = true;
+        kernel::delayMillis(50);
+        callback_finished = true;
+    });
+
+    Thread thread("publisher", 4096, [&pubsub] {
+        pubsub.publish(1);
+        return 0;
+    });
+    thread.start();
+    while (!callback_started) {
+        kernel::delayTicks(1);
+    }
+
+    pubsub.unsubscribe(subscription);
+    CHECK(callback_finished);
+    thread.join();
+}
+
+TEST_CASE("PubSub subscriptions can keep changing from within callbacks") {
+    PubSub<int> pubsub;
+    int counter = 0;
+    PubSub<int>::SubscriptionHandle subscription = nullptr;
+    PubSub<int>::Callback callback = [&](auto) {
+        counter++;
+        // Replace the subscription, which retires a snapshot for each publish
+        pubsub.unsubscribe(subscription);
+        subscription = pubsub.subscribe(callback);
+    };
+
+    subscription = pubsub.subscribe(callback);
+    for (int i = 0; i < 100; ++i) {
+        pubsub.publish(i);
+    }
+    pubsub.unsubscribe(subscription);
+
+    CHECK_EQ(counter, 100);
+}